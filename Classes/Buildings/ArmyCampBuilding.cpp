@@ -68,6 +68,7 @@ void ArmyCampBuilding::addTroopDisplay(UnitType type)
     BaseUnit* troopUnit = UnitFactory::createUnit(type);
     if (!troopUnit)
         return;
+    troopUnit->onDeploy();
     
     troopUnit->setScale(0.5f);
     troopUnit->setName("troop_display");
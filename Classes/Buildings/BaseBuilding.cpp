@@ -11,7 +11,6 @@
 #include "BuildingHealthBarUI.h"
 #include "Managers/UpgradeManager.h"
 #include "Services/BuildingUpgradeService.h"
-#include "Unit/BaseUnit.h"
 #include "Unit/CombatStats.h"
 #include "Audio/AudioManager.h"
 
@@ -691,18 +690,6 @@ void BaseBuilding::repair(int amount)
         _currentHitpoints = _maxHitpoints;
 }
 
-void BaseBuilding::setTarget(BaseUnit* target)
-{
-    _currentTarget = target;
-}
-
-void BaseBuilding::attackTarget(BaseUnit* target)
-{
-    if (!target || !isDefenseBuilding())
-        return;
-    // 基础攻击逻辑，子类可重写以实现发射投射物
-}
-
 // ==================== UI与显示 ====================
 
 void BaseBuilding::initHealthBarUI()
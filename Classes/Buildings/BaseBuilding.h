@@ -9,6 +9,7 @@
 #ifndef BASE_BUILDING_H_
 #define BASE_BUILDING_H_
 
+#include "Buildings/BuildingTypes.h"
 #include "ResourceManager.h"
 #include "Unit/CombatStats.h"
 #include "cocos2d.h"
@@ -16,25 +17,8 @@
 #include <functional>
 #include <string>
 
-class BaseUnit;
 class BuildingHealthBarUI;
 
-/**
- * @enum BuildingType
- * @brief 建筑类型枚举
- */
-enum class BuildingType
-{
-    kTownHall,   ///< 大本营
-    kResource,   ///< 资源建筑
-    kArmy,       ///< 军事建筑（兵营）
-    kArmyCamp,   ///< 军营（存放士兵）
-    kDefense,    ///< 防御建筑
-    kWall,       ///< 城墙
-    kDecoration, ///< 装饰
-    kUnknown     ///< 未知类型
-};
-
 /**
  * @struct BuildingConfigData
  * @brief 建筑配置数据结构，用于数据驱动
@@ -142,6 +126,7 @@ public:
     /**
      * @brief 受到伤害
      * @param damage 伤害值
+     * @note 战斗中由 BattleManager 按模拟结算结果调用，建筑本身不做战斗判定
      */
     void takeDamage(int damage);
 
@@ -167,18 +152,6 @@ public:
     /** @brief 获取攻击范围 */
     float getAttackRange() const { return _combatStats.attackRange; }
 
-    /** @brief 设置攻击目标 */
-    void setTarget(BaseUnit* target);
-
-    /** @brief 获取当前目标 */
-    BaseUnit* getTarget() const { return _currentTarget; }
-
-    /** @brief 清除目标 */
-    void clearTarget() { _currentTarget = nullptr; }
-
-    /** @brief 攻击目标 */
-    virtual void attackTarget(BaseUnit* target);
-
     // ==================== 升级系统 ====================
 
     /** @brief 尝试升级建筑 (委托给 Service) */
@@ -257,9 +230,7 @@ protected:
     int _maxHitpoints     = 100;  ///< 最大生命值 (缓存自 config)
     int _currentHitpoints = 100;  ///< 当前生命值
 
-    CombatStats _combatStats;               ///< 战斗属性
-    BaseUnit*   _currentTarget  = nullptr;  ///< 当前攻击目标
-    float       _attackCooldown = 0.0f;     ///< 攻击冷却计时器
+    CombatStats _combatStats;  ///< 战斗属性
 
     BuildingHealthBarUI* _healthBarUI       = nullptr;  ///< 血条UI
     bool                 _battleModeEnabled = false;    ///< 战斗模式是否启用
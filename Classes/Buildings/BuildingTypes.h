@@ -0,0 +1,39 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     BuildingTypes.h
+ * File Function: 建筑类型定义 - 建筑相关的枚举（不依赖引擎）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef BUILDING_TYPES_H_
+#define BUILDING_TYPES_H_
+
+/**
+ * @enum BuildingType
+ * @brief 建筑类型枚举
+ */
+enum class BuildingType
+{
+    kTownHall,   ///< 大本营
+    kResource,   ///< 资源建筑
+    kArmy,       ///< 军事建筑（兵营）
+    kArmyCamp,   ///< 军营（存放士兵）
+    kDefense,    ///< 防御建筑
+    kWall,       ///< 城墙
+    kDecoration, ///< 装饰
+    kUnknown     ///< 未知类型
+};
+
+/**
+ * @enum DefenseType
+ * @brief 防御建筑类型枚举
+ */
+enum class DefenseType
+{
+    kCannon,       ///< 加农炮
+    kArcherTower,  ///< 箭塔
+    kWizardTower   ///< 法师塔
+};
+
+#endif // BUILDING_TYPES_H_
@@ -13,22 +13,9 @@
 #include "cocos2d.h"
 
 #include <string>
-#include <vector>
 
-class BaseUnit;
 class BuildingHealthBarUI;
 
-/**
- * @enum DefenseType
- * @brief 防御建筑类型枚举
- */
-enum class DefenseType
-{
-    kCannon,       ///< 加农炮
-    kArcherTower,  ///< 箭塔
-    kWizardTower   ///< 法师塔
-};
-
 /**
  * @class DefenseBuilding
  * @brief 防御建筑类 - 可自动攻击敌方单位
@@ -81,28 +68,25 @@ public:
     virtual std::string getImageForLevel(int level) const override;
 
     /**
-     * @brief 每帧更新
-     * @param dt 帧时间间隔
+     * @brief 播放开火表现，并把投射物精灵放到建筑位置
+     * @param projectile 投射物精灵（由 BattleObjectPool 提供，加入建筑的父节点）
+     * @param targetPos 开火时的目标位置（箭矢朝向用）
+     * @note 索敌、冷却、飞行和伤害结算都在 BattleSimulation 中完成，
+     *       精灵位置由 BattleManager 每步按模拟中的投射物状态更新，命中时归还对象池
      */
-    virtual void tick(float dt) override;
+    void playShotEffect(cocos2d::Node* projectile, const cocos2d::Vec2& targetPos);
 
     /**
-     * @brief 检测敌方士兵并自动选择目标
-     * @param units 敌方单位列表
-     */
-    void detectEnemies(const std::vector<BaseUnit*>& units);
-
-    /**
-     * @brief 攻击目标
-     * @param target 目标单位
+     * @brief 创建投射物精灵（加农炮/法师塔为炮弹，箭塔为箭矢）
+     * @param defenseType 防御类型
      */
-    virtual void attackTarget(BaseUnit* target) override;
+    static cocos2d::Node* createProjectileSprite(DefenseType defenseType);
 
     /**
-     * @brief 发射炮弹并造成伤害
-     * @param target 目标单位
+     * @brief 创建命中特效节点（法师塔的特效大小与溅射范围一致）
+     * @param defenseType 防御类型
      */
-    void fireProjectile(BaseUnit* target);
+    static cocos2d::Node* createHitEffect(DefenseType defenseType);
 
     /** @brief 播放攻击动画 */
     void playAttackAnimation();
@@ -137,13 +121,13 @@ private:
      * @brief 创建炮弹精灵
      * @return cocos2d::Sprite* 炮弹精灵
      */
-    cocos2d::Sprite* createCannonballSprite();
+    static cocos2d::Sprite* createCannonballSprite();
 
     /**
      * @brief 创建箭矢精灵
      * @return cocos2d::Sprite* 箭矢精灵
      */
-    cocos2d::Sprite* createArrowSprite();
+    static cocos2d::Sprite* createArrowSprite();
 
     DefenseType _defenseType;            ///< 防御建筑类型
     std::string _customImagePath;        ///< 自定义图片路径
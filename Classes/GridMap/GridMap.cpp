@@ -43,11 +43,13 @@ bool GridMap::init(const Size& mapSize, float tileSize)
     _gridWidth = static_cast<int>(round(mapSize.width / tileSize)) - 1;
     _gridHeight = _gridWidth;
 
-    _collisionMap.resize(_gridWidth, std::vector<bool>(_gridHeight, false));
+    _collisionMap.resize(_gridWidth, _gridHeight);
 
     _startPixel = Vec2(_mapSize.width / 2.0f, _mapSize.height + 30.0f - _tileSize * 0.5f);
     _gridVisible = false;
     _deployOverlayVisible = false;
+    _baseShown = false;
+    _baseValid = false;
 
     return true;
 }
@@ -305,34 +307,21 @@ bool GridMap::canDeployAt(int gridX, int gridY) const
         return false;
     }
 
-    // 检查周围3x3区域（包括自身和周围一圈）是否有被占用的网格
-    for (int dx = -1; dx <= 1; ++dx)
-    {
-        for (int dy = -1; dy <= 1; ++dy)
-        {
-            int checkX = gridX + dx;
-            int checkY = gridY + dy;
-
-            // 边界检查
-            if (checkX < 0 || checkX >= _gridWidth ||
-                checkY < 0 || checkY >= _gridHeight)
-            {
-                continue;
-            }
-
-            // 如果该网格被建筑占用，则不能在此位置部署
-            if (_collisionMap[checkX][checkY])
-            {
-                return false;
-            }
-        }
-    }
-
-    return true;
+    // 检查周围3x3区域（包括自身和周围一圈）是否有被占用的网格，超出地图的部分被裁掉
+    return !_collisionMap.anyInRect(gridX - 1, gridY - 1, 3, 3);
 }
 
 void GridMap::updateBuildingBase(Vec2 gridPos, Size size, bool isValid)
 {
+    if (_baseShown && _baseGridPos == gridPos && _baseSize.equals(size) && _baseValid == isValid)
+    {
+        return;
+    }
+    _baseShown = true;
+    _baseGridPos = gridPos;
+    _baseSize = size;
+    _baseValid = isValid;
+
     _baseNode->clear();
 
     float halfW = _tileSize / 2.0f;
@@ -374,6 +363,7 @@ void GridMap::updateBuildingBase(Vec2 gridPos, Size size, bool isValid)
 
 void GridMap::hideBuildingBase()
 {
+    _baseShown = false;
     _baseNode->clear();
 }
 
@@ -389,17 +379,8 @@ bool GridMap::checkArea(Vec2 startGridPos, Size size)
         return false;
     }
 
-    for (int x = startX; x < startX + w; x++)
-    {
-        for (int y = startY; y < startY + h; y++)
-        {
-            if (_collisionMap[x][y])
-            {
-                return false;
-            }
-        }
-    }
-    return true;
+    // 按行检查覆盖到的字，不逐格访问
+    return !_collisionMap.anyInRect(startX, startY, w, h);
 }
 
 
@@ -407,6 +388,7 @@ bool GridMap::checkArea(Vec2 startGridPos, Size size)
 void GridMap::setStartPixel(const Vec2& pixel)
 {
     _startPixel = pixel;
+    _baseShown = false;  // 底座预览的顶点依赖起始像素，下一次更新时必须重绘
     if (_gridVisible)
         showWholeGrid(true);
 }
@@ -446,9 +428,7 @@ void GridMap::setStartCorner(GridMap::Corner corner)
 
 bool GridMap::isBlocked(int x, int y) const
 {
-    if (x < 0 || y < 0 || x >= _gridWidth || y >= _gridHeight)
-        return true;
-    return _collisionMap[x][y];
+    return _collisionMap.isBlocked(x, y);
 }
 
 void GridMap::markArea(cocos2d::Vec2 startGridPos, cocos2d::Size size, bool occupied)
@@ -458,17 +438,6 @@ void GridMap::markArea(cocos2d::Vec2 startGridPos, cocos2d::Size size, bool occu
     int w = static_cast<int>(size.width);
     int h = static_cast<int>(size.height);
 
-    // 遍历建筑覆盖的每一个格子
-    for (int x = startX; x < startX + w; x++)
-    {
-        for (int y = startY; y < startY + h; y++)
-        {
-            // 边界检查，防止数组越界
-            if (x >= 0 && x < _gridWidth && y >= 0 && y < _gridHeight)
-            {
-                // _collisionMap 是你在 GridMap 中存储 true/false 的二维数组
-                _collisionMap[x][y] = occupied;
-            }
-        }
-    }
+    // 越界部分被裁掉，每行只改写覆盖到的字
+    _collisionMap.fillRect(startX, startY, w, h, occupied);
 }
\ No newline at end of file
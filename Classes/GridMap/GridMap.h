@@ -9,6 +9,7 @@
 #pragma once
 
 #include "cocos2d.h"
+#include "Simulation/CollisionBitmap.h"
 #include <vector>
 
 /**
@@ -31,7 +32,7 @@ private:
     cocos2d::DrawNode* _baseNode;                     ///< 用于绘制建筑底座预览的节点
     cocos2d::DrawNode* _deployOverlayNode;            ///< 用于绘制部署区域覆盖层的节点
 
-    std::vector<std::vector<bool>> _collisionMap;     ///< 碰撞地图，true表示该网格被占用
+    CollisionBitmap _collisionMap;                    ///< 碰撞地图（按行打包的位图），置位表示该网格被占用
     int _gridWidth;                                   ///< 网格宽度（网格单位）
     int _gridHeight;                                  ///< 网格高度（网格单位）
 
@@ -39,6 +40,11 @@ private:
     bool _gridVisible;                                ///< 网格是否可见
     bool _deployOverlayVisible;                       ///< 部署覆盖层是否可见
 
+    bool _baseShown;                                  ///< 建筑底座预览是否已绘制
+    cocos2d::Vec2 _baseGridPos;                       ///< 已绘制底座预览的起始网格坐标
+    cocos2d::Size _baseSize;                          ///< 已绘制底座预览的尺寸
+    bool _baseValid;                                  ///< 已绘制底座预览的有效状态
+
 public:
     /**
      * @enum Corner
@@ -111,6 +117,7 @@ public:
      * @param gridPos 建筑的起始网格坐标
      * @param size 建筑占用的网格尺寸
      * @param isValid 是否为有效放置位置（绿色/红色显示）
+     * @note 拖动时触摸移动事件远多于跨越网格的次数，位置、尺寸和状态都未变化时不重绘
      */
     void updateBuildingBase(cocos2d::Vec2 gridPos, cocos2d::Size size, bool isValid);
     
@@ -191,4 +198,17 @@ public:
      * @return 被阻挡或超出范围返回true，否则返回false
      */
     bool isBlocked(int x, int y) const;
+
+    /**
+     * @brief 碰撞地图版本号
+     * @return 每次 markArea 实际改变了某个网格的占用状态时递增
+     * @note 缓存可放置/可部署结果的模块比较版本号即可判断是否需要刷新
+     */
+    inline uint32_t getCollisionVersion() const { return _collisionMap.getVersion(); }
+
+    /**
+     * @brief 获取碰撞位图（按行读取原始字，供部署检查等模块按字扫描）
+     * @return 碰撞位图
+     */
+    inline const CollisionBitmap& getCollisionMap() const { return _collisionMap; }
 };
\ No newline at end of file
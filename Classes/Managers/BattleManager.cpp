@@ -13,15 +13,34 @@
 #include "Managers/DeploymentValidator.h"
 #include "Managers/MusicManager.h"
 #include "Managers/TroopInventory.h"
-#include "PathFinder.h"
 #include "ResourceManager.h"
-#include "Unit/UnitFactory.h"
 
+#include <algorithm>
+#include <cmath>
 #include <ctime>
+#include <limits>
+#include <thread>
 
 USING_NS_CC;
 
-BattleManager::BattleManager() : _deploymentValidator(nullptr) {}
+namespace
+{
+/** @brief 按所在行（地图层 y 坐标取整）计算渲染深度：越靠下越靠前 */
+int depthOfRow(int row)
+{
+    return 10000 - row;
+}
+} // namespace
+
+BattleManager::BattleManager() : _deploymentValidator(nullptr)
+{
+    // 寻路和步进中的数据并行阶段各用最多 2 个后台线程（给主线程留一个核心）；
+    // 单核设备上为 0，全部在主线程上执行。两者都不影响模拟结果
+    int cores   = static_cast<int>(std::thread::hardware_concurrency());
+    int workers = std::min(2, std::max(0, cores - 1));
+    _simulation.setPathWorkerCount(workers);
+    _simulation.setJobWorkerCount(workers);
+}
 
 BattleManager::~BattleManager() {}
 
@@ -57,72 +76,99 @@ void BattleManager::init(cocos2d::Node* mapLayer, const AccountGameData& enemyDa
     _state         = BattleState::LOADING;
 
     // 重置所有战斗数据
-    _elapsedTime        = 0.0f;
-    _readyPhaseElapsed  = 0.0f;
-    _starsEarned        = 0;
-    _goldLooted         = 0;
-    _elixirLooted       = 0;
-    _destructionPercent = 0;
-    _accumulatedTime    = 0.0f;
-    _currentFrame       = 0;
+    _readyPhaseElapsed = 0.0f;
+    _goldLooted        = 0;
+    _elixirLooted      = 0;
+    _accumulatedTime   = 0.0f;
+    _simulation.reset();
 
     // 重置战斗结束状态
     _endReason          = BattleEndReason::TIMEOUT;
-    _townHallDestroyed  = false;
     _hasDeployedAnyUnit = false;
 
-    _deployedUnits.clear();
+    _unitViews.clear();
+    _unitRows.clear();
+    _projectileViews.clear();
     _enemyBuildings.clear();
+    _objectPool.clear();
 }
 
 void BattleManager::setBuildings(const std::vector<BaseBuilding*>& buildings)
 {
-    _enemyBuildings      = buildings;
-    _totalBuildingHP     = 0;
-    _destroyedBuildingHP = 0;
+    _enemyBuildings.clear();
+    _simulation.reset();
 
-    if (!_gridMap)
+    if (_gridMap)
+    {
+        Vec2 startPixel = _gridMap->getStartPixel();
+        _simulation.initGrid(_gridMap->getGridWidth(), _gridMap->getGridHeight(),
+                             Fixed::fromFloat(_gridMap->getTileSize()), SimVec2::fromFloat(startPixel.x, startPixel.y));
+    }
+    else
+    {
         CCLOG("❌ 警告: setBuildings 调用时 _gridMap 为空!");
+    }
 
     CCLOG("📊 ============ 设置战斗建筑 ============");
     CCLOG("📊 建筑总数: %zu", buildings.size());
 
-    for (auto* building : _enemyBuildings)
+    for (auto* building : buildings)
     {
-        if (building)
+        if (!building)
+            continue;
+
+        int maxHP = building->getMaxHitpoints();
+        int curHP = building->getHitpoints();
+
+        // 确保血量合理，防止初始化问题
+        if (maxHP <= 0)
         {
-            int maxHP = building->getMaxHitpoints();
-            int curHP = building->getHitpoints();
-            
-            // 确保血量合理，防止初始化问题
-            if (maxHP <= 0)
-            {
-                CCLOG("⚠️ 警告：建筑 %s 的 maxHP 为 %d，使用默认值 100", 
-                      building->getDisplayName().c_str(), maxHP);
-                maxHP = 100;
-            }
-            
-            // 战斗开始时强制将所有建筑血量重置为满血
-            if (curHP != maxHP)
-            {
-                CCLOG("⚠️ 警告：建筑 %s 血量不一致 (%d/%d)，重置为满血", 
-                      building->getDisplayName().c_str(), curHP, maxHP);
-                building->repair(maxHP - curHP);
-            }
-            
-            _totalBuildingHP += maxHP;
+            CCLOG("⚠️ 警告：建筑 %s 的 maxHP 为 %d，使用默认值 100", 
+                  building->getDisplayName().c_str(), maxHP);
+            maxHP = 100;
+        }
 
-            CCLOG("📊 建筑: %s, 血量: %d/%d, 类型: %d", 
-                  building->getDisplayName().c_str(), 
-                  curHP, maxHP,
-                  static_cast<int>(building->getBuildingType()));
+        // 战斗开始时强制将所有建筑血量重置为满血
+        if (curHP != maxHP)
+        {
+            CCLOG("⚠️ 警告：建筑 %s 血量不一致 (%d/%d)，重置为满血", 
+                  building->getDisplayName().c_str(), curHP, maxHP);
+            building->repair(maxHP - curHP);
+        }
 
-            if (_gridMap)
-            {
-                Vec2 gridPos  = building->getGridPosition();
-                Size gridSize = building->getGridSize();
-                _gridMap->markArea(gridPos, gridSize, true);
-            }
+        CCLOG("📊 建筑: %s, 血量: %d/%d, 类型: %d", 
+              building->getDisplayName().c_str(), 
+              curHP, maxHP,
+              static_cast<int>(building->getBuildingType()));
+
+        Vec2 gridPos  = building->getGridPosition();
+        Size gridSize = building->getGridSize();
+
+        SimBuildingDesc desc;
+        desc.type             = building->getBuildingType();
+        desc.footprint.x      = static_cast<int>(gridPos.x);
+        desc.footprint.y      = static_cast<int>(gridPos.y);
+        desc.footprint.width  = static_cast<int>(gridSize.width);
+        desc.footprint.height = static_cast<int>(gridSize.height);
+        desc.position         = SimVec2::fromFloat(building->getPositionX(), building->getPositionY());
+        desc.maxHitpoints     = maxHP;
+        desc.stats            = building->getCombatStats();
+
+        if (auto* defenseBuilding = dynamic_cast<DefenseBuilding*>(building))
+        {
+            desc.defenseType = defenseBuilding->getDefenseType();
+        }
+
+        // 模拟建筑 ID 与 _enemyBuildings 下标一致
+        _simulation.addBuilding(desc);
+        _enemyBuildings.push_back(building);
+
+        // 建筑不会移动，深度只设置一次
+        building->setLocalZOrder(depthOfRow(static_cast<int>(building->getPositionY())));
+
+        if (_gridMap)
+        {
+            _gridMap->markArea(gridPos, gridSize, true);
         }
     }
 
@@ -137,7 +183,7 @@ void BattleManager::setBuildings(const std::vector<BaseBuilding*>& buildings)
         }
     }
 
-    CCLOG("📊 总血量: %d", _totalBuildingHP);
+    CCLOG("📊 总血量: %d", _simulation.getTotalBuildingHP());
     CCLOG("📊 ========================================");
 }
 
@@ -152,8 +198,8 @@ void BattleManager::startBattle(const TroopDeploymentMap& deployment)
 
     // 进入准备阶段（准备倒计时开始，战斗计时器不启动）
     _state             = BattleState::READY;
-    _elapsedTime       = 0.0f;
     _readyPhaseElapsed = 0.0f;
+    _simulation.setFrame(0);
 
     CCLOG("🎮 进入战斗准备阶段，等待部署第一个单位（最长 %.0f 秒）...", _readyPhaseTime);
 
@@ -189,6 +235,15 @@ void BattleManager::startBattle(const TroopDeploymentMap& deployment)
     CCLOG("📦 可部署部队: 野蛮人=%d, 弓箭手=%d, 巨人=%d, 哥布林=%d, 炸弹人=%d", 
           _barbarianCount, _archerCount, _giantCount, _goblinCount, _wallBreakerCount);
 
+    // 按本场规模预热对象池，部署、开火和命中时不再创建精灵
+    std::map<DefenseType, int> defenseCounts;
+    for (auto* building : _enemyBuildings)
+    {
+        if (auto* defenseBuilding = dynamic_cast<DefenseBuilding*>(building))
+            defenseCounts[defenseBuilding->getDefenseType()]++;
+    }
+    _objectPool.prewarm(deployment, defenseCounts);
+
     // 非回放模式下消耗部队并开始录制
     if (!_isReplayMode)
     {
@@ -221,8 +276,8 @@ void BattleManager::skipReadyPhase()
     CCLOG("⏩ 跳过准备阶段，直接进入战斗状态（回放模式）");
     
     _state = BattleState::FIGHTING;
-    _elapsedTime = 0.0f;
     _readyPhaseElapsed = _readyPhaseTime;  // 标记准备阶段已完成
+    _simulation.setFrame(0);
 
     // 激活所有防御建筑
     activateAllBuildings();
@@ -241,7 +296,7 @@ void BattleManager::triggerBattleStart()
     CCLOG("⚔️ 战斗正式开始！计时器启动（准备阶段用时: %.1f秒）", _readyPhaseElapsed);
     
     _state = BattleState::FIGHTING;
-    _elapsedTime = 0.0f;
+    _simulation.setFrame(0);
 
     // 播放战斗音乐
     MusicManager::getInstance().playMusic(MusicType::BATTLE_GOING);
@@ -305,98 +360,151 @@ void BattleManager::update(float dt)
     {
         _accumulatedTime += dt;
 
-        while (_accumulatedTime >= FIXED_TIME_STEP)
+        bool stepped = false;
+        while (_accumulatedTime >= BattleSimulation::kFixedTimeStep)
         {
             fixedUpdate();
-            _accumulatedTime -= FIXED_TIME_STEP;
+            _accumulatedTime -= BattleSimulation::kFixedTimeStep;
+            stepped = true;
         }
+
+        // 精灵只需反映本帧最后一步的结果（加速回放时一帧会推进多步）
+        if (stepped)
+            syncViews();
     }
 }
 
 void BattleManager::fixedUpdate()
 {
-    _currentFrame++;
+    // 回放中每隔一段时间在推进之前保存关键帧，跳转从最近的关键帧恢复（录制时不保存）
+    ReplaySystem::getInstance().captureKeyframe(_simulation);
 
+    // 回放的部署必须在推进之前执行，与录制时 recordDeployUnit(getFrame()) 的时序一致
     if (_isReplayMode)
     {
-        ReplaySystem::getInstance().updateFrame(_currentFrame);
+        ReplaySystem::getInstance().updateFrame(_simulation.getFrame());
     }
 
-    updateBattleState(FIXED_TIME_STEP);
+    _simulation.step();
+
+    // 快进中不把事件映射为表现，结束后由 snapViews() 一次性对齐
+    if (_fastForwarding)
+        return;
+
+    updateBattleState();
 }
 
-void BattleManager::updateBattleState(float dt)
+void BattleManager::fastForward(unsigned int targetFrame, const std::vector<TimedDeployment>& deployments)
 {
-    // 仅在 FIGHTING 状态下累加战斗时间
-    if (_state == BattleState::FIGHTING)
-    {
-        _elapsedTime += dt;
-    }
+    targetFrame     = std::min(targetFrame, getBattleEndFrame());
+    _fastForwarding = true;
+
+    // 快进中不处理命中事件，飞行中的投射物精灵先收回，否则槽位复用后会留在场景里
+    clearProjectileViews();
 
-    // 更新 Z-Order
-    for (auto* unit : _deployedUnits)
+    // 与逐帧推进相同：部署在该帧推进之前执行；全部摧毁或回放录制的结束帧到达后停止
+    size_t next = 0;
+    while (_simulation.getFrame() < targetFrame && !_simulation.areAllBuildingsDestroyed() &&
+           _state != BattleState::FINISHED)
     {
-        if (unit && !unit->isDead() && !unit->isPendingRemoval())
+        for (; next < deployments.size() && deployments[next].frame <= _simulation.getFrame(); next++)
         {
-            int newZOrder = 10000 - static_cast<int>(unit->getPositionY());
-            unit->setLocalZOrder(newZOrder);
+            deployUnitRemote(deployments[next].type, deployments[next].position);
         }
-    }
 
-    for (auto* building : _enemyBuildings)
+        // 还没有进入战斗（没有部署过单位）时模拟不推进
+        if (_state != BattleState::FIGHTING)
+            break;
+        fixedUpdate();
+    }
+    for (; next < deployments.size() && _state != BattleState::FINISHED; next++)
     {
-        if (building && !building->isDestroyed())
-        {
-            int newZOrder = 10000 - static_cast<int>(building->getPositionY());
-            building->setLocalZOrder(newZOrder);
-        }
+        deployUnitRemote(deployments[next].type, deployments[next].position);
     }
 
-    // 清理已死亡且等待移除的单位
-    _deployedUnits.erase(
-        std::remove_if(_deployedUnits.begin(), _deployedUnits.end(),
-            [](BaseUnit* unit) {
-                if (unit == nullptr)
-                {
-                    return true;
-                }
-                // 检查是否已标记为等待移除
-                if (unit->isPendingRemoval())
-                {
-                    return true;
-                }
-                return false;
-            }),
-        _deployedUnits.end());
+    _fastForwarding  = false;
+    _accumulatedTime = 0.0f;
 
-    // 更新单位移动
-    for (auto* unit : _deployedUnits)
+    snapViews();
+    syncViews();
+
+    CCLOG("⏩ 快进完成: 帧 %u, 单位 %zu, 摧毁率 %d%%", _simulation.getFrame(), _unitViews.size(),
+          _simulation.getDestructionPercent());
+
+    if (_onUIUpdate)
+        _onUIUpdate();
+    checkBattleEndConditions();
+}
+
+void BattleManager::catchUpSpectate(int64_t elapsedMs, const std::vector<TimedDeployment>& deployments)
+{
+    unsigned int targetFrame = static_cast<unsigned int>(elapsedMs * 60 / 1000);
+
+    // setTimeOffset 把帧号直接对齐到了已进行时间，模拟中还没有单位：回到第 0 帧按原始时序重新推进
+    if (_simulation.getUnits().empty())
+        _simulation.setFrame(0);
+
+    fastForward(targetFrame, deployments);
+}
+
+void BattleManager::seekReplay(unsigned int targetFrame)
+{
+    if (!_isReplayMode || (_state != BattleState::FIGHTING && _state != BattleState::FINISHED))
+        return;
+
+    targetFrame = std::min(targetFrame, getBattleEndFrame());
+
+    // 回放已结束时只能向后跳转，到达战斗结束之后的帧没有意义
+    bool resume = _state == BattleState::FINISHED;
+    if (resume && targetFrame >= _simulation.getFrame())
+        return;
+
+    std::vector<UnitType> deployedTypes;
+    for (const auto& unit : _simulation.getUnits())
+        deployedTypes.push_back(unit.type);
+
+    if (!ReplaySystem::getInstance().seek(targetFrame, _simulation))
+        return;
+
+    // 向后跳转：关键帧之后部署的单位已不在模拟中，收回精灵，部队退回计数（之后重新部署时不会被拒绝）
+    const auto& units     = _simulation.getUnits();
+    size_t      unitCount = units.size();
+    for (size_t i = unitCount; i < _unitViews.size(); i++)
     {
-        if (unit && !unit->isDead())
-        {
-            unit->tickMovement(dt);
-        }
+        if (_unitViews[i])
+            _objectPool.recycleUnit(_unitViews[i]);
+        if (int* count = troopCountOf(deployedTypes[i]))
+            (*count)++;
     }
 
-    // 更新 AI（包括攻击冷却和攻击逻辑）
-    updateUnitAI(dt);
+    // 向前跳过了关键帧：其间部署的单位直接出现在模拟中，扣除部队计数，精灵由 snapViews() 取出
+    for (size_t i = _unitViews.size(); i < unitCount; i++)
+    {
+        if (int* count = troopCountOf(units[i].type))
+            (*count)--;
+        _hasDeployedAnyUnit = true;
+    }
+    _unitViews.resize(unitCount, nullptr);
+    _unitRows.resize(unitCount, std::numeric_limits<int>::min());
 
-    // 更新防御建筑
-    for (auto* building : _enemyBuildings)
+    // 从结束状态跳回：恢复战斗状态和音乐，到达结束条件时 fastForward 会再次结束战斗
+    if (resume)
     {
-        if (building && building->isDefenseBuilding())
-        {
-            auto* defenseBuilding = dynamic_cast<DefenseBuilding*>(building);
-            if (defenseBuilding)
-            {
-                defenseBuilding->tick(dt);
-                defenseBuilding->detectEnemies(_deployedUnits);
-            }
-        }
+        _state = BattleState::FIGHTING;
+        MusicManager::getInstance().playMusic(MusicType::BATTLE_GOING);
     }
 
-    // 更新星星和破坏率
-    updateStarsAndDestruction();
+    fastForward(targetFrame);
+}
+
+unsigned int BattleManager::getBattleEndFrame() const
+{
+    return static_cast<unsigned int>(_battleTime / BattleSimulation::kFixedTimeStep);
+}
+
+void BattleManager::updateBattleState()
+{
+    applySimulationEvents();
 
     // 检查战斗结束条件
     checkBattleEndConditions();
@@ -405,83 +513,214 @@ void BattleManager::updateBattleState(float dt)
         _onUIUpdate();
 }
 
-void BattleManager::updateStarsAndDestruction()
+void BattleManager::applySimulationEvents()
 {
-    if (_enemyBuildings.empty())
+    for (const auto& event : _simulation.getEvents())
     {
-        _destructionPercent = 100;
-        _starsEarned        = 3;
-        return;
-    }
+        BaseUnit*     unitView     = (event.unit >= 0 && event.unit < static_cast<int>(_unitViews.size()))
+                                         ? _unitViews[event.unit]
+                                         : nullptr;
+        BaseBuilding* buildingView = (event.building >= 0 && event.building < static_cast<int>(_enemyBuildings.size()))
+                                         ? _enemyBuildings[event.building]
+                                         : nullptr;
+
+        switch (event.type)
+        {
+        case SimEventType::kUnitMove:
+            if (unitView)
+                unitView->playMoveAnimation(Vec2(event.direction.x.toFloat(), event.direction.y.toFloat()));
+            break;
 
-    // 计算破坏的 HP
-    _destroyedBuildingHP = 0;
-    int  destroyedCount  = 0;
-    bool townHallFound   = false;
+        case SimEventType::kUnitIdle:
+            if (unitView)
+                unitView->stopMoving();
+            break;
 
-    for (auto* building : _enemyBuildings)
-    {
-        if (!building)
-            continue;
+        case SimEventType::kUnitAttack:
+            if (unitView)
+                unitView->attack(false);
+            break;
 
-        int lostHP = building->getMaxHitpoints() - building->getHitpoints();
-        _destroyedBuildingHP += lostHP;
+        case SimEventType::kUnitDamaged:
+            if (unitView)
+                unitView->showDamage(event.value);
+            break;
 
-        if (building->isDestroyed())
-        {
-            destroyedCount++;
+        case SimEventType::kUnitDied:
+            if (unitView)
+            {
+                SimVec2 position = _simulation.getUnitPosition(event.unit);
+                unitView->setPosition(position.x.toFloat(), position.y.toFloat());
+                unitView->die();
+                _unitViews[event.unit] = nullptr;
+            }
+            break;
+
+        case SimEventType::kBuildingDamaged:
+            if (buildingView)
+                buildingView->takeDamage(buildingView->getHitpoints() - event.value);
+            break;
 
-            // 检測大本营是否被摧毁
-            if (building->getBuildingType() == BuildingType::kTownHall)
+        case SimEventType::kBuildingDestroyed:
+            if (buildingView)
             {
-                if (!_townHallDestroyed)
+                CCLOG("🔥 %s 被摧毁!", buildingView->getDisplayName().c_str());
+                if (_gridMap)
                 {
-                    _townHallDestroyed = true;
-                    CCLOG("⭐ 大本营被摧毁! +1 星");
+                    _gridMap->markArea(buildingView->getGridPosition(), buildingView->getGridSize(), false);
                 }
             }
-        }
+            break;
 
-        if (building->getBuildingType() == BuildingType::kTownHall)
-        {
-            townHallFound = true;
+        case SimEventType::kDefenseFire:
+            if (auto* defenseBuilding = dynamic_cast<DefenseBuilding*>(buildingView))
+            {
+                if (event.value >= static_cast<int>(_projectileViews.size()))
+                    _projectileViews.resize(event.value + 1);
+
+                ProjectileView& view = _projectileViews[event.value];
+                view.type            = defenseBuilding->getDefenseType();
+                view.node            = _objectPool.acquireProjectile(view.type);
+                defenseBuilding->playShotEffect(view.node,
+                                                Vec2(event.position.x.toFloat(), event.position.y.toFloat()));
+                if (!view.node->getParent())
+                {
+                    _objectPool.releaseProjectile(view.type, view.node);
+                    view.node = nullptr;
+                }
+            }
+            break;
+
+        case SimEventType::kProjectileHit:
+            if (event.value < static_cast<int>(_projectileViews.size()) && _projectileViews[event.value].node)
+            {
+                ProjectileView& view   = _projectileViews[event.value];
+                Node*           parent = view.node->getParent();
+                _objectPool.releaseProjectile(view.type, view.node);
+                view.node = nullptr;
+                _objectPool.playHitEffect(view.type, parent,
+                                          Vec2(event.position.x.toFloat(), event.position.y.toFloat()));
+            }
+            break;
         }
     }
+}
+
+void BattleManager::syncViews()
+{
+    // 精灵只读取模拟结果，不参与移动计算
+    const SimUnitMotion& motion = _simulation.getUnitMotion();
 
-    // 计算破坏率 (基于 HP)
-    if (_totalBuildingHP > 0)
+    for (size_t i = 0; i < _unitViews.size(); i++)
     {
-        _destructionPercent = std::min(100, (_destroyedBuildingHP * 100) / _totalBuildingHP);
-    }
+        BaseUnit* unit = _unitViews[i];
+        if (!unit)
+            continue;
 
-    // 统一的星星计算逻辑
-    int newStars = 0;
+        SimVec2 position = motion.getPosition(static_cast<int>(i));
+        unit->setPosition(position.x.toFloat(), position.y.toFloat());
 
-    // 规则1: 摧毁大本营 = 1 星
-    if (_townHallDestroyed)
+        // 只有换行的单位才重新设置深度（父节点在下一次渲染时统一重排一次）
+        int row = position.y.toInt();
+        if (row != _unitRows[i])
+        {
+            _unitRows[i] = row;
+            unit->setLocalZOrder(depthOfRow(row));
+        }
+    }
+
+    // 投射物追踪目标：在发射点和目标当前位置之间按模拟中的飞行进度插值
+    const auto& projectiles = _simulation.getProjectiles();
+    for (size_t i = 0; i < _projectileViews.size(); i++)
     {
-        newStars++;
+        Node* view = _projectileViews[i].node;
+        if (!view || !projectiles[i].active)
+            continue;
+
+        const SimProjectile& projectile = projectiles[i];
+        SimVec2              target     = motion.getPosition(projectile.target);
+        float                progress   = projectile.progress().toFloat();
+        Vec2                 origin(projectile.origin.x.toFloat(), projectile.origin.y.toFloat());
+        view->setPosition(origin + (Vec2(target.x.toFloat(), target.y.toFloat()) - origin) * progress);
     }
+}
 
-    // 规则2: 破坏率 >= 50% = 1 星
-    if (_destructionPercent >= 50)
+void BattleManager::snapViews()
+{
+    const auto&          units  = _simulation.getUnits();
+    const SimUnitMotion& motion = _simulation.getUnitMotion();
+    for (size_t i = 0; i < _unitViews.size(); i++)
     {
-        newStars++;
+        BaseUnit*      view = _unitViews[i];
+        const SimUnit& unit = units[i];
+        if (!view && !unit.dead)
+        {
+            // 回放跳转回关键帧后，之后才死亡的单位重新存活（原精灵已播放死亡动画），重新取出一个
+            view = _objectPool.acquireUnit(unit.type);
+            if (!view)
+                continue;
+            view->enableBattleMode();
+            if (_mapLayer)
+                _mapLayer->addChild(view);
+            _unitViews[i] = view;
+            _unitRows[i]  = std::numeric_limits<int>::min(); // 由 syncViews() 设置位置和深度
+        }
+        if (!view)
+            continue;
+
+        if (unit.dead)
+        {
+            _objectPool.recycleUnit(view);
+            _unitViews[i] = nullptr;
+            continue;
+        }
+
+        if (view->getCurrentHP() != unit.stats.hitpoints)
+            view->showDamage(unit.stats.hitpoints);
+
+        if (motion.isMoving(unit.id))
+            view->playMoveAnimation(Vec2(unit.velocity.x.toFloat(), unit.velocity.y.toFloat()));
+        else
+            view->stopMoving();
     }
 
-    // 规则3: 破坏率 = 100% = 1 星 (总共最多3星)
-    if (_destructionPercent >= 100)
+    const auto& buildings = _simulation.getBuildings();
+    for (size_t i = 0; i < _enemyBuildings.size() && i < buildings.size(); i++)
     {
-        newStars++;
+        BaseBuilding* view = _enemyBuildings[i];
+        if (!view || view->getHitpoints() == buildings[i].hitpoints)
+            continue;
+
+        if (view->getHitpoints() > buildings[i].hitpoints)
+        {
+            view->takeDamage(view->getHitpoints() - buildings[i].hitpoints);
+            if (buildings[i].isDestroyed() && _gridMap)
+                _gridMap->markArea(view->getGridPosition(), view->getGridSize(), false);
+            continue;
+        }
+
+        // 回放跳转回关键帧：建筑恢复到当时的生命值，当时未被摧毁的重新显示并占据网格
+        bool wasDestroyed = view->isDestroyed();
+        view->repair(buildings[i].hitpoints - view->getHitpoints());
+        if (wasDestroyed)
+        {
+            view->setVisible(true);
+            if (_gridMap)
+                _gridMap->markArea(view->getGridPosition(), view->getGridSize(), true);
+        }
     }
 
-    // 只能增加星星，不能减少
-    if (newStars > _starsEarned)
+    // 快进中发射的投射物没有精灵，命中时 kProjectileHit 按空槽位跳过
+}
+
+void BattleManager::clearProjectileViews()
+{
+    for (auto& view : _projectileViews)
     {
-        int gained   = newStars - _starsEarned;
-        _starsEarned = newStars;
-        CCLOG("⭐ 星星更新: %d (+%d), 破坏率: %d%%", _starsEarned, gained, _destructionPercent);
+        if (view.node)
+            _objectPool.releaseProjectile(view.type, view.node);
     }
+    _projectileViews.clear();
 }
 
 void BattleManager::checkBattleEndConditions()
@@ -492,7 +731,7 @@ void BattleManager::checkBattleEndConditions()
     // 仅在 FIGHTING 状态下检查时间
     if (_state == BattleState::FIGHTING)
     {
-        float remainingTime = _battleTime - _elapsedTime;
+        float remainingTime = _battleTime - _simulation.getElapsedTime();
 
         // 条件1: 战斗时间耗尽
         if (remainingTime <= 0)
@@ -504,8 +743,8 @@ void BattleManager::checkBattleEndConditions()
         }
     }
 
-    // 条件2: 100% 破坏
-    if (_destructionPercent >= 100)
+    // 条件2: 100% 破坏（模拟在建筑被摧毁时累加计数）
+    if (_simulation.areAllBuildingsDestroyed())
     {
         CCLOG("🎉 战斗结束: 全部建筑被摧毁!");
         _endReason = BattleEndReason::ALL_DESTROYED;
@@ -531,29 +770,12 @@ void BattleManager::checkBattleEndConditions()
 
 bool BattleManager::checkAllUnitsDeadOrDeployed() const
 {
-    for (auto* unit : _deployedUnits)
-    {
-        // 跳过空指针和等待移除的单位
-        if (unit && !unit->isDead() && !unit->isPendingRemoval())
-        {
-            return false;
-        }
-    }
-    return true;
+    return countAliveUnits() == 0;
 }
 
 int BattleManager::countAliveUnits() const
 {
-    int count = 0;
-    for (auto* unit : _deployedUnits)
-    {
-        // 只统计有效且未死亡且未等待移除的单位
-        if (unit && !unit->isDead() && !unit->isPendingRemoval())
-        {
-            count++;
-        }
-    }
-    return count;
+    return _simulation.countAliveUnits();
 }
 
 int BattleManager::getTotalRemainingTroops() const
@@ -561,8 +783,12 @@ int BattleManager::getTotalRemainingTroops() const
     return _barbarianCount + _archerCount + _giantCount + _goblinCount + _wallBreakerCount;
 }
 
-void BattleManager::deployUnit(UnitType type, const cocos2d::Vec2& position)
+void BattleManager::deployUnit(UnitType type, const cocos2d::Vec2& touchPosition)
 {
+    // 部署坐标取整到像素：回放和 PvP 以文本传输坐标，整数在任何格式下都能无损往返，
+    // 保证各端进入定点模拟的输入完全一致
+    const Vec2 position(std::round(touchPosition.x), std::round(touchPosition.y));
+
     // 网络模式下非攻击方不能部署
     if (_isNetworked && !_isAttacker)
     {
@@ -581,29 +807,8 @@ void BattleManager::deployUnit(UnitType type, const cocos2d::Vec2& position)
     }
 
     // 获取对应部队计数器
-    int* count = nullptr;
-    switch (type)
-    {
-    case UnitType::kBarbarian:
-        count = &_barbarianCount;
-        break;
-    case UnitType::kArcher:
-        count = &_archerCount;
-        break;
-    case UnitType::kGiant:
-        count = &_giantCount;
-        break;
-    case UnitType::kGoblin:
-        count = &_goblinCount;
-        break;
-    case UnitType::kWallBreaker:
-        count = &_wallBreakerCount;
-        break;
-    default:
-        return;
-    }
-
-    if (*count <= 0)
+    int* count = troopCountOf(type);
+    if (!count || *count <= 0)
         return;
 
     (*count)--;
@@ -615,7 +820,7 @@ void BattleManager::deployUnit(UnitType type, const cocos2d::Vec2& position)
     // 非回放模式下记录操作
     if (!_isReplayMode)
     {
-        ReplaySystem::getInstance().recordDeployUnit(_currentFrame, type, position);
+        ReplaySystem::getInstance().recordDeployUnit(_simulation.getFrame(), type, position);
 
         // 网络模式下发送操作
         if (_isNetworked && _isAttacker && _onNetworkDeploy)
@@ -637,23 +842,29 @@ void BattleManager::deployUnitRemote(UnitType type, const cocos2d::Vec2& positio
 
 void BattleManager::spawnUnit(UnitType type, const cocos2d::Vec2& position)
 {
-    BaseUnit* unit = UnitFactory::createUnit(type);
+    BaseUnit* unit = _objectPool.acquireUnit(type);
     if (!unit)
         return;
 
     unit->setPosition(position);
     unit->enableBattleMode();
 
-    int zOrder = 10000 - static_cast<int>(position.y);
+    int row = static_cast<int>(position.y);
     if (_mapLayer)
-        _mapLayer->addChild(unit, zOrder);
-    _deployedUnits.push_back(unit);
+        _mapLayer->addChild(unit, depthOfRow(row));
+    if (!_fastForwarding)
+        unit->onDeploy();
+
+    // 模拟单位 ID 与 _unitViews 下标一致
+    _simulation.spawnUnit(type, unit->getLevel(), SimVec2::fromFloat(position.x, position.y));
+    _unitViews.push_back(unit);
+    _unitRows.push_back(row);
 
     // 首次部署单位时触发战斗正式开始
     if (!_hasDeployedAnyUnit)
     {
         _hasDeployedAnyUnit = true;
-        
+
         // 如果当前是 READY 或 LOADING 状态，触发战斗开始
         if (_state == BattleState::READY || _state == BattleState::LOADING)
         {
@@ -661,169 +872,26 @@ void BattleManager::spawnUnit(UnitType type, const cocos2d::Vec2& position)
         }
     }
 
-    CCLOG("🪖 部署单位: type=%d, pos=(%.1f,%.1f), 存活单位数=%zu", 
-          static_cast<int>(type), position.x, position.y, _deployedUnits.size());
+    CCLOG("🪖 部署单位: type=%d, pos=(%.1f,%.1f), 存活单位数=%d",
+          static_cast<int>(type), position.x, position.y, _simulation.countAliveUnits());
 }
 
-void BattleManager::updateUnitAI(float dt)
+int* BattleManager::troopCountOf(UnitType type)
 {
-    GridMap* gridMap = dynamic_cast<GridMap*>(_mapLayer);
-
-    for (auto it = _deployedUnits.begin(); it != _deployedUnits.end();)
+    switch (type)
     {
-        BaseUnit* unit = *it;
-        
-        // 安全检查：跳过空指针、已死亡或等待移除的单位
-        if (!unit || unit->isDead() || unit->isPendingRemoval())
-        {
-            ++it;
-            continue;
-        }
-
-        BaseBuilding* target = unit->getTarget();
-
-        // 需要寻找新目标
-        if (!target || target->isDestroyed())
-        {
-            unit->clearTarget();
-
-            BaseBuilding* bestTarget = nullptr;
-            Vec2          unitPos    = unit->getPosition();
-
-            // 目标查找辅助函数
-            auto findTargetWithFilter = [&](std::function<bool(BaseBuilding*)> filter) -> BaseBuilding* {
-                BaseBuilding* closest = nullptr;
-                float         minDist = 999999.0f;
-                for (auto* b : _enemyBuildings)
-                {
-                    if (b && !b->isDestroyed() && filter(b))
-                    {
-                        float dist = unitPos.distance(b->getPosition());
-                        if (dist < minDist)
-                        {
-                            minDist = dist;
-                            closest = b;
-                        }
-                    }
-                }
-                return closest;
-            };
-
-            // 根据单位类型选择优先目标
-            if (unit->getUnitType() == UnitType::kGiant)
-            {
-                // 巨人优先攻击防御建筑
-                bestTarget = findTargetWithFilter([](BaseBuilding* b) { return b->isDefenseBuilding(); });
-            }
-            else if (unit->getUnitType() == UnitType::kGoblin)
-            {
-                // 哥布林优先攻击资源建筑
-                bestTarget = findTargetWithFilter(
-                    [](BaseBuilding* b) { return b->getBuildingType() == BuildingType::kResource; });
-            }
-            else if (unit->getUnitType() == UnitType::kWallBreaker)
-            {
-                // 炸弹人优先攻击城墙
-                bestTarget =
-                    findTargetWithFilter([](BaseBuilding* b) { return b->getBuildingType() == BuildingType::kWall; });
-            }
-
-            // 如果没有优先目标，选择最近的任意建筑
-            if (!bestTarget)
-            {
-                bestTarget = findTargetWithFilter([](BaseBuilding* b) { return true; });
-            }
-
-            if (bestTarget)
-            {
-                unit->setTarget(bestTarget);
-                target = bestTarget;
-                unit->stopMoving();
-            }
-        }
-
-        // 执行攻击或移动逻辑
-        if (target && !target->isDestroyed())
-        {
-            Vec2 targetPos = target->getPosition();
-
-            if (unit->isInAttackRange(targetPos))
-            {
-                // 在攻击范围内
-                if (unit->isMoving())
-                    unit->stopMoving();
-
-                // 🔴 修复：先更新攻击冷却，再检查是否可以攻击
-                unit->updateAttackCooldown(dt);
-                
-                if (unit->isAttackReady())
-                {
-                    // 🔴 修复：在攻击前再次检查目标有效性，防止重复攻击已摧毁的建筑
-                    if (target->isDestroyed())
-                    {
-                        unit->clearTarget();
-                        ++it;
-                        continue;
-                    }
-                    
-                    if (unit->getUnitType() == UnitType::kWallBreaker)
-                    {
-                        // 炸弹人自爆攻击
-                        unit->attack(false);
-                        float damage = unit->getDamage() * 40.0f;
-                        target->takeDamage(static_cast<int>(damage));
-                        unit->die();
-                        
-                        CCLOG("💥 炸弹人自爆攻击: 伤害=%.1f, 目标血量=%d/%d",
-                              damage, target->getHitpoints(), target->getMaxHitpoints());
-                    }
-                    else
-                    {
-                        // 普通攻击
-                        unit->attack(false);
-                        int damage = static_cast<int>(unit->getDamage());
-                        target->takeDamage(damage);
-                        unit->resetAttackCooldown();
-                        
-                        CCLOG("⚔️ %s 攻击 %s: 伤害=%d, 目标血量=%d/%d",
-                              unit->getDisplayName().c_str(), target->getDisplayName().c_str(),
-                              damage, target->getHitpoints(), target->getMaxHitpoints());
-                    }
-
-                    // 检查目标是否被摧毁
-                    if (target->isDestroyed())
-                    {
-                        CCLOG("🔥 %s 被摧毁!", target->getDisplayName().c_str());
-                        unit->clearTarget();
-                        if (gridMap)
-                        {
-                            gridMap->markArea(target->getGridPosition(), target->getGridSize(), false);
-                        }
-                    }
-                }
-            }
-            else
-            {
-                // 不在攻击范围内，需要移动
-                bool needsPathfinding = !unit->isMoving();
-
-                if (needsPathfinding)
-                {
-                    if (gridMap)
-                    {
-                        std::vector<Vec2> path =
-                            PathFinder::getInstance().findPath(gridMap, unit->getPosition(), targetPos, false);
-                        unit->moveToPath(path);
-                    }
-                    else
-                    {
-                        unit->moveTo(targetPos);
-                    }
-                }
-            }
-        }
-
-        ++it;
+    case UnitType::kBarbarian:
+        return &_barbarianCount;
+    case UnitType::kArcher:
+        return &_archerCount;
+    case UnitType::kGiant:
+        return &_giantCount;
+    case UnitType::kGoblin:
+        return &_goblinCount;
+    case UnitType::kWallBreaker:
+        return &_wallBreakerCount;
+    default:
+        return nullptr;
     }
 }
 
@@ -844,6 +912,9 @@ void BattleManager::endBattle(bool surrender)
         return;
     _state = BattleState::FINISHED;
 
+    // 模拟不再推进，飞行中的投射物不会命中
+    clearProjectileViews();
+
     // 处理投降
     if (surrender)
     {
@@ -853,13 +924,19 @@ void BattleManager::endBattle(bool surrender)
 
     if (!_isReplayMode)
     {
-        ReplaySystem::getInstance().recordEndBattle(_currentFrame);
+        ReplaySystem::getInstance().recordEndBattle(_simulation.getFrame());
     }
 
     calculateBattleResult();
 
+    // 定点模拟在各平台逐位一致，对比双方/回放的哈希即可发现不同步
+    CCLOG("🔒 模拟状态哈希: %016llx (帧: %u)",
+          static_cast<unsigned long long>(_simulation.computeStateHash()), _simulation.getFrame());
+
     // 胜负判定：获得至少1星 或 破坏率>=50% 视为胜利
-    bool isVictory = (_starsEarned > 0) || (_destructionPercent >= 50);
+    int  stars              = _simulation.getStars();
+    int  destructionPercent = _simulation.getDestructionPercent();
+    bool isVictory          = (stars > 0) || (destructionPercent >= 50);
 
     if (isVictory)
         MusicManager::getInstance().playMusic(MusicType::BATTLE_WIN, false);
@@ -867,7 +944,7 @@ void BattleManager::endBattle(bool surrender)
         MusicManager::getInstance().playMusic(MusicType::BATTLE_LOSE, false);
 
     CCLOG("🏆 战斗结果: 星数=%d, 破坏率=%d%%, 原因=%d, 胜利=%s", 
-          _starsEarned, _destructionPercent,
+          stars, destructionPercent,
           static_cast<int>(_endReason), isVictory ? "是" : "否");
 
     // Issue 1 Fix: 非回放非网络模式下返还未使用的部队并正确保存
@@ -938,16 +1015,17 @@ void BattleManager::returnUnusedTroops()
 
 void BattleManager::calculateBattleResult()
 {
-    int maxGold   = _enemyGameData.gold;
-    int maxElixir = _enemyGameData.elixir;
+    int maxGold            = _enemyGameData.gold;
+    int maxElixir          = _enemyGameData.elixir;
+    int destructionPercent = _simulation.getDestructionPercent();
 
     // 根据星星数量调整掠夺率
     float baseLootRate = 0.2f;
-    float starBonus    = _starsEarned * 0.1f;
+    float starBonus    = _simulation.getStars() * 0.1f;
     float lootRate     = std::min(0.5f, baseLootRate + starBonus);
 
-    _goldLooted   = static_cast<int>(maxGold * (_destructionPercent / 100.0f) * lootRate);
-    _elixirLooted = static_cast<int>(maxElixir * (_destructionPercent / 100.0f) * lootRate);
+    _goldLooted   = static_cast<int>(maxGold * (destructionPercent / 100.0f) * lootRate);
+    _elixirLooted = static_cast<int>(maxElixir * (destructionPercent / 100.0f) * lootRate);
 
     auto& resMgr = ResourceManager::getInstance();
     resMgr.addResource(ResourceType::kGold, _goldLooted);
@@ -965,13 +1043,15 @@ void BattleManager::uploadBattleResult()
     if (_enemyUserId == currentAccount->account.userId)
         return;
 
+    int starsEarned = _simulation.getStars();
+
     DefenseLog defenseLog;
     defenseLog.attackerId   = currentAccount->account.userId;
     defenseLog.attackerName = currentAccount->account.username;
-    defenseLog.starsLost    = _starsEarned;
+    defenseLog.starsLost    = starsEarned;
     defenseLog.goldLost     = _goldLooted;
     defenseLog.elixirLost   = _elixirLooted;
-    defenseLog.trophyChange = -(_starsEarned * 10 - (3 - _starsEarned) * 3);
+    defenseLog.trophyChange = -(starsEarned * 10 - (3 - starsEarned) * 3);
     defenseLog.timestamp    = getCurrentTimestamp();
     defenseLog.isViewed     = false;
     defenseLog.replayData   = ReplaySystem::getInstance().stopRecording();
@@ -1013,7 +1093,7 @@ float BattleManager::getRemainingTime() const
     {
         return _battleTime;
     }
-    return std::max(0.0f, _battleTime - _elapsedTime);
+    return std::max(0.0f, _battleTime - _simulation.getElapsedTime());
 }
 
 int BattleManager::getTroopCount(UnitType type) const
@@ -1072,17 +1152,17 @@ int BattleManager::calculateStars() const
 {
     int stars = 0;
 
-    if (_townHallDestroyed)
+    if (_simulation.isTownHallDestroyed())
     {
         stars++;
     }
 
-    if (_destructionPercent >= 50)
+    if (_simulation.getDestructionPercent() >= 50)
     {
         stars++;
     }
 
-    if (_destructionPercent >= 100)
+    if (_simulation.getDestructionPercent() >= 100)
     {
         stars++;
     }
@@ -1092,10 +1172,11 @@ int BattleManager::calculateStars() const
 
 float BattleManager::calculateDestructionRate() const
 {
-    if (_totalBuildingHP <= 0)
+    if (_simulation.getTotalBuildingHP() <= 0)
         return 0.0f;
 
-    return static_cast<float>(_destroyedBuildingHP) / static_cast<float>(_totalBuildingHP);
+    return static_cast<float>(_simulation.getDestroyedBuildingHP()) /
+           static_cast<float>(_simulation.getTotalBuildingHP());
 }
 
 // ============================================================================
@@ -1108,10 +1189,10 @@ void BattleManager::setTimeOffset(int64_t elapsed_ms)
     float elapsed_seconds = static_cast<float>(elapsed_ms) / 1000.0f;
     
     // 确保不超过战斗总时间
-    _elapsedTime = std::min(elapsed_seconds, _battleTime);
+    elapsed_seconds = std::min(elapsed_seconds, _battleTime);
     
     // 计算对应的帧数
-    _currentFrame = static_cast<unsigned int>(_elapsedTime / FIXED_TIME_STEP);
+    _simulation.setFrame(static_cast<unsigned int>(elapsed_seconds / BattleSimulation::kFixedTimeStep));
     
     // 如果有时间偏移，说明战斗已经在进行中
     if (elapsed_ms > 0 && _state == BattleState::READY)
@@ -1122,7 +1203,7 @@ void BattleManager::setTimeOffset(int64_t elapsed_ms)
     }
     
     CCLOG("📺 [BattleManager] 设置时间偏移: %lldms -> %.2fs (帧: %u)", 
-          static_cast<long long>(elapsed_ms), _elapsedTime, _currentFrame);
+          static_cast<long long>(elapsed_ms), _simulation.getElapsedTime(), _simulation.getFrame());
     
     if (_onUIUpdate)
     {
@@ -1132,5 +1213,5 @@ void BattleManager::setTimeOffset(int64_t elapsed_ms)
 
 int64_t BattleManager::getElapsedTimeMs() const
 {
-    return static_cast<int64_t>(_elapsedTime * 1000.0f);
+    return static_cast<int64_t>(_simulation.getElapsedTime() * 1000.0f);
 }
\ No newline at end of file
@@ -13,9 +13,10 @@
 #include "Buildings/DefenseBuilding.h"
 #include "GameDataModels.h"
 #include "GridMap.h"
+#include "Managers/BattleObjectPool.h"
 #include "Managers/DeploymentValidator.h"
 #include "Managers/ReplaySystem.h"
-#include "PathFinder.h"
+#include "Simulation/BattleSimulation.h"
 #include "Unit/BaseUnit.h"
 #include "Unit/UnitTypes.h"
 #include "cocos2d.h"
@@ -28,6 +29,16 @@
 
 using TroopDeploymentMap = std::map<UnitType, int>;
 
+/**
+ * @struct TimedDeployment
+ * @brief 带模拟帧号的部署操作（观战追赶时按原始时序重新部署）
+ */
+struct TimedDeployment {
+    unsigned int  frame = 0;                     ///< 部署时的模拟帧（在该帧推进之前部署）
+    UnitType      type  = UnitType::kBarbarian;  ///< 单位类型
+    cocos2d::Vec2 position;                      ///< 部署位置
+};
+
 /**
  * @enum BattleMode
  * @brief 战斗模式枚举
@@ -64,6 +75,8 @@ enum class BattleEndReason {
  * 4. FINISHED -> 战斗结束
  * 
  * @note 准备阶段最长 30 秒，超时自动结束战斗（0星）
+ * @note 战斗规则（寻路、索敌、伤害、星数）全部由 BattleSimulation 计算，
+ *       BattleManager 只负责流程控制，并把模拟事件映射为精灵动画
  */
 class BattleManager {
  public:
@@ -142,10 +155,10 @@ class BattleManager {
     float getReadyPhaseRemainingTime() const;
 
     /** @brief 获取获得的星星数 */
-    int getStars() const { return _starsEarned; }
+    int getStars() const { return _simulation.getStars(); }
 
     /** @brief 获取摧毁百分比 */
-    int getDestructionPercent() const { return _destructionPercent; }
+    int getDestructionPercent() const { return _simulation.getDestructionPercent(); }
 
     /** @brief 获取掠夺的金币 */
     int getGoldLooted() const { return _goldLooted; }
@@ -160,7 +173,7 @@ class BattleManager {
     BattleEndReason getEndReason() const { return _endReason; }
 
     /** @brief 大本营是否被摧毁 */
-    bool isTownHallDestroyed() const { return _townHallDestroyed; }
+    bool isTownHallDestroyed() const { return _simulation.isTownHallDestroyed(); }
 
     /**
      * @brief 获取指定类型部队数量
@@ -247,6 +260,36 @@ class BattleManager {
      */
     void setTimeOffset(int64_t elapsed_ms);
 
+    /**
+     * @brief 无渲染快进到指定帧
+     * @param target_frame 目标帧（不超过战斗总时间）
+     * @param deployments 按帧号升序的部署操作：帧号不晚于当前帧的在推进前部署，
+     *                    到达目标帧仍未部署的（帧号未知或超出）在目标帧部署
+     * @note 快进期间只推进模拟，不处理事件、不回调 UI，单位不播放部署音效；
+     *       回放模式下 ReplaySystem 的部署照常在每步之前执行。
+     *       结束后一次性把单位、建筑精灵对齐到模拟状态，再检查战斗结束条件
+     */
+    void fastForward(unsigned int target_frame, const std::vector<TimedDeployment>& deployments = {});
+
+    /**
+     * @brief 观战追赶：从第 0 帧按帧号重新部署历史操作，快进到已进行时间
+     * @param elapsed_ms 战斗已进行时间（毫秒）
+     * @param deployments 历史部署（按帧号升序）
+     * @note 必须在部署任何单位之前调用；setTimeOffset 只对齐了帧号，模拟中还没有单位
+     */
+    void catchUpSpectate(int64_t elapsed_ms, const std::vector<TimedDeployment>& deployments);
+
+    /**
+     * @brief 回放跳转到指定帧（进度拖动、后退）
+     * @param target_frame 目标帧（不超过战斗总时间）
+     * @note 由 ReplaySystem 恢复不晚于目标帧的最近关键帧，再无渲染快进到目标帧，
+     *       耗时不超过推进一个关键帧间隔；回放结束后仍可向后跳转，状态恢复为 FIGHTING
+     */
+    void seekReplay(unsigned int target_frame);
+
+    /** @brief 战斗总时间对应的帧数 */
+    unsigned int getBattleEndFrame() const;
+
     /**
      * @brief 获取已进行时间（毫秒）
      * @return int64_t 已进行时间
@@ -259,15 +302,37 @@ class BattleManager {
      */
     void skipReadyPhase();
 
+    /** @brief 获取战斗模拟（只读） */
+    const BattleSimulation& getSimulation() const { return _simulation; }
+
+    /** @brief 获取精灵对象池（调试浮层显示统计用） */
+    const BattleObjectPool& getObjectPool() const { return _objectPool; }
+
  private:
     /** @brief 固定时间步长更新 */
     void fixedUpdate();
     
     /** @brief 更新战斗状态 */
-    void updateBattleState(float dt);
-    
-    /** @brief 更新单位AI */
-    void updateUnitAI(float dt);
+    void updateBattleState();
+
+    /** @brief 将本步模拟事件映射为单位/建筑表现 */
+    void applySimulationEvents();
+
+    /**
+     * @brief 同步单位和投射物精灵位置以及单位的 Z-Order
+     * @note 每个渲染帧调用一次（不是每个固定步长），只有换行的单位会重新设置深度
+     */
+    void syncViews();
+
+    /**
+     * @brief 快进或回放跳转结束后把精灵对齐到模拟状态
+     * @note 快进中死亡的单位直接回收，跳转回关键帧后重新存活的单位重新取出精灵，
+     *       存活单位同步生命值和移动动画，建筑同步生命值与摧毁状态（包括恢复被摧毁的建筑）
+     */
+    void snapViews();
+
+    /** @brief 把所有投射物精灵归还对象池 */
+    void clearProjectileViews();
     
     /** @brief 激活所有建筑 */
     void activateAllBuildings();
@@ -281,9 +346,6 @@ class BattleManager {
     /** @brief 获取当前时间戳 */
     std::string getCurrentTimestamp();
 
-    /** @brief 更新星星和破坏率 */
-    void updateStarsAndDestruction();
-    
     /** @brief 检查战斗结束条件 */
     void checkBattleEndConditions();
     
@@ -307,6 +369,9 @@ class BattleManager {
 
     void spawnUnit(UnitType type, const cocos2d::Vec2& position);
 
+    /** @brief 某一兵种的剩余可部署数量（未知兵种返回 nullptr） */
+    int* troopCountOf(UnitType type);
+
     cocos2d::Node* _mapLayer = nullptr;                  ///< 地图层
     GameStateData  _enemyGameData;                       ///< 敌方游戏数据
     std::string    _enemyUserId;                         ///< 敌方用户ID
@@ -316,20 +381,25 @@ class BattleManager {
     float _battleTime         = 180.0f; ///< 战斗总时间（秒）
     float _readyPhaseTime     = 30.0f;  ///< 准备阶段时间（秒）
     float _readyPhaseElapsed  = 0.0f;   ///< 准备阶段已用时间
-    float _elapsedTime        = 0.0f;   ///< 战斗已用时间（仅 FIGHTING 状态累加）
-    int   _starsEarned        = 0;      ///< 获得星星数
     int   _goldLooted         = 0;      ///< 掠夺金币
     int   _elixirLooted       = 0;      ///< 掠夺圣水
-    int   _destructionPercent = 0;      ///< 摧毁百分比
 
     BattleEndReason _endReason          = BattleEndReason::TIMEOUT; ///< 战斗结束原因
-    bool            _townHallDestroyed  = false;                    ///< 大本营是否被摧毁
     bool            _hasDeployedAnyUnit = false;                    ///< 是否曾部署过单位
 
-    std::vector<BaseUnit*>     _deployedUnits;           ///< 已部署的单位
-    std::vector<BaseBuilding*> _enemyBuildings;          ///< 敌方建筑
-    int                        _totalBuildingHP     = 0; ///< 总建筑血量
-    int                        _destroyedBuildingHP = 0; ///< 已摧毁建筑血量
+    /** @brief 飞行中的投射物精灵及其所属的对象池桶 */
+    struct ProjectileView
+    {
+        cocos2d::Node* node = nullptr;             ///< 炮弹/箭矢精灵（命中后置空）
+        DefenseType    type = DefenseType::kCannon; ///< 发射它的防御类型
+    };
+
+    BattleSimulation            _simulation;      ///< 战斗模拟（唯一的规则实现）
+    BattleObjectPool            _objectPool;      ///< 单位、投射物和命中特效精灵的对象池
+    std::vector<BaseUnit*>      _unitViews;       ///< 按模拟单位 ID 索引的单位精灵（死亡后置空）
+    std::vector<int>            _unitRows;        ///< 单位精灵当前深度对应的行（与 _unitViews 对应）
+    std::vector<ProjectileView> _projectileViews; ///< 按模拟投射物槽位索引的投射物精灵
+    std::vector<BaseBuilding*>  _enemyBuildings;  ///< 敌方建筑（下标即模拟建筑 ID）
 
     int _barbarianCount   = 0; ///< 野蛮人数量
     int _archerCount      = 0; ///< 弓箭手数量
@@ -337,9 +407,8 @@ class BattleManager {
     int _goblinCount      = 0; ///< 哥布林数量
     int _wallBreakerCount = 0; ///< 炸弹人数量
 
-    float        _accumulatedTime = 0.0f;         ///< 累积时间
-    unsigned int _currentFrame    = 0;            ///< 当前帧
-    const float  FIXED_TIME_STEP  = 1.0f / 60.0f; ///< 固定时间步长
+    float _accumulatedTime = 0.0f;  ///< 累积时间
+    bool  _fastForwarding  = false; ///< 是否正在无渲染快进（步进后不处理事件）
 
     std::function<void()>              _onUIUpdate;     ///< UI更新回调
     std::function<void()>              _onBattleEnd;    ///< 战斗结束回调
@@ -0,0 +1,253 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     BattleObjectPool.cpp
+ * File Function: 战斗对象池实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "BattleObjectPool.h"
+
+#include "Buildings/DefenseBuilding.h"
+#include "Unit/BaseUnit.h"
+#include "Unit/UnitFactory.h"
+
+#include <algorithm>
+
+USING_NS_CC;
+
+namespace
+{
+const int kHitEffectZOrder = 5001; ///< 命中特效层级（投射物为 5000）
+
+const char* defenseTypeName(DefenseType type)
+{
+    switch (type)
+    {
+    case DefenseType::kCannon:
+        return "加农炮";
+    case DefenseType::kArcherTower:
+        return "箭塔";
+    case DefenseType::kWizardTower:
+        return "法师塔";
+    default:
+        return "未知防御";
+    }
+}
+
+std::string formatBucket(const std::string& name, const BattleObjectPool::PoolStats& stats, int idle)
+{
+    return StringUtils::format("%s 使用%d 峰值%d 空闲%d 新建%d(预热%d) 复用%d\n", name.c_str(), stats.inUse,
+                               stats.peakInUse, idle, stats.created, stats.prewarmed, stats.reused);
+}
+} // namespace
+
+BattleObjectPool::~BattleObjectPool()
+{
+    clear();
+}
+
+void BattleObjectPool::clear()
+{
+    // 仍在场景中的单位不再回收（回调捕获了 this）
+    for (auto* node : _owned)
+    {
+        if (auto* unit = dynamic_cast<BaseUnit*>(node))
+            unit->setRecycleCallback(nullptr);
+    }
+
+    // 播放中的特效结束时会回调池，先停止
+    for (auto* effect : _playingEffects)
+    {
+        effect->stopAllActions();
+        effect->removeFromParent();
+    }
+    _playingEffects.clear();
+
+    for (auto& bucket : _units)
+        bucket = Bucket();
+    for (auto& bucket : _projectiles)
+        bucket = Bucket();
+    for (auto& bucket : _hitEffects)
+        bucket = Bucket();
+    _owned.clear();
+}
+
+void BattleObjectPool::prewarm(const std::map<UnitType, int>& army, const std::map<DefenseType, int>& defenses)
+{
+    for (const auto& pair : army)
+    {
+        int index = static_cast<int>(pair.first);
+        if (index < 0 || index >= kUnitTypeCount)
+            continue;
+
+        Bucket& bucket = _units[index];
+        for (int i = static_cast<int>(bucket.idle.size()) + bucket.stats.inUse; i < pair.second; i++)
+        {
+            BaseUnit* unit = createUnit(pair.first);
+            if (!unit)
+                break;
+            bucket.idle.pushBack(unit);
+            bucket.stats.created++;
+            bucket.stats.prewarmed++;
+        }
+    }
+
+    for (const auto& pair : defenses)
+    {
+        int     index      = static_cast<int>(pair.first);
+        Bucket& projectile = _projectiles[index];
+        Bucket& hitEffect  = _hitEffects[index];
+        for (int i = static_cast<int>(projectile.idle.size()) + projectile.stats.inUse; i < pair.second; i++)
+        {
+            Node* node = DefenseBuilding::createProjectileSprite(pair.first);
+            _owned.pushBack(node);
+            projectile.idle.pushBack(node);
+            projectile.stats.created++;
+            projectile.stats.prewarmed++;
+        }
+        for (int i = static_cast<int>(hitEffect.idle.size()) + hitEffect.stats.inUse; i < pair.second; i++)
+        {
+            Node* node = DefenseBuilding::createHitEffect(pair.first);
+            _owned.pushBack(node);
+            hitEffect.idle.pushBack(node);
+            hitEffect.stats.created++;
+            hitEffect.stats.prewarmed++;
+        }
+    }
+}
+
+BaseUnit* BattleObjectPool::acquireUnit(UnitType type)
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= kUnitTypeCount)
+        return nullptr;
+
+    return static_cast<BaseUnit*>(takeOrCreate(_units[index], [this, type]() { return createUnit(type); }));
+}
+
+void BattleObjectPool::recycleUnit(BaseUnit* unit)
+{
+    unit->stopAllActions();
+    unit->removeFromParent();
+    releaseUnit(unit);
+}
+
+Node* BattleObjectPool::acquireProjectile(DefenseType type)
+{
+    return takeOrCreate(_projectiles[static_cast<int>(type)], [this, type]() {
+        Node* node = DefenseBuilding::createProjectileSprite(type);
+        _owned.pushBack(node);
+        return node;
+    });
+}
+
+void BattleObjectPool::releaseProjectile(DefenseType type, cocos2d::Node* projectile)
+{
+    projectile->stopAllActions();
+    projectile->removeFromParent();
+    projectile->setRotation(0.0f);
+    putBack(_projectiles[static_cast<int>(type)], projectile);
+}
+
+void BattleObjectPool::playHitEffect(DefenseType type, cocos2d::Node* parent, const cocos2d::Vec2& position)
+{
+    if (!parent)
+        return;
+
+    Node* effect = takeOrCreate(_hitEffects[static_cast<int>(type)], [this, type]() {
+        Node* node = DefenseBuilding::createHitEffect(type);
+        _owned.pushBack(node);
+        return node;
+    });
+
+    effect->setPosition(position);
+    effect->setScale(0.4f);
+    effect->setOpacity(255);
+    parent->addChild(effect, kHitEffectZOrder);
+    _playingEffects.pushBack(effect);
+
+    auto expand = Spawn::create(ScaleTo::create(0.2f, 1.0f), FadeOut::create(0.25f), nullptr);
+    auto finish = CallFunc::create([this, type, effect]() { releaseHitEffect(type, effect); });
+    effect->runAction(Sequence::create(expand, finish, nullptr));
+}
+
+std::string BattleObjectPool::formatStats() const
+{
+    std::string text;
+    for (int i = 0; i < kUnitTypeCount; i++)
+    {
+        if (_units[i].stats.created > 0)
+        {
+            text += formatBucket(UnitFactory::getUnitName(static_cast<UnitType>(i)), _units[i].stats,
+                                 static_cast<int>(_units[i].idle.size()));
+        }
+    }
+    for (int i = 0; i < kDefenseTypeCount; i++)
+    {
+        std::string name = defenseTypeName(static_cast<DefenseType>(i));
+        if (_projectiles[i].stats.created > 0)
+        {
+            text += formatBucket(name + "弹", _projectiles[i].stats, static_cast<int>(_projectiles[i].idle.size()));
+        }
+        if (_hitEffects[i].stats.created > 0)
+        {
+            text += formatBucket(name + "命中", _hitEffects[i].stats, static_cast<int>(_hitEffects[i].idle.size()));
+        }
+    }
+    return text;
+}
+
+BaseUnit* BattleObjectPool::createUnit(UnitType type)
+{
+    BaseUnit* unit = UnitFactory::createUnit(type);
+    if (!unit)
+        return nullptr;
+
+    _owned.pushBack(unit);
+    unit->setRecycleCallback([this](BaseUnit* deadUnit) { releaseUnit(deadUnit); });
+    return unit;
+}
+
+Node* BattleObjectPool::takeOrCreate(Bucket& bucket, const std::function<cocos2d::Node*()>& create)
+{
+    Node* node = nullptr;
+    if (!bucket.idle.empty())
+    {
+        // _owned 仍持有引用，popBack 释放空闲列表的引用后节点不会被销毁
+        node = bucket.idle.back();
+        bucket.idle.popBack();
+        bucket.stats.reused++;
+    }
+    else
+    {
+        node = create();
+        if (!node)
+            return nullptr;
+        bucket.stats.created++;
+    }
+
+    bucket.stats.inUse++;
+    bucket.stats.peakInUse = std::max(bucket.stats.peakInUse, bucket.stats.inUse);
+    return node;
+}
+
+void BattleObjectPool::putBack(Bucket& bucket, cocos2d::Node* node)
+{
+    bucket.idle.pushBack(node);
+    bucket.stats.inUse--;
+}
+
+void BattleObjectPool::releaseUnit(BaseUnit* unit)
+{
+    // 死亡淡出序列结束时调用，单位已从父节点移除
+    unit->resetForReuse();
+    putBack(_units[static_cast<int>(unit->getUnitType())], unit);
+}
+
+void BattleObjectPool::releaseHitEffect(DefenseType type, cocos2d::Node* effect)
+{
+    effect->removeFromParent();
+    _playingEffects.eraseObject(effect);
+    putBack(_hitEffects[static_cast<int>(type)], effect);
+}
@@ -0,0 +1,116 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     BattleObjectPool.h
+ * File Function: 战斗对象池 - 单位、投射物与命中特效精灵的复用
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef BATTLE_OBJECT_POOL_H_
+#define BATTLE_OBJECT_POOL_H_
+
+#include "Buildings/BuildingTypes.h"
+#include "Unit/UnitTypes.h"
+#include "cocos2d.h"
+
+#include <functional>
+#include <map>
+#include <string>
+
+class BaseUnit;
+
+/**
+ * @class BattleObjectPool
+ * @brief 战斗中的精灵对象池，按单位类型/防御类型分桶
+ *
+ * 战斗加载时按进攻方军队和防守方防御建筑数量预先创建精灵，部署单位、
+ * 防御开火和命中时不再创建节点、加载动画。单位死亡淡出后、投射物命中后、
+ * 命中特效播放完后回到所属的桶，下次取出前已恢复到初始状态。
+ *
+ * 池持有它创建的所有节点的引用，节点离开场景树时不会被释放；
+ * 池销毁或 clear() 时一并释放。
+ */
+class BattleObjectPool
+{
+public:
+    static constexpr int kUnitTypeCount    = static_cast<int>(UnitType::kWallBreaker) + 1;     ///< 单位类型数
+    static constexpr int kDefenseTypeCount = static_cast<int>(DefenseType::kWizardTower) + 1; ///< 防御类型数
+
+    /** @brief 单个桶的统计 */
+    struct PoolStats
+    {
+        int created   = 0; ///< 累计创建数（含预热）
+        int prewarmed = 0; ///< 预热创建数
+        int reused    = 0; ///< 从空闲列表取出的次数
+        int inUse     = 0; ///< 当前使用中
+        int peakInUse = 0; ///< 使用中的峰值
+    };
+
+    BattleObjectPool() = default;
+    ~BattleObjectPool();
+
+    BattleObjectPool(const BattleObjectPool&)            = delete;
+    BattleObjectPool& operator=(const BattleObjectPool&) = delete;
+
+    /**
+     * @brief 释放所有节点并清空统计
+     * @note 仍在场景中的单位留在场景中（不再回收），播放中的命中特效被移除
+     */
+    void clear();
+
+    /**
+     * @brief 按本场战斗的规模预先创建精灵
+     * @param army 进攻方各兵种数量
+     * @param defenses 防守方各类防御建筑数量（每座防御同一时间最多一发投射物在飞行）
+     */
+    void prewarm(const std::map<UnitType, int>& army, const std::map<DefenseType, int>& defenses);
+
+    /**
+     * @brief 取出一个单位（满血、待机、未加入场景）
+     * @note 单位死亡淡出结束后自动回到池中
+     */
+    BaseUnit* acquireUnit(UnitType type);
+
+    /** @brief 不播放死亡动画，直接把单位移出场景并放回池中（快进中死亡的单位） */
+    void recycleUnit(BaseUnit* unit);
+
+    /** @brief 取出一个投射物精灵（未加入场景） */
+    cocos2d::Node* acquireProjectile(DefenseType type);
+
+    /** @brief 归还投射物精灵（从父节点移除） */
+    void releaseProjectile(DefenseType type, cocos2d::Node* projectile);
+
+    /**
+     * @brief 在命中点播放命中特效，播放完后特效自动回到池中
+     * @param type 防御类型
+     * @param parent 特效的父节点
+     * @param position 命中点（父节点坐标系）
+     */
+    void playHitEffect(DefenseType type, cocos2d::Node* parent, const cocos2d::Vec2& position);
+
+    /** @brief 各个桶的使用情况（调试浮层显示用，每个非空桶一行） */
+    std::string formatStats() const;
+
+private:
+    /** @brief 同一种对象的空闲列表与统计 */
+    struct Bucket
+    {
+        cocos2d::Vector<cocos2d::Node*> idle;  ///< 空闲节点
+        PoolStats                       stats; ///< 统计
+    };
+
+    BaseUnit*      createUnit(UnitType type);
+    cocos2d::Node* takeOrCreate(Bucket& bucket, const std::function<cocos2d::Node*()>& create);
+    void           putBack(Bucket& bucket, cocos2d::Node* node);
+    void           releaseUnit(BaseUnit* unit);
+    void           releaseHitEffect(DefenseType type, cocos2d::Node* effect);
+
+    Bucket _units[kUnitTypeCount];          ///< 按单位类型
+    Bucket _projectiles[kDefenseTypeCount]; ///< 按防御类型
+    Bucket _hitEffects[kDefenseTypeCount];  ///< 按防御类型
+
+    cocos2d::Vector<cocos2d::Node*> _owned;          ///< 池创建的所有节点（持有引用）
+    cocos2d::Vector<cocos2d::Node*> _playingEffects; ///< 播放中的命中特效
+};
+
+#endif // BATTLE_OBJECT_POOL_H_
@@ -30,8 +30,7 @@ bool DeploymentValidator::Init(GridMap* grid_map) {
   grid_height_ = grid_map_->getGridHeight();
 
   // 初始化禁止部署地图，默认所有位置都可以部署
-  forbidden_map_.resize(
-      grid_width_, std::vector<bool>(grid_height_, false));
+  forbidden_map_.resize(grid_width_, grid_height_);
 
   CCLOG("✅ DeploymentValidator 初始化成功: 网格大小 %dx%d",
         grid_width_, grid_height_);
@@ -42,9 +41,7 @@ bool DeploymentValidator::Init(GridMap* grid_map) {
 void DeploymentValidator::SetBuildings(
     const std::vector<BaseBuilding*>& buildings) {
   // 重置禁止部署地图
-  for (auto& row : forbidden_map_) {
-    std::fill(row.begin(), row.end(), false);
-  }
+  forbidden_map_.resize(grid_width_, grid_height_);
 
   // 标记每个建筑及其周围区域
   for (BaseBuilding* building : buildings) {
@@ -53,15 +50,8 @@ void DeploymentValidator::SetBuildings(
     }
   }
 
-  // 统计禁止区域数量
-  int forbidden_count = 0;
-  for (int x = 0; x < grid_width_; ++x) {
-    for (int y = 0; y < grid_height_; ++y) {
-      if (forbidden_map_[x][y]) {
-        ++forbidden_count;
-      }
-    }
-  }
+  // 统计禁止区域数量（按字计数置位）
+  int forbidden_count = forbidden_map_.count();
 
   CCLOG("📊 DeploymentValidator: 已设置 %zu 个建筑，禁止部署区域: %d 个网格",
         buildings.size(), forbidden_count);
@@ -88,12 +78,10 @@ void DeploymentValidator::MarkBuildingForbiddenZone(BaseBuilding* building) {
   int forbidden_end_y =
       std::min(grid_height_ - 1, start_y + building_height - 1 + kForbiddenRadius);
 
-  // 标记禁止区域
-  for (int x = forbidden_start_x; x <= forbidden_end_x; ++x) {
-    for (int y = forbidden_start_y; y <= forbidden_end_y; ++y) {
-      forbidden_map_[x][y] = true;
-    }
-  }
+  // 标记禁止区域（每行一次按字写入）
+  forbidden_map_.fillRect(forbidden_start_x, forbidden_start_y,
+                          forbidden_end_x - forbidden_start_x + 1,
+                          forbidden_end_y - forbidden_start_y + 1, true);
 
   CCLOG("🏗️ 标记建筑 %s 禁止区域: (%d,%d) 到 (%d,%d)",
         building->getDisplayName().c_str(),
@@ -133,39 +121,40 @@ bool DeploymentValidator::CanDeployAtGrid(int grid_x, int grid_y) const {
   }
 
   // 检查是否在禁止区域内
-  return !forbidden_map_[grid_x][grid_y];
+  return !forbidden_map_.test(grid_x, grid_y);
 }
 
 std::vector<Vec2> DeploymentValidator::GetDeployableGridPositions() const {
   std::vector<Vec2> deployable_positions;
   deployable_positions.reserve(grid_width_ * grid_height_ / 2);
-
-  for (int x = 0; x < grid_width_; ++x) {
-    for (int y = 0; y < grid_height_; ++y) {
-      if (!forbidden_map_[x][y]) {
-        deployable_positions.emplace_back(
-            static_cast<float>(x), static_cast<float>(y));
-      }
-    }
-  }
-
+  CollectGridPositions(false, &deployable_positions);
   return deployable_positions;
 }
 
 std::vector<Vec2> DeploymentValidator::GetForbiddenGridPositions() const {
   std::vector<Vec2> forbidden_positions;
   forbidden_positions.reserve(grid_width_ * grid_height_ / 2);
+  CollectGridPositions(true, &forbidden_positions);
+  return forbidden_positions;
+}
 
-  for (int x = 0; x < grid_width_; ++x) {
-    for (int y = 0; y < grid_height_; ++y) {
-      if (forbidden_map_[x][y]) {
-        forbidden_positions.emplace_back(
-            static_cast<float>(x), static_cast<float>(y));
+void DeploymentValidator::CollectGridPositions(
+    bool forbidden, std::vector<Vec2>* positions) const {
+  // 按行逐字扫描，只访问目标状态的格子（结果按行优先排列）
+  int words_per_row = forbidden_map_.getWordsPerRow();
+  for (int y = 0; y < grid_height_; ++y) {
+    const CollisionBitmap::Word* row = forbidden_map_.row(y);
+    for (int w = 0; w < words_per_row; ++w) {
+      CollisionBitmap::Word word =
+          (forbidden ? row[w] : ~row[w]) & forbidden_map_.validMask(w);
+      while (word != 0) {
+        int x = w * CollisionBitmap::kWordBits +
+                CollisionBitmap::lowestBit(word);
+        positions->emplace_back(static_cast<float>(x), static_cast<float>(y));
+        word &= word - 1;
       }
     }
   }
-
-  return forbidden_positions;
 }
 
 int DeploymentValidator::GetGridWidth() const {
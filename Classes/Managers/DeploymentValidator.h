@@ -11,6 +11,7 @@
 
 #include "Buildings/BaseBuilding.h"
 #include "GridMap.h"
+#include "Simulation/CollisionBitmap.h"
 #include "cocos2d.h"
 
 #include <set>
@@ -116,10 +117,18 @@ class DeploymentValidator {
    */
   void MarkBuildingForbiddenZone(BaseBuilding* building);
 
+  /**
+   * @brief 收集所有禁止（或可以）部署的网格位置
+   * @param forbidden true 收集禁止部署的位置，false 收集可部署的位置
+   * @param positions 输出列表（追加）
+   */
+  void CollectGridPositions(bool forbidden,
+                            std::vector<cocos2d::Vec2>* positions) const;
+
   GridMap* grid_map_ = nullptr;  ///< 网格地图指针
 
-  // 禁止部署地图：true = 禁止部署, false = 可以部署
-  std::vector<std::vector<bool>> forbidden_map_;
+  // 禁止部署地图（按行打包的位图）：置位 = 禁止部署, 清零 = 可以部署
+  CollisionBitmap forbidden_map_;
 
   int grid_width_ = 0;   ///< 网格宽度
   int grid_height_ = 0;  ///< 网格高度
@@ -7,6 +7,7 @@
  * License:       MIT License
  ****************************************************************/
 #include "ReplaySystem.h"
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -127,6 +128,7 @@ void ReplaySystem::reset()
     _isReplaying = false;
     _currentReplayData = ReplayData();
     _nextEventIndex = 0;
+    _keyframes.clear();
     _deployUnitCallback = nullptr;
     _endBattleCallback = nullptr;
 }
@@ -231,6 +233,51 @@ void ReplaySystem::updateFrame(unsigned int currentFrame)
     }
 }
 
+void ReplaySystem::captureKeyframe(BattleSimulation& simulation)
+{
+    // 录制时的关键帧不会写入回放数据（startRecording/loadReplay 都会清空），保存只会白白卡顿主线程
+    if (!_isReplaying) return;
+
+    // 跳转回去之后再次经过已保存的帧时不重复保存
+    unsigned int frame = simulation.getFrame();
+    if (frame % kKeyframeInterval != 0) return;
+    if (!_keyframes.empty() && _keyframes.back().frameIndex >= frame) return;
+
+    ReplayKeyframe keyframe;
+    keyframe.frameIndex = frame;
+    simulation.saveKeyframe(keyframe.state);
+    _keyframes.push_back(std::move(keyframe));
+}
+
+bool ReplaySystem::seek(unsigned int frame, BattleSimulation& simulation)
+{
+    if (!_isReplaying) return false;
+
+    unsigned int current = simulation.getFrame();
+    auto it = std::upper_bound(_keyframes.begin(), _keyframes.end(), frame,
+                               [](unsigned int f, const ReplayKeyframe& keyframe) { return f < keyframe.frameIndex; });
+
+    // 没有不晚于目标帧的关键帧，或当前帧比它更接近目标：从当前帧推进
+    if (it == _keyframes.begin() || (current <= frame && (it - 1)->frameIndex <= current))
+        return current <= frame;
+
+    const ReplayKeyframe& keyframe = *(it - 1);
+    if (!simulation.loadKeyframe(keyframe.state))
+    {
+        CCLOG("❌ ReplaySystem: Failed to restore keyframe at frame %u", keyframe.frameIndex);
+        return current <= frame;
+    }
+
+    // 关键帧保存于该帧推进之前，帧号不早于它的事件都还没有执行（事件按帧号升序）
+    const auto& events = _currentReplayData.events;
+    _nextEventIndex = std::lower_bound(events.begin(), events.end(), keyframe.frameIndex,
+                                       [](const ReplayEvent& event, unsigned int f) { return event.frameIndex < f; }) -
+                      events.begin();
+
+    CCLOG("⏪ ReplaySystem: Restored keyframe at frame %u for seek to frame %u", keyframe.frameIndex, frame);
+    return true;
+}
+
 void ReplaySystem::setDeployUnitCallback(std::function<void(UnitType, const cocos2d::Vec2&)> callback)
 {
     _deployUnitCallback = callback;
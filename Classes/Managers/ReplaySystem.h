@@ -10,8 +10,10 @@
 #define REPLAY_SYSTEM_H_
 
 #include "cocos2d.h"
+#include "Simulation/BattleSimulation.h"
 #include "Unit/UnitTypes.h"
 
+#include <cstdint>
 #include <functional>
 #include <sstream>
 #include <string>
@@ -69,15 +71,28 @@ struct ReplayData {
     static ReplayData deserialize(const std::string& data);
 };
 
+/**
+ * @struct ReplayKeyframe
+ * @brief 回放关键帧：某一帧推进之前的模拟状态（只保存在内存中，不进入序列化的回放数据）
+ */
+struct ReplayKeyframe {
+    unsigned int         frameIndex = 0; ///< 所在帧（该帧的事件尚未执行）
+    std::vector<uint8_t> state;          ///< BattleSimulation::saveKeyframe() 的输出
+};
+
 /**
  * @class ReplaySystem
  * @brief 战斗回放系统（单例）
  *
  * 负责记录战斗过程中的关键事件，并能够序列化/反序列化，
  * 以及在回放模式下重现这些事件。
+ * 回放中每隔 kKeyframeInterval 帧保存一次模拟关键帧，
+ * 跳转时从最近的关键帧恢复，只需无渲染推进不超过一个间隔的帧数。
  */
 class ReplaySystem {
 public:
+    static constexpr unsigned int kKeyframeInterval = 300; ///< 关键帧间隔（帧，即 5 秒）
+
     /**
      * @brief 获取单例实例
      * @return ReplaySystem& 单例引用
@@ -127,6 +142,24 @@ public:
      */
     void updateFrame(unsigned int currentFrame);
 
+    /**
+     * @brief 在推进当前帧之前按需保存关键帧
+     * @param simulation 战斗模拟（仅回放中，帧号为间隔整数倍且尚未保存过该帧时保存）
+     */
+    void captureKeyframe(BattleSimulation& simulation);
+
+    /**
+     * @brief 回放跳转：恢复不晚于目标帧的最近关键帧，事件索引移到关键帧所在帧
+     * @param frame 目标帧
+     * @param simulation 回放使用的战斗模拟
+     * @return bool 模拟处于不晚于目标帧的状态时为 true，之后由调用方无渲染推进到目标帧
+     * @note 向前跳转且当前帧与目标帧之间没有关键帧时直接从当前帧推进，不恢复
+     */
+    bool seek(unsigned int frame, BattleSimulation& simulation);
+
+    /** @brief 已保存的关键帧数 */
+    size_t getKeyframeCount() const { return _keyframes.size(); }
+
     /** @brief 设置部署士兵的回调 */
     void setDeployUnitCallback(std::function<void(UnitType, const cocos2d::Vec2&)> callback);
 
@@ -163,6 +196,8 @@ private:
     ReplayData _currentReplayData;  ///< 当前回放数据
     size_t _nextEventIndex = 0;     ///< 下一个事件索引
 
+    std::vector<ReplayKeyframe> _keyframes;  ///< 关键帧（按帧号升序）
+
     std::function<void(UnitType, const cocos2d::Vec2&)> _deployUnitCallback;  ///< 部署回调
     std::function<void()> _endBattleCallback;  ///< 结束回调
 };
@@ -246,6 +246,12 @@ void SocketClient::recvThreadFunc() {
         std::string msg_data;
         
         if (recvPacket(msg_type, msg_data)) {
+            // 心跳直接在接收线程应答，避免主线程卡顿（加载场景等）导致被服务器判定超时
+            if (msg_type == PACKET_HEARTBEAT_PING) {
+                sendPacket(PACKET_HEARTBEAT_PONG, msg_data);
+                continue;
+            }
+
             std::lock_guard<std::mutex> lock(callback_mutex_);
             pending_packets_.push({msg_type, msg_data});
         } else {
@@ -516,7 +522,7 @@ void SocketClient::handlePvpAction(const std::string& data) {
         return;
     }
 
-    // 格式: unitType,x,y（逗号分隔）
+    // 格式: unitType,x,y[,frame]（逗号分隔，实时操作直接部署，不需要帧号）
     try {
         std::istringstream iss(data);
         std::string token;
@@ -802,13 +808,13 @@ void SocketClient::requestPvp(const std::string& target_id) {
     cocos2d::log("[SocketClient] 请求 PVP: target=%s", target_id.c_str());
 }
 
-void SocketClient::sendPvpAction(int unit_type, float x, float y) {
-    // 格式: unitType,x,y
+void SocketClient::sendPvpAction(int unit_type, float x, float y, unsigned int frame) {
+    // 格式: unitType,x,y,frame（帧号追加在末尾，只解析前三个字段的旧版本不受影响）
     std::ostringstream oss;
-    oss << unit_type << kActionSeparator << x << kActionSeparator << y;
+    oss << unit_type << kActionSeparator << x << kActionSeparator << y << kActionSeparator << frame;
     sendPacket(PACKET_PVP_ACTION, oss.str());
-    cocos2d::log("[SocketClient] 发送 PVP 操作: type=%d, pos=(%.1f,%.1f)", 
-                 unit_type, x, y);
+    cocos2d::log("[SocketClient] 发送 PVP 操作: type=%d, pos=(%.1f,%.1f), frame=%u", 
+                 unit_type, x, y, frame);
 }
 
 void SocketClient::endPvp() {
@@ -53,6 +53,8 @@ enum PacketType : uint32_t {
     PACKET_ATTACK_DATA = 4,
     PACKET_USER_LIST_REQ = 5,
     PACKET_USER_LIST_RESP = 6,
+    PACKET_HEARTBEAT_PING = 7,
+    PACKET_HEARTBEAT_PONG = 8,
 
     // 匹配系统 (10-19)
     PACKET_MATCH_FIND = 10,
@@ -322,8 +324,9 @@ class SocketClient {
      * @param unit_type 单位类型
      * @param x 部署 X 坐标
      * @param y 部署 Y 坐标
+     * @param frame 部署时的模拟帧（观战者追赶时按帧重新部署；旧版本解析时忽略该字段）
      */
-    void sendPvpAction(int unit_type, float x, float y);
+    void sendPvpAction(int unit_type, float x, float y, unsigned int frame);
     
     /**
      * @brief 结束 PVP 战斗
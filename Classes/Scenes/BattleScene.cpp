@@ -19,7 +19,10 @@
 #include "Managers/TroopInventory.h"
 #include "ResourceManager.h"
 #include "Unit/UnitTypes.h"
+#include <algorithm>
+#include <chrono>
 #include <ctime>
+#include <limits>
 #include <sstream>
 
 USING_NS_CC;
@@ -136,6 +139,7 @@ bool BattleScene::initWithEnemyData(const AccountGameData& enemyData, const std:
                 
                 _battleUI->updateStars(_battleManager->getStars());
                 _battleUI->updateDestruction(_battleManager->getDestructionPercent());
+                _battleUI->updatePoolStats(_battleManager->getObjectPool().formatStats());
             }
         });
 
@@ -345,6 +349,7 @@ bool BattleScene::initWithReplayData(const std::string& replayDataStr)
                 _battleUI->updateTimer(static_cast<int>(_battleManager->getRemainingTime()));
                 _battleUI->updateStars(_battleManager->getStars());
                 _battleUI->updateDestruction(_battleManager->getDestructionPercent());
+                _battleUI->updatePoolStats(_battleManager->getObjectPool().formatStats());
             }
         });
 
@@ -397,6 +402,11 @@ bool BattleScene::initWithReplayData(const std::string& replayDataStr)
         _battleUI->setEndBattleButtonText("退出回放");
         _battleUI->setReplayMode(true);
         _battleUI->showBattleHUD(true);
+        _battleUI->showReplayControls(true);
+        _battleUI->setReplaySeekCallback([this](float offsetSeconds) {
+            if (_battleManager)
+                seekReplay(_battleManager->getElapsedTimeMs() / 1000.0f + offsetSeconds);
+        });
     }
 
     // 回放模式：立即开始战斗，跳过准备阶段
@@ -548,36 +558,15 @@ bool BattleScene::canDeployAtPosition(const cocos2d::Vec2& mapLocalPos) const
     int gridX = static_cast<int>(gridPos.x);
     int gridY = static_cast<int>(gridPos.y);
 
-    // 获取网格尺寸
-    int gridWidth = _gridMap->getGridWidth();
-    int gridHeight = _gridMap->getGridHeight();
-
     CCLOG("🔍 部署检查: mapLocalPos=(%.1f,%.1f), worldPos=(%.1f,%.1f), gridPos=(%d,%d)", 
           mapLocalPos.x, mapLocalPos.y, worldPos.x, worldPos.y, gridX, gridY);
 
     // 检查周围3x3区域（包括自身和周围一圈）是否有被占用的网格
-    // 这确保单位不会部署在建筑物上或建筑物周围一圈内
-    for (int dx = -1; dx <= 1; ++dx)
+    // 这确保单位不会部署在建筑物上或建筑物周围一圈内（按字检查，超出地图的部分被裁掉）
+    if (!_gridMap->canDeployAt(gridX, gridY))
     {
-        for (int dy = -1; dy <= 1; ++dy)
-        {
-            int checkX = gridX + dx;
-            int checkY = gridY + dy;
-
-            // 边界检查
-            if (checkX < 0 || checkX >= gridWidth || 
-                checkY < 0 || checkY >= gridHeight)
-            {
-                continue;
-            }
-
-            // 如果该网格被建筑占用，则不能在此位置部署
-            if (_gridMap->isBlocked(checkX, checkY))
-            {
-                CCLOG("🚫 网格(%d,%d)被占用，禁止在(%d,%d)部署", checkX, checkY, gridX, gridY);
-                return false;
-            }
-        }
+        CCLOG("🚫 网格(%d,%d)周围被占用，禁止部署", gridX, gridY);
+        return false;
     }
 
     CCLOG("✅ 网格(%d,%d)可以部署", gridX, gridY);
@@ -726,7 +715,13 @@ void BattleScene::update(float dt)
 
 void BattleScene::toggleSpeed()
 {
-    if (_timeScale >= 4.0f)
+    // 回放在 4 倍速之后再切换：无渲染快进到战斗结束，不必再等待剩余时间
+    if (_timeScale >= 4.0f && _battleManager && _battleManager->isReplayMode())
+    {
+        _timeScale = 1.0f;
+        _battleManager->fastForward(_battleManager->getBattleEndFrame());
+    }
+    else if (_timeScale >= 4.0f)
     {
         _timeScale = 1.0f;
     }
@@ -736,6 +731,25 @@ void BattleScene::toggleSpeed()
     }
 }
 
+void BattleScene::seekReplay(float seconds)
+{
+    // 回放后退/前进：从不晚于目标时间的最近关键帧恢复，再无渲染推进到目标时间
+    if (!_battleManager || !_battleManager->isReplayMode())
+        return;
+
+    bool wasFinished = _battleManager->getState() == BattleManager::BattleState::FINISHED;
+
+    _timeScale = 1.0f;
+    _battleManager->seekReplay(static_cast<unsigned int>(std::max(0.0f, seconds) / BattleSimulation::kFixedTimeStep));
+
+    // 回放结束后跳转回去：收起结果面板，继续观看
+    if (wasFinished && _battleManager->getState() == BattleManager::BattleState::FIGHTING && _battleUI)
+    {
+        _battleUI->hideResultPanel();
+        _battleUI->updateStatus("🔴 战斗回放中", Color4B::RED);
+    }
+}
+
 // ==================== PVP/观战模式 ====================
 
 void BattleScene::setPvpMode(bool isAttacker)
@@ -846,6 +860,7 @@ void BattleScene::replaySpectateHistory()
         _battleUI->showReadyPhaseUI(false);
     }
 
+    std::vector<TimedDeployment> deployments;
     for (size_t i = 0; i < _spectateHistory.size(); ++i)
     {
         const auto& action = _spectateHistory[i];
@@ -853,7 +868,7 @@ void BattleScene::replaySpectateHistory()
         // 🔧 将操作添加到已处理集合（用于后续去重）
 //         _processedActionSet.insert(action);
         
-        // 格式解析: "unitType,x,y"
+        // 格式解析: "unitType,x,y[,frame]"
         std::vector<std::string> parts;
         std::stringstream        ss(action);
         std::string              item;
@@ -866,12 +881,18 @@ void BattleScene::replaySpectateHistory()
         {
             try
             {
-                int   type = std::stoi(parts[0]);
-                float x    = std::stof(parts[1]);
-                float y    = std::stof(parts[2]);
-
-                CCLOG("📺 回放历史操作[%zu]: type=%d, pos=(%.1f,%.1f)", i, type, x, y);
-                _battleManager->deployUnitRemote(static_cast<UnitType>(type), Vec2(x, y));
+                TimedDeployment deployment;
+                deployment.type     = static_cast<UnitType>(std::stoi(parts[0]));
+                deployment.position = Vec2(std::stof(parts[1]), std::stof(parts[2]));
+
+                // 旧版本客户端不带帧号：无法还原时序，快进结束时再部署（与原来的行为一致）
+                deployment.frame = parts.size() >= 4 ? static_cast<unsigned int>(std::stoul(parts[3]))
+                                                     : std::numeric_limits<unsigned int>::max();
+
+                CCLOG("📺 回放历史操作[%zu]: type=%d, pos=(%.1f,%.1f), frame=%u", i,
+                      static_cast<int>(deployment.type), deployment.position.x, deployment.position.y,
+                      deployment.frame);
+                deployments.push_back(deployment);
             }
             catch (const std::exception& e)
             {
@@ -883,6 +904,14 @@ void BattleScene::replaySpectateHistory()
             CCLOG("⚠️ 历史操作格式错误: %s", action.c_str());
         }
     }
+
+    // 无渲染快进：从第 0 帧按原始时序部署并推进到已进行时间，结束后一次性对齐精灵
+    std::stable_sort(deployments.begin(), deployments.end(),
+                     [](const TimedDeployment& a, const TimedDeployment& b) { return a.frame < b.frame; });
+    auto start = std::chrono::steady_clock::now();
+    _battleManager->catchUpSpectate(_spectateElapsedMs, deployments);
+    CCLOG("📺 观战追赶完成: %lldms 的战斗用时 %.1fms", static_cast<long long>(_spectateElapsedMs),
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
     
     // 🔧 标记历史回放完成
     _spectateHistoryProcessed = true;
@@ -1050,8 +1079,10 @@ void BattleScene::onEnter()
         if (_battleManager && _isAttacker && !_isSpectateMode)
         {
             _battleManager->setNetworkDeployCallback([this](UnitType type, const Vec2& pos) {
-                CCLOG("📤 发送远程部署: type=%d, pos=(%.1f,%.1f)", (int)type, pos.x, pos.y);
-                SocketClient::getInstance().sendPvpAction((int)type, pos.x, pos.y);
+                // 部署发生在当前帧推进之前，与回放录制的帧号一致
+                unsigned int frame = _battleManager->getSimulation().getFrame();
+                CCLOG("📤 发送远程部署: type=%d, pos=(%.1f,%.1f), frame=%u", (int)type, pos.x, pos.y, frame);
+                SocketClient::getInstance().sendPvpAction((int)type, pos.x, pos.y, frame);
             });
         }
     }
@@ -144,6 +144,7 @@ class BattleScene : public cocos2d::Scene {
     void onTroopDeselected();
     void returnToMainScene();
     void toggleSpeed();
+    void seekReplay(float seconds);
 
     // ==================== 地图控制 ====================
     cocos2d::Rect _mapBoundary;
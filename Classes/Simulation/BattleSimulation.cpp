@@ -0,0 +1,1152 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     BattleSimulation.cpp
+ * File Function: 无渲染的战斗模拟核心实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "BattleSimulation.h"
+
+#include "PathFinder.h"
+#include "SimStateBuffer.h"
+
+#include <algorithm>
+
+namespace
+{
+/** @brief 炸弹人自爆对城墙的伤害倍率（对其他建筑造成普通伤害） */
+constexpr int kWallBreakerDamageMultiplier = 40;
+
+/** @brief 路径起点与单位距离小于该值时跳过（像素） */
+constexpr int kPathStartSkipDistance = 10;
+
+/** @brief 同一目标的单位数达到该值时改用共享流场，否则单独运行 A* */
+constexpr int kFlowFieldMinUsers = 2;
+
+/** @brief 沿流场一次最多向前合并的同方向格子数 */
+constexpr int kFlowFieldLookahead = 8;
+
+/** @brief 空间索引的方格边长（格）：与防御建筑射程相当，半径查询只覆盖 3x3 左右的方格 */
+constexpr int kSpatialCellTiles = 4;
+
+/** @brief 数据并行阶段每块处理的单位/建筑数：数量不超过一块时不分发，避免唤醒线程的开销超过收益 */
+constexpr int kMotionGrain  = 1024;
+constexpr int kTargetGrain  = 16;
+constexpr int kDefenseGrain = 32;
+
+/** @brief 单位没有预先查询的候选目标 */
+constexpr int kNoCandidate = -2;
+
+/** @brief 关键帧格式版本（字段变化时递增，旧关键帧不再加载） */
+constexpr uint64_t kKeyframeFormat = 1;
+
+/** @brief 单位在空间索引中的类别位 */
+uint32_t categoryOf(UnitType type)
+{
+    return 1u << static_cast<int>(type);
+}
+
+/** @brief 建筑在空间索引中的类别位 */
+uint32_t categoryOf(BuildingType type)
+{
+    return 1u << static_cast<int>(type);
+}
+
+/** @brief 匹配任意类别的掩码 */
+constexpr uint32_t kAnyCategory = ~0u;
+
+/**
+ * @brief 目标偏好表：单位配置中的优先目标类型 -> 优先攻击的建筑类型
+ *
+ * 单位的偏好由 UnitConfig 中的 preferredTarget 决定，部署时查表一次；
+ * 新增兵种只需配置 preferredTarget，新增偏好类别只需在这里加一行。
+ * 表中没有的类型（kAny、kGround、kAir）表示没有偏好，直接攻击最近的建筑。
+ */
+struct TargetPreference
+{
+    CombatStats::TargetType preferred; ///< 单位配置的优先目标类型
+    BuildingType            building;  ///< 对应的建筑类型
+};
+
+const TargetPreference kTargetPreferences[] = {
+    {CombatStats::TargetType::kDefense, BuildingType::kDefense},
+    {CombatStats::TargetType::kResource, BuildingType::kResource},
+    {CombatStats::TargetType::kWalls, BuildingType::kWall},
+};
+
+BuildingType preferredBuildingOf(CombatStats::TargetType preferred)
+{
+    for (const TargetPreference& preference : kTargetPreferences)
+    {
+        if (preference.preferred == preferred)
+            return preference.building;
+    }
+    return BuildingType::kUnknown;
+}
+
+/** @brief 按配置创建单位的静态部分（部署和关键帧恢复共用） */
+SimUnit makeUnit(int id, UnitType type, int level)
+{
+    CombatStats config = UnitConfig::getByType(type, level);
+
+    SimUnit unit;
+    unit.id                = id;
+    unit.type              = type;
+    unit.level             = level;
+    unit.stats             = SimStats::fromCombatStats(config);
+    unit.preferredBuilding = preferredBuildingOf(config.preferredTarget);
+    unit.moveSpeed         = Fixed::fromFloat(UnitConfig::getMoveSpeed(type));
+    return unit;
+}
+
+/** @brief 投射物飞行速度（像素/秒） */
+Fixed projectileSpeedOf(DefenseType type)
+{
+    switch (type)
+    {
+    case DefenseType::kArcherTower:
+        return Fixed::fromInt(800);
+    case DefenseType::kWizardTower:
+        return Fixed::fromInt(500);
+    case DefenseType::kCannon:
+    default:
+        return Fixed::fromInt(600);
+    }
+}
+
+/** @brief FNV-1a 64 位哈希累加 */
+void hashCombine(uint64_t& hash, int64_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        hash ^= (static_cast<uint64_t>(value) >> (i * 8)) & 0xFF;
+        hash *= 1099511628211ULL;
+    }
+}
+} // namespace
+
+// ==================== 初始化 ====================
+
+void BattleSimulation::reset()
+{
+    _units.clear();
+    _motion.clear();
+    _pathService.clear();
+    _buildings.clear();
+    _projectiles.clear();
+    _freeProjectiles.clear();
+    _activeProjectiles.clear();
+    _events.clear();
+    _flowFields.clear();
+    _hierarchy.clear();
+    _attackers.clear();
+    _defenses.clear();
+    _defenseShots.clear();
+    _targetCandidates.clear();
+    _targetQueries.clear();
+    _unitIndex.clear();
+    _buildingIndex.clear();
+    for (auto& index : _buildingsByType)
+        index.clear();
+
+    _frame                   = 0;
+    _stars                   = 0;
+    _destructionPercent      = 0;
+    _townHallDestroyed       = false;
+    _totalBuildingHP         = 0;
+    _destroyedBuildingHP     = 0;
+    _destroyedBuildingCount  = 0;
+    _aliveUnitCount          = 0;
+    _candidateDestroyedCount = 0;
+}
+
+void BattleSimulation::initGrid(int width, int height, Fixed tileSize, const SimVec2& startPixel)
+{
+    _grid.init(width, height, tileSize, startPixel);
+
+    // 等距网格的四个角：(0,0) 在最上方，(w-1,0) 最右，(0,h-1) 最左，(w-1,h-1) 最下
+    Fixed   halfTile = tileSize / 2;
+    SimVec2 top      = _grid.getPositionFromGrid(0, 0);
+    SimVec2 bottom   = _grid.getPositionFromGrid(width - 1, height - 1);
+    SimVec2 left     = _grid.getPositionFromGrid(0, height - 1);
+    SimVec2 right    = _grid.getPositionFromGrid(width - 1, 0);
+    SimVec2 minCorner(left.x - halfTile, bottom.y - halfTile);
+    SimVec2 maxCorner(right.x + halfTile, top.y + halfTile);
+
+    _unitIndex.init(minCorner, maxCorner, tileSize * kSpatialCellTiles);
+    _buildingIndex.init(minCorner, maxCorner, tileSize * kSpatialCellTiles);
+    for (auto& index : _buildingsByType)
+        index.init(minCorner, maxCorner, tileSize * kSpatialCellTiles);
+}
+
+int BattleSimulation::addBuilding(const SimBuildingDesc& desc)
+{
+    SimBuilding building;
+    building.id           = static_cast<int>(_buildings.size());
+    building.type         = desc.type;
+    building.defenseType  = desc.defenseType;
+    building.footprint    = desc.footprint;
+    building.position     = desc.position;
+    building.maxHitpoints = desc.maxHitpoints > 0 ? desc.maxHitpoints : 100;
+    building.hitpoints    = building.maxHitpoints;
+    building.stats        = SimStats::fromCombatStats(desc.stats);
+
+    _totalBuildingHP += building.maxHitpoints;
+    _grid.markArea(building.footprint, true);
+
+    _buildings.push_back(building);
+    _attackers.emplace_back();
+    if (building.isDefense())
+    {
+        _defenses.push_back(building.id);
+        _defenseShots.push_back(-1);
+    }
+    _buildingIndex.insert(building.id, building.position, categoryOf(building.type));
+    _buildingsByType[static_cast<int>(building.type)].insert(building.id, building.position, kAnyCategory);
+    return building.id;
+}
+
+int BattleSimulation::spawnUnit(UnitType type, int level, const SimVec2& position)
+{
+    SimUnit unit = makeUnit(static_cast<int>(_units.size()), type, level);
+
+    // 初始冷却为攻击间隔的一半，防止新部署的单位立即攻击
+    unit.attackCooldown = unit.stats.attackSpeed / 2;
+
+    _units.push_back(unit);
+    _aliveUnitCount++;
+    _motion.add(position, unit.moveSpeed * stepDelta());
+    _unitIndex.insert(unit.id, position, categoryOf(type));
+    return unit.id;
+}
+
+// ==================== 固定步长推进 ====================
+
+void BattleSimulation::step()
+{
+    const Fixed dt = stepDelta();
+
+    _frame++;
+    _events.clear();
+
+    applyPathResults();
+
+    // 所有单位一起前进一步（按 ID 分块并行），只有到达路段终点的单位需要逐个处理
+    // （处理只涉及单位自身，按 ID 顺序进行与逐个推进的结果相同）
+    _jobs.parallelFor(_motion.size(), kMotionGrain, [this](int begin, int end) { _motion.advance(begin, end); });
+    for (auto& unit : _units)
+    {
+        SimUnitMotion::StepResult result = _motion.getStepResult(unit.id);
+        if (result == SimUnitMotion::kIdle)
+            continue;
+
+        if (result == SimUnitMotion::kArrived)
+            onSegmentReached(unit);
+        _unitIndex.move(unit.id, _motion.getPosition(unit.id));
+    }
+
+    prefetchTargets();
+    for (auto& unit : _units)
+    {
+        if (!unit.dead)
+            updateUnitAI(unit, dt);
+    }
+
+    // 冷却、目标有效性检查和索敌只读写各自的建筑，按 ID 分块并行；
+    // 开火要分配投射物槽位并产生事件，再按 ID 顺序串行执行
+    _jobs.parallelFor(static_cast<int>(_defenses.size()), kDefenseGrain, [this, dt](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            SimBuilding& building = _buildings[_defenses[i]];
+            _defenseShots[i]      = -1;
+            if (building.isDestroyed())
+                continue;
+            _defenseShots[i] = tickDefense(building, dt);
+            detectEnemies(building);
+        }
+    });
+    for (size_t i = 0; i < _defenses.size(); i++)
+    {
+        if (_defenseShots[i] >= 0)
+            fireProjectile(_buildings[_defenses[i]], _units[_defenseShots[i]]);
+    }
+
+    updateProjectiles(dt);
+
+    // 有建筑时摧毁率只随伤害事件变化；没有建筑的基地没有伤害事件，直接按全毁计
+    if (_buildings.empty())
+        updateStarsAndDestruction();
+}
+
+// ==================== 单位移动 ====================
+
+void BattleSimulation::moveUnitTo(SimUnit& unit, const SimVec2& target)
+{
+    if (unit.dead)
+        return;
+
+    _motion.setMoveTarget(unit.id, target);
+    SimVec2 diff = target - _motion.getPosition(unit.id);
+
+    if (diff.lengthSquared() < Fixed::fromInt(1).squaredRaw())
+        return;
+
+    SimVec2 velocity = diff.getNormalized() * unit.moveSpeed;
+    bool    turned   = !_motion.isMoving(unit.id) || velocity.x != unit.velocity.x || velocity.y != unit.velocity.y;
+    unit.velocity    = velocity;
+    _motion.startSegment(unit.id, target, velocity * stepDelta());
+
+    // 沿流场逐格移动时方向经常不变，只在起步或转向时通知表现层
+    if (turned)
+        emit(SimEventType::kUnitMove, unit.id, -1).direction = diff;
+}
+
+void BattleSimulation::moveUnitAlongPath(SimUnit& unit, const std::vector<SimVec2>& path, uint32_t pathVersion)
+{
+    if (path.empty() || unit.dead)
+        return;
+
+    unit.path        = path;
+    unit.pathIndex   = 0;
+    unit.followFlow  = false;
+    unit.pathVersion = pathVersion;
+
+    if (_motion.getPosition(unit.id).distanceSquared(unit.path[0]) <
+        Fixed::fromInt(kPathStartSkipDistance).squaredRaw())
+    {
+        unit.pathIndex = 1;
+    }
+
+    if (unit.pathIndex < static_cast<int>(unit.path.size()))
+    {
+        moveUnitTo(unit, unit.path[unit.pathIndex]);
+    }
+}
+
+void BattleSimulation::requestPath(SimUnit& unit, const SimBuilding& target)
+{
+    // 快照中的抽象图必须与网格同步，否则每个求解线程都要各自整体构建一次
+    if (!_hierarchy.isSyncedWith(_grid))
+        _hierarchy.build(_grid);
+
+    PathService::Request request;
+    request.unit     = unit.id;
+    request.target   = target.id;
+    request.from     = _motion.getPosition(unit.id);
+    request.to       = target.position;
+    request.goalArea = target.footprint;
+    _pathService.submit(_grid, _hierarchy, _pathSearchMode, request, _frame + PathService::kLatencyFrames);
+    unit.pathPending = true;
+}
+
+void BattleSimulation::applyPathResults()
+{
+    PathService::Result result;
+    while (_pathService.takeReady(_frame, result))
+    {
+        SimUnit& unit    = _units[result.request.unit];
+        SimVec2  current = _motion.getPosition(unit.id);
+        unit.pathPending = false;
+
+        // 等待期间单位死亡、更换目标或已经移动（如改为沿流场前进）时结果作废，由 AI 重新决定
+        if (unit.dead || unit.retarget || unit.target != result.request.target || _motion.isMoving(unit.id) ||
+            current.x != result.request.from.x || current.y != result.request.from.y)
+            continue;
+
+        if (result.path.empty())
+        {
+            // 被完全围住时直线接近
+            moveUnitTo(unit, result.request.to);
+        }
+        else
+        {
+            moveUnitAlongPath(unit, result.path, result.version);
+        }
+    }
+}
+
+bool BattleSimulation::stepAlongFlowField(SimUnit& unit)
+{
+    if (unit.target < 0)
+        return false;
+
+    const SimBuilding& target   = _buildings[unit.target];
+    SimVec2            position = _motion.getPosition(unit.id);
+    if (unit.retarget || position.isWithin(target.position, unit.stats.attackRange))
+        return false;
+
+    // 碰撞地图变化后流场在这里按需重建，逐格采样的单位自动绕开新的缺口或障碍
+    SimCell cell = _grid.getGridPosition(position);
+    SimCell next;
+    if (!_flowFields.nextStep(_grid, target.id, target.footprint, cell, next))
+        return false;
+
+    // 方向不变的连续格子合并成一段直线，减少路段切换
+    int dx = next.x - cell.x;
+    int dy = next.y - cell.y;
+    for (int i = 1; i < kFlowFieldLookahead; i++)
+    {
+        SimCell ahead;
+        if (!_flowFields.nextStep(_grid, target.id, target.footprint, next, ahead) || ahead.x - next.x != dx ||
+            ahead.y - next.y != dy)
+            break;
+        next = ahead;
+    }
+
+    unit.path.clear();
+    unit.pathIndex  = 0;
+    unit.followFlow = true;
+    moveUnitTo(unit, _grid.getPositionFromGrid(next.x, next.y));
+    return _motion.isMoving(unit.id);
+}
+
+void BattleSimulation::stopUnit(SimUnit& unit)
+{
+    _motion.stop(unit.id);
+    unit.followFlow = false;
+    unit.path.clear();
+    emit(SimEventType::kUnitIdle, unit.id, -1);
+}
+
+void BattleSimulation::onSegmentReached(SimUnit& unit)
+{
+    // 检查路径
+    unit.pathIndex++;
+    if (unit.pathIndex < static_cast<int>(unit.path.size()) && unit.pathVersion != _grid.getVersion())
+    {
+        // 规划后有建筑或城墙被摧毁，剩余路径可能绕了远路：停下来让 AI 本帧重新寻路
+        stopUnit(unit);
+    }
+    else if (unit.pathIndex < static_cast<int>(unit.path.size()))
+    {
+        moveUnitTo(unit, unit.path[unit.pathIndex]);
+    }
+    else if (!unit.followFlow || !stepAlongFlowField(unit))
+    {
+        stopUnit(unit);
+    }
+}
+
+// ==================== 单位 AI ====================
+
+int BattleSimulation::findTargetFor(const SimUnit& unit) const
+{
+    SimVec2 position = _motion.getPosition(unit.id);
+
+    // 优先目标：只查询该类型建筑自己的索引，不再逐个过滤全部建筑
+    if (unit.preferredBuilding != BuildingType::kUnknown)
+    {
+        int best = _buildingsByType[static_cast<int>(unit.preferredBuilding)].findNearest(position, kAnyCategory);
+        if (best >= 0)
+            return best;
+    }
+
+    // 没有优先目标（或已全部摧毁），选择最近的任意建筑
+    return _buildingIndex.findNearest(position, kAnyCategory);
+}
+
+void BattleSimulation::prefetchTargets()
+{
+    // AI 循环之前单位位置和建筑索引都不再变化，需要新目标的单位可以并行查询
+    // （通常只有目标刚被摧毁的几个单位，数量不超过一块时直接在本线程查询）
+    _targetCandidates.assign(_units.size(), kNoCandidate);
+    _candidateDestroyedCount = _destroyedBuildingCount;
+    _targetQueries.clear();
+    for (const auto& unit : _units)
+    {
+        if (!unit.dead && (unit.target < 0 || unit.retarget))
+            _targetQueries.push_back(unit.id);
+    }
+
+    _jobs.parallelFor(static_cast<int>(_targetQueries.size()), kTargetGrain, [this](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            int unit                = _targetQueries[i];
+            _targetCandidates[unit] = findTargetFor(_units[unit]);
+        }
+    });
+}
+
+int BattleSimulation::takeTargetFor(const SimUnit& unit)
+{
+    int candidate              = _targetCandidates[unit.id];
+    _targetCandidates[unit.id] = kNoCandidate;
+
+    // 之后又有建筑被摧毁（已从索引中移除）时候选可能失效，重新查询
+    if (candidate != kNoCandidate && _candidateDestroyedCount == _destroyedBuildingCount)
+        return candidate;
+    return findTargetFor(unit);
+}
+
+void BattleSimulation::setUnitTarget(SimUnit& unit, int building)
+{
+    detachFromTarget(unit);
+    unit.target   = building;
+    unit.retarget = false;
+    if (unit.target >= 0)
+    {
+        unit.targetSlot = static_cast<int>(_attackers[unit.target].size());
+        _attackers[unit.target].push_back(unit.id);
+    }
+}
+
+void BattleSimulation::detachFromTarget(SimUnit& unit)
+{
+    if (unit.targetSlot < 0)
+        return;
+
+    // 与列表末尾交换后删除，O(1)
+    std::vector<int>& attackers = _attackers[unit.target];
+    int               last      = attackers.back();
+
+    attackers[unit.targetSlot] = last;
+    _units[last].targetSlot    = unit.targetSlot;
+    attackers.pop_back();
+    unit.targetSlot = -1;
+}
+
+void BattleSimulation::updateUnitAI(SimUnit& unit, Fixed dt)
+{
+    // 需要寻找新目标（目标被摧毁时由 damageBuilding 标记，目标存活的单位不查询索引）
+    if (unit.target < 0 || unit.retarget)
+    {
+        setUnitTarget(unit, takeTargetFor(unit));
+        if (unit.target < 0)
+            return;
+        stopUnit(unit);
+    }
+
+    SimBuilding& target = _buildings[unit.target];
+
+    if (_motion.getPosition(unit.id).isWithin(target.position, unit.stats.attackRange))
+    {
+        // 在攻击范围内
+        if (_motion.isMoving(unit.id))
+            stopUnit(unit);
+
+        // 先更新攻击冷却，再检查是否可以攻击
+        if (unit.attackCooldown > Fixed())
+            unit.attackCooldown -= dt;
+
+        if (unit.attackCooldown > Fixed())
+            return;
+
+        emit(SimEventType::kUnitAttack, unit.id, target.id);
+
+        if (unit.type == UnitType::kWallBreaker)
+        {
+            // 炸弹人自爆攻击：只对城墙造成倍率伤害，与原 onDeathBefore 的规则一致（伤害只结算一次）
+            Fixed damage = unit.stats.damage;
+            if (target.type == BuildingType::kWall)
+                damage = damage * kWallBreakerDamageMultiplier;
+            damageBuilding(target, damage.toInt());
+            killUnit(unit);
+        }
+        else
+        {
+            damageBuilding(target, unit.stats.damage.toInt());
+            unit.attackCooldown = unit.stats.attackSpeed;
+        }
+
+        if (target.isDestroyed())
+            setUnitTarget(unit, -1);
+    }
+    else if (!_motion.isMoving(unit.id))
+    {
+        // 多个单位攻击同一目标时共享一个流场，每步只需 O(1) 采样
+        if (static_cast<int>(_attackers[target.id].size()) >= kFlowFieldMinUsers)
+        {
+            if (!stepAlongFlowField(unit))
+                moveUnitTo(unit, target.position); // 已到达目标占地或不可达时直线接近
+            return;
+        }
+
+        // 唯一攻击者：单独寻路接近目标（目标占地视为可通行），结果到期前原地等待
+        if (!unit.pathPending)
+            requestPath(unit, target);
+    }
+}
+
+// ==================== 防御建筑 ====================
+
+int BattleSimulation::tickDefense(SimBuilding& building, Fixed dt)
+{
+    if (building.attackCooldown > Fixed())
+    {
+        building.attackCooldown -= dt;
+    }
+
+    if (building.target < 0)
+        return -1;
+
+    const SimUnit& target = _units[building.target];
+    if (target.dead || !building.position.isWithin(_motion.getPosition(target.id), building.stats.attackRange))
+    {
+        building.target = -1;
+        return -1;
+    }
+
+    if (building.attackCooldown > Fixed())
+        return -1;
+
+    // 只决定是否开火，发射由调用方串行进行（发射不改变单位，不影响其他建筑本步的判断）
+    building.attackCooldown = building.stats.attackSpeed;
+    return target.id;
+}
+
+void BattleSimulation::detectEnemies(SimBuilding& building)
+{
+    // 如果已有有效目标，不重新选择
+    if (building.target >= 0 && !_units[building.target].dead)
+        return;
+
+    // 射程内最近的存活单位（距离相同时取 ID 较小者，与按 ID 顺序扫描的结果一致）
+    int closestUnit = _unitIndex.findNearestWithin(building.position, building.stats.attackRange, kAnyCategory);
+    if (closestUnit >= 0)
+    {
+        building.target = closestUnit;
+    }
+}
+
+void BattleSimulation::fireProjectile(SimBuilding& building, SimUnit& target)
+{
+    SimVec2 position = _motion.getPosition(target.id);
+
+    int slot;
+    if (_freeProjectiles.empty())
+    {
+        slot = static_cast<int>(_projectiles.size());
+        _projectiles.emplace_back();
+    }
+    else
+    {
+        slot = _freeProjectiles.back();
+        _freeProjectiles.pop_back();
+    }
+
+    // 飞行时间在发射时确定，命中只取决于固定步长的推进，与渲染帧率无关
+    SimProjectile& projectile = _projectiles[slot];
+    projectile.source         = building.id;
+    projectile.target         = target.id;
+    projectile.damage         = building.stats.damage;
+    projectile.splashRadius   = building.stats.splashRadius;
+    projectile.origin         = building.position;
+    projectile.flightTime     = building.position.distance(position) / projectileSpeedOf(building.defenseType);
+    projectile.remaining      = projectile.flightTime;
+    projectile.active         = true;
+    _activeProjectiles.push_back(slot);
+
+    SimEvent& event = emit(SimEventType::kDefenseFire, target.id, building.id);
+    event.value     = slot;
+    event.position  = position;
+    event.duration  = projectile.remaining;
+}
+
+void BattleSimulation::updateProjectiles(Fixed dt)
+{
+    // 结算只影响单位，不会发射新的投射物，可以边遍历边压缩飞行列表（保持发射顺序）
+    size_t kept = 0;
+    for (size_t i = 0; i < _activeProjectiles.size(); i++)
+    {
+        int            slot       = _activeProjectiles[i];
+        SimProjectile& projectile = _projectiles[slot];
+
+        projectile.remaining -= dt;
+        if (projectile.remaining > Fixed())
+        {
+            _activeProjectiles[kept++] = slot;
+            continue;
+        }
+
+        resolveProjectile(slot);
+    }
+    _activeProjectiles.resize(kept);
+}
+
+void BattleSimulation::resolveProjectile(int slot)
+{
+    SimProjectile& projectile = _projectiles[slot];
+    SimVec2        impact     = _motion.getPosition(projectile.target);
+
+    SimEvent& event = emit(SimEventType::kProjectileHit, projectile.target, projectile.source);
+    event.value     = slot;
+    event.position  = impact;
+
+    if (projectile.splashRadius > Fixed())
+    {
+        // 溅射：目标已死亡时仍在其最后位置爆炸，按 ID 顺序结算半径内的存活单位
+        _unitIndex.queryRadius(impact, projectile.splashRadius, kAnyCategory, _splashTargets);
+        for (int unit : _splashTargets)
+        {
+            damageUnit(_units[unit], projectile.damage);
+        }
+    }
+    else if (!_units[projectile.target].dead)
+    {
+        damageUnit(_units[projectile.target], projectile.damage);
+    }
+
+    projectile.active = false;
+    _freeProjectiles.push_back(slot);
+}
+
+// ==================== 伤害结算 ====================
+
+void BattleSimulation::damageUnit(SimUnit& unit, Fixed damage)
+{
+    if (unit.dead)
+        return;
+
+    unit.stats.takeDamage(damage);
+    emit(SimEventType::kUnitDamaged, unit.id, -1).value = unit.stats.hitpoints;
+
+    if (unit.stats.hitpoints <= 0)
+    {
+        killUnit(unit);
+    }
+}
+
+void BattleSimulation::killUnit(SimUnit& unit)
+{
+    if (unit.dead)
+        return;
+
+    // 死亡单位保留 target（计入状态哈希），只离开攻击者列表
+    detachFromTarget(unit);
+
+    _unitIndex.remove(unit.id);
+
+    _motion.stop(unit.id);
+
+    _aliveUnitCount--;
+
+    unit.dead       = true;
+    unit.followFlow = false;
+    unit.path.clear();
+    emit(SimEventType::kUnitDied, unit.id, -1);
+}
+
+void BattleSimulation::damageBuilding(SimBuilding& building, int damage)
+{
+    if (damage <= 0 || building.isDestroyed())
+        return;
+
+    int applied = std::min(damage, building.hitpoints);
+    building.hitpoints -= applied;
+    _destroyedBuildingHP += applied;
+
+    emit(SimEventType::kBuildingDamaged, -1, building.id).value = building.hitpoints;
+
+    if (building.isDestroyed())
+    {
+        _destroyedBuildingCount++;
+        if (building.type == BuildingType::kTownHall)
+            _townHallDestroyed = true;
+
+        // 被摧毁的建筑不再阻挡寻路，也不再需要它的流场
+        _grid.markArea(building.footprint, false);
+        _hierarchy.onAreaChanged(_grid, building.footprint);
+        _flowFields.release(building.id);
+        _buildingIndex.remove(building.id);
+        _buildingsByType[static_cast<int>(building.type)].remove(building.id);
+        emit(SimEventType::kBuildingDestroyed, -1, building.id);
+
+        // 只通知以它为目标的单位，它们在本步或下一步轮到自己时重新选择目标
+        // （仍按单位 ID 顺序查询最近邻索引，与逐帧检查时的结果一致）
+        for (int attacker : _attackers[building.id])
+        {
+            _units[attacker].targetSlot = -1;
+            _units[attacker].retarget   = true;
+        }
+        _attackers[building.id].clear();
+    }
+
+    updateStarsAndDestruction();
+}
+
+// ==================== 星数与摧毁率 ====================
+
+void BattleSimulation::updateStarsAndDestruction()
+{
+    if (_buildings.empty())
+    {
+        _destructionPercent = 100;
+        _stars              = 3;
+        return;
+    }
+
+    // 计算破坏率 (基于 HP，_destroyedBuildingHP 与大本营状态在 damageBuilding 中累加)
+    if (_totalBuildingHP > 0)
+    {
+        _destructionPercent = std::min(100, (_destroyedBuildingHP * 100) / _totalBuildingHP);
+    }
+
+    // 规则1: 摧毁大本营 = 1 星；规则2: 破坏率 >= 50% = 1 星；规则3: 破坏率 = 100% = 1 星
+    int newStars = 0;
+    if (_townHallDestroyed)
+        newStars++;
+    if (_destructionPercent >= 50)
+        newStars++;
+    if (_destructionPercent >= 100)
+        newStars++;
+
+    // 只能增加星星，不能减少
+    if (newStars > _stars)
+    {
+        _stars = newStars;
+    }
+}
+
+uint64_t BattleSimulation::computeStateHash() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    hashCombine(hash, _frame);
+    hashCombine(hash, _stars);
+    hashCombine(hash, _destructionPercent);
+
+    for (const auto& unit : _units)
+    {
+        SimVec2 position = _motion.getPosition(unit.id);
+        hashCombine(hash, position.x.raw());
+        hashCombine(hash, position.y.raw());
+        hashCombine(hash, unit.stats.hitpoints);
+        hashCombine(hash, unit.target);
+        hashCombine(hash, unit.attackCooldown.raw());
+        hashCombine(hash, (unit.dead ? 1 : 0) | (_motion.isMoving(unit.id) ? 2 : 0) | (unit.pathPending ? 4 : 0));
+    }
+
+    for (const auto& building : _buildings)
+    {
+        hashCombine(hash, building.hitpoints);
+        hashCombine(hash, building.target);
+        hashCombine(hash, building.attackCooldown.raw());
+    }
+
+    for (int slot : _activeProjectiles)
+    {
+        hashCombine(hash, _projectiles[slot].target);
+        hashCombine(hash, _projectiles[slot].remaining.raw());
+    }
+
+    return hash;
+}
+
+// ==================== 关键帧 ====================
+
+void BattleSimulation::saveKeyframe(std::vector<uint8_t>& out)
+{
+    out.clear();
+    SimStateWriter writer(out);
+
+    writer.writeUInt(kKeyframeFormat);
+    writer.writeUInt(_frame);
+    writer.writeInt(_stars);
+    writer.writeInt(_destructionPercent);
+    writer.writeBool(_townHallDestroyed);
+    writer.writeInt(_destroyedBuildingHP);
+    writer.writeInt(_destroyedBuildingCount);
+
+    writer.writeUInt(_buildings.size());
+    for (const auto& building : _buildings)
+    {
+        writer.writeInt(building.hitpoints);
+        writer.writeInt(building.target);
+        writer.writeFixed(building.attackCooldown);
+    }
+
+    // 版本号也要还原：单位的 pathVersion 与它比较来判断路径是否过期
+    const CollisionBitmap& collision = _grid.getCollisionMap();
+    writer.writeUInt(collision.getVersion());
+    writer.writeUInt(static_cast<uint64_t>(collision.getWordsPerRow()) * collision.getHeight());
+    for (int y = 0; y < collision.getHeight(); y++)
+    {
+        for (int i = 0; i < collision.getWordsPerRow(); i++)
+            writer.writeUInt(collision.row(y)[i]);
+    }
+
+    writer.writeUInt(_units.size());
+    for (const auto& unit : _units)
+    {
+        writer.writeInt(static_cast<int>(unit.type));
+        writer.writeInt(unit.level);
+        writer.writeInt(unit.stats.hitpoints);
+        writer.writeVec2(unit.velocity);
+        writer.writeUInt(unit.path.size());
+        for (const auto& point : unit.path)
+            writer.writeVec2(point);
+        writer.writeInt(unit.pathIndex);
+        writer.writeBool(unit.followFlow);
+        writer.writeBool(unit.pathPending);
+        writer.writeUInt(unit.pathVersion);
+        writer.writeInt(unit.target);
+        writer.writeInt(unit.targetSlot);
+        writer.writeBool(unit.retarget);
+        writer.writeFixed(unit.attackCooldown);
+        writer.writeBool(unit.dead);
+    }
+    _motion.saveState(writer);
+
+    // 空闲槽位和飞行列表的顺序决定之后发射时复用哪个槽位（事件中的槽位号），原样保存
+    writer.writeUInt(_projectiles.size());
+    for (const auto& projectile : _projectiles)
+    {
+        writer.writeBool(projectile.active);
+        if (!projectile.active)
+            continue;
+        writer.writeInt(projectile.source);
+        writer.writeInt(projectile.target);
+        writer.writeFixed(projectile.damage);
+        writer.writeFixed(projectile.splashRadius);
+        writer.writeVec2(projectile.origin);
+        writer.writeFixed(projectile.flightTime);
+        writer.writeFixed(projectile.remaining);
+    }
+    writer.writeUInt(_freeProjectiles.size());
+    for (int slot : _freeProjectiles)
+        writer.writeInt(slot);
+    writer.writeUInt(_activeProjectiles.size());
+    for (int slot : _activeProjectiles)
+        writer.writeInt(slot);
+
+    std::vector<PathService::PendingResult> pending;
+    _pathService.collectPending(pending);
+    writer.writeUInt(pending.size());
+    for (const auto& entry : pending)
+    {
+        const PathService::Request& request = entry.result.request;
+        writer.writeUInt(entry.applyFrame);
+        writer.writeInt(request.unit);
+        writer.writeInt(request.target);
+        writer.writeVec2(request.from);
+        writer.writeVec2(request.to);
+        writer.writeRect(request.goalArea);
+        writer.writeUInt(entry.result.version);
+        writer.writeUInt(entry.result.path.size());
+        for (const auto& point : entry.result.path)
+            writer.writeVec2(point);
+    }
+}
+
+bool BattleSimulation::loadKeyframe(const std::vector<uint8_t>& data)
+{
+    // 先全部解析到局部变量，校验通过后再替换，失败时模拟保持原状
+    SimStateReader reader(data);
+    if (reader.readUInt() != kKeyframeFormat)
+        return false;
+
+    unsigned int frame              = static_cast<unsigned int>(reader.readUInt());
+    int          stars              = static_cast<int>(reader.readInt());
+    int          destructionPercent = static_cast<int>(reader.readInt());
+    bool         townHallDestroyed  = reader.readBool();
+    int          destroyedHP        = static_cast<int>(reader.readInt());
+    int          destroyedCount     = static_cast<int>(reader.readInt());
+
+    int buildingCount = static_cast<int>(_buildings.size());
+    if (reader.readCount() != _buildings.size())
+        return false;
+    std::vector<SimBuilding> buildings = _buildings;
+    for (auto& building : buildings)
+    {
+        building.hitpoints      = static_cast<int>(reader.readInt());
+        building.target         = static_cast<int>(reader.readInt());
+        building.attackCooldown = reader.readFixed();
+    }
+
+    uint32_t                           version = static_cast<uint32_t>(reader.readUInt());
+    std::vector<CollisionBitmap::Word> words(reader.readCount());
+    for (auto& word : words)
+        word = reader.readUInt();
+    SimGrid grid = _grid;
+    if (!grid.restoreCollisionMap(words, version))
+        return false;
+
+    std::vector<SimUnit> units(reader.readCount());
+    int                  unitLimit = static_cast<int>(units.size());
+    for (int id = 0; id < unitLimit && reader.ok(); id++)
+    {
+        int type  = static_cast<int>(reader.readInt());
+        int level = static_cast<int>(reader.readInt());
+        if (type < static_cast<int>(UnitType::kBarbarian) || type > static_cast<int>(UnitType::kWallBreaker))
+            return false;
+
+        SimUnit& unit        = units[id];
+        unit                 = makeUnit(id, static_cast<UnitType>(type), level);
+        unit.stats.hitpoints = static_cast<int>(reader.readInt());
+        unit.velocity        = reader.readVec2();
+        unit.path.resize(reader.readCount());
+        for (auto& point : unit.path)
+            point = reader.readVec2();
+        unit.pathIndex      = static_cast<int>(reader.readInt());
+        unit.followFlow     = reader.readBool();
+        unit.pathPending    = reader.readBool();
+        unit.pathVersion    = static_cast<uint32_t>(reader.readUInt());
+        unit.target         = static_cast<int>(reader.readInt());
+        unit.targetSlot     = static_cast<int>(reader.readInt());
+        unit.retarget       = reader.readBool();
+        unit.attackCooldown = reader.readFixed();
+        unit.dead           = reader.readBool();
+        bool attached = unit.targetSlot >= 0;
+        if (unit.target < -1 || unit.target >= buildingCount || (attached && (unit.target < 0 || unit.dead)))
+            return false;
+    }
+
+    // 建筑的目标单位在单位读出之后才能校验
+    for (const auto& building : buildings)
+    {
+        if (building.target < -1 || building.target >= unitLimit)
+            return false;
+    }
+
+    // 攻击者列表按交换删除维护，每个建筑上的槽位必须恰好是 0..n-1：
+    // 重复或空缺的槽位会让 detachFromTarget 访问错误的单位
+    std::vector<std::vector<int>> attackers(buildings.size());
+    for (const auto& unit : units)
+    {
+        if (unit.targetSlot < 0)
+            continue;
+        if (buildings[unit.target].isDestroyed())
+            return false;
+        std::vector<int>& slots = attackers[unit.target];
+        if (unit.targetSlot >= unitLimit)
+            return false;
+        if (unit.targetSlot >= static_cast<int>(slots.size()))
+            slots.resize(unit.targetSlot + 1, -1);
+        if (slots[unit.targetSlot] != -1)
+            return false;
+        slots[unit.targetSlot] = unit.id;
+    }
+    for (const auto& slots : attackers)
+    {
+        if (std::find(slots.begin(), slots.end(), -1) != slots.end())
+            return false;
+    }
+
+    SimUnitMotion motion;
+    if (!motion.loadState(reader) || motion.size() != unitLimit)
+        return false;
+
+    std::vector<SimProjectile> projectiles(reader.readCount());
+    for (auto& projectile : projectiles)
+    {
+        projectile.active = reader.readBool();
+        if (!projectile.active)
+            continue;
+        projectile.source       = static_cast<int>(reader.readInt());
+        projectile.target       = static_cast<int>(reader.readInt());
+        projectile.damage       = reader.readFixed();
+        projectile.splashRadius = reader.readFixed();
+        projectile.origin       = reader.readVec2();
+        projectile.flightTime   = reader.readFixed();
+        projectile.remaining    = reader.readFixed();
+        if (projectile.target < 0 || projectile.target >= unitLimit || projectile.source < 0 ||
+            projectile.source >= buildingCount)
+            return false;
+    }
+    int              slotCount = static_cast<int>(projectiles.size());
+    std::vector<int> freeProjectiles(reader.readCount());
+    for (auto& slot : freeProjectiles)
+        slot = static_cast<int>(reader.readInt());
+    std::vector<int> activeProjectiles(reader.readCount());
+    for (auto& slot : activeProjectiles)
+        slot = static_cast<int>(reader.readInt());
+    // 空闲列表与飞行列表恰好划分全部槽位：飞行列表只含活动的投射物，空闲列表只含非活动的
+    if (freeProjectiles.size() + activeProjectiles.size() != projectiles.size())
+        return false;
+    std::vector<bool> listed(projectiles.size(), false);
+    for (const auto* slots : {&freeProjectiles, &activeProjectiles})
+    {
+        bool active = slots == &activeProjectiles;
+        for (int slot : *slots)
+        {
+            if (slot < 0 || slot >= slotCount || listed[slot] || projectiles[slot].active != active)
+                return false;
+            listed[slot] = true;
+        }
+    }
+
+    std::vector<PathService::PendingResult> pending(reader.readCount());
+    for (auto& entry : pending)
+    {
+        PathService::Request& request = entry.result.request;
+        entry.applyFrame              = static_cast<unsigned int>(reader.readUInt());
+        request.unit                  = static_cast<int>(reader.readInt());
+        request.target                = static_cast<int>(reader.readInt());
+        request.from                  = reader.readVec2();
+        request.to                    = reader.readVec2();
+        request.goalArea              = reader.readRect();
+        entry.result.version          = static_cast<uint32_t>(reader.readUInt());
+        entry.result.path.resize(reader.readCount());
+        for (auto& point : entry.result.path)
+            point = reader.readVec2();
+        if (request.unit < 0 || request.unit >= unitLimit)
+            return false;
+    }
+
+    if (!reader.ok() || !reader.atEnd())
+        return false;
+
+    _frame                  = frame;
+    _stars                  = stars;
+    _destructionPercent     = destructionPercent;
+    _townHallDestroyed      = townHallDestroyed;
+    _destroyedBuildingHP    = destroyedHP;
+    _destroyedBuildingCount = destroyedCount;
+    _buildings              = std::move(buildings);
+    _grid                   = std::move(grid);
+    _units                  = std::move(units);
+    _attackers              = std::move(attackers);
+    _motion                 = std::move(motion);
+    _projectiles            = std::move(projectiles);
+    _freeProjectiles        = std::move(freeProjectiles);
+    _activeProjectiles      = std::move(activeProjectiles);
+    _pathService.restorePending(pending);
+
+    rebuildDerivedState();
+    return true;
+}
+
+void BattleSimulation::rebuildDerivedState()
+{
+    _events.clear();
+    _targetCandidates.clear();
+    _targetQueries.clear();
+    _defenseShots.assign(_defenses.size(), -1);
+
+    // 流场和分层寻路图按需重建，与增量维护得到的结果相同
+    _flowFields.clear();
+    _hierarchy.clear();
+
+    _aliveUnitCount = 0;
+    _unitIndex.clear();
+    for (const auto& unit : _units)
+    {
+        if (unit.dead)
+            continue;
+        _aliveUnitCount++;
+        _unitIndex.insert(unit.id, _motion.getPosition(unit.id), categoryOf(unit.type));
+    }
+
+    // 空间索引的查询结果在距离相同时按 ID 决定，插入顺序不影响结果
+    _buildingIndex.clear();
+    for (auto& index : _buildingsByType)
+        index.clear();
+    for (const auto& building : _buildings)
+    {
+        if (building.isDestroyed())
+            continue;
+        _buildingIndex.insert(building.id, building.position, categoryOf(building.type));
+        _buildingsByType[static_cast<int>(building.type)].insert(building.id, building.position, kAnyCategory);
+    }
+}
+
+SimEvent& BattleSimulation::emit(SimEventType type, int unit, int building)
+{
+    SimEvent event;
+    event.type     = type;
+    event.unit     = unit;
+    event.building = building;
+    _events.push_back(event);
+    return _events.back();
+}
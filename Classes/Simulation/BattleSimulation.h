@@ -0,0 +1,271 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     BattleSimulation.h
+ * File Function: 无渲染的战斗模拟核心 - 单位、建筑、寻路、索敌、伤害与固定步长推进
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef BATTLE_SIMULATION_H_
+#define BATTLE_SIMULATION_H_
+
+#include "FlowField.h"
+#include "HierarchicalPathFinder.h"
+#include "JobSystem.h"
+#include "PathFinder.h"
+#include "PathService.h"
+#include "SimEntities.h"
+#include "SimGrid.h"
+#include "SimTypes.h"
+#include "SimUnitMotion.h"
+#include "SpatialHash.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BattleSimulation
+ * @brief 战斗规则的唯一实现，不依赖 cocos2d
+ *
+ * 每次 step() 推进一个固定时间步（1/60 秒），顺序为：
+ * 0. 按提交顺序应用到期的寻路结果（PathService，提交后 kLatencyFrames 帧生效）
+ * 1. 单位沿路径移动（SimUnitMotion 批量推进，到达路段终点的单位再逐个处理）
+ * 2. 单位 AI：选择目标（空间索引最近邻查询）、寻路（多个单位共享同一目标时沿流场移动，
+ *    单独接近时向 PathService 提交请求，远距离走分层寻路）、攻击
+ * 3. 防御建筑：冷却、开火、索敌（空间索引半径查询）
+ * 4. 投射物飞行与命中结算（法师塔对命中点周围的单位造成溅射伤害）
+ *
+ * 步骤 1 的批量推进、步骤 2 之前为需要新目标的单位预先查询候选目标、步骤 3 的冷却与索敌
+ * 是数据并行的，交给 JobSystem 按 ID 分块执行：每块只写入自己那部分单位/建筑，
+ * 开火、移动、伤害等有先后依赖的部分仍按 ID 顺序串行处理，结果与工作线程数无关。
+ *
+ * 星数、摧毁率、被摧毁建筑数和存活单位数在伤害/摧毁/部署/死亡发生时增量维护，
+ * 战斗结束判定只读取这些计数，不再逐帧遍历建筑和单位。
+ *
+ * 表现层（BattleManager）只负责把输入（部署）交给模拟，
+ * 再根据单位/建筑状态和 getEvents() 返回的事件更新精灵。
+ * 同样的输入序列在任何平台上都可以脱离渲染重放，用于测试、
+ * 性能评估和服务器端校验。
+ */
+class BattleSimulation
+{
+public:
+    static constexpr int kBuildingTypeCount = static_cast<int>(BuildingType::kUnknown) + 1; ///< 建筑类型数
+
+    static constexpr float kFixedTimeStep = 1.0f / 60.0f; ///< 固定时间步长（表现层累积时间用）
+
+    /** @brief 模拟内部使用的定点时间步长 */
+    static Fixed stepDelta() { return Fixed::fromRatio(1, 60); }
+
+    /** @brief 清空所有实体与计数，回到第 0 帧 */
+    void reset();
+
+    /**
+     * @brief 初始化网格
+     * @param width 网格宽度
+     * @param height 网格高度
+     * @param tileSize 单个网格的宽度（像素）
+     * @param startPixel 网格(0,0)对应的地图层坐标
+     */
+    void initGrid(int width, int height, Fixed tileSize, const SimVec2& startPixel);
+
+    /**
+     * @brief 添加防守建筑（生命值重置为满血，占地标记为不可通行）
+     * @return int 建筑 ID
+     */
+    int addBuilding(const SimBuildingDesc& desc);
+
+    /**
+     * @brief 部署单位
+     * @param type 单位类型
+     * @param level 单位等级
+     * @param position 部署位置
+     * @return int 单位 ID
+     */
+    int spawnUnit(UnitType type, int level, const SimVec2& position);
+
+    /** @brief 推进一个固定时间步 */
+    void step();
+
+    /** @brief 最近一次 step() 产生的事件 */
+    const std::vector<SimEvent>& getEvents() const { return _events; }
+
+    /** @brief 已推进的帧数 */
+    unsigned int getFrame() const { return _frame; }
+
+    /**
+     * @brief 直接设置帧数（观战中途加入时对齐时间，不推进模拟）
+     */
+    void setFrame(unsigned int frame) { _frame = frame; }
+
+    /** @brief 已进行时间（秒） */
+    float getElapsedTime() const { return _frame * kFixedTimeStep; }
+
+    const std::vector<SimUnit>&     getUnits() const { return _units; }
+    const SimUnitMotion&            getUnitMotion() const { return _motion; }
+    const std::vector<SimBuilding>& getBuildings() const { return _buildings; }
+    const SimGrid&                  getGrid() const { return _grid; }
+
+    /** @brief 投射物槽位池（下标即 kDefenseFire / kProjectileHit 事件中的槽位，只有 active 的槽位有效） */
+    const std::vector<SimProjectile>& getProjectiles() const { return _projectiles; }
+
+    /** @brief 单位当前位置 */
+    SimVec2 getUnitPosition(int unit) const { return _motion.getPosition(unit); }
+
+    /** @brief 获得的星星数（只增不减） */
+    int getStars() const { return _stars; }
+
+    /** @brief 摧毁百分比（基于生命值） */
+    int getDestructionPercent() const { return _destructionPercent; }
+
+    /** @brief 大本营是否被摧毁 */
+    bool isTownHallDestroyed() const { return _townHallDestroyed; }
+
+    int getTotalBuildingHP() const { return _totalBuildingHP; }
+    int getDestroyedBuildingHP() const { return _destroyedBuildingHP; }
+
+    /** @brief 已被摧毁的建筑数 */
+    int getDestroyedBuildingCount() const { return _destroyedBuildingCount; }
+
+    /** @brief 是否所有建筑都已被摧毁（没有建筑时为 true） */
+    bool areAllBuildingsDestroyed() const { return _destroyedBuildingCount == static_cast<int>(_buildings.size()); }
+
+    /** @brief 存活单位数量 */
+    int countAliveUnits() const { return _aliveUnitCount; }
+
+    /** @brief 流场缓存（性能统计用） */
+    const FlowFieldCache& getFlowFields() const { return _flowFields; }
+
+    /**
+     * @brief 设置逐格寻路的搜索方式（默认逐格 A*）
+     *
+     * 两种方式的路径代价相同，但等价路径之间的取舍可能不同，
+     * 同一场战斗的回放必须使用相同的搜索方式才能得到相同的结果。
+     */
+    void setPathSearchMode(PathSearchMode mode) { _pathSearchMode = mode; }
+
+    /**
+     * @brief 设置寻路工作线程数（默认 0：提交请求时直接求解）
+     * @note 不影响模拟结果，只把寻路耗时从步进中移到工作线程
+     */
+    void setPathWorkerCount(int count) { _pathService.setWorkerCount(count); }
+
+    /**
+     * @brief 设置步进中数据并行阶段的工作线程数（默认 0：全部在调用线程上执行）
+     * @note 不影响模拟结果，只影响步进耗时
+     */
+    void setJobWorkerCount(int count) { _jobs.setWorkerCount(count); }
+
+    /** @brief 数据并行阶段的任务调度器（性能统计用） */
+    const JobSystem& getJobSystem() const { return _jobs; }
+
+    /** @brief 异步寻路服务（性能统计用） */
+    const PathService& getPathService() const { return _pathService; }
+
+    /** @brief 分层寻路器（性能统计用） */
+    const HierarchicalPathFinder& getHierarchy() const { return _hierarchy; }
+
+    /** @brief 存活单位的空间索引（性能统计用） */
+    const SpatialHash& getUnitIndex() const { return _unitIndex; }
+
+    /** @brief 未被摧毁建筑的空间索引（性能统计用） */
+    const SpatialHash& getBuildingIndex() const { return _buildingIndex; }
+
+    /** @brief 某一类型未被摧毁建筑的空间索引（性能统计用） */
+    const SpatialHash& getBuildingIndex(BuildingType type) const { return _buildingsByType[static_cast<int>(type)]; }
+
+    /**
+     * @brief 计算当前模拟状态的哈希（FNV-1a 64）
+     *
+     * 覆盖帧号、所有单位/建筑/投射物的定点原始值和星数。
+     * 同一回放在不同平台、不同编译器下逐帧得到的哈希应完全相同，
+     * 用于回放校验和 PvP 双端不同步检测。
+     */
+    uint64_t computeStateHash() const;
+
+    /**
+     * @brief 把当前状态写成关键帧（回放跳转用）
+     *
+     * 只保存随战斗变化的状态：帧号与计数、建筑生命值与目标、碰撞位图、单位、投射物
+     * 和尚未应用的寻路结果（会等待工作线程求解完成）。建筑的静态属性、空间索引、
+     * 攻击者列表、流场和分层寻路图都可以由这些状态重新推出，不写入关键帧。
+     * @param out 输出的字节序列（覆盖原内容）
+     */
+    void saveKeyframe(std::vector<uint8_t>& out);
+
+    /**
+     * @brief 从关键帧恢复状态，之后的推进与保存时继续推进的结果逐位相同
+     * @param data saveKeyframe() 的输出
+     * @return bool 成功时为 true；数据损坏或建筑与保存时不一致时返回 false，状态不变
+     * @note 调用前必须用与保存时相同的网格和 addBuilding 顺序初始化过本模拟
+     */
+    bool loadKeyframe(const std::vector<uint8_t>& data);
+
+private:
+    void rebuildDerivedState();
+
+    void moveUnitTo(SimUnit& unit, const SimVec2& target);
+    void moveUnitAlongPath(SimUnit& unit, const std::vector<SimVec2>& path, uint32_t pathVersion);
+    void requestPath(SimUnit& unit, const SimBuilding& target);
+    void applyPathResults();
+    bool stepAlongFlowField(SimUnit& unit);
+    void stopUnit(SimUnit& unit);
+    void onSegmentReached(SimUnit& unit);
+    void updateUnitAI(SimUnit& unit, Fixed dt);
+    int  findTargetFor(const SimUnit& unit) const;
+    void prefetchTargets();
+    int  takeTargetFor(const SimUnit& unit);
+    void setUnitTarget(SimUnit& unit, int building);
+    void detachFromTarget(SimUnit& unit);
+
+    int  tickDefense(SimBuilding& building, Fixed dt);
+    void detectEnemies(SimBuilding& building);
+    void fireProjectile(SimBuilding& building, SimUnit& target);
+    void updateProjectiles(Fixed dt);
+    void resolveProjectile(int slot);
+
+    void damageUnit(SimUnit& unit, Fixed damage);
+    void killUnit(SimUnit& unit);
+    void damageBuilding(SimBuilding& building, int damage);
+
+    /** @brief 由摧毁计数推出摧毁率与星数（O(1)，建筑受伤或被摧毁时调用） */
+    void updateStarsAndDestruction();
+
+    SimEvent& emit(SimEventType type, int unit, int building);
+
+    SimGrid                    _grid;
+    std::vector<SimUnit>       _units;
+    SimUnitMotion              _motion;        ///< 单位的位置与移动状态（按单位 ID 存放）
+    std::vector<SimBuilding>   _buildings;
+    std::vector<SimProjectile> _projectiles;       ///< 投射物槽位池
+    std::vector<int>           _freeProjectiles;   ///< 空闲槽位
+    std::vector<int>           _activeProjectiles; ///< 飞行中的槽位（按发射顺序）
+    std::vector<int>           _splashTargets;     ///< 溅射结算的临时缓冲
+    std::vector<SimEvent>      _events;
+    JobSystem                  _jobs;          ///< 步进中数据并行阶段的任务调度
+    PathService                _pathService;   ///< 单独接近目标时的寻路（工作线程在快照上求解）
+    FlowFieldCache             _flowFields;    ///< 按目标建筑共享的流场
+    HierarchicalPathFinder     _hierarchy;     ///< 远距离寻路用的簇-入口抽象图
+    std::vector<std::vector<int>> _attackers; ///< 每个建筑的攻击者（选它为目标的存活单位 ID）
+    SpatialHash                _unitIndex;     ///< 存活单位（类别位为 1 << 单位类型），防御建筑索敌用
+    SpatialHash                _buildingIndex; ///< 未被摧毁的建筑（类别位为 1 << 建筑类型），无偏好时选目标用
+    SpatialHash                _buildingsByType[kBuildingTypeCount]; ///< 按建筑类型划分的未被摧毁建筑，优先目标查询用
+    std::vector<int>           _defenses;         ///< 防御建筑 ID（按 ID 升序）
+    std::vector<int>           _defenseShots;     ///< 与 _defenses 对应：本步开火的目标单位（-1 表示不开火）
+    std::vector<int>           _targetCandidates; ///< 按单位 ID：预先查询的候选目标（kNoCandidate 表示没有）
+    std::vector<int>           _targetQueries;    ///< 本步需要预先查询目标的单位 ID
+
+    PathSearchMode _pathSearchMode = PathSearchMode::kAStar; ///< 逐格寻路的搜索方式
+
+    unsigned int _frame                   = 0;
+    int          _stars                   = 0;
+    int          _destructionPercent      = 0;
+    bool         _townHallDestroyed       = false;
+    int          _totalBuildingHP         = 0;
+    int          _destroyedBuildingHP     = 0; ///< 已造成的建筑伤害总和（每次伤害累加实际扣除的生命值）
+    int          _destroyedBuildingCount  = 0; ///< 已被摧毁的建筑数
+    int          _aliveUnitCount          = 0; ///< 存活单位数（部署时加一，死亡时减一）
+    int          _candidateDestroyedCount = 0; ///< 预先查询候选目标时的被摧毁建筑数（之后变化则候选作废）
+};
+
+#endif // BATTLE_SIMULATION_H_
@@ -0,0 +1,181 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     CollisionBitmap.cpp
+ * File Function: 碰撞位图实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "CollisionBitmap.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+namespace
+{
+/** @brief 8 个占用位 -> 8 个通行字节（可通行 1，被占用 0），逐字节查表展开 */
+struct PassableTable
+{
+    uint8_t bytes[256][8];
+
+    PassableTable()
+    {
+        for (int bits = 0; bits < 256; bits++)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                bytes[bits][i] = static_cast<uint8_t>(~(bits >> i) & 1);
+            }
+        }
+    }
+};
+
+const PassableTable kPassableTable;
+
+// 64 位 de Bruijn 序列：孤立出最低位后相乘，高 6 位唯一对应位序号
+const uint64_t kDeBruijn64      = 0x03F79D71B4CB0A89ULL;
+const int      kDeBruijnIndex[] = {0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,
+                                   62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+                                   63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+                                   46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6};
+} // namespace
+
+constexpr int CollisionBitmap::kWordBits;
+
+void CollisionBitmap::resize(int width, int height)
+{
+    _width       = std::max(0, width);
+    _height      = std::max(0, height);
+    _wordsPerRow = (_width + kWordBits - 1) / kWordBits;
+    _words.assign(static_cast<size_t>(_wordsPerRow) * _height, 0);
+    _version++;
+}
+
+bool CollisionBitmap::clip(int& x0, int& y0, int& x1, int& y1) const
+{
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(_width, x1);
+    y1 = std::min(_height, y1);
+    return x0 < x1 && y0 < y1;
+}
+
+bool CollisionBitmap::anyInRect(int x, int y, int width, int height) const
+{
+    int x0 = x, y0 = y, x1 = x + width, y1 = y + height;
+    if (!clip(x0, y0, x1, y1))
+        return false;
+
+    int firstWord = x0 / kWordBits;
+    int lastWord  = (x1 - 1) / kWordBits;
+    if (firstWord == lastWord)
+    {
+        // 常见情况：区域在每行只覆盖一个字，掩码只算一次，每行一次与运算
+        Word        mask  = bitRange(x0 % kWordBits, (x1 - 1) % kWordBits + 1);
+        const Word* words = _words.data() + y0 * _wordsPerRow + firstWord;
+        Word        hits  = 0;
+        for (int row = y0; row < y1; row++, words += _wordsPerRow)
+        {
+            hits |= *words & mask;
+        }
+        return hits != 0;
+    }
+
+    for (int row = y0; row < y1; row++)
+    {
+        const Word* words = _words.data() + row * _wordsPerRow;
+        for (int w = firstWord; w <= lastWord; w++)
+        {
+            int from = w == firstWord ? x0 % kWordBits : 0;
+            int to   = w == lastWord ? (x1 - 1) % kWordBits + 1 : kWordBits;
+            if (words[w] & bitRange(from, to))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool CollisionBitmap::fillRect(int x, int y, int width, int height, bool occupied)
+{
+    int x0 = x, y0 = y, x1 = x + width, y1 = y + height;
+    if (!clip(x0, y0, x1, y1))
+        return false;
+
+    int  firstWord = x0 / kWordBits;
+    int  lastWord  = (x1 - 1) / kWordBits;
+    Word changed   = 0;
+    for (int row = y0; row < y1; row++)
+    {
+        Word* words = _words.data() + row * _wordsPerRow;
+        for (int w = firstWord; w <= lastWord; w++)
+        {
+            int  from = w == firstWord ? x0 % kWordBits : 0;
+            int  to   = w == lastWord ? (x1 - 1) % kWordBits + 1 : kWordBits;
+            Word mask = bitRange(from, to);
+            Word next = occupied ? (words[w] | mask) : (words[w] & ~mask);
+            changed |= next ^ words[w];
+            words[w] = next;
+        }
+    }
+
+    if (changed == 0)
+        return false;
+    _version++;
+    return true;
+}
+
+void CollisionBitmap::unpackPassable(int y, int x, int count, uint8_t* out) const
+{
+    const Word* words = row(y);
+    while (count > 0)
+    {
+        int  bit  = x % kWordBits;
+        int  span = std::min(count, kWordBits - bit);
+        Word bits = words[x / kWordBits] >> bit;
+        if ((bits & bitRange(0, span)) == 0)
+        {
+            std::fill(out, out + span, static_cast<uint8_t>(1));
+        }
+        else
+        {
+            int i = 0;
+            for (; i + 8 <= span; i += 8)
+            {
+                std::memcpy(out + i, kPassableTable.bytes[(bits >> i) & 0xFF], 8);
+            }
+            for (; i < span; i++)
+            {
+                out[i] = static_cast<uint8_t>(~(bits >> i) & 1);
+            }
+        }
+        out += span;
+        x += span;
+        count -= span;
+    }
+}
+
+int CollisionBitmap::lowestBit(Word word)
+{
+    return kDeBruijnIndex[((word & (~word + 1)) * kDeBruijn64) >> 58];
+}
+
+bool CollisionBitmap::restore(const std::vector<Word>& words, uint32_t version)
+{
+    if (words.size() != _words.size())
+        return false;
+
+    _words   = words;
+    _version = version;
+    return true;
+}
+
+int CollisionBitmap::count() const
+{
+    int total = 0;
+    for (Word word : _words)
+    {
+        total += static_cast<int>(std::bitset<kWordBits>(word).count());
+    }
+    return total;
+}
@@ -0,0 +1,125 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     CollisionBitmap.h
+ * File Function: 按行打包的碰撞位图（每个字 64 格，矩形区域按字并行读写）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef COLLISION_BITMAP_H_
+#define COLLISION_BITMAP_H_
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CollisionBitmap
+ * @brief 不依赖引擎的碰撞位图，GridMap（建造/部署）和 SimGrid（战斗模拟）共用
+ *
+ * 按行存放：第 y 行占 getWordsPerRow() 个 64 位字，格子 x 位于第 x / 64 个字的
+ * 第 x % 64 位，置 1 表示被占用。行尾超出宽度的位恒为 0。
+ * 矩形区域的检查与标记每行只处理覆盖到的几个字（44 格宽的地图每行只有一个字），
+ * 拖动建筑时的放置检查不再逐格访问。
+ *
+ * 版本号在 resize 或任意格子的状态真正改变时递增，缓存通行状态的模块
+ * 只需比较一个整数即可判断是否需要重建。
+ */
+class CollisionBitmap
+{
+public:
+    using Word = uint64_t;
+
+    static constexpr int kWordBits = 64; ///< 每个字的格子数
+
+    /** @brief 重新设置尺寸并清空所有格子 */
+    void resize(int width, int height);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    int getWordsPerRow() const { return _wordsPerRow; }
+
+    /** @brief 版本号（resize 或格子状态改变时递增） */
+    uint32_t getVersion() const { return _version; }
+
+    /** @brief 坐标是否在范围内 */
+    bool isValid(int x, int y) const { return x >= 0 && x < _width && y >= 0 && y < _height; }
+
+    /** @brief 读取一个格子（调用方保证坐标有效） */
+    bool test(int x, int y) const { return (_words[y * _wordsPerRow + (x >> 6)] >> (x & 63)) & 1; }
+
+    /** @brief 读取一个格子，超出范围视为被占用 */
+    bool isBlocked(int x, int y) const { return !isValid(x, y) || test(x, y); }
+
+    /**
+     * @brief 第 y 行的原始数据（getWordsPerRow() 个字）
+     *
+     * 供寻路、部署检查等按字扫描：例如对取反后的字用 ctz 逐个找出可通行格子。
+     */
+    const Word* row(int y) const { return _words.data() + y * _wordsPerRow; }
+
+    /**
+     * @brief 矩形区域内是否有被占用的格子
+     * @note 超出范围的部分会被裁掉，不视为占用；需要“越界即失败”时调用方先做边界检查
+     */
+    bool anyInRect(int x, int y, int width, int height) const;
+
+    /**
+     * @brief 把矩形区域内的格子全部置为 occupied（超出范围的部分被裁掉）
+     * @return 是否有格子的状态发生了变化
+     */
+    bool fillRect(int x, int y, int width, int height, bool occupied);
+
+    /**
+     * @brief 把第 y 行 [x, x + count) 的通行状态展开为字节（可通行 1，被占用 0）
+     *
+     * 寻路模块的通行快照由它逐行填充，整字为空时直接整段写 1。
+     * 调用方保证区间在范围内。
+     */
+    void unpackPassable(int y, int x, int count, uint8_t* out) const;
+
+    /**
+     * @brief 恢复位数据与版本号（战斗模拟从关键帧恢复时用）
+     * @param words 行优先的位数据，长度必须为 getWordsPerRow() * getHeight()
+     * @return bool 长度不符时返回 false，不做任何修改
+     */
+    bool restore(const std::vector<Word>& words, uint32_t version);
+
+    /** @brief 被占用的格子总数 */
+    int count() const;
+
+    /**
+     * @brief 最低置位的位序号（word 不能为 0）
+     *
+     * 按字扫描时用 word &= word - 1 逐个清掉最低位，只访问置位的格子。
+     */
+    static int lowestBit(Word word);
+
+    /** @brief 行内第 wordIndex 个字的有效位（x < 宽度）掩码，取反扫描空闲格子时用来去掉行尾 */
+    Word validMask(int wordIndex) const
+    {
+        int valid = _width - wordIndex * kWordBits;
+        return valid >= kWordBits ? ~Word(0) : bitRange(0, valid);
+    }
+
+private:
+    /**
+     * @brief 把矩形裁剪到范围内
+     * @return 裁剪后为空时返回 false
+     */
+    bool clip(int& x0, int& y0, int& x1, int& y1) const;
+
+    /** @brief 位区间 [from, to)（0 <= from < to <= 64）对应的掩码 */
+    static Word bitRange(int from, int to)
+    {
+        Word high = to == kWordBits ? ~Word(0) : (Word(1) << to) - 1;
+        return high & ~((Word(1) << from) - 1);
+    }
+
+    std::vector<Word> _words;           ///< 行优先的位数据
+    int               _width       = 0; ///< 宽度（格）
+    int               _height      = 0; ///< 高度（格）
+    int               _wordsPerRow = 0; ///< 每行的字数
+    uint32_t          _version     = 0; ///< 版本号
+};
+
+#endif // COLLISION_BITMAP_H_
@@ -0,0 +1,137 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     FixedPoint.h
+ * File Function: 战斗模拟使用的 16.16 定点数
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef FIXED_POINT_H_
+#define FIXED_POINT_H_
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @class Fixed
+ * @brief 16.16 有符号定点数
+ *
+ * 战斗模拟中的坐标、时间和伤害全部使用定点数，运算只涉及整数加减乘除，
+ * 结果与编译器、浮点模式（FMA 合并、x87/SSE）和 CPU 架构无关，
+ * 保证同一输入序列在 x86-64 与 ARM 上逐位一致，用于回放和 PvP 同步。
+ *
+ * 浮点数只允许在边界处转换：配置表常量、部署坐标进入模拟时调用 fromFloat，
+ * 表现层读取时调用 toFloat。
+ *
+ * 取值范围约 ±32767，地图层坐标（< 4000 像素）有充足余量。
+ */
+class Fixed
+{
+public:
+    static constexpr int     kFractionBits = 16;
+    static constexpr int32_t kOne          = 1 << kFractionBits;
+
+    constexpr Fixed() : _raw(0) {}
+
+    /** @brief 由原始定点值构造 */
+    static constexpr Fixed fromRaw(int32_t raw) { return Fixed(raw, RawTag()); }
+
+    /** @brief 由整数构造 */
+    static constexpr Fixed fromInt(int value) { return Fixed(value * kOne, RawTag()); }
+
+    /**
+     * @brief 由浮点数构造（四舍五入到最近的 1/65536）
+     * @note 乘以 2 的幂是精确运算，同一 float 输入在任何平台上得到同一结果
+     */
+    static Fixed fromFloat(float value) { return fromRaw(static_cast<int32_t>(std::lround(value * kOne))); }
+
+    /** @brief 由分数 numerator/denominator 构造（向零截断） */
+    static constexpr Fixed fromRatio(int numerator, int denominator)
+    {
+        return fromRaw(static_cast<int32_t>(static_cast<int64_t>(numerator) * kOne / denominator));
+    }
+
+    int32_t raw() const { return _raw; }
+
+    /** @brief 转换为浮点数（仅供表现层使用） */
+    float toFloat() const { return static_cast<float>(_raw) / kOne; }
+
+    /** @brief 向零截断为整数 */
+    int toInt() const { return _raw / kOne; }
+
+    /** @brief 四舍五入为整数（.5 远离零） */
+    int roundToInt() const { return _raw >= 0 ? (_raw + kOne / 2) / kOne : -((-_raw + kOne / 2) / kOne); }
+
+    Fixed operator-() const { return fromRaw(-_raw); }
+    Fixed operator+(Fixed o) const { return fromRaw(_raw + o._raw); }
+    Fixed operator-(Fixed o) const { return fromRaw(_raw - o._raw); }
+    Fixed operator*(Fixed o) const { return fromRaw(static_cast<int32_t>(static_cast<int64_t>(_raw) * o._raw / kOne)); }
+    Fixed operator/(Fixed o) const { return fromRaw(static_cast<int32_t>(static_cast<int64_t>(_raw) * kOne / o._raw)); }
+    Fixed operator*(int s) const { return fromRaw(_raw * s); }
+    Fixed operator/(int s) const { return fromRaw(_raw / s); }
+
+    Fixed& operator+=(Fixed o)
+    {
+        _raw += o._raw;
+        return *this;
+    }
+    Fixed& operator-=(Fixed o)
+    {
+        _raw -= o._raw;
+        return *this;
+    }
+
+    bool operator==(Fixed o) const { return _raw == o._raw; }
+    bool operator!=(Fixed o) const { return _raw != o._raw; }
+    bool operator<(Fixed o) const { return _raw < o._raw; }
+    bool operator<=(Fixed o) const { return _raw <= o._raw; }
+    bool operator>(Fixed o) const { return _raw > o._raw; }
+    bool operator>=(Fixed o) const { return _raw >= o._raw; }
+
+    /**
+     * @brief 平方的原始值（32.32 格式，int64 不会溢出）
+     * @note 用于距离平方比较，避免开方
+     */
+    int64_t squaredRaw() const { return static_cast<int64_t>(_raw) * _raw; }
+
+    /**
+     * @brief 对 32.32 格式的平方值开方，得到 16.16 定点数
+     * @param squared 非负的 32.32 平方值
+     */
+    static Fixed sqrtOfSquaredRaw(int64_t squared)
+    {
+        if (squared <= 0)
+            return Fixed();
+
+        // 逐位整数开方，结果向下取整
+        uint64_t value  = static_cast<uint64_t>(squared);
+        uint64_t result = 0;
+        uint64_t bit    = uint64_t(1) << 62;
+        while (bit > value)
+            bit >>= 2;
+        while (bit != 0)
+        {
+            if (value >= result + bit)
+            {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return fromRaw(static_cast<int32_t>(result));
+    }
+
+private:
+    struct RawTag
+    {
+    };
+    constexpr Fixed(int32_t raw, RawTag) : _raw(raw) {}
+
+    int32_t _raw;
+};
+
+#endif // FIXED_POINT_H_
@@ -0,0 +1,196 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     FlowField.cpp
+ * File Function: 流场按需展开与采样
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "FlowField.h"
+
+namespace
+{
+// 8方向：上下左右 + 对角线，直线10，斜线14（与 PathFinder 一致）
+const int kDx[]    = {0, 1, 0, -1, 1, 1, -1, -1};
+const int kDy[]    = {1, 0, -1, 0, 1, -1, 1, -1};
+const int kCosts[] = {10, 10, 10, 10, 14, 14, 14, 14};
+} // namespace
+
+constexpr int FlowField::kUnreachable;
+
+void FlowFieldCache::clear()
+{
+    _slotOf.clear();
+    _freeSlots.clear();
+    for (int slot = static_cast<int>(_fields.size()) - 1; slot >= 0; slot--)
+    {
+        _fields[slot]._built = false;
+        _freeSlots.push_back(slot);
+    }
+    _passableVersion = 0;
+}
+
+void FlowFieldCache::release(int buildingId)
+{
+    if (buildingId < 0 || buildingId >= static_cast<int>(_slotOf.size()) || _slotOf[buildingId] < 0)
+        return;
+
+    int slot             = _slotOf[buildingId];
+    _fields[slot]._built = false;
+    _slotOf[buildingId]  = -1;
+    _freeSlots.push_back(slot);
+}
+
+FlowField& FlowFieldCache::acquire(const SimGrid& grid, int buildingId, const SimRect& goalArea)
+{
+    if (buildingId >= static_cast<int>(_slotOf.size()))
+        _slotOf.resize(buildingId + 1, -1);
+
+    int& slot = _slotOf[buildingId];
+    if (slot < 0)
+    {
+        if (_freeSlots.empty())
+        {
+            slot = static_cast<int>(_fields.size());
+            _fields.emplace_back();
+        }
+        else
+        {
+            slot = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+    }
+
+    FlowField& field = _fields[slot];
+    if (field.isValidFor(grid))
+        return field;
+
+    // 重新从目标占地开始展开（槽位内的数组保留容量，不重新分配）
+    int width  = grid.getGridWidth();
+    int height = grid.getGridHeight();
+
+    field._stride   = width + 2;
+    field._version  = grid.getVersion();
+    field._built    = true;
+    field._pending  = 0;
+    field._frontier = 0;
+    field._cursor   = 0;
+    field._cost.assign(field._stride * (height + 2), FlowField::kUnreachable);
+    for (auto& bucket : field._buckets)
+        bucket.clear();
+
+    for (int x = goalArea.x; x < goalArea.x + goalArea.width; x++)
+    {
+        for (int y = goalArea.y; y < goalArea.y + goalArea.height; y++)
+        {
+            if (!grid.isValid(x, y))
+                continue;
+            field._cost[field.indexOf(x, y)] = 0;
+            field._buckets[0].push_back(field.indexOf(x, y));
+            field._pending++;
+        }
+    }
+
+    refreshPassable(grid, field._stride);
+    _buildCount++;
+    return field;
+}
+
+void FlowFieldCache::refreshPassable(const SimGrid& grid, int stride)
+{
+    if (_passableVersion == grid.getVersion() && !_passable.empty())
+        return;
+
+    // 边框格子保持 0（不可通行），展开时只做一次数组读取
+    int width  = grid.getGridWidth();
+    int height = grid.getGridHeight();
+    _passable.assign(stride * (height + 2), 0);
+    for (int y = 0; y < height; y++)
+    {
+        grid.getCollisionMap().unpackPassable(y, 0, width, &_passable[(y + 1) * stride + 1]);
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        _offsets[i] = kDy[i] * stride + kDx[i];
+    }
+    _passableVersion = grid.getVersion();
+}
+
+void FlowFieldCache::expandLevel(FlowField& field)
+{
+    // 边代价只有 10 和 14，松弛只会向其他桶追加，可以边遍历边展开（Dial 算法）
+    std::vector<int>& bucket = field._buckets[field._frontier % FlowField::kBucketCount];
+    for (; field._cursor < bucket.size(); field._cursor++)
+    {
+        int cell = bucket[field._cursor];
+        field._pending--;
+        if (field._cost[cell] != field._frontier)
+            continue; // 已被更短的路径更新过
+
+        _expandedCount++;
+        for (int i = 0; i < 8; i++)
+        {
+            int neighbor = cell + _offsets[i];
+            if (!_passable[neighbor])
+                continue;
+
+            // 斜走规则是对称的：从邻格走到当前格同样要求两侧直线格子可通行
+            if (i >= 4 && (!isPassable(field, cell + kDx[i]) || !isPassable(field, cell + kDy[i] * field._stride)))
+                continue;
+
+            int newCost = field._frontier + kCosts[i];
+            if (newCost < field._cost[neighbor])
+            {
+                field._cost[neighbor] = newCost;
+                field._buckets[newCost % FlowField::kBucketCount].push_back(neighbor);
+                field._pending++;
+            }
+        }
+    }
+
+    bucket.clear();
+    field._cursor = 0;
+    field._frontier++;
+}
+
+bool FlowFieldCache::nextStep(const SimGrid& grid, int buildingId, const SimRect& goalArea, const SimCell& from,
+                              SimCell& next)
+{
+    FlowField& field = acquire(grid, buildingId, goalArea);
+    refreshPassable(grid, field._stride);
+
+    // 展开到起点所在的代价层为止：代价比起点小的邻格此时都已确定，
+    // 最优下一步一定在其中；起点不可达时会一直展开到开放列表耗尽
+    int current = field.indexOf(from.x, from.y);
+    while (field._pending > 0 && field._frontier <= field._cost[current])
+    {
+        expandLevel(field);
+    }
+
+    int currentCost = field._cost[current];
+    if (currentCost == 0)
+        return false;
+
+    int bestCost = FlowField::kUnreachable;
+    for (int i = 0; i < 8; i++)
+    {
+        int neighbor = current + _offsets[i];
+        int cost     = field._cost[neighbor];
+        if (cost == FlowField::kUnreachable || cost >= currentCost)
+            continue;
+
+        // 防止“穿墙角”
+        if (i >= 4 && (!isPassable(field, current + kDx[i]) || !isPassable(field, current + kDy[i] * field._stride)))
+            continue;
+
+        cost += kCosts[i];
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            next     = SimCell(from.x + kDx[i], from.y + kDy[i]);
+        }
+    }
+
+    return bestCost != FlowField::kUnreachable;
+}
@@ -0,0 +1,112 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     FlowField.h
+ * File Function: 按目标建筑共享的流场（可续算的 Dijkstra 距离场）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef FLOW_FIELD_H_
+#define FLOW_FIELD_H_
+
+#include "SimGrid.h"
+#include "SimTypes.h"
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class FlowField
+ * @brief 一个目标建筑的积分场
+ *
+ * 从目标建筑占地出发做 8 方向 Dijkstra（直线 10，斜线 14），记录每个格子
+ * 到目标的最短代价。任意位置的单位只需比较相邻 8 格的代价就能得到下一步，
+ * 不必各自运行 A*。通行规则与 PathFinder 相同：目标占地视为可通行，
+ * 斜走时两侧直线格子都必须可通行。
+ *
+ * Dijkstra 是按需续算的：代价按层（同一代价值）展开，只展开到查询格子
+ * 的代价确定为止，剩余的开放列表保留在流场里供下一次查询继续。
+ * 大部分目标只被附近的单位攻击，流场通常只覆盖目标周围一小块区域。
+ *
+ * 由 FlowFieldCache 创建和维护。
+ */
+class FlowField
+{
+public:
+    static constexpr int kUnreachable = INT_MAX; ///< 未到达或不可达格子的代价
+
+    /** @brief 是否对应当前版本的碰撞地图 */
+    bool isValidFor(const SimGrid& grid) const { return _built && _version == grid.getVersion(); }
+
+private:
+    friend class FlowFieldCache;
+
+    static constexpr int kBucketCount = 15; ///< 桶数（大于最大边代价 14）
+
+    /** @brief 网格坐标 -> _cost 下标（四周各留一圈不可达的边框，内层循环无需越界检查） */
+    int indexOf(int x, int y) const { return (y + 1) * _stride + x + 1; }
+
+    std::vector<int> _cost;                  ///< 每个格子到目标的代价（含边框，按 indexOf 存放）
+    std::vector<int> _buckets[kBucketCount]; ///< 环形桶队列：代价为 c 的格子在 c % kBucketCount 号桶
+    int              _pending  = 0;          ///< 桶中尚未处理的条目数
+    int              _frontier = 0;          ///< 正在展开的代价层
+    size_t           _cursor   = 0;          ///< 当前层桶内已处理到的位置
+    int              _stride  = 0;           ///< 含边框的行宽（width + 2）
+    uint32_t         _version = 0;           ///< 构建时的碰撞地图版本号
+    bool             _built   = false;       ///< 是否已初始化
+};
+
+/**
+ * @class FlowFieldCache
+ * @brief 以建筑 ID 为键的流场缓存
+ *
+ * 流场在第一次被请求时初始化，碰撞地图版本号变化（建筑或城墙被摧毁）后
+ * 在下一次请求时重新从目标占地开始展开。流场存放在槽位池中，目标建筑
+ * 被摧毁后 release() 归还槽位供下一个目标复用，内存不重新分配。
+ */
+class FlowFieldCache
+{
+public:
+    /** @brief 丢弃所有流场（保留槽位内存） */
+    void clear();
+
+    /** @brief 目标建筑已失效，归还其流场槽位 */
+    void release(int buildingId);
+
+    /**
+     * @brief 沿目标建筑的流场采样下一步要走的格子
+     * @param grid 模拟网格
+     * @param buildingId 目标建筑 ID
+     * @param goalArea 目标建筑占地
+     * @param from 当前所在格子
+     * @param next 输出下一格
+     * @return 已在目标占地内或不可达时返回 false
+     */
+    bool nextStep(const SimGrid& grid, int buildingId, const SimRect& goalArea, const SimCell& from, SimCell& next);
+
+    /** @brief 累计初始化（含碰撞地图变化后的重新展开）次数 */
+    int getBuildCount() const { return _buildCount; }
+
+    /** @brief 累计展开的格子数 */
+    int getExpandedCount() const { return _expandedCount; }
+
+private:
+    FlowField& acquire(const SimGrid& grid, int buildingId, const SimRect& goalArea);
+    void       refreshPassable(const SimGrid& grid, int stride);
+    void       expandLevel(FlowField& field);
+
+    /** @brief 通行检查（目标占地的代价恒为 0，据此视为可通行） */
+    bool isPassable(const FlowField& field, int cell) const { return _passable[cell] != 0 || field._cost[cell] == 0; }
+
+    std::vector<FlowField> _fields;               ///< 流场槽位池
+    std::vector<int>       _slotOf;               ///< 建筑 ID -> 槽位（-1 表示没有流场）
+    std::vector<int>       _freeSlots;            ///< 空闲槽位
+    std::vector<uint8_t>   _passable;             ///< 当前碰撞地图的通行状态快照（布局与 _cost 相同）
+    uint32_t               _passableVersion = 0;  ///< 快照对应的碰撞地图版本号
+    int                    _offsets[8]      = {}; ///< 8 个方向在 _cost 中的下标偏移
+    int                    _buildCount      = 0;  ///< 累计初始化次数
+    int                    _expandedCount   = 0;  ///< 累计展开的格子数
+};
+
+#endif // FLOW_FIELD_H_
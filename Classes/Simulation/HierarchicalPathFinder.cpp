@@ -0,0 +1,555 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     HierarchicalPathFinder.cpp
+ * File Function: 分层寻路（HPA*）实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "HierarchicalPathFinder.h"
+#include "PathFinder.h"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+namespace
+{
+// 8方向：上下左右 + 对角线，直线10，斜线14（与 PathFinder 一致）
+const int kDx[]    = {0, 1, 0, -1, 1, 1, -1, -1};
+const int kDy[]    = {1, 0, -1, 0, 1, -1, 1, -1};
+const int kCosts[] = {10, 10, 10, 10, 14, 14, 14, 14};
+
+const int kUnreachable       = INT_MAX; ///< 不可达
+const int kMaxSingleEntrance = 5;       ///< 入口长度不超过该值时只在中点放一对入口节点
+
+uint64_t packEntry(int cost, int node)
+{
+    return (static_cast<uint64_t>(cost) << 32) | static_cast<uint32_t>(node);
+}
+} // namespace
+
+constexpr int HierarchicalPathFinder::kClusterSize;
+
+// ==================== 构建与修复 ====================
+
+void HierarchicalPathFinder::build(const SimGrid& grid)
+{
+    _width     = grid.getGridWidth();
+    _height    = grid.getGridHeight();
+    _clustersX = (_width + kClusterSize - 1) / kClusterSize;
+    _clustersY = (_height + kClusterSize - 1) / kClusterSize;
+
+    _clusters.assign(_clustersX * _clustersY, Cluster());
+    _portalAt.assign(_width * _height, -1);
+
+    for (int cy = 0; cy < _clustersY; cy++)
+    {
+        for (int cx = 0; cx < _clustersX; cx++)
+        {
+            Cluster& cluster = _clusters[cy * _clustersX + cx];
+            cluster.x        = cx * kClusterSize;
+            cluster.y        = cy * kClusterSize;
+            cluster.width    = std::min(kClusterSize, _width - cluster.x);
+            cluster.height   = std::min(kClusterSize, _height - cluster.y);
+            cluster.stride   = cluster.width + 2;
+        }
+    }
+
+    int clusterCount = static_cast<int>(_clusters.size());
+    for (int i = 0; i < clusterCount; i++)
+    {
+        scanEntrances(grid, i, true);
+        scanEntrances(grid, i, false);
+    }
+    for (int i = 0; i < clusterCount; i++)
+    {
+        rebuildPortals(i);
+    }
+    for (int i = 0; i < clusterCount; i++)
+    {
+        rebuildEdges(grid, i);
+    }
+
+    _clusterBuildCount += clusterCount;
+    _version = grid.getVersion();
+    _built   = true;
+}
+
+void HierarchicalPathFinder::onAreaChanged(const SimGrid& grid, const SimRect& area)
+{
+    // 尚未构建时等第一次查询整体构建
+    if (!_built || _version == grid.getVersion())
+        return;
+
+    // 中间漏掉了修改（或网格尺寸变化），无法确定受影响的范围
+    if (_version + 1 != grid.getVersion() || _width != grid.getGridWidth() || _height != grid.getGridHeight())
+    {
+        build(grid);
+        return;
+    }
+
+    int minX = std::max(area.x, 0);
+    int minY = std::max(area.y, 0);
+    int maxX = std::min(area.x + area.width, _width) - 1;
+    int maxY = std::min(area.y + area.height, _height) - 1;
+    if (minX > maxX || minY > maxY)
+    {
+        _version = grid.getVersion();
+        return;
+    }
+
+    // 区域覆盖的簇需要重建簇内边；四条边界上的入口如有变化，相邻簇的入口节点也随之变化
+    std::vector<uint8_t> dirty(_clusters.size(), 0);
+    for (int cy = minY / kClusterSize; cy <= maxY / kClusterSize; cy++)
+    {
+        for (int cx = minX / kClusterSize; cx <= maxX / kClusterSize; cx++)
+        {
+            int cluster    = cy * _clustersX + cx;
+            dirty[cluster] = 1;
+
+            if (scanEntrances(grid, cluster, true) && cx + 1 < _clustersX)
+                dirty[cluster + 1] = 1;
+            if (scanEntrances(grid, cluster, false) && cy + 1 < _clustersY)
+                dirty[cluster + _clustersX] = 1;
+            if (cx > 0 && scanEntrances(grid, cluster - 1, true))
+                dirty[cluster - 1] = 1;
+            if (cy > 0 && scanEntrances(grid, cluster - _clustersX, false))
+                dirty[cluster - _clustersX] = 1;
+        }
+    }
+
+    int clusterCount = static_cast<int>(_clusters.size());
+    for (int i = 0; i < clusterCount; i++)
+    {
+        if (dirty[i])
+            rebuildPortals(i);
+    }
+    for (int i = 0; i < clusterCount; i++)
+    {
+        if (dirty[i])
+        {
+            rebuildEdges(grid, i);
+            _clusterBuildCount++;
+        }
+    }
+
+    _version = grid.getVersion();
+}
+
+bool HierarchicalPathFinder::scanEntrances(const SimGrid& grid, int cluster, bool east)
+{
+    Cluster& self = _clusters[cluster];
+    int      cx   = cluster % _clustersX;
+    int      cy   = cluster / _clustersX;
+
+    std::vector<Entrance> entrances;
+    if ((east && cx + 1 < _clustersX) || (!east && cy + 1 < _clustersY))
+    {
+        // 沿边界逐格检查两侧是否都可通行，连续的一段构成一个入口
+        int length = east ? self.height : self.width;
+        int start  = -1;
+        for (int t = 0; t <= length; t++)
+        {
+            bool open = false;
+            if (t < length)
+            {
+                int x = east ? self.x + self.width - 1 : self.x + t;
+                int y = east ? self.y + t : self.y + self.height - 1;
+                open  = !grid.isBlocked(x, y) && !grid.isBlocked(east ? x + 1 : x, east ? y : y + 1);
+            }
+
+            if (open && start < 0)
+                start = t;
+            if (open || start < 0)
+                continue;
+
+            int segment  = t - start;
+            int picks[2] = {start + segment / 2, -1};
+            if (segment > kMaxSingleEntrance)
+            {
+                picks[0] = start;
+                picks[1] = t - 1;
+            }
+
+            for (int pick : picks)
+            {
+                if (pick < 0)
+                    continue;
+                int      x = east ? self.x + self.width - 1 : self.x + pick;
+                int      y = east ? self.y + pick : self.y + self.height - 1;
+                Entrance entrance;
+                entrance.inside  = y * _width + x;
+                entrance.outside = east ? entrance.inside + 1 : entrance.inside + _width;
+                entrances.push_back(entrance);
+            }
+            start = -1;
+        }
+    }
+
+    std::vector<Entrance>& current = east ? self.eastEntrances : self.northEntrances;
+    if (current == entrances)
+        return false;
+
+    current.swap(entrances);
+    return true;
+}
+
+void HierarchicalPathFinder::rebuildPortals(int cluster)
+{
+    Cluster& self = _clusters[cluster];
+    for (int cell : self.portals)
+    {
+        _portalAt[cell] = -1;
+    }
+    self.portals.clear();
+    self.links.clear();
+
+    auto addLink = [this, &self](int cell, int acrossCell) {
+        if (_portalAt[cell] < 0)
+        {
+            _portalAt[cell] = static_cast<int>(self.portals.size());
+            self.portals.push_back(cell);
+        }
+        Link link;
+        link.portal     = _portalAt[cell];
+        link.acrossCell = acrossCell;
+        self.links.push_back(link);
+    };
+
+    int cx = cluster % _clustersX;
+    int cy = cluster / _clustersX;
+    for (const Entrance& entrance : self.eastEntrances)
+    {
+        addLink(entrance.inside, entrance.outside);
+    }
+    for (const Entrance& entrance : self.northEntrances)
+    {
+        addLink(entrance.inside, entrance.outside);
+    }
+    if (cx > 0)
+    {
+        for (const Entrance& entrance : _clusters[cluster - 1].eastEntrances)
+        {
+            addLink(entrance.outside, entrance.inside);
+        }
+    }
+    if (cy > 0)
+    {
+        for (const Entrance& entrance : _clusters[cluster - _clustersX].northEntrances)
+        {
+            addLink(entrance.outside, entrance.inside);
+        }
+    }
+}
+
+void HierarchicalPathFinder::rebuildEdges(const SimGrid& grid, int cluster)
+{
+    Cluster& self        = _clusters[cluster];
+    int      portalCount = static_cast<int>(self.portals.size());
+    int      count       = self.paddedCount();
+
+    // 通行状态快照：查询时的簇内搜索只读快照，不再逐格访问碰撞地图
+    self.open.assign(count, 0);
+    for (int y = self.y; y < self.y + self.height; y++)
+    {
+        grid.getCollisionMap().unpackPassable(y, self.x, self.width, &self.open[localOf(self, y * _width + self.x)]);
+    }
+    for (int cell : self.portals)
+    {
+        self.open[localOf(self, cell)] = 2;
+    }
+
+    self.costs.assign(portalCount * portalCount, kUnreachable);
+    self.trees.resize(portalCount * count);
+
+    std::vector<int> cost(count);
+    for (int i = 0; i < portalCount; i++)
+    {
+        searchCluster(self, self.portals[i], -1, SimRect(), cost.data(), &self.trees[i * count]);
+        for (int j = 0; j < portalCount; j++)
+        {
+            self.costs[i * portalCount + j] = cost[localOf(self, self.portals[j])];
+        }
+    }
+}
+
+void HierarchicalPathFinder::searchCluster(const Cluster& cluster, int sourceCell, int extraTarget,
+                                           const SimRect& goalArea, int* cost, int* parent)
+{
+    // 目标占地与簇相交时，在快照的副本上把占地标记为可通行
+    const uint8_t* open = cluster.open.data();
+    int            minX = std::max(goalArea.x, cluster.x);
+    int            minY = std::max(goalArea.y, cluster.y);
+    int            maxX = std::min(goalArea.x + goalArea.width, cluster.x + cluster.width);
+    int            maxY = std::min(goalArea.y + goalArea.height, cluster.y + cluster.height);
+    if (minX < maxX && minY < maxY)
+    {
+        _open.assign(cluster.open.begin(), cluster.open.end());
+        for (int y = minY; y < maxY; y++)
+        {
+            for (int x = minX; x < maxX; x++)
+            {
+                uint8_t& state = _open[localOf(cluster, y * _width + x)];
+                state          = std::max<uint8_t>(state, 1);
+            }
+        }
+        open = _open.data();
+    }
+
+    std::fill(cost, cost + cluster.paddedCount(), kUnreachable);
+
+    int offsets[8];
+    for (int i = 0; i < 8; i++)
+    {
+        offsets[i] = kDy[i] * cluster.stride + kDx[i];
+    }
+
+    int extra     = extraTarget >= 0 ? localOf(cluster, extraTarget) : -1;
+    int remaining = static_cast<int>(cluster.portals.size()) + (extra >= 0 && open[extra] != 2 ? 1 : 0);
+
+    int source     = localOf(cluster, sourceCell);
+    cost[source]   = 0;
+    parent[source] = -1;
+    _buckets[0].push_back(source);
+    int pending = 1;
+
+    // 边代价只有 10 和 14，松弛只会向其他桶追加，可以边遍历边展开（Dial 算法，与 FlowField 相同）
+    for (int frontier = 0; pending > 0 && remaining > 0; frontier++)
+    {
+        std::vector<int>& bucket = _buckets[frontier % 15];
+        for (size_t k = 0; k < bucket.size(); k++)
+        {
+            int current = bucket[k];
+            pending--;
+            if (cost[current] != frontier)
+                continue; // 已被更短的路径更新过
+            if (open[current] == 2 || current == extra)
+                remaining--;
+
+            for (int i = 0; i < 8; i++)
+            {
+                int neighbor = current + offsets[i];
+                if (!open[neighbor])
+                    continue;
+
+                // 防止“穿墙角”
+                if (i >= 4 && (!open[current + kDx[i]] || !open[current + kDy[i] * cluster.stride]))
+                    continue;
+
+                int newCost = frontier + kCosts[i];
+                if (newCost < cost[neighbor])
+                {
+                    cost[neighbor]   = newCost;
+                    parent[neighbor] = current;
+                    _buckets[newCost % 15].push_back(neighbor);
+                    pending++;
+                }
+            }
+        }
+        bucket.clear();
+    }
+
+    for (auto& bucket : _buckets)
+    {
+        bucket.clear();
+    }
+}
+
+void HierarchicalPathFinder::walkTree(const Cluster& cluster, const int* parent, int fromCell,
+                                      std::vector<int>& cells) const
+{
+    int local = localOf(cluster, fromCell);
+    while ((local = parent[local]) != -1)
+    {
+        cells.push_back(cellOf(cluster, local));
+    }
+}
+
+// ==================== 查询 ====================
+
+std::vector<SimVec2> HierarchicalPathFinder::findPath(const SimGrid& grid, const SimVec2& startWorldUnit,
+                                                      const SimVec2& endWorldTarget, const SimRect& goalArea)
+{
+    std::vector<SimVec2> path;
+
+    SimCell startGrid = grid.getGridPosition(startWorldUnit);
+    SimCell endGrid   = grid.getGridPosition(endWorldTarget);
+    if (!grid.isValid(startGrid.x, startGrid.y) || !grid.isValid(endGrid.x, endGrid.y))
+    {
+        return path;
+    }
+
+    if (!isSyncedWith(grid) || _width != grid.getGridWidth() || _height != grid.getGridHeight())
+    {
+        build(grid);
+    }
+
+    int            startCell      = startGrid.y * _width + startGrid.x;
+    int            endCell        = endGrid.y * _width + endGrid.x;
+    int            startClusterId = clusterOf(startGrid.x, startGrid.y);
+    int            endClusterId   = clusterOf(endGrid.x, endGrid.y);
+    const Cluster& startCluster   = _clusters[startClusterId];
+    const Cluster& endCluster     = _clusters[endClusterId];
+
+    // 起点、终点分别在所在簇内做一次 Dijkstra，得到接入抽象图的临时边
+    _startCost.resize(startCluster.paddedCount());
+    _startTree.resize(startCluster.paddedCount());
+    _goalCost.resize(endCluster.paddedCount());
+    _goalTree.resize(endCluster.paddedCount());
+    searchCluster(startCluster, startCell, startClusterId == endClusterId ? endCell : -1, goalArea,
+                  _startCost.data(), _startTree.data());
+    searchCluster(endCluster, endCell, -1, goalArea, _goalCost.data(), _goalTree.data());
+
+    // 抽象节点编号：各簇入口节点依次排列，最后是起点和终点
+    int clusterCount = static_cast<int>(_clusters.size());
+    _nodeOffset.resize(clusterCount);
+    _nodeCluster.clear();
+    for (int i = 0; i < clusterCount; i++)
+    {
+        _nodeOffset[i] = static_cast<int>(_nodeCluster.size());
+        _nodeCluster.insert(_nodeCluster.end(), _clusters[i].portals.size(), i);
+    }
+    int startNode = static_cast<int>(_nodeCluster.size());
+    int goalNode  = startNode + 1;
+
+    auto nodeCell = [&](int node) {
+        if (node == startNode)
+            return startCell;
+        if (node == goalNode)
+            return endCell;
+        int cluster = _nodeCluster[node];
+        return _clusters[cluster].portals[node - _nodeOffset[cluster]];
+    };
+    auto heuristic = [&](int node) {
+        int cell = nodeCell(node);
+        return PathFinder::getDistance(cell % _width, cell / _width, endGrid.x, endGrid.y);
+    };
+
+    _nodeG.assign(goalNode + 1, kUnreachable);
+    _nodeParent.assign(goalNode + 1, -1);
+    _nodeClosed.assign(goalNode + 1, 0);
+
+    _heap.clear();
+    auto relax = [&](int from, int to, int edgeCost) {
+        if (edgeCost == kUnreachable || _nodeClosed[to])
+            return;
+        int newCost = _nodeG[from] + edgeCost;
+        if (newCost < _nodeG[to])
+        {
+            _nodeG[to]      = newCost;
+            _nodeParent[to] = from;
+            _heap.push_back(packEntry(newCost + heuristic(to), to));
+            std::push_heap(_heap.begin(), _heap.end(), std::greater<uint64_t>());
+        }
+    };
+
+    _nodeG[startNode] = 0;
+    _heap.push_back(packEntry(heuristic(startNode), startNode));
+
+    bool pathFound = false;
+    while (!_heap.empty())
+    {
+        std::pop_heap(_heap.begin(), _heap.end(), std::greater<uint64_t>());
+        int current = static_cast<int>(_heap.back() & 0xffffffffu);
+        _heap.pop_back();
+
+        if (_nodeClosed[current])
+            continue;
+        _nodeClosed[current] = 1;
+        if (current == goalNode)
+        {
+            pathFound = true;
+            break;
+        }
+
+        if (current == startNode)
+        {
+            int portalCount = static_cast<int>(startCluster.portals.size());
+            for (int i = 0; i < portalCount; i++)
+            {
+                int cell = startCluster.portals[i];
+                relax(current, _nodeOffset[startClusterId] + i, _startCost[localOf(startCluster, cell)]);
+            }
+            if (startClusterId == endClusterId)
+                relax(current, goalNode, _startCost[localOf(startCluster, endCell)]);
+            continue;
+        }
+
+        int            clusterId   = _nodeCluster[current];
+        const Cluster& cluster     = _clusters[clusterId];
+        int            portal      = current - _nodeOffset[clusterId];
+        int            portalCount = static_cast<int>(cluster.portals.size());
+        for (int j = 0; j < portalCount; j++)
+        {
+            if (j != portal)
+                relax(current, _nodeOffset[clusterId] + j, cluster.costs[portal * portalCount + j]);
+        }
+        for (const Link& link : cluster.links)
+        {
+            if (link.portal != portal)
+                continue;
+            int acrossCluster = clusterOf(link.acrossCell % _width, link.acrossCell / _width);
+            relax(current, _nodeOffset[acrossCluster] + _portalAt[link.acrossCell], 10);
+        }
+        if (clusterId == endClusterId)
+            relax(current, goalNode, _goalCost[localOf(endCluster, cluster.portals[portal])]);
+    }
+
+    if (!pathFound)
+        return path;
+
+    // 把抽象路径逐跳展开成格子路径：簇内的一跳沿对应的最短路径树回溯（得到逆序，再翻转），
+    // 簇间的一跳就是边界对面的格子，进入终点的一跳沿终点的最短路径树回溯（已是正序）
+    _cells.clear();
+    _cells.push_back(startCell);
+
+    auto appendReversed = [&](const Cluster& cluster, const int* tree, int toCell) {
+        size_t mark = _cells.size();
+        _cells.push_back(toCell);
+        walkTree(cluster, tree, toCell, _cells);
+        _cells.pop_back(); // 树根即上一跳的终点，已在路径中
+        std::reverse(_cells.begin() + mark, _cells.end());
+    };
+
+    _nodePath.clear();
+    for (int node = goalNode; node != -1; node = _nodeParent[node])
+    {
+        _nodePath.push_back(node);
+    }
+    std::reverse(_nodePath.begin(), _nodePath.end());
+
+    for (size_t i = 0; i + 1 < _nodePath.size(); i++)
+    {
+        int from = _nodePath[i];
+        int to   = _nodePath[i + 1];
+        if (from == startNode)
+        {
+            appendReversed(startCluster, _startTree.data(), nodeCell(to));
+        }
+        else if (to == goalNode)
+        {
+            walkTree(endCluster, _goalTree.data(), nodeCell(from), _cells);
+        }
+        else if (_nodeCluster[from] == _nodeCluster[to])
+        {
+            const Cluster& cluster = _clusters[_nodeCluster[from]];
+            int            portal  = from - _nodeOffset[_nodeCluster[from]];
+            appendReversed(cluster, &cluster.trees[portal * cluster.paddedCount()], nodeCell(to));
+        }
+        else
+        {
+            _cells.push_back(nodeCell(to));
+        }
+    }
+
+    _rawPath.clear();
+    _rawPath.push_back(startWorldUnit);
+    for (int cell : _cells)
+    {
+        _rawPath.push_back(grid.getPositionFromGrid(cell % _width, cell / _width));
+    }
+
+    path = PathFinder::getInstance().smoothPath(grid, _rawPath, false, goalArea);
+    return path;
+}
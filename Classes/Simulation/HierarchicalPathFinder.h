@@ -0,0 +1,168 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     HierarchicalPathFinder.h
+ * File Function: 分层寻路（HPA*）- 簇划分、入口图与建筑摧毁后的局部修复
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef HIERARCHICAL_PATH_FINDER_H_
+#define HIERARCHICAL_PATH_FINDER_H_
+
+#include "SimGrid.h"
+#include "SimTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class HierarchicalPathFinder
+ * @brief 在 SimGrid 上维护簇-入口抽象图的分层寻路器
+ *
+ * 网格被切成 kClusterSize x kClusterSize 的簇。相邻两簇之间边界上连续可通行的
+ * 一段称为入口，入口中点（较长时取两端）在两侧各放一个入口节点，两节点之间
+ * 是代价 10 的簇间边。同一簇内的入口节点两两之间用限制在簇内的 Dijkstra
+ * 求出代价，同时保留最短路径树，细化路径时只需沿父指针回溯。簇内搜索读取
+ * 簇自己的通行状态快照，所有入口节点都确定后即提前结束。
+ *
+ * 查询时把起点和终点临时接入各自所在簇的入口节点，在抽象图上做 A*，
+ * 再把每一跳展开成格子路径，最后交给 PathFinder 做路径平滑。
+ * 通行规则与 PathFinder 相同：goalArea 内的格子可通行，斜走时两侧直线格子
+ * 都必须可通行。簇边界上的斜向穿越不计入入口，因此结果可能略长于最优路径。
+ *
+ * 建筑或城墙被摧毁后由 onAreaChanged() 只重建受影响的簇（以及入口随之变化的
+ * 相邻簇）。抽象图记录同步时的碰撞地图版本号，版本号不一致时查询会先整体重建。
+ */
+class HierarchicalPathFinder
+{
+public:
+    static constexpr int kClusterSize = 11; ///< 簇边长（格），44x44 的地图划分为 4x4 个簇
+
+    /** @brief 丢弃抽象图（下一次查询时整体构建） */
+    void clear() { _built = false; }
+
+    /** @brief 按当前碰撞地图整体构建抽象图 */
+    void build(const SimGrid& grid);
+
+    /**
+     * @brief 碰撞地图的一块区域刚被 markArea 修改，局部修复抽象图
+     * @param grid 修改后的模拟网格
+     * @param area 被修改的区域
+     */
+    void onAreaChanged(const SimGrid& grid, const SimRect& area);
+
+    /** @brief 抽象图是否与碰撞地图的当前版本同步 */
+    bool isSyncedWith(const SimGrid& grid) const { return _built && _version == grid.getVersion(); }
+
+    /**
+     * @brief 分层寻路
+     * @param grid 模拟网格
+     * @param startWorldUnit 起点坐标
+     * @param endWorldTarget 终点坐标
+     * @param goalArea 目标建筑占地（其中的格子视为可通行）
+     * @return std::vector<SimVec2> 平滑后的路径点列表（抽象图上不可达时为空）
+     */
+    std::vector<SimVec2> findPath(const SimGrid& grid, const SimVec2& startWorldUnit, const SimVec2& endWorldTarget,
+                                  const SimRect& goalArea = SimRect());
+
+    /** @brief 累计重建的簇数（整体构建计入全部簇） */
+    int getClusterBuildCount() const { return _clusterBuildCount; }
+
+private:
+    /** @brief 入口节点与相邻簇入口节点之间的连接 */
+    struct Link
+    {
+        int portal     = 0; ///< 本簇入口节点序号
+        int acrossCell = 0; ///< 边界另一侧的格子（y * width + x）
+    };
+
+    /** @brief 入口：边界两侧各一个格子 */
+    struct Entrance
+    {
+        int inside  = 0; ///< 本簇一侧的格子
+        int outside = 0; ///< 相邻簇一侧的格子
+
+        bool operator==(const Entrance& other) const { return inside == other.inside && outside == other.outside; }
+    };
+
+    struct Cluster
+    {
+        int x      = 0; ///< 左下角格子 x
+        int y      = 0; ///< 左下角格子 y
+        int width  = 0; ///< 宽度（地图边缘的簇可能不足 kClusterSize）
+        int height = 0; ///< 高度
+        int stride = 0; ///< 含边框的行宽（width + 2）
+
+        std::vector<Entrance> eastEntrances;  ///< 与右侧簇之间的入口
+        std::vector<Entrance> northEntrances; ///< 与上方簇之间的入口（y 增大的方向）
+        std::vector<int>      portals;        ///< 入口节点所在格子
+        std::vector<Link>     links;          ///< 簇间边
+        std::vector<uint8_t>  open;           ///< 通行状态快照（0 阻挡，1 可通行，2 入口节点；四周一圈边框为 0）
+        std::vector<int>      costs;          ///< 入口节点两两之间的代价（portals² 个）
+        std::vector<int>      trees;          ///< 每个入口节点的簇内最短路径树（portals x paddedCount() 个父指针）
+
+        int paddedCount() const { return stride * (height + 2); }
+    };
+
+    int clusterOf(int x, int y) const { return (y / kClusterSize) * _clustersX + x / kClusterSize; }
+
+    /** @brief 格子（y * width + x）-> 簇内含边框的下标 */
+    int localOf(const Cluster& cluster, int cell) const
+    {
+        return (cell / _width - cluster.y + 1) * cluster.stride + cell % _width - cluster.x + 1;
+    }
+
+    /** @brief 簇内含边框的下标 -> 格子 */
+    int cellOf(const Cluster& cluster, int local) const
+    {
+        return (cluster.y + local / cluster.stride - 1) * _width + cluster.x + local % cluster.stride - 1;
+    }
+
+
+    bool scanEntrances(const SimGrid& grid, int cluster, bool east);
+    void rebuildPortals(int cluster);
+    void rebuildEdges(const SimGrid& grid, int cluster);
+
+    /**
+     * @brief 限制在簇内的 Dijkstra（桶队列），簇内所有入口节点和 extraTarget 都确定后结束
+     * @param extraTarget 额外需要确定代价的格子（-1 表示没有）
+     * @param goalArea 视为可通行的目标占地
+     * @param cost 输出代价（按 localOf 下标，只有已确定的格子可靠）
+     * @param parent 输出最短路径树（按 localOf 下标，源点为 -1）
+     */
+    void searchCluster(const Cluster& cluster, int sourceCell, int extraTarget, const SimRect& goalArea, int* cost,
+                       int* parent);
+
+    /** @brief 沿最短路径树从 fromCell 回溯到树根，依次追加经过的格子（不含 fromCell） */
+    void walkTree(const Cluster& cluster, const int* parent, int fromCell, std::vector<int>& cells) const;
+
+    int      _width             = 0;
+    int      _height            = 0;
+    int      _clustersX         = 0;
+    int      _clustersY         = 0;
+    uint32_t _version           = 0;     ///< 抽象图对应的碰撞地图版本号
+    bool     _built             = false; ///< 是否已构建
+    int      _clusterBuildCount = 0;     ///< 累计重建的簇数
+
+    std::vector<Cluster> _clusters;
+    std::vector<int>     _portalAt; ///< 格子 -> 所在簇内的入口节点序号（-1 表示不是入口节点）
+
+    // 查询用的临时缓冲（跨查询复用）
+    std::vector<uint64_t> _heap;         ///< 抽象 A* 的开放列表（f << 32 | 节点）
+    std::vector<int>      _buckets[15];  ///< 簇内 Dijkstra 的环形桶队列（边代价只有 10 和 14）
+    std::vector<uint8_t>  _open;         ///< 叠加目标占地后的通行状态
+    std::vector<int>      _startCost;    ///< 起点所在簇内各格子的代价
+    std::vector<int>      _startTree;    ///< 起点所在簇内的最短路径树
+    std::vector<int>      _goalCost;     ///< 终点所在簇内各格子的代价
+    std::vector<int>      _goalTree;     ///< 终点所在簇内的最短路径树
+    std::vector<int>      _nodeOffset;   ///< 每个簇第一个入口节点在抽象图中的编号
+    std::vector<int>      _nodeCluster;  ///< 抽象节点 -> 所在簇
+    std::vector<int>      _nodeG;        ///< 抽象 A* 的 g 值
+    std::vector<int>      _nodeParent;   ///< 抽象 A* 的父节点
+    std::vector<uint8_t>  _nodeClosed;   ///< 抽象 A* 的关闭标记
+    std::vector<int>      _nodePath;     ///< 抽象路径（起点 -> 终点）
+    std::vector<int>      _cells;        ///< 细化后的格子路径
+    std::vector<SimVec2>  _rawPath;      ///< 平滑前的路径点
+};
+
+#endif // HIERARCHICAL_PATH_FINDER_H_
@@ -0,0 +1,157 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     JobSystem.cpp
+ * File Function: 工作窃取的并行任务调度实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "JobSystem.h"
+
+#include <algorithm>
+
+JobSystem::~JobSystem()
+{
+    stopWorkers();
+}
+
+void JobSystem::setWorkerCount(int count)
+{
+    stopWorkers();
+
+    _stopping = false;
+    _queues.clear();
+    for (int i = 0; i <= count; i++)
+    {
+        _queues.emplace_back(new WorkQueue());
+    }
+    for (int i = 1; i <= count; i++)
+    {
+        _workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _batchStarted.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void JobSystem::parallelFor(int count, int grain, const RangeFunction& function)
+{
+    grain = std::max(grain, 1);
+    if (count <= 0)
+        return;
+    if (_workers.empty() || count <= grain)
+    {
+        function(0, count);
+        return;
+    }
+
+    int   chunkCount = (count + grain - 1) / grain;
+    Batch batch;
+    batch.function = &function;
+    batch.count    = count;
+    batch.grain    = grain;
+    batch.remaining.store(chunkCount, std::memory_order_relaxed);
+
+    // 按连续区间分给各线程：不发生窃取时每个线程访问的数据也是连续的
+    int queueCount = static_cast<int>(_queues.size());
+    for (int queue = 0; queue < queueCount; queue++)
+    {
+        int                         begin = chunkCount * queue / queueCount;
+        int                         end   = chunkCount * (queue + 1) / queueCount;
+        std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+        for (int index = begin; index < end; index++)
+        {
+            _queues[queue]->chunks.push_back(Chunk{&batch, index});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _batchId++;
+        _batchCount++;
+    }
+    _batchStarted.notify_all();
+
+    // 调用线程也参与，做完自己的块后窃取；最后等待其他线程手中的块完成
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _batchFinished.wait(lock, [&batch]() { return batch.remaining.load(std::memory_order_acquire) == 0; });
+}
+
+bool JobSystem::takeChunk(int queue, Chunk& chunk)
+{
+    {
+        WorkQueue&                  own = *_queues[queue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty())
+        {
+            chunk = own.chunks.front();
+            own.chunks.pop_front();
+            return true;
+        }
+    }
+
+    // 自己的队列空了：从下一个线程开始依次窃取，取对方队列尾部（离对方正在处理的数据最远）
+    int queueCount = static_cast<int>(_queues.size());
+    for (int i = 1; i < queueCount; i++)
+    {
+        WorkQueue&                  victim = *_queues[(queue + i) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty())
+        {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            _stealCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::runChunks(int queue)
+{
+    Chunk chunk;
+    while (takeChunk(queue, chunk))
+    {
+        Batch& batch = *chunk.batch;
+        int    begin = chunk.index * batch.grain;
+        int    end   = std::min(begin + batch.grain, batch.count);
+        (*batch.function)(begin, end);
+
+        // 减到 0 之后 batch 随时可能被调用线程释放，不能再访问
+        if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _batchFinished.notify_all();
+        }
+    }
+}
+
+void JobSystem::workerLoop(int queue)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _batchStarted.wait(lock, [this, seen]() { return _stopping || _batchId != seen; });
+            if (_stopping)
+                return;
+            seen = _batchId;
+        }
+
+        runChunks(queue);
+    }
+}
@@ -0,0 +1,106 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     JobSystem.h
+ * File Function: 工作窃取的并行任务调度 - 步进中的数据并行阶段按块分发给工作线程
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef JOB_SYSTEM_H_
+#define JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief 小型工作窃取调度器，只提供阻塞式的 parallelFor
+ *
+ * parallelFor 把 [0, count) 切成 grain 大小的块，按连续区间预先分给调用线程和每个
+ * 工作线程各自的队列；线程从自己队列的头部依次取块，做完后从其他队列的尾部窃取，
+ * 直到所有块完成才返回。块的划分只取决于 count 和 grain，与线程数无关。
+ *
+ * 调度器不保证块的执行顺序，调用方必须保证每个下标只写入自己的数据
+ * （按 ID 划分的数组），这样结果与串行执行逐位相同。
+ * 0 个工作线程或数据量不超过一块时直接在调用线程上执行。
+ */
+class JobSystem
+{
+public:
+    /** @brief 处理下标区间 [begin, end) */
+    using RangeFunction = std::function<void(int begin, int end)>;
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /** @brief 设置工作线程数（0 表示全部在调用线程上执行） */
+    void setWorkerCount(int count);
+
+    int getWorkerCount() const { return static_cast<int>(_workers.size()); }
+
+    /**
+     * @brief 并行处理 [0, count)，返回时所有块都已完成
+     * @param count 下标总数
+     * @param grain 每块的下标数
+     * @param function 处理一块的函数（不同块可能在不同线程上同时执行）
+     */
+    void parallelFor(int count, int grain, const RangeFunction& function);
+
+    /** @brief 累计分发到工作线程的批次数（性能统计用） */
+    int64_t getBatchCount() const { return _batchCount; }
+
+    /** @brief 累计从其他线程队列窃取的块数（性能统计用） */
+    int64_t getStealCount() const { return _stealCount.load(std::memory_order_relaxed); }
+
+private:
+    /** @brief 一次 parallelFor 调用（在调用线程的栈上，所有块完成前有效） */
+    struct Batch
+    {
+        const RangeFunction* function = nullptr;
+        int                  count    = 0;
+        int                  grain    = 1;
+        std::atomic<int>     remaining{0}; ///< 未完成的块数
+    };
+
+    /** @brief 队列中的一块 */
+    struct Chunk
+    {
+        Batch* batch = nullptr;
+        int    index = 0; ///< 块序号
+    };
+
+    /** @brief 每个线程自己的块队列（自己从头部取，其他线程从尾部窃取） */
+    struct WorkQueue
+    {
+        std::mutex        mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    bool takeChunk(int queue, Chunk& chunk);
+    void runChunks(int queue);
+    void workerLoop(int queue);
+    void stopWorkers();
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues;  ///< 0 号属于调用线程，i 号属于第 i 个工作线程
+    std::vector<std::thread>                _workers; ///< 工作线程
+    std::mutex                              _mutex;
+    std::condition_variable                 _batchStarted;  ///< 有新批次或需要退出
+    std::condition_variable                 _batchFinished; ///< 某个批次的最后一块完成
+    uint64_t                                _batchId  = 0;  ///< 最近一次分发的批次序号（受 _mutex 保护）
+    bool                                    _stopping = false;
+
+    int64_t              _batchCount = 0; ///< 累计分发的批次数
+    std::atomic<int64_t> _stealCount{0};  ///< 累计窃取的块数
+};
+
+#endif // JOB_SYSTEM_H_
@@ -0,0 +1,563 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     PathFinder.cpp
+ * File Function: A*寻路算法实现（扁平节点数组 + 索引二叉堆）
+ * Author:        刘相成、赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "PathFinder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// 8方向：上下左右 + 对角线，直线10，斜线14
+const int kDx[]    = {0, 1, 0, -1, 1, 1, -1, -1};
+const int kDy[]    = {1, 0, -1, 0, 1, -1, 1, -1};
+const int kCosts[] = {10, 10, 10, 10, 14, 14, 14, 14};
+} // namespace
+
+// ==================== PathSearchContext ====================
+
+void PathSearchContext::prepare(int width, int height)
+{
+    int nodeCount = width * height;
+    if (width != _width || height != _height)
+    {
+        _width  = width;
+        _height = height;
+        _stamp.assign(nodeCount, 0);
+        _gCost.resize(nodeCount);
+        _hCost.resize(nodeCount);
+        _parent.resize(nodeCount);
+        _heapIndex.resize(nodeCount);
+        _heap.reserve(nodeCount);
+        _passable.clear();
+        _generation = 0;
+    }
+
+    // 代号回绕时旧的 stamp 可能与新代号相同，必须真正清空一次
+    if (++_generation == 0)
+    {
+        std::fill(_stamp.begin(), _stamp.end(), 0);
+        _generation = 1;
+    }
+    _heap.clear();
+}
+
+void PathSearchContext::refreshPassable(const SimGrid& grid)
+{
+    if (_passableVersion == grid.getVersion() && !_passable.empty())
+        return;
+
+    // 边框格子保持 0（不可通行），跳跃时越界检查与阻挡检查合并为一次数组读取
+    int stride = _width + 2;
+    _passable.assign(stride * (_height + 2), 0);
+    for (int y = 0; y < _height; y++)
+    {
+        grid.getCollisionMap().unpackPassable(y, 0, _width, &_passable[(y + 1) * stride + 1]);
+    }
+    _passableVersion = grid.getVersion();
+}
+
+void PathSearchContext::visit(int node, int gCost, int hCost, int parent)
+{
+    _stamp[node]     = _generation;
+    _gCost[node]     = gCost;
+    _hCost[node]     = hCost;
+    _parent[node]    = parent;
+    _heapIndex[node] = -1;
+}
+
+bool PathSearchContext::heapLess(int a, int b) const
+{
+    // f 相同时优先 h 更小（更接近终点）的节点，减少无效扩展
+    int fa = _gCost[a] + _hCost[a];
+    int fb = _gCost[b] + _hCost[b];
+    if (fa != fb)
+        return fa < fb;
+    return _hCost[a] < _hCost[b];
+}
+
+void PathSearchContext::siftUp(int pos)
+{
+    int node = _heap[pos];
+    while (pos > 0)
+    {
+        int parentPos = (pos - 1) / 2;
+        int parent    = _heap[parentPos];
+        if (!heapLess(node, parent))
+            break;
+        _heap[pos]         = parent;
+        _heapIndex[parent] = pos;
+        pos                = parentPos;
+    }
+    _heap[pos]       = node;
+    _heapIndex[node] = pos;
+}
+
+void PathSearchContext::siftDown(int pos)
+{
+    int size = static_cast<int>(_heap.size());
+    int node = _heap[pos];
+    while (true)
+    {
+        int child = pos * 2 + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && heapLess(_heap[child + 1], _heap[child]))
+            ++child;
+        if (!heapLess(_heap[child], node))
+            break;
+        _heap[pos]               = _heap[child];
+        _heapIndex[_heap[child]] = pos;
+        pos                      = child;
+    }
+    _heap[pos]       = node;
+    _heapIndex[node] = pos;
+}
+
+void PathSearchContext::heapPush(int node)
+{
+    _heap.push_back(node);
+    siftUp(static_cast<int>(_heap.size()) - 1);
+}
+
+int PathSearchContext::heapPop()
+{
+    int top  = _heap.front();
+    int last = _heap.back();
+    _heap.pop_back();
+    if (!_heap.empty())
+    {
+        _heap[0] = last;
+        siftDown(0);
+    }
+    _heapIndex[top] = -2;
+    return top;
+}
+
+void PathSearchContext::heapDecrease(int node)
+{
+    siftUp(_heapIndex[node]);
+}
+
+// ==================== PathFinder ====================
+
+PathFinder& PathFinder::getInstance()
+{
+    static PathFinder instance;
+    return instance;
+}
+
+int PathFinder::getDistance(int ax, int ay, int bx, int by)
+{
+    int dstX = std::abs(ax - bx);
+    int dstY = std::abs(ay - by);
+
+    // 对角线移动优化：min(dx, dy) 步走斜线(14)，剩余走直线(10)
+    if (dstX > dstY)
+        return 14 * dstY + 10 * (dstX - dstY);
+    return 14 * dstX + 10 * (dstY - dstX);
+}
+
+bool PathFinder::isPassable(const SimGrid& grid, int x, int y, bool ignoreWalls, const SimRect& goalArea)
+{
+    if (!grid.isValid(x, y))
+        return false;
+    if (ignoreWalls || goalArea.contains(x, y))
+        return true;
+    return !grid.isBlocked(x, y);
+}
+
+// 视线检测：精确遍历线段经过的所有格子（Amanatides-Woo DDA，超覆盖）
+bool PathFinder::hasLineOfSight(const SimGrid& grid, const SimVec2& start, const SimVec2& end, bool ignoreWalls,
+                                const SimRect& goalArea)
+{
+    if (ignoreWalls)
+        return true; // 炸弹人无视阻挡
+
+    // 连续网格坐标平移半格后，格子 (i, j) 恰好覆盖 [i, i + 1) x [j, j + 1)，全部用定点原始值做整数运算
+    SimVec2 from = grid.toGridSpace(start);
+    SimVec2 to   = grid.toGridSpace(end);
+    int64_t x0   = from.x.raw() + Fixed::kOne / 2;
+    int64_t y0   = from.y.raw() + Fixed::kOne / 2;
+    int64_t x1   = to.x.raw() + Fixed::kOne / 2;
+    int64_t y1   = to.y.raw() + Fixed::kOne / 2;
+
+    int cx = static_cast<int>(x0 >> Fixed::kFractionBits);
+    int cy = static_cast<int>(y0 >> Fixed::kFractionBits);
+    int ex = static_cast<int>(x1 >> Fixed::kFractionBits);
+    int ey = static_cast<int>(y1 >> Fixed::kFractionBits);
+
+    int     stepX = (x1 > x0) - (x1 < x0);
+    int     stepY = (y1 > y0) - (y1 < y0);
+    int64_t spanX = x1 > x0 ? x1 - x0 : x0 - x1;
+    int64_t spanY = y1 > y0 ? y1 - y0 : y0 - y1;
+
+    // 沿各轴到下一条格线的距离；比较 nextX / spanX 与 nextY / spanY 即可知道先穿过哪条格线
+    int64_t nextX = stepX > 0 ? (static_cast<int64_t>(cx + 1) << Fixed::kFractionBits) - x0
+                              : x0 - (static_cast<int64_t>(cx) << Fixed::kFractionBits);
+    int64_t nextY = stepY > 0 ? (static_cast<int64_t>(cy + 1) << Fixed::kFractionBits) - y0
+                              : y0 - (static_cast<int64_t>(cy) << Fixed::kFractionBits);
+
+    // 与 getGridPosition 相同，地图外的点按最近的边缘格子处理
+    auto isBlockedAt = [&](int x, int y) {
+        x = std::max(0, std::min(grid.getGridWidth() - 1, x));
+        y = std::max(0, std::min(grid.getGridHeight() - 1, y));
+        return !isPassable(grid, x, y, false, goalArea);
+    };
+
+    // 起点格和终点格是路径点本身，不参与检查；每一步至少向终点格靠近一格，步数有上限
+    for (int guard = std::abs(ex - cx) + std::abs(ey - cy); guard > 0 && (cx != ex || cy != ey); guard--)
+    {
+        int64_t crossX = stepX != 0 ? nextX * spanY : INT64_MAX;
+        int64_t crossY = stepY != 0 ? nextY * spanX : INT64_MAX;
+        if (crossX < crossY)
+        {
+            cx += stepX;
+            nextX += Fixed::kOne;
+        }
+        else if (crossY < crossX)
+        {
+            cy += stepY;
+            nextY += Fixed::kOne;
+        }
+        else
+        {
+            // 恰好穿过格点：两侧的格子都算经过（与防穿墙角规则一致）
+            if (isBlockedAt(cx + stepX, cy) || isBlockedAt(cx, cy + stepY))
+                return false;
+            cx += stepX;
+            cy += stepY;
+            nextX += Fixed::kOne;
+            nextY += Fixed::kOne;
+        }
+
+        if ((cx != ex || cy != ey) && isBlockedAt(cx, cy))
+            return false;
+    }
+    return true;
+}
+
+// 路径平滑：拉直路径，视线检测次数与路径点数成线性关系
+std::vector<SimVec2> PathFinder::smoothPath(const SimGrid& grid, const std::vector<SimVec2>& rawPath, bool ignoreWalls,
+                                            const SimRect& goalArea)
+{
+    if (rawPath.size() <= 2)
+        return rawPath;
+
+    std::vector<SimVec2> smoothedPath;
+    smoothedPath.push_back(rawPath[0]); // 起点肯定要
+
+    // 拐点：格子路径上方向改变的点。相邻两个拐点之间是一段直线或对角线上的连续格子，
+    // 沿它走总是合法的。rawPath[0] 是单位真实位置，rawPath[1] 起才是格子中心
+    int  last     = static_cast<int>(rawPath.size()) - 1;
+    auto isCorner = [&](int i) {
+        if (i <= 1 || i >= last)
+            return true;
+        SimVec2 in  = rawPath[i] - rawPath[i - 1];
+        SimVec2 out = rawPath[i + 1] - rawPath[i];
+        return in.x != out.x || in.y != out.y;
+    };
+
+    // 从锚点出发依次尝试后续拐点：能直达就继续向前，直达不了时在上一段直线中
+    // 二分出能直达的最远格子作为新锚点（新锚点与下一个拐点在同一段直线上）
+    int anchor  = 0;
+    int reached = 0; // 已确认可以从锚点直达（或沿直线到达）的最后一个点
+    for (int i = 1; i <= last; i++)
+    {
+        if (!isCorner(i))
+            continue;
+
+        if (reached == anchor || hasLineOfSight(grid, rawPath[anchor], rawPath[i], ignoreWalls, goalArea))
+        {
+            reached = i;
+            continue;
+        }
+
+        int visible = reached;
+        int hidden  = i;
+        while (hidden - visible > 1)
+        {
+            int mid = (visible + hidden) / 2;
+            if (hasLineOfSight(grid, rawPath[anchor], rawPath[mid], ignoreWalls, goalArea))
+                visible = mid;
+            else
+                hidden = mid;
+        }
+
+        smoothedPath.push_back(rawPath[visible]);
+        anchor  = visible;
+        reached = i;
+    }
+
+    if (anchor != last)
+        smoothedPath.push_back(rawPath[last]);
+
+    return smoothedPath;
+}
+
+bool PathFinder::searchAStar(const SimGrid& grid, PathSearchContext& context, const SimCell& startGrid,
+                             const SimCell& endGrid, bool ignoreWalls, const SimRect& goalArea)
+{
+    int width     = grid.getGridWidth();
+    int startNode = startGrid.y * width + startGrid.x;
+    int endNode   = endGrid.y * width + endGrid.x;
+    context.visit(startNode, 0, getDistance(startGrid.x, startGrid.y, endGrid.x, endGrid.y), -1);
+    context.heapPush(startNode);
+
+    while (!context._heap.empty())
+    {
+        int currentNode = context.heapPop();
+        if (currentNode == endNode)
+            return true;
+
+        int cx = currentNode % width;
+        int cy = currentNode / width;
+
+        for (int i = 0; i < 8; i++)
+        {
+            int nx = cx + kDx[i];
+            int ny = cy + kDy[i];
+            if (!grid.isValid(nx, ny))
+                continue;
+
+            int  neighbor = ny * width + nx;
+            bool visited  = context.isVisited(neighbor);
+            if (visited && context._heapIndex[neighbor] == -2)
+                continue;
+
+            // 碰撞检测：终点格与目标建筑占地可以进入
+            if (neighbor != endNode && !isPassable(grid, nx, ny, ignoreWalls, goalArea))
+                continue;
+
+            // 对角线移动时的额外检查：防止“穿墙角”
+            // 斜走时两个相邻的直线格子必须都可通行
+            if (i >= 4)
+            {
+                if (!isPassable(grid, nx, cy, ignoreWalls, goalArea) ||
+                    !isPassable(grid, cx, ny, ignoreWalls, goalArea))
+                {
+                    continue;
+                }
+            }
+
+            int newCost = context._gCost[currentNode] + kCosts[i];
+            if (!visited)
+            {
+                context.visit(neighbor, newCost, getDistance(nx, ny, endGrid.x, endGrid.y), currentNode);
+                context.heapPush(neighbor);
+            }
+            else if (newCost < context._gCost[neighbor])
+            {
+                context._gCost[neighbor]  = newCost;
+                context._parent[neighbor] = currentNode;
+                context.heapDecrease(neighbor);
+            }
+        }
+    }
+
+    return false;
+}
+
+int PathFinder::jump(const PathSearchContext& context, int x, int y, int dx, int dy, const SimCell& endGrid,
+                     const SimRect& goalArea)
+{
+    auto walkable = [&](int cx, int cy) { return isOpen(context, cx, cy, goalArea); };
+
+    while (true)
+    {
+        int nx = x + dx;
+        int ny = y + dy;
+        if (!walkable(nx, ny))
+            return -1;
+
+        // 与逐格 A* 相同的防穿墙角规则
+        if (dx != 0 && dy != 0 && (!walkable(nx, y) || !walkable(x, ny)))
+            return -1;
+
+        x = nx;
+        y = ny;
+        if (x == endGrid.x && y == endGrid.y)
+            return y * context._width + x;
+
+        if (dx != 0 && dy != 0)
+        {
+            // 斜向：任一直线分量能跳到跳点，当前格就是跳点
+            if (jump(context, x, y, dx, 0, endGrid, goalArea) >= 0 ||
+                jump(context, x, y, 0, dy, endGrid, goalArea) >= 0)
+            {
+                return y * context._width + x;
+            }
+        }
+        else if (dx != 0)
+        {
+            // 水平：侧面的格子可走而它身后的格子被挡时，侧面格子只能经由当前格以最短代价到达（强迫邻居）
+            if ((walkable(x, y - 1) && !walkable(x - dx, y - 1)) || (walkable(x, y + 1) && !walkable(x - dx, y + 1)))
+                return y * context._width + x;
+        }
+        else
+        {
+            if ((walkable(x - 1, y) && !walkable(x - 1, y - dy)) || (walkable(x + 1, y) && !walkable(x + 1, y - dy)))
+                return y * context._width + x;
+        }
+    }
+}
+
+bool PathFinder::searchJumpPoint(const SimGrid& grid, PathSearchContext& context, const SimCell& startGrid,
+                                 const SimCell& endGrid, const SimRect& goalArea)
+{
+    context.refreshPassable(grid);
+
+    int width     = grid.getGridWidth();
+    int startNode = startGrid.y * width + startGrid.x;
+    int endNode   = endGrid.y * width + endGrid.x;
+    context.visit(startNode, 0, getDistance(startGrid.x, startGrid.y, endGrid.x, endGrid.y), -1);
+    context.heapPush(startNode);
+
+    while (!context._heap.empty())
+    {
+        int currentNode = context.heapPop();
+        if (currentNode == endNode)
+            return true;
+
+        int cx = currentNode % width;
+        int cy = currentNode / width;
+
+        // 剪枝：起点展开全部 8 个方向，其余跳点只展开自然邻居和可能的强迫邻居方向
+        int dirX[8];
+        int dirY[8];
+        int dirCount = 0;
+        int parent   = context._parent[currentNode];
+        if (parent < 0)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                dirX[dirCount]   = kDx[i];
+                dirY[dirCount++] = kDy[i];
+            }
+        }
+        else
+        {
+            int px = parent % width;
+            int py = parent / width;
+            int dx = (cx > px) - (cx < px);
+            int dy = (cy > py) - (cy < py);
+            if (dx != 0 && dy != 0)
+            {
+                const int dirs[3][2] = {{dx, 0}, {0, dy}, {dx, dy}};
+                for (const auto& dir : dirs)
+                {
+                    dirX[dirCount]   = dir[0];
+                    dirY[dirCount++] = dir[1];
+                }
+            }
+            else
+            {
+                // 直线方向：前进、两个前斜方向、两个侧向（侧向只在强迫邻居存在时才可能更优，由 jump 判定通行）
+                int sx = dy != 0 ? 1 : 0;
+                int sy = dx != 0 ? 1 : 0;
+                const int dirs[5][2] = {{dx, dy}, {dx + sx, dy + sy}, {dx - sx, dy - sy}, {sx, sy}, {-sx, -sy}};
+                for (const auto& dir : dirs)
+                {
+                    dirX[dirCount]   = dir[0];
+                    dirY[dirCount++] = dir[1];
+                }
+            }
+        }
+
+        for (int i = 0; i < dirCount; i++)
+        {
+            int neighbor = jump(context, cx, cy, dirX[i], dirY[i], endGrid, goalArea);
+            if (neighbor < 0)
+                continue;
+
+            bool visited = context.isVisited(neighbor);
+            if (visited && context._heapIndex[neighbor] == -2)
+                continue;
+
+            // 跳点之间是纯直线或纯对角线，8方向距离就是实际代价
+            int nx      = neighbor % width;
+            int ny      = neighbor / width;
+            int newCost = context._gCost[currentNode] + getDistance(cx, cy, nx, ny);
+            if (!visited)
+            {
+                context.visit(neighbor, newCost, getDistance(nx, ny, endGrid.x, endGrid.y), currentNode);
+                context.heapPush(neighbor);
+            }
+            else if (newCost < context._gCost[neighbor])
+            {
+                context._gCost[neighbor]  = newCost;
+                context._parent[neighbor] = currentNode;
+                context.heapDecrease(neighbor);
+            }
+        }
+    }
+
+    return false;
+}
+
+std::vector<SimVec2> PathFinder::findPath(const SimGrid& grid, PathSearchContext& context,
+                                          const SimVec2& startWorldUnit, const SimVec2& endWorldTarget,
+                                          bool ignoreWalls, const SimRect& goalArea, PathSearchMode mode)
+{
+    std::vector<SimVec2> path;
+
+    SimCell startGrid = grid.getGridPosition(startWorldUnit);
+    SimCell endGrid   = grid.getGridPosition(endWorldTarget);
+
+    int width  = grid.getGridWidth();
+    int height = grid.getGridHeight();
+
+    if (!grid.isValid(startGrid.x, startGrid.y) || !grid.isValid(endGrid.x, endGrid.y))
+    {
+        return path;
+    }
+
+    context.prepare(width, height);
+
+    // 逐格 A* 允许进入被阻挡的终点格，跳点搜索只在可通行的格子上跳跃，这种情况交给逐格 A*；
+    // 忽略城墙时整张地图都是开阔地，逐格 A* 本身就几乎不走冤枉路
+    bool pathFound = false;
+    if (mode == PathSearchMode::kJumpPoint && !ignoreWalls && isPassable(grid, endGrid.x, endGrid.y, false, goalArea))
+        pathFound = searchJumpPoint(grid, context, startGrid, endGrid, goalArea);
+    else
+        pathFound = searchAStar(grid, context, startGrid, endGrid, ignoreWalls, goalArea);
+
+    if (pathFound)
+    {
+        // 回溯得到逆序格子路径，末尾补上单位真正的起点后整体翻转。
+        // 跳点搜索的父节点是上一个跳点，两者之间按直线或对角线补齐中间格子。
+        // 如果单位在地图外，格子路径的第一个点是边界点，
+        // smoothPath 需要检查 "startWorldUnit" 到后续各点的连线
+        std::vector<SimVec2>& rawPath = context._rawPath;
+        rawPath.clear();
+        for (int node = endGrid.y * width + endGrid.x; node != -1; node = context._parent[node])
+        {
+            int x = node % width;
+            int y = node / width;
+            rawPath.push_back(grid.getPositionFromGrid(x, y));
+
+            int parent = context._parent[node];
+            if (parent < 0)
+                continue;
+
+            int px = parent % width;
+            int py = parent / width;
+            int dx = (px > x) - (px < x);
+            int dy = (py > y) - (py < y);
+            for (x += dx, y += dy; x != px || y != py; x += dx, y += dy)
+            {
+                rawPath.push_back(grid.getPositionFromGrid(x, y));
+            }
+        }
+        rawPath.push_back(startWorldUnit);
+        std::reverse(rawPath.begin(), rawPath.end());
+
+        path = smoothPath(grid, rawPath, ignoreWalls, goalArea);
+    }
+
+    return path;
+}
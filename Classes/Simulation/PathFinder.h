@@ -0,0 +1,160 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     PathFinder.h
+ * File Function: A*寻路算法实现（逐格 A* 与跳点搜索）
+ * Author:        刘相成、赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+#ifndef __PATH_FINDER_H__
+#define __PATH_FINDER_H__
+
+#include "SimGrid.h"
+#include "SimTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum PathSearchMode
+ * @brief 网格搜索方式
+ */
+enum class PathSearchMode
+{
+    kAStar,    ///< 逐格 8 方向 A*
+    kJumpPoint ///< 跳点搜索（JPS）：只把跳点放入开放列表，路径代价与 kAStar 相同
+};
+
+/**
+ * @class PathSearchContext
+ * @brief 可复用的 A* 搜索上下文
+ *
+ * 节点数据按 y * width + x 存放在扁平数组中，只在网格尺寸变化时重新分配。
+ * 每次搜索递增 generation，节点的 stamp 不等于当前 generation 即视为未访问，
+ * 因此无需在每次搜索前清空数组。开放列表是带位置索引的二叉堆，支持 decrease-key。
+ *
+ * 每个上下文同一时间只能服务一次搜索；并行寻路时每个线程各持有一个。
+ * 跳点搜索使用的通行状态快照按碰撞地图版本号缓存，因此一个上下文只应服务于同一个网格。
+ */
+class PathSearchContext
+{
+public:
+    /** @brief 为指定尺寸的网格准备一次新的搜索 */
+    void prepare(int width, int height);
+
+    /** @brief 按碰撞地图当前版本刷新通行状态快照（跳点搜索使用，版本未变时直接返回） */
+    void refreshPassable(const SimGrid& grid);
+
+private:
+    friend class PathFinder;
+
+    bool isVisited(int node) const { return _stamp[node] == _generation; }
+    void visit(int node, int gCost, int hCost, int parent);
+
+    void heapPush(int node);
+    int  heapPop();
+    void heapDecrease(int node);
+    bool heapLess(int a, int b) const;
+    void siftUp(int pos);
+    void siftDown(int pos);
+
+    int      _width      = 0;
+    int      _height     = 0;
+    uint32_t _generation = 0;
+
+    std::vector<uint32_t> _stamp;     ///< 节点最近一次被访问的搜索代号
+    std::vector<int>      _gCost;     ///< 起点到节点的代价
+    std::vector<int>      _hCost;     ///< 节点到终点的估算代价
+    std::vector<int>      _parent;    ///< 父节点下标（-1 表示无）
+    std::vector<int>      _heapIndex; ///< 节点在堆中的位置（-1 表示不在堆中，-2 表示已关闭）
+    std::vector<int>      _heap;      ///< 开放列表（存节点下标）
+    std::vector<SimVec2>  _rawPath;   ///< 路径回溯缓冲
+    std::vector<uint8_t>  _passable;  ///< 通行状态快照（四周各留一圈 0 作为边框）
+    uint32_t              _passableVersion = 0; ///< 快照对应的碰撞地图版本号
+};
+
+/**
+ * @class PathFinder
+ * @brief A*寻路器（单例，无状态）
+ *
+ * 工作在 SimGrid 上，不依赖引擎。goalArea 内的格子视为可通行，
+ * 用于寻路到被建筑占据的目标点。搜索过程中的所有临时数据都放在
+ * 调用方提供的 PathSearchContext 中，搜索本身不分配内存。
+ *
+ * 开阔地带上逐格 A* 会把大量等价的邻格放进开放列表。kJumpPoint 模式沿直线和
+ * 对角线“跳跃”，只在遇到强迫邻居（障碍物拐角）或终点时停下，开放列表里只有
+ * 这些跳点。剪枝规则按“斜走时两侧直线格子都必须可通行”推导，因此与逐格 A*
+ * 遵守同一条防穿墙角规则，找到的路径代价相同（走法可能不同）。
+ */
+class PathFinder
+{
+public:
+    /**
+     * @brief 获取单例实例
+     * @return PathFinder& 单例引用
+     */
+    static PathFinder& getInstance();
+
+    /**
+     * @brief 核心A*寻路函数
+     * @param grid 模拟网格
+     * @param context 搜索上下文（可跨多次调用复用）
+     * @param startWorldUnit 起点坐标
+     * @param endWorldTarget 终点坐标
+     * @param ignoreWalls 是否忽略城墙
+     * @param goalArea 目标建筑占地（其中的格子视为可通行）
+     * @param mode 搜索方式
+     * @return std::vector<SimVec2> 路径点列表（找不到路径时为空）
+     */
+    std::vector<SimVec2> findPath(const SimGrid& grid, PathSearchContext& context, const SimVec2& startWorldUnit,
+                                  const SimVec2& endWorldTarget, bool ignoreWalls = false,
+                                  const SimRect& goalArea = SimRect(), PathSearchMode mode = PathSearchMode::kAStar);
+
+    /**
+     * @brief 路径平滑（HierarchicalPathFinder 细化出的格子路径也经由这里平滑）
+     */
+    std::vector<SimVec2> smoothPath(const SimGrid& grid, const std::vector<SimVec2>& rawPath, bool ignoreWalls,
+                                    const SimRect& goalArea);
+
+    /** @brief 8方向估算距离（直线 10，斜线 14） */
+    static int getDistance(int ax, int ay, int bx, int by);
+
+private:
+    /** @brief 格子是否可通行（目标区域内的格子总是可通行） */
+    bool isPassable(const SimGrid& grid, int x, int y, bool ignoreWalls, const SimRect& goalArea);
+
+    /** @brief 逐格 A*，找到终点时返回 true（父指针留在 context 中） */
+    bool searchAStar(const SimGrid& grid, PathSearchContext& context, const SimCell& startGrid,
+                     const SimCell& endGrid, bool ignoreWalls, const SimRect& goalArea);
+
+    /** @brief 跳点搜索，找到终点时返回 true（父指针指向上一个跳点） */
+    bool searchJumpPoint(const SimGrid& grid, PathSearchContext& context, const SimCell& startGrid,
+                         const SimCell& endGrid, const SimRect& goalArea);
+
+    /** @brief 跳点搜索的通行检查：读取快照，目标区域内的格子总是可通行 */
+    static bool isOpen(const PathSearchContext& context, int x, int y, const SimRect& goalArea)
+    {
+        return context._passable[(y + 1) * (context._width + 2) + x + 1] != 0 || goalArea.contains(x, y);
+    }
+
+    /**
+     * @brief 从 (x, y) 沿 (dx, dy) 方向跳跃
+     * @return 找到的跳点下标（y * width + x），遇到阻挡或地图边缘时返回 -1
+     */
+    int jump(const PathSearchContext& context, int x, int y, int dx, int dy, const SimCell& endGrid,
+             const SimRect& goalArea);
+
+    /**
+     * @brief 检查两点之间是否有视线
+     */
+    bool hasLineOfSight(const SimGrid& grid, const SimVec2& start, const SimVec2& end, bool ignoreWalls,
+                        const SimRect& goalArea);
+
+    PathFinder() = default;
+    ~PathFinder() = default;
+    PathFinder(const PathFinder&) = delete;
+    PathFinder& operator=(const PathFinder&) = delete;
+};
+
+#endif // __PATH_FINDER_H__
\ No newline at end of file
@@ -0,0 +1,220 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     PathService.cpp
+ * File Function: 异步寻路服务实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "PathService.h"
+
+namespace
+{
+/** @brief 起点与终点的格子距离（8方向代价）超过该值时改用分层寻路，更近时直接 A* */
+constexpr int kHierarchicalMinDistance = HierarchicalPathFinder::kClusterSize * 10;
+} // namespace
+
+constexpr unsigned int PathService::kLatencyFrames;
+
+PathService::~PathService()
+{
+    stopWorkers();
+}
+
+void PathService::setWorkerCount(int count)
+{
+    stopWorkers();
+
+    _stopping = false;
+    for (int i = 0; i < count; i++)
+    {
+        _workers.emplace_back(&PathService::workerLoop, this);
+    }
+}
+
+void PathService::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _jobQueued.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+
+    // 工作线程退出时可能留下未开始的请求，由取结果的一方自己求解
+}
+
+void PathService::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.clear();
+    }
+    // 正在求解的请求由工作线程持有引用，完成后自然释放
+    _pending.clear();
+    _snapshot.reset();
+}
+
+void PathService::submit(const SimGrid& grid, const HierarchicalPathFinder& hierarchy, PathSearchMode mode,
+                         const Request& request, unsigned int applyFrame)
+{
+    if (!_snapshot || _snapshot->grid.getVersion() != grid.getVersion())
+    {
+        auto snapshot       = std::make_shared<Snapshot>();
+        snapshot->grid      = grid;
+        snapshot->hierarchy = hierarchy;
+        _snapshot           = snapshot;
+    }
+
+    auto job        = std::make_shared<Job>();
+    job->request    = request;
+    job->mode       = mode;
+    job->applyFrame = applyFrame;
+    job->version    = _snapshot->grid.getVersion();
+    job->snapshot   = _snapshot;
+    _pending.push_back(job);
+    _submittedCount++;
+
+    if (_workers.empty())
+    {
+        solve(_localSolver, *job);
+        job->started = true;
+        job->done    = true;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_back(job);
+    }
+    _jobQueued.notify_one();
+}
+
+bool PathService::takeReady(unsigned int frame, Result& result)
+{
+    if (_pending.empty() || _pending.front()->applyFrame > frame)
+        return false;
+
+    std::shared_ptr<Job> job = _pending.front();
+    _pending.pop_front();
+    if (finish(*job))
+        _stallCount++;
+
+    result.request = job->request;
+    result.version = job->version;
+    result.path    = std::move(job->path);
+    return true;
+}
+
+bool PathService::finish(Job& job)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (job.done)
+        return false;
+
+    if (!job.started)
+    {
+        // 队列先进先出，更早的请求都已完成，尚未开始的这一个一定在队首：直接接手，不空等
+        _queue.pop_front();
+        job.started = true;
+        lock.unlock();
+        solve(_localSolver, job);
+        lock.lock();
+        job.done = true;
+    }
+    else
+    {
+        _jobFinished.wait(lock, [&job]() { return job.done; });
+    }
+    return true;
+}
+
+void PathService::collectPending(std::vector<PendingResult>& out)
+{
+    out.clear();
+    for (const auto& job : _pending)
+    {
+        finish(*job);
+
+        PendingResult pending;
+        pending.result.request = job->request;
+        pending.result.version = job->version;
+        pending.result.path    = job->path;
+        pending.applyFrame     = job->applyFrame;
+        out.push_back(std::move(pending));
+    }
+}
+
+void PathService::restorePending(const std::vector<PendingResult>& pending)
+{
+    clear();
+    for (const auto& entry : pending)
+    {
+        auto job        = std::make_shared<Job>();
+        job->request    = entry.result.request;
+        job->applyFrame = entry.applyFrame;
+        job->version    = entry.result.version;
+        job->path       = entry.result.path;
+        job->started    = true;
+        job->done       = true;
+        _pending.push_back(job);
+    }
+}
+
+void PathService::workerLoop()
+{
+    Solver solver;
+    for (;;)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobQueued.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+            if (_stopping)
+                return;
+
+            job = _queue.front();
+            _queue.pop_front();
+            job->started = true;
+        }
+
+        solve(solver, *job);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            job->done = true;
+        }
+        _jobFinished.notify_all();
+    }
+}
+
+void PathService::solve(Solver& solver, Job& job)
+{
+    // 切换到新快照时复制抽象图；搜索上下文的通行状态缓存按版本号区分，一并重建
+    if (solver.snapshot != job.snapshot)
+    {
+        solver.snapshot  = job.snapshot;
+        solver.hierarchy = job.snapshot->hierarchy;
+        solver.context   = PathSearchContext();
+    }
+
+    const SimGrid& grid = job.snapshot->grid;
+    const Request& req  = job.request;
+    SimCell        from = grid.getGridPosition(req.from);
+    SimCell        to   = grid.getGridPosition(req.to);
+
+    // 远距离查询先走簇-入口抽象图，抽象图上不可达（如只能斜穿簇边界）时退回逐格 A*
+    if (PathFinder::getDistance(from.x, from.y, to.x, to.y) > kHierarchicalMinDistance)
+    {
+        job.path = solver.hierarchy.findPath(grid, req.from, req.to, req.goalArea);
+        if (!job.path.empty())
+            return;
+    }
+
+    job.path = PathFinder::getInstance().findPath(grid, solver.context, req.from, req.to, false, req.goalArea,
+                                                  job.mode);
+}
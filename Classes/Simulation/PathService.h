@@ -0,0 +1,168 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     PathService.h
+ * File Function: 异步寻路服务 - 工作线程在碰撞地图快照上求解，固定帧数后按提交顺序交回结果
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef PATH_SERVICE_H_
+#define PATH_SERVICE_H_
+
+#include "HierarchicalPathFinder.h"
+#include "PathFinder.h"
+#include "SimGrid.h"
+#include "SimTypes.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class PathService
+ * @brief 单位寻路请求的异步求解服务
+ *
+ * 模拟在步进中提交请求，每个请求的应用帧固定为提交帧 + kLatencyFrames。
+ * 请求连同提交时的网格与分层寻路抽象图快照一起交给工作线程，模拟在应用帧
+ * 按提交顺序取回结果；工作线程尚未完成时，取结果的一方直接接手或等待。
+ *
+ * 求解只读取快照，结果与工作线程数量和调度顺序无关：0 个工作线程（提交时
+ * 直接求解）与任意多个工作线程得到逐位相同的模拟结果，回放与 PvP 双端一致。
+ * 同一网格版本的请求共享一份快照，只有建筑或城墙被摧毁后才会复制新快照。
+ */
+class PathService
+{
+public:
+    static constexpr unsigned int kLatencyFrames = 2; ///< 提交后第几帧应用结果（模拟规则的一部分）
+
+    /** @brief 寻路请求 */
+    struct Request
+    {
+        int     unit   = -1; ///< 单位 ID
+        int     target = -1; ///< 目标建筑 ID
+        SimVec2 from;        ///< 起点（单位提交时的位置）
+        SimVec2 to;          ///< 终点（目标建筑位置）
+        SimRect goalArea;    ///< 目标建筑占地（其中的格子视为可通行）
+    };
+
+    /** @brief 寻路结果 */
+    struct Result
+    {
+        Request              request;     ///< 对应的请求
+        uint32_t             version = 0; ///< 求解所用快照的碰撞地图版本号
+        std::vector<SimVec2> path;        ///< 平滑后的路径点（不可达时为空）
+    };
+
+    /** @brief 尚未交回的结果（模拟关键帧保存/恢复用） */
+    struct PendingResult
+    {
+        Result       result;         ///< 求解结果
+        unsigned int applyFrame = 0; ///< 应用结果的帧
+    };
+
+    PathService() = default;
+    ~PathService();
+
+    PathService(const PathService&)            = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    /**
+     * @brief 设置工作线程数（0 表示在提交时直接求解）
+     * @note 会等待正在求解的请求完成；不影响模拟结果，只影响耗时分布
+     */
+    void setWorkerCount(int count);
+
+    int getWorkerCount() const { return static_cast<int>(_workers.size()); }
+
+    /** @brief 丢弃所有未交回的请求和快照（模拟重置时调用） */
+    void clear();
+
+    /**
+     * @brief 提交请求
+     * @param grid 当前网格
+     * @param hierarchy 与 grid 同步的分层寻路器（网格版本变化后复制进新快照）
+     * @param mode 逐格寻路的搜索方式
+     * @param request 请求
+     * @param applyFrame 应用结果的帧
+     */
+    void submit(const SimGrid& grid, const HierarchicalPathFinder& hierarchy, PathSearchMode mode,
+                const Request& request, unsigned int applyFrame);
+
+    /**
+     * @brief 按提交顺序取出下一个应用帧不晚于 frame 的结果
+     * @return bool 有结果时为 true（结果尚未求解完成时会等待）
+     */
+    bool takeReady(unsigned int frame, Result& result);
+
+    /**
+     * @brief 等待所有未交回的请求求解完成，按提交顺序复制出结果（不取出）
+     *
+     * 模拟保存关键帧时调用：结果只取决于提交时的快照，保存已求解的路径
+     * 与恢复后重新求解得到的结果相同，恢复时不需要保存快照。
+     */
+    void collectPending(std::vector<PendingResult>& out);
+
+    /**
+     * @brief 丢弃所有未交回的请求，换成已求解完成的结果（模拟从关键帧恢复时调用）
+     * @param pending collectPending() 得到的结果（按提交顺序）
+     */
+    void restorePending(const std::vector<PendingResult>& pending);
+
+    /** @brief 累计提交的请求数 */
+    int getSubmittedCount() const { return _submittedCount; }
+
+    /** @brief 取结果时工作线程尚未完成、需要接手或等待的次数（性能统计用） */
+    int getStallCount() const { return _stallCount; }
+
+private:
+    /** @brief 某一网格版本的只读快照 */
+    struct Snapshot
+    {
+        SimGrid                grid;
+        HierarchicalPathFinder hierarchy;
+    };
+
+    /** @brief 每个求解线程私有的可变状态 */
+    struct Solver
+    {
+        std::shared_ptr<const Snapshot> snapshot;  ///< 当前 hierarchy 副本来自的快照
+        HierarchicalPathFinder          hierarchy; ///< 快照抽象图的私有副本（查询会写入临时缓冲）
+        PathSearchContext               context;   ///< A* 搜索上下文
+    };
+
+    struct Job
+    {
+        Request                         request;
+        PathSearchMode                  mode       = PathSearchMode::kAStar;
+        unsigned int                    applyFrame = 0;
+        uint32_t                        version    = 0;     ///< 快照的碰撞地图版本号
+        std::shared_ptr<const Snapshot> snapshot;           ///< 求解所用快照（从关键帧恢复的结果为空）
+        std::vector<SimVec2>            path;
+        bool                            started    = false; ///< 已被某个线程取走（受 _mutex 保护）
+        bool                            done       = false; ///< 已求解完成（受 _mutex 保护）
+    };
+
+    static void solve(Solver& solver, Job& job);
+    bool        finish(Job& job);
+    void        workerLoop();
+    void        stopWorkers();
+
+    std::shared_ptr<const Snapshot>  _snapshot;     ///< 最近一次提交使用的快照（网格版本不变时复用）
+    Solver                           _localSolver;  ///< 提交/取结果的线程自己求解时使用
+    std::deque<std::shared_ptr<Job>> _pending;      ///< 未交回的请求（按提交顺序，只由模拟线程访问）
+    std::deque<std::shared_ptr<Job>> _queue;        ///< 等待工作线程的请求（受 _mutex 保护）
+    std::vector<std::thread>         _workers;      ///< 工作线程
+    std::mutex                       _mutex;
+    std::condition_variable          _jobQueued;    ///< 有新请求或需要退出
+    std::condition_variable          _jobFinished;  ///< 有请求求解完成
+    bool                             _stopping = false;
+
+    int _submittedCount = 0; ///< 累计提交数
+    int _stallCount     = 0; ///< 取结果时尚未完成的次数
+};
+
+#endif // PATH_SERVICE_H_
@@ -0,0 +1,155 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimEntities.h
+ * File Function: 战斗模拟实体（单位、建筑、投射物）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef SIM_ENTITIES_H_
+#define SIM_ENTITIES_H_
+
+#include "Buildings/BuildingTypes.h"
+#include "SimTypes.h"
+#include "Unit/CombatStats.h"
+#include "Unit/UnitTypes.h"
+
+#include <vector>
+
+/**
+ * @struct SimStats
+ * @brief 定点化的战斗属性
+ *
+ * 由配置表中的 CombatStats 在进入模拟时转换一次，之后所有结算都不再使用浮点数。
+ */
+struct SimStats
+{
+    int   maxHitpoints = 100; ///< 最大生命值
+    int   hitpoints    = 100; ///< 当前生命值
+    Fixed damage;             ///< 每次攻击伤害
+    Fixed attackSpeed;        ///< 攻击间隔（秒）
+    Fixed attackRange;        ///< 攻击范围（像素）
+    Fixed splashRadius;       ///< 溅射半径（像素，0 表示只伤害目标）
+    int   armor = 0;          ///< 护甲
+
+    static SimStats fromCombatStats(const CombatStats& stats)
+    {
+        SimStats result;
+        result.maxHitpoints = stats.maxHitpoints;
+        result.hitpoints    = stats.currentHitpoints;
+        result.damage       = Fixed::fromFloat(stats.damage);
+        result.attackSpeed  = Fixed::fromFloat(stats.attackSpeed);
+        result.attackRange  = Fixed::fromFloat(stats.attackRange);
+        result.splashRadius = Fixed::fromFloat(stats.splashRadius);
+        result.armor        = stats.armor;
+        return result;
+    }
+
+    /**
+     * @brief 受到伤害（规则与 CombatStats::takeDamage 相同：扣除护甲、至少 1 点、四舍五入）
+     */
+    void takeDamage(Fixed dmg)
+    {
+        Fixed actualDamage = dmg - Fixed::fromInt(armor);
+        if (actualDamage < Fixed::fromInt(1))
+            actualDamage = Fixed::fromInt(1);
+
+        hitpoints -= actualDamage.roundToInt();
+        if (hitpoints < 0)
+            hitpoints = 0;
+    }
+};
+
+/**
+ * @struct SimUnit
+ * @brief 模拟中的进攻单位
+ *
+ * ID 即在 BattleSimulation 单位数组中的下标，死亡后保留，不会复用。
+ * 每步都要更新的位置、路段终点和移动状态按 ID 存放在 SimUnitMotion 中，
+ * 这里只保留转向判断、寻路和战斗用的状态。
+ */
+struct SimUnit
+{
+    int         id    = -1;                    ///< 单位 ID
+    UnitType    type  = UnitType::kBarbarian;  ///< 单位类型
+    int         level = 1;                     ///< 单位等级
+    SimStats    stats;                         ///< 战斗属性（含当前生命值）
+    Fixed       moveSpeed;                     ///< 移动速度（像素/秒）
+
+    SimVec2              velocity;             ///< 移动速度向量（起步/转向判断用）
+    std::vector<SimVec2> path;                 ///< 路径点
+    int                  pathIndex = 0;        ///< 当前路径索引
+    bool                 followFlow = false;   ///< 是否沿目标流场逐格移动（路径走完后继续采样）
+    bool                 pathPending = false;  ///< 已提交寻路请求，等待 PathService 交回结果
+    uint32_t             pathVersion = 0;      ///< 规划路径时的碰撞地图版本号（不一致说明路径已过期）
+
+    int          target            = -1;                     ///< 目标建筑 ID（-1 表示无）
+    int          targetSlot        = -1;                     ///< 在目标建筑攻击者列表中的下标（-1 表示不在列表中）
+    bool         retarget          = false;                  ///< 目标已被摧毁，轮到该单位时重新选择目标
+    BuildingType preferredBuilding = BuildingType::kUnknown; ///< 优先攻击的建筑类型（kUnknown 表示没有偏好）
+    Fixed        attackCooldown;                             ///< 攻击冷却
+    bool         dead = false;                               ///< 是否死亡
+};
+
+/**
+ * @struct SimBuildingDesc
+ * @brief 向模拟添加建筑时的描述
+ */
+struct SimBuildingDesc
+{
+    BuildingType type        = BuildingType::kUnknown; ///< 建筑类型
+    DefenseType  defenseType = DefenseType::kCannon;   ///< 防御类型（仅 kDefense 有效）
+    SimRect      footprint;                            ///< 占地
+    SimVec2      position;                             ///< 地图层坐标
+    int          maxHitpoints = 100;                   ///< 最大生命值
+    CombatStats  stats;                                ///< 战斗属性（防御建筑使用，进入模拟时定点化）
+};
+
+/**
+ * @struct SimBuilding
+ * @brief 模拟中的防守建筑
+ */
+struct SimBuilding
+{
+    int          id          = -1;                     ///< 建筑 ID
+    BuildingType type        = BuildingType::kUnknown; ///< 建筑类型
+    DefenseType  defenseType = DefenseType::kCannon;   ///< 防御类型
+    SimRect      footprint;                            ///< 占地
+    SimVec2      position;                             ///< 地图层坐标
+    int          maxHitpoints = 100;                   ///< 最大生命值
+    int          hitpoints    = 100;                   ///< 当前生命值
+    SimStats     stats;                                ///< 战斗属性
+
+    int   target = -1;    ///< 目标单位 ID（-1 表示无）
+    Fixed attackCooldown; ///< 攻击冷却
+
+    bool isDefense() const { return type == BuildingType::kDefense; }
+    bool isDestroyed() const { return hitpoints <= 0; }
+};
+
+/**
+ * @struct SimProjectile
+ * @brief 飞行中的防御建筑投射物，飞行时间结束时结算伤害
+ *
+ * 存放在 BattleSimulation 的槽位池中，命中后槽位归还复用。投射物追踪目标：
+ * 命中点是结算时目标的位置，表现层按 progress() 在发射点和目标之间插值。
+ */
+struct SimProjectile
+{
+    int     source = -1;     ///< 发射建筑 ID
+    int     target = -1;     ///< 目标单位 ID
+    Fixed   damage;          ///< 伤害
+    Fixed   splashRadius;    ///< 溅射半径（0 表示只伤害目标）
+    SimVec2 origin;          ///< 发射位置
+    Fixed   flightTime;      ///< 总飞行时间（秒）
+    Fixed   remaining;       ///< 剩余飞行时间（秒）
+    bool    active = false;  ///< 槽位是否正在使用
+
+    /** @brief 已飞行的比例（0 ~ 1） */
+    Fixed progress() const
+    {
+        return flightTime > Fixed() ? Fixed::fromInt(1) - remaining / flightTime : Fixed::fromInt(1);
+    }
+};
+
+#endif // SIM_ENTITIES_H_
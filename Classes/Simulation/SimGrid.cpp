@@ -0,0 +1,57 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimGrid.cpp
+ * File Function: 战斗模拟网格实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "SimGrid.h"
+
+#include <algorithm>
+
+void SimGrid::init(int width, int height, Fixed tileSize, const SimVec2& startPixel)
+{
+    _gridWidth  = width;
+    _gridHeight = height;
+    _tileSize   = tileSize;
+    _startPixel = startPixel;
+    _collisionMap.resize(width, height);
+}
+
+void SimGrid::markArea(const SimRect& area, bool occupied)
+{
+    _collisionMap.fillRect(area.x, area.y, area.width, area.height, occupied);
+}
+
+SimVec2 SimGrid::toGridSpace(const SimVec2& position) const
+{
+    Fixed halfW = _tileSize / 2;
+    Fixed halfH = halfW * 3 / 4;
+
+    Fixed dx = position.x - _startPixel.x;
+    Fixed dy = _startPixel.y - position.y;
+
+    return SimVec2((dy / halfH + dx / halfW) / 2, (dy / halfH - dx / halfW) / 2);
+}
+
+SimCell SimGrid::getGridPosition(const SimVec2& position) const
+{
+    SimVec2 grid = toGridSpace(position);
+
+    int gridX = grid.x.roundToInt();
+    int gridY = grid.y.roundToInt();
+
+    gridX = std::max(0, std::min(_gridWidth - 1, gridX));
+    gridY = std::max(0, std::min(_gridHeight - 1, gridY));
+
+    return SimCell(gridX, gridY);
+}
+
+SimVec2 SimGrid::getPositionFromGrid(int x, int y) const
+{
+    Fixed halfW = _tileSize / 2;
+    Fixed halfH = halfW * 3 / 4;
+
+    return SimVec2(halfW * (x - y) + _startPixel.x, _startPixel.y - halfH * (x + y));
+}
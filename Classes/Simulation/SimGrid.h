@@ -0,0 +1,103 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimGrid.h
+ * File Function: 战斗模拟使用的等距网格（坐标换算与碰撞地图）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef SIM_GRID_H_
+#define SIM_GRID_H_
+
+#include "CollisionBitmap.h"
+#include "SimTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SimGrid
+ * @brief 不依赖引擎的等距菱形网格
+ *
+ * 坐标换算公式与 GridMap 一致，但直接工作在地图层本地坐标上
+ * （单位和建筑的 position 即为该坐标系），不经过节点变换。
+ * 换算全部使用定点数，保证跨平台结果一致。
+ */
+class SimGrid
+{
+public:
+    /**
+     * @brief 初始化网格
+     * @param width 网格宽度（网格单位）
+     * @param height 网格高度（网格单位）
+     * @param tileSize 单个网格的宽度（像素）
+     * @param startPixel 网格(0,0)对应的地图层坐标
+     */
+    void init(int width, int height, Fixed tileSize, const SimVec2& startPixel);
+
+    int   getGridWidth() const { return _gridWidth; }
+    int   getGridHeight() const { return _gridHeight; }
+    Fixed getTileSize() const { return _tileSize; }
+
+    /** @brief 坐标是否在网格范围内 */
+    bool isValid(int x, int y) const { return x >= 0 && x < _gridWidth && y >= 0 && y < _gridHeight; }
+
+    /**
+     * @brief 检查指定网格是否被阻挡
+     * @return 被阻挡或超出范围返回 true
+     */
+    bool isBlocked(int x, int y) const { return _collisionMap.isBlocked(x, y); }
+
+    /**
+     * @brief 标记指定区域的通行状态
+     * @param area 建筑占地
+     * @param occupied true=不可通行, false=可通行
+     */
+    void markArea(const SimRect& area, bool occupied);
+
+    /**
+     * @brief 碰撞地图版本号
+     *
+     * 每次 init 或 markArea 改变了任意格子的通行状态时递增，
+     * 缓存寻路结果的模块（流场等）据此判断是否需要重建。
+     */
+    uint32_t getVersion() const { return _collisionMap.getVersion(); }
+
+    /** @brief 碰撞位图（按行打包，寻路模块按字扫描构建通行快照） */
+    const CollisionBitmap& getCollisionMap() const { return _collisionMap; }
+
+    /**
+     * @brief 恢复碰撞位图和版本号（关键帧恢复用，网格尺寸必须与保存时相同）
+     * @return bool 数据长度与当前网格不符时返回 false
+     */
+    bool restoreCollisionMap(const std::vector<CollisionBitmap::Word>& words, uint32_t version)
+    {
+        return _collisionMap.restore(words, version);
+    }
+
+    /**
+     * @brief 地图层坐标 -> 网格坐标（限制在有效范围内）
+     */
+    SimCell getGridPosition(const SimVec2& position) const;
+
+    /**
+     * @brief 地图层坐标 -> 连续网格坐标（不取整、不限制范围，格子中心为整数坐标）
+     *
+     * getGridPosition 对它四舍五入后截断到地图内，视线检测据此做精确的格子遍历。
+     */
+    SimVec2 toGridSpace(const SimVec2& position) const;
+
+    /**
+     * @brief 网格坐标 -> 地图层坐标（网格中心点）
+     */
+    SimVec2 getPositionFromGrid(int x, int y) const;
+
+private:
+    CollisionBitmap _collisionMap;   ///< 碰撞地图（置位表示被占用），兼作版本号
+    int             _gridWidth  = 0; ///< 网格宽度
+    int             _gridHeight = 0; ///< 网格高度
+    Fixed           _tileSize;       ///< 网格宽度（像素）
+    SimVec2         _startPixel;     ///< 网格(0,0)对应的坐标
+};
+
+#endif // SIM_GRID_H_
@@ -0,0 +1,159 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimStateBuffer.h
+ * File Function: 模拟状态的紧凑二进制读写 - 关键帧序列化用
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef SIM_STATE_BUFFER_H_
+#define SIM_STATE_BUFFER_H_
+
+#include "SimTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SimStateWriter
+ * @brief 把整数和定点数追加到字节数组
+ *
+ * 整数按 zigzag + 7 位一组的变长编码写入：生命值、ID、布尔量等小数值只占 1~2 字节，
+ * 与平台字节序无关，同一状态在任何平台上得到相同的字节序列。
+ */
+class SimStateWriter
+{
+public:
+    explicit SimStateWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+    void writeUInt(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            _out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        _out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void writeInt(int64_t value)
+    {
+        writeUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void writeBool(bool value) { _out.push_back(value ? 1 : 0); }
+    void writeFixed(Fixed value) { writeInt(value.raw()); }
+
+    void writeVec2(const SimVec2& value)
+    {
+        writeFixed(value.x);
+        writeFixed(value.y);
+    }
+
+    void writeRect(const SimRect& rect)
+    {
+        writeInt(rect.x);
+        writeInt(rect.y);
+        writeInt(rect.width);
+        writeInt(rect.height);
+    }
+
+private:
+    std::vector<uint8_t>& _out;
+};
+
+/**
+ * @class SimStateReader
+ * @brief 按 SimStateWriter 的格式读回
+ *
+ * 数据被截断时后续读取都返回 0 并把 ok() 置为 false，调用方读完后统一检查一次，
+ * 不需要在每次读取后判断。
+ */
+class SimStateReader
+{
+public:
+    explicit SimStateReader(const std::vector<uint8_t>& data) : _data(data.data()), _size(data.size()) {}
+
+    uint64_t readUInt()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (_offset >= _size)
+            {
+                _ok = false;
+                return 0;
+            }
+            uint8_t byte = _data[_offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        _ok = false;
+        return 0;
+    }
+
+    int64_t readInt()
+    {
+        uint64_t value = readUInt();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    bool readBool()
+    {
+        if (_offset >= _size)
+        {
+            _ok = false;
+            return false;
+        }
+        return _data[_offset++] != 0;
+    }
+
+    Fixed readFixed() { return Fixed::fromRaw(static_cast<int32_t>(readInt())); }
+
+    SimVec2 readVec2()
+    {
+        Fixed x = readFixed();
+        Fixed y = readFixed();
+        return SimVec2(x, y);
+    }
+
+    SimRect readRect()
+    {
+        SimRect rect;
+        rect.x      = static_cast<int>(readInt());
+        rect.y      = static_cast<int>(readInt());
+        rect.width  = static_cast<int>(readInt());
+        rect.height = static_cast<int>(readInt());
+        return rect;
+    }
+
+    /**
+     * @brief 读取元素个数，超过剩余字节数时视为数据损坏（每个元素至少占 1 字节）
+     */
+    size_t readCount()
+    {
+        uint64_t count = readUInt();
+        if (count > _size - _offset)
+        {
+            _ok = false;
+            return 0;
+        }
+        return static_cast<size_t>(count);
+    }
+
+    /** @brief 目前为止的读取是否都在数据范围内 */
+    bool ok() const { return _ok; }
+
+    /** @brief 是否恰好读完全部数据 */
+    bool atEnd() const { return _offset == _size; }
+
+private:
+    const uint8_t* _data;
+    size_t         _size;
+    size_t         _offset = 0;
+    bool           _ok     = true;
+};
+
+#endif // SIM_STATE_BUFFER_H_
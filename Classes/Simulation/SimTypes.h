@@ -0,0 +1,124 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimTypes.h
+ * File Function: 战斗模拟核心的基础类型（向量、网格坐标、事件）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef SIM_TYPES_H_
+#define SIM_TYPES_H_
+
+#include "FixedPoint.h"
+
+#include <cstdint>
+
+/**
+ * @struct SimVec2
+ * @brief 模拟使用的二维定点向量（地图层本地坐标，像素）
+ *
+ * 范围判断请使用 isWithin / distanceSquared，只在需要方向或实际距离时才开方。
+ */
+struct SimVec2
+{
+    Fixed x;
+    Fixed y;
+
+    SimVec2() = default;
+    SimVec2(Fixed px, Fixed py) : x(px), y(py) {}
+
+    /** @brief 由浮点坐标构造（仅用于部署、建筑位置等边界输入） */
+    static SimVec2 fromFloat(float px, float py) { return SimVec2(Fixed::fromFloat(px), Fixed::fromFloat(py)); }
+
+    SimVec2 operator+(const SimVec2& o) const { return SimVec2(x + o.x, y + o.y); }
+    SimVec2 operator-(const SimVec2& o) const { return SimVec2(x - o.x, y - o.y); }
+    SimVec2 operator*(Fixed s) const { return SimVec2(x * s, y * s); }
+    bool    operator==(const SimVec2& o) const { return x == o.x && y == o.y; }
+
+    /** @brief 长度平方（32.32 原始值） */
+    int64_t lengthSquared() const { return x.squaredRaw() + y.squaredRaw(); }
+
+    /** @brief 到另一点的距离平方（32.32 原始值） */
+    int64_t distanceSquared(const SimVec2& o) const { return (*this - o).lengthSquared(); }
+
+    /** @brief 到另一点的距离是否不超过 range */
+    bool isWithin(const SimVec2& o, Fixed range) const { return distanceSquared(o) <= range.squaredRaw(); }
+
+    Fixed length() const { return Fixed::sqrtOfSquaredRaw(lengthSquared()); }
+    Fixed distance(const SimVec2& o) const { return (*this - o).length(); }
+
+    /** @brief 单位向量（零向量返回自身） */
+    SimVec2 getNormalized() const
+    {
+        Fixed len = length();
+        if (len <= Fixed())
+            return *this;
+        return SimVec2(x / len, y / len);
+    }
+};
+
+/**
+ * @struct SimCell
+ * @brief 网格坐标
+ */
+struct SimCell
+{
+    int x = 0;
+    int y = 0;
+
+    SimCell() = default;
+    SimCell(int cx, int cy) : x(cx), y(cy) {}
+
+    bool operator==(const SimCell& o) const { return x == o.x && y == o.y; }
+};
+
+/**
+ * @struct SimRect
+ * @brief 网格矩形区域（建筑占地）
+ */
+struct SimRect
+{
+    int x      = 0;
+    int y      = 0;
+    int width  = 0;
+    int height = 0;
+
+    bool contains(int cx, int cy) const
+    {
+        return cx >= x && cx < x + width && cy >= y && cy < y + height;
+    }
+};
+
+/**
+ * @enum SimEventType
+ * @brief 模拟事件类型，表现层据此播放动画和音效
+ */
+enum class SimEventType
+{
+    kUnitMove,          ///< 单位开始沿新方向移动（direction 为移动方向）
+    kUnitIdle,          ///< 单位停止移动
+    kUnitAttack,        ///< 单位发动攻击
+    kUnitDamaged,       ///< 单位受到伤害（value 为剩余生命值）
+    kUnitDied,          ///< 单位死亡
+    kBuildingDamaged,   ///< 建筑受到伤害（value 为剩余生命值）
+    kBuildingDestroyed, ///< 建筑被摧毁
+    kDefenseFire,       ///< 防御建筑开火（value 为投射物槽位，position 为目标位置，duration 为飞行时间）
+    kProjectileHit      ///< 投射物命中（value 为投射物槽位，position 为命中点，unit 为目标）
+};
+
+/**
+ * @struct SimEvent
+ * @brief 一次模拟步中产生的事件
+ */
+struct SimEvent
+{
+    SimEventType type;
+    int          unit     = -1;   ///< 相关单位 ID（-1 表示无）
+    int          building = -1;   ///< 相关建筑 ID（-1 表示无）
+    int          value    = 0;    ///< 附加整数值
+    SimVec2      position;        ///< 附加位置
+    SimVec2      direction;       ///< 附加方向
+    Fixed        duration;        ///< 附加时长（秒）
+};
+
+#endif // SIM_TYPES_H_
@@ -0,0 +1,143 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimUnitMotion.cpp
+ * File Function: 单位运动状态的批量推进
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "SimUnitMotion.h"
+
+#include "SimStateBuffer.h"
+
+#include <cstdlib>
+
+namespace
+{
+/**
+ * @brief 批量前进一步（无分支，只有 32 位运算，编译器可以向量化）
+ *
+ * 到达终点时距离不超过 reach，两个分量也一定不超过 reach：方框外的单位直接前进一步，
+ * 方框内的单位先不动并标记为 kNear，留给调用方精确判断。
+ * 输出数组用 __restrict 标注，避免编译器为别名检查放弃向量化。
+ */
+void advanceKernel(int count, int32_t* __restrict x, int32_t* __restrict y, uint8_t* __restrict result,
+                   const int32_t* stepX, const int32_t* stepY, const int32_t* goalX, const int32_t* goalY,
+                   const int32_t* reach, const uint8_t* moving)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int32_t inBox   = -static_cast<int32_t>((std::abs(x[i] - goalX[i]) <= reach[i]) &
+                                              (std::abs(y[i] - goalY[i]) <= reach[i]));
+        int32_t move    = -static_cast<int32_t>(moving[i]);
+        int32_t advance = move & ~inBox;
+
+        x[i] += stepX[i] & advance;
+        y[i] += stepY[i] & advance;
+        result[i] = static_cast<uint8_t>((move & SimUnitMotion::kMoved) + (move & inBox & SimUnitMotion::kArrived));
+    }
+}
+} // namespace
+
+void SimUnitMotion::clear()
+{
+    _x.clear();
+    _y.clear();
+    _stepX.clear();
+    _stepY.clear();
+    _goalX.clear();
+    _goalY.clear();
+    _reach.clear();
+    _moving.clear();
+    _result.clear();
+}
+
+int SimUnitMotion::add(const SimVec2& position, Fixed stepLength)
+{
+    _x.push_back(position.x.raw());
+    _y.push_back(position.y.raw());
+    _stepX.push_back(0);
+    _stepY.push_back(0);
+    _goalX.push_back(position.x.raw());
+    _goalY.push_back(position.y.raw());
+    _reach.push_back(stepLength.raw());
+    _moving.push_back(0);
+    _result.push_back(kIdle);
+    return size() - 1;
+}
+
+void SimUnitMotion::startSegment(int unit, const SimVec2& target, const SimVec2& displacement)
+{
+    setMoveTarget(unit, target);
+    _stepX[unit]  = displacement.x.raw();
+    _stepY[unit]  = displacement.y.raw();
+    _moving[unit] = 1;
+}
+
+void SimUnitMotion::setMoveTarget(int unit, const SimVec2& target)
+{
+    _goalX[unit] = target.x.raw();
+    _goalY[unit] = target.y.raw();
+}
+
+void SimUnitMotion::saveState(SimStateWriter& writer) const
+{
+    writer.writeUInt(_x.size());
+    for (int i = 0; i < size(); i++)
+    {
+        writer.writeInt(_x[i]);
+        writer.writeInt(_y[i]);
+        writer.writeInt(_stepX[i]);
+        writer.writeInt(_stepY[i]);
+        writer.writeInt(_goalX[i]);
+        writer.writeInt(_goalY[i]);
+        writer.writeInt(_reach[i]);
+        writer.writeBool(_moving[i] != 0);
+    }
+}
+
+bool SimUnitMotion::loadState(SimStateReader& reader)
+{
+    clear();
+    size_t count = reader.readCount();
+    for (size_t i = 0; i < count && reader.ok(); i++)
+    {
+        _x.push_back(static_cast<int32_t>(reader.readInt()));
+        _y.push_back(static_cast<int32_t>(reader.readInt()));
+        _stepX.push_back(static_cast<int32_t>(reader.readInt()));
+        _stepY.push_back(static_cast<int32_t>(reader.readInt()));
+        _goalX.push_back(static_cast<int32_t>(reader.readInt()));
+        _goalY.push_back(static_cast<int32_t>(reader.readInt()));
+        _reach.push_back(static_cast<int32_t>(reader.readInt()));
+        _moving.push_back(reader.readBool() ? 1 : 0);
+        _result.push_back(kIdle);
+    }
+    return reader.ok();
+}
+
+void SimUnitMotion::advance(int begin, int end)
+{
+    advanceKernel(end - begin, _x.data() + begin, _y.data() + begin, _result.data() + begin, _stepX.data() + begin,
+                  _stepY.data() + begin, _goalX.data() + begin, _goalY.data() + begin, _reach.data() + begin,
+                  _moving.data() + begin);
+
+    // 离终点不到一步的单位很少，逐个用 64 位距离精确判断
+    for (int i = begin; i < end; i++)
+    {
+        if (_result[i] != kNear)
+            continue;
+
+        if (getPosition(i).isWithin(getMoveTarget(i), Fixed::fromRaw(_reach[i])))
+        {
+            _x[i]      = _goalX[i];
+            _y[i]      = _goalY[i];
+            _result[i] = kArrived;
+        }
+        else
+        {
+            _x[i] += _stepX[i];
+            _y[i] += _stepY[i];
+            _result[i] = kMoved;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimUnitMotion.h
+ * File Function: 单位运动状态的数组结构（SoA）存储与批量推进
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef SIM_UNIT_MOTION_H_
+#define SIM_UNIT_MOTION_H_
+
+#include "SimTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+class SimStateReader;
+class SimStateWriter;
+
+/**
+ * @class SimUnitMotion
+ * @brief 所有单位每步都要访问的运动状态，按字段分别连续存放
+ *
+ * 下标即单位 ID。坐标、每步位移、路段终点都以 16.16 定点原始值存成 int32 数组，
+ * advance() 先对全部单位执行同一段无分支的 32 位整数运算（编译器可以向量化），
+ * 只有离路段终点不到一步的少数单位再逐个做精确的 64 位距离判断。
+ * 到达路段终点后的处理（取下一个路径点、沿流场采样、停下）分支多且很少发生，
+ * 由 BattleSimulation 根据 getStepResult() 逐个处理。
+ *
+ * 结果与逐个单位调用 SimVec2::isWithin 和 position + velocity * dt 逐位相同。
+ */
+class SimUnitMotion
+{
+public:
+    /** @brief advance() 后每个单位的结果 */
+    enum StepResult : uint8_t
+    {
+        kIdle    = 0, ///< 没有在移动
+        kMoved   = 1, ///< 向路段终点前进了一步
+        kArrived = 2, ///< 到达路段终点（坐标已吸附到终点）
+        kNear    = 3  ///< advance() 内部使用：在终点附近的方框内，需要精确判断
+    };
+
+    /** @brief 移除所有单位 */
+    void clear();
+
+    /**
+     * @brief 加入一个单位
+     * @param position 初始位置
+     * @param stepLength 每步最多移动的距离（移动速度 x 时间步长），距终点不超过它即视为到达
+     * @return 单位下标
+     */
+    int add(const SimVec2& position, Fixed stepLength);
+
+    int size() const { return static_cast<int>(_x.size()); }
+
+    SimVec2 getPosition(int unit) const { return SimVec2(Fixed::fromRaw(_x[unit]), Fixed::fromRaw(_y[unit])); }
+    SimVec2 getMoveTarget(int unit) const { return SimVec2(Fixed::fromRaw(_goalX[unit]), Fixed::fromRaw(_goalY[unit])); }
+    bool    isMoving(int unit) const { return _moving[unit] != 0; }
+
+    /**
+     * @brief 开始一段直线移动
+     * @param target 路段终点
+     * @param displacement 每步位移（速度 x 时间步长）
+     */
+    void startSegment(int unit, const SimVec2& target, const SimVec2& displacement);
+
+    /** @brief 只更新路段终点，不改变移动状态（距离过近无需移动时） */
+    void setMoveTarget(int unit, const SimVec2& target);
+
+    /** @brief 停止移动 */
+    void stop(int unit) { _moving[unit] = 0; }
+
+    /** @brief 所有移动中的单位前进一步，结果写入 getStepResult() */
+    void advance() { advance(0, size()); }
+
+    /**
+     * @brief 下标在 [begin, end) 内的单位前进一步
+     * @note 只读写这些单位自己的数组元素，不相交的区间可以在不同线程上同时推进
+     */
+    void advance(int begin, int end);
+
+    /** @brief 最近一次 advance() 中该单位的结果 */
+    StepResult getStepResult(int unit) const { return static_cast<StepResult>(_result[unit]); }
+
+    /** @brief 写入所有单位的运动状态（关键帧用，不含只在一步之内有效的 StepResult） */
+    void saveState(SimStateWriter& writer) const;
+
+    /**
+     * @brief 用 saveState() 写入的数据替换当前状态
+     * @return bool 数据完整时为 true（失败时状态未定义，调用方应丢弃本对象）
+     */
+    bool loadState(SimStateReader& reader);
+
+private:
+    std::vector<int32_t> _x;      ///< 坐标 x（定点原始值）
+    std::vector<int32_t> _y;      ///< 坐标 y
+    std::vector<int32_t> _stepX;  ///< 每步位移 x
+    std::vector<int32_t> _stepY;  ///< 每步位移 y
+    std::vector<int32_t> _goalX;  ///< 路段终点 x
+    std::vector<int32_t> _goalY;  ///< 路段终点 y
+    std::vector<int32_t> _reach;  ///< 到达判定距离（每步最多移动的距离）
+    std::vector<uint8_t> _moving; ///< 是否正在移动（0/1）
+    std::vector<uint8_t> _result; ///< 最近一步的 StepResult
+};
+
+#endif // SIM_UNIT_MOTION_H_
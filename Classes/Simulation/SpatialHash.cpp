@@ -0,0 +1,304 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SpatialHash.cpp
+ * File Function: 均匀网格空间索引实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "SpatialHash.h"
+
+#include <algorithm>
+
+void SpatialHash::init(const SimVec2& minCorner, const SimVec2& maxCorner, Fixed cellSize)
+{
+    _origin   = minCorner;
+    _cellSize = cellSize > Fixed() ? cellSize : Fixed::fromInt(1);
+    _columns  = std::max(1, (maxCorner.x - minCorner.x).raw() / _cellSize.raw() + 1);
+    _rows     = std::max(1, (maxCorner.y - minCorner.y).raw() / _cellSize.raw() + 1);
+    _cells.assign(_columns * _rows, Cell());
+    _entries.clear();
+}
+
+void SpatialHash::clear()
+{
+    for (auto& cell : _cells)
+    {
+        cell.items.clear();
+        cell.categories = 0;
+    }
+    _entries.clear();
+}
+
+int SpatialHash::columnOf(Fixed x) const
+{
+    int column = (x - _origin.x).raw() / _cellSize.raw();
+    return std::max(0, std::min(_columns - 1, column));
+}
+
+int SpatialHash::rowOf(Fixed y) const
+{
+    int row = (y - _origin.y).raw() / _cellSize.raw();
+    return std::max(0, std::min(_rows - 1, row));
+}
+
+Fixed SpatialHash::edgeGapOf(const SimVec2& center) const
+{
+    Fixed left   = center.x - (_origin.x + _cellSize * columnOf(center.x));
+    Fixed bottom = center.y - (_origin.y + _cellSize * rowOf(center.y));
+    Fixed gap    = std::min(std::min(left, _cellSize - left), std::min(bottom, _cellSize - bottom));
+    return std::max(Fixed(), gap);
+}
+
+void SpatialHash::insert(int id, const SimVec2& position, uint32_t category)
+{
+    if (id < 0)
+        return;
+    if (_cells.empty())
+        _cells.resize(_columns * _rows);
+    if (id >= static_cast<int>(_entries.size()))
+        _entries.resize(id + 1);
+
+    if (_entries[id].cell >= 0)
+        unlink(_entries[id]);
+    link(id, rowOf(position.y) * _columns + columnOf(position.x), position, category);
+}
+
+void SpatialHash::move(int id, const SimVec2& position)
+{
+    if (!contains(id))
+        return;
+
+    Entry& entry     = _entries[id];
+    int    cellIndex = rowOf(position.y) * _columns + columnOf(position.x);
+    if (cellIndex == entry.cell)
+    {
+        _cells[cellIndex].items[entry.slot].position = position;
+        return;
+    }
+
+    uint32_t category = _cells[entry.cell].items[entry.slot].category;
+    unlink(entry);
+    link(id, cellIndex, position, category);
+}
+
+void SpatialHash::remove(int id)
+{
+    if (!contains(id))
+        return;
+    unlink(_entries[id]);
+}
+
+void SpatialHash::link(int id, int cellIndex, const SimVec2& position, uint32_t category)
+{
+    Cell& cell = _cells[cellIndex];
+
+    Item item;
+    item.id       = id;
+    item.category = category;
+    item.position = position;
+
+    _entries[id].cell = cellIndex;
+    _entries[id].slot = static_cast<int>(cell.items.size());
+    cell.items.push_back(item);
+    cell.categories |= category;
+}
+
+void SpatialHash::unlink(Entry& entry)
+{
+    // 与方格内最后一个实体交换后弹出，O(1) 删除
+    Cell& cell             = _cells[entry.cell];
+    int   lastId           = cell.items.back().id;
+    cell.items[entry.slot] = cell.items.back();
+    _entries[lastId].slot  = entry.slot;
+    cell.items.pop_back();
+    entry.cell = -1;
+
+    // 类别并集只能重新计算（方格内实体很少）
+    cell.categories = 0;
+    for (const Item& item : cell.items)
+    {
+        cell.categories |= item.category;
+    }
+}
+
+template <typename Visit, typename Bound>
+void SpatialHash::forEachRing(const SimVec2& center, uint32_t mask, Visit visit, Bound bound) const
+{
+    int centerColumn = columnOf(center.x);
+    int centerRow    = rowOf(center.y);
+    int maxRing      = std::max(std::max(centerColumn, _columns - 1 - centerColumn),
+                                std::max(centerRow, _rows - 1 - centerRow));
+
+    auto visitCell = [&](const Cell& cell) {
+        if (cell.categories & mask)
+            visit(cell);
+    };
+
+    for (int ring = 0; ring <= maxRing && bound(ring); ring++)
+    {
+        int rowBegin = std::max(0, centerRow - ring);
+        int rowEnd   = std::min(_rows - 1, centerRow + ring);
+        for (int row = rowBegin; row <= rowEnd; row++)
+        {
+            const Cell* cells = _cells.data() + row * _columns;
+            if (row == centerRow - ring || row == centerRow + ring)
+            {
+                // 环的上下两条边：整段
+                int columnBegin = std::max(0, centerColumn - ring);
+                int columnEnd   = std::min(_columns - 1, centerColumn + ring);
+                for (int column = columnBegin; column <= columnEnd; column++)
+                {
+                    visitCell(cells[column]);
+                }
+            }
+            else
+            {
+                // 环的左右两条边：各一格
+                if (centerColumn - ring >= 0)
+                    visitCell(cells[centerColumn - ring]);
+                if (centerColumn + ring < _columns)
+                    visitCell(cells[centerColumn + ring]);
+            }
+        }
+    }
+}
+
+int SpatialHash::findNearest(const SimVec2& center, uint32_t mask) const
+{
+    if (_cells.empty())
+        return -1;
+
+    Fixed     edgeGap = edgeGapOf(center);
+    Candidate best;
+    int64_t   visited = 0;
+    forEachRing(
+        center, mask,
+        [&](const Cell& cell) {
+            for (const Item& item : cell.items)
+            {
+                visited++;
+                if ((item.category & mask) == 0)
+                    continue;
+
+                Candidate candidate{center.distanceSquared(item.position), item.id};
+                if (candidate < best)
+                    best = candidate;
+            }
+        },
+        [&](int ring) { return best.id < 0 || ringLowerBound(ring, edgeGap) <= best.distance; });
+
+    countVisited(visited);
+    return best.id;
+}
+
+int SpatialHash::findNearestWithin(const SimVec2& center, Fixed radius, uint32_t mask) const
+{
+    if (_cells.empty() || radius < Fixed())
+        return -1;
+
+    int64_t   radiusSquared = radius.squaredRaw();
+    Candidate best;
+    int64_t   visited = 0;
+
+    int columnBegin = columnOf(center.x - radius);
+    int columnEnd   = columnOf(center.x + radius);
+    int rowBegin    = rowOf(center.y - radius);
+    int rowEnd      = rowOf(center.y + radius);
+    for (int row = rowBegin; row <= rowEnd; row++)
+    {
+        for (int column = columnBegin; column <= columnEnd; column++)
+        {
+            const Cell& cell = _cells[row * _columns + column];
+            if ((cell.categories & mask) == 0)
+                continue;
+
+            for (const Item& item : cell.items)
+            {
+                visited++;
+                if ((item.category & mask) == 0)
+                    continue;
+
+                Candidate candidate{center.distanceSquared(item.position), item.id};
+                if (candidate.distance <= radiusSquared && candidate < best)
+                    best = candidate;
+            }
+        }
+    }
+
+    countVisited(visited);
+    return best.id;
+}
+
+void SpatialHash::findKNearest(const SimVec2& center, uint32_t mask, int k, std::vector<int>& out) const
+{
+    out.clear();
+    if (_cells.empty() || k <= 0)
+        return;
+
+    // 候选按 (距离, ID) 升序保存，最多 k 个；k 通常很小，插入排序即可
+    Fixed                  edgeGap = edgeGapOf(center);
+    std::vector<Candidate> nearest;
+    int64_t                visited = 0;
+    nearest.reserve(k + 1);
+    forEachRing(
+        center, mask,
+        [&](const Cell& cell) {
+            for (const Item& item : cell.items)
+            {
+                visited++;
+                if ((item.category & mask) == 0)
+                    continue;
+
+                Candidate candidate{center.distanceSquared(item.position), item.id};
+                if (static_cast<int>(nearest.size()) == k && !(candidate < nearest.back()))
+                    continue;
+
+                nearest.insert(std::upper_bound(nearest.begin(), nearest.end(), candidate), candidate);
+                if (static_cast<int>(nearest.size()) > k)
+                    nearest.pop_back();
+            }
+        },
+        [&](int ring) {
+            return static_cast<int>(nearest.size()) < k || ringLowerBound(ring, edgeGap) <= nearest.back().distance;
+        });
+
+    for (const Candidate& candidate : nearest)
+    {
+        out.push_back(candidate.id);
+    }
+    countVisited(visited);
+}
+
+void SpatialHash::queryRadius(const SimVec2& center, Fixed radius, uint32_t mask, std::vector<int>& out) const
+{
+    out.clear();
+    if (_cells.empty() || radius < Fixed())
+        return;
+
+    int64_t radiusSquared = radius.squaredRaw();
+    int     columnBegin   = columnOf(center.x - radius);
+    int     columnEnd     = columnOf(center.x + radius);
+    int     rowBegin      = rowOf(center.y - radius);
+    int     rowEnd        = rowOf(center.y + radius);
+    int64_t visited       = 0;
+    for (int row = rowBegin; row <= rowEnd; row++)
+    {
+        for (int column = columnBegin; column <= columnEnd; column++)
+        {
+            const Cell& cell = _cells[row * _columns + column];
+            if ((cell.categories & mask) == 0)
+                continue;
+
+            for (const Item& item : cell.items)
+            {
+                visited++;
+                if ((item.category & mask) != 0 && center.distanceSquared(item.position) <= radiusSquared)
+                    out.push_back(item.id);
+            }
+        }
+    }
+
+    countVisited(visited);
+    std::sort(out.begin(), out.end());
+}
@@ -0,0 +1,167 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SpatialHash.h
+ * File Function: 均匀网格空间索引 - 按类别过滤的半径查询与最近邻查询
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#ifndef SPATIAL_HASH_H_
+#define SPATIAL_HASH_H_
+
+#include "SimTypes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SpatialHash
+ * @brief 把实体按地图层坐标分到等大的方格里，查询只访问目标附近的方格
+ *
+ * 实体用调用方给定的 ID（单位或建筑 ID）标识，附带一个类别位（例如单位类型或
+ * 建筑类型的 1 << n），查询时按类别掩码过滤。单位每步移动后调用 move()，
+ * 只有跨越方格时才在方格之间搬移；建筑被摧毁后 remove()。
+ *
+ * 超出边界的坐标被归入最外圈的方格，最外圈方格相当于向外无限延伸，
+ * 最近邻查询按环逐圈向外扩展时的距离下界对它们同样成立。
+ *
+ * 所有查询在距离相同时取 ID 较小者，结果与按 ID 顺序线性扫描（严格小于才替换）
+ * 完全一致，模拟的确定性不受方格内存放顺序影响。
+ *
+ * 查询不修改索引（访问计数是原子的），没有 insert/move/remove 同时进行时
+ * 可以在多个线程上并发查询。
+ */
+class SpatialHash
+{
+public:
+    /**
+     * @brief 设置覆盖范围与方格尺寸（清空所有实体）
+     * @param minCorner 覆盖范围的最小坐标
+     * @param maxCorner 覆盖范围的最大坐标
+     * @param cellSize 方格边长（像素）
+     */
+    void init(const SimVec2& minCorner, const SimVec2& maxCorner, Fixed cellSize);
+
+    /** @brief 移除所有实体（保留方格划分与内存） */
+    void clear();
+
+    /** @brief 加入实体（ID 已存在时先移除） */
+    void insert(int id, const SimVec2& position, uint32_t category);
+
+    /** @brief 更新实体位置（只有跨越方格时才搬移） */
+    void move(int id, const SimVec2& position);
+
+    /** @brief 移除实体（不存在时忽略） */
+    void remove(int id);
+
+    /** @brief 实体是否在索引中 */
+    bool contains(int id) const
+    {
+        return id >= 0 && id < static_cast<int>(_entries.size()) && _entries[id].cell >= 0;
+    }
+
+    /**
+     * @brief 最近的实体
+     * @param center 查询点
+     * @param mask 类别掩码（与实体类别按位与非零才参与）
+     * @return 实体 ID，没有符合条件的实体时返回 -1
+     */
+    int findNearest(const SimVec2& center, uint32_t mask) const;
+
+    /**
+     * @brief 半径内最近的实体（距离不超过 radius）
+     * @return 实体 ID，没有时返回 -1
+     */
+    int findNearestWithin(const SimVec2& center, Fixed radius, uint32_t mask) const;
+
+    /**
+     * @brief 最近的 k 个实体，按距离（相同时按 ID）从近到远写入 out
+     */
+    void findKNearest(const SimVec2& center, uint32_t mask, int k, std::vector<int>& out) const;
+
+    /**
+     * @brief 半径内的所有实体，按 ID 升序写入 out
+     */
+    void queryRadius(const SimVec2& center, Fixed radius, uint32_t mask, std::vector<int>& out) const;
+
+    /** @brief 累计检查过的实体数（性能统计用） */
+    int64_t getVisitedCount() const { return _visitedCount.load(std::memory_order_relaxed); }
+
+private:
+    /** @brief 方格内的实体（坐标和类别与 ID 放在一起，查询时顺序读取） */
+    struct Item
+    {
+        int      id       = -1; ///< 实体 ID
+        uint32_t category = 0;  ///< 类别位
+        SimVec2  position;      ///< 坐标
+    };
+
+    /** @brief 方格 */
+    struct Cell
+    {
+        std::vector<Item> items;          ///< 方格内的实体
+        uint32_t          categories = 0; ///< 方格内实体类别的并集（查询据此整格跳过）
+    };
+
+    /** @brief 实体 ID -> 所在位置 */
+    struct Entry
+    {
+        int cell = -1; ///< 所在方格（-1 表示不在索引中）
+        int slot = 0;  ///< 在方格列表中的下标
+    };
+
+    /** @brief 候选结果（距离平方、ID），按字典序比较 */
+    struct Candidate
+    {
+        int64_t distance = INT64_MAX; ///< 到查询点的距离平方
+        int     id       = -1;        ///< 实体 ID
+
+        bool operator<(const Candidate& other) const
+        {
+            return distance < other.distance || (distance == other.distance && id < other.id);
+        }
+    };
+
+    /** @brief 坐标 -> 列号 / 行号（超出范围时截断到最外圈） */
+    int columnOf(Fixed x) const;
+    int rowOf(Fixed y) const;
+
+    void link(int id, int cellIndex, const SimVec2& position, uint32_t category);
+    void unlink(Entry& entry);
+
+    /** @brief 一次查询结束时累加访问计数（每次查询只做一次原子加） */
+    void countVisited(int64_t visited) const { _visitedCount.fetch_add(visited, std::memory_order_relaxed); }
+
+    /**
+     * @brief 从查询点所在方格开始逐环访问，visit 对每个含 mask 类别的方格调用；
+     *        bound(ring) 返回 false 时停止（ring 圈之外的方格都不可能更近）
+     */
+    template <typename Visit, typename Bound>
+    void forEachRing(const SimVec2& center, uint32_t mask, Visit visit, Bound bound) const;
+
+    /**
+     * @brief 第 ring 圈方格到查询点的距离平方下界
+     * @param edgeGap 查询点到自身所在方格四条边的最小距离（查询点在范围外时为 0）
+     */
+    int64_t ringLowerBound(int ring, Fixed edgeGap) const
+    {
+        if (ring == 0)
+            return 0;
+        Fixed gap = _cellSize * (ring - 1) + edgeGap;
+        return gap.squaredRaw();
+    }
+
+    /** @brief 查询点到所在方格四条边的最小距离（查询点在范围外时为 0） */
+    Fixed edgeGapOf(const SimVec2& center) const;
+
+    SimVec2                      _origin;                           ///< 第 0 列第 0 行方格的最小坐标
+    Fixed                        _cellSize     = Fixed::fromInt(1); ///< 方格边长
+    int                          _columns      = 1;                 ///< 列数
+    int                          _rows         = 1;                 ///< 行数
+    std::vector<Cell>            _cells;                            ///< 方格（行优先）
+    std::vector<Entry>           _entries;                          ///< ID -> 所在位置
+    mutable std::atomic<int64_t> _visitedCount{0};                  ///< 累计检查过的实体数
+};
+
+#endif // SPATIAL_HASH_H_
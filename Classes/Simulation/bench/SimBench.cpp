@@ -0,0 +1,195 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     SimBench.cpp
+ * File Function: 战斗模拟性能基准：寻路、路径平滑与整场战斗步进
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "BattleSimulation.h"
+#include "PathFinder.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int   kGridSize = 44;
+constexpr float kTileSize = 55.6f;
+constexpr float kStartX   = 1406.0f;
+constexpr float kStartY   = 2107.2f;
+
+double elapsedMs(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+void addBuilding(BattleSimulation& sim, BuildingType type, int x, int y, int size, int hitpoints,
+                 const CombatStats& stats = CombatStats(), DefenseType defenseType = DefenseType::kCannon)
+{
+    SimBuildingDesc desc;
+    desc.type         = type;
+    desc.defenseType  = defenseType;
+    desc.footprint    = {x, y, size, size};
+    SimVec2 a         = sim.getGrid().getPositionFromGrid(x, y);
+    SimVec2 b         = sim.getGrid().getPositionFromGrid(x + size - 1, y + size - 1);
+    desc.position     = SimVec2((a.x + b.x) / 2, (a.y + b.y) / 2);
+    desc.maxHitpoints = hitpoints;
+    desc.stats        = stats;
+    sim.addBuilding(desc);
+}
+
+/**
+ * @brief 标准测试村庄：中央大本营、8x8 排布的 3x3 建筑（每三座一座防御）和上下两道城墙
+ */
+void setupVillage(BattleSimulation& sim)
+{
+    sim.reset();
+    sim.initGrid(kGridSize, kGridSize, Fixed::fromFloat(kTileSize), SimVec2::fromFloat(kStartX, kStartY));
+    addBuilding(sim, BuildingType::kTownHall, 20, 20, 4, 4000);
+
+    int index = 0;
+    for (int gx = 6; gx < 38; gx += 4)
+    {
+        for (int gy = 6; gy < 38; gy += 4)
+        {
+            if (gx >= 18 && gx < 26 && gy >= 18 && gy < 26)
+                continue;
+            ++index;
+            if (index % 3 == 0)
+            {
+                bool cannon = index % 2 != 0;
+                addBuilding(sim, BuildingType::kDefense, gx, gy, 3, 900,
+                            cannon ? DefenseConfig::getCannon(3) : DefenseConfig::getArcherTower(3),
+                            cannon ? DefenseType::kCannon : DefenseType::kArcherTower);
+            }
+            else
+            {
+                addBuilding(sim, index % 3 == 1 ? BuildingType::kResource : BuildingType::kArmy, gx, gy, 3, 900);
+            }
+        }
+    }
+    for (int i = 3; i < 41; ++i)
+    {
+        addBuilding(sim, BuildingType::kWall, i, 3, 1, 600);
+        addBuilding(sim, BuildingType::kWall, i, 40, 1, 600);
+    }
+}
+
+/**
+ * @brief 整场战斗：units 个士兵从四边同时投放，最多 60 秒（覆盖空间索引、SoA 运动、任务并行等步进路径）
+ */
+void benchBattle(int units, int jobWorkers, int pathWorkers)
+{
+    BattleSimulation sim;
+    sim.setJobWorkerCount(jobWorkers);
+    sim.setPathWorkerCount(pathWorkers);
+    setupVillage(sim);
+    for (int i = 0; i < units; ++i)
+    {
+        int edge  = i % 4;
+        int along = (i / 4) % (kGridSize - 2) + 1;
+        int x     = edge == 0 ? 0 : edge == 1 ? kGridSize - 1 : along;
+        int y     = edge == 2 ? 0 : edge == 3 ? kGridSize - 1 : along;
+        sim.spawnUnit(static_cast<UnitType>(i % 5), 1, sim.getGrid().getPositionFromGrid(x, y));
+    }
+
+    double worst = 0.0;
+    auto   begin = Clock::now();
+    while (sim.getFrame() < 3600 && sim.countAliveUnits() > 0 && sim.getDestructionPercent() < 100)
+    {
+        auto frameBegin = Clock::now();
+        sim.step();
+        double frameMs = elapsedMs(frameBegin);
+        if (frameMs > worst)
+            worst = frameMs;
+    }
+    double total = elapsedMs(begin);
+
+    std::printf("battle    units=%-5d jobs=%d paths=%d frames=%-5u total=%8.1fms per-frame=%.3fms worst=%.2fms "
+                "hash=%016llx\n",
+                units, jobWorkers, pathWorkers, sim.getFrame(), total, total / sim.getFrame(), worst,
+                static_cast<unsigned long long>(sim.computeStateHash()));
+}
+
+/**
+ * @brief 逐格 A* 与跳点搜索：在测试村庄的碰撞地图上求解固定的一组起终点
+ */
+void benchPathSearch(PathSearchMode mode, const char* name, int queries)
+{
+    BattleSimulation sim;
+    setupVillage(sim);
+    const SimGrid&    grid = sim.getGrid();
+    PathSearchContext context;
+
+    uint32_t state     = 12345;
+    auto     nextCell  = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int>((state >> 8) % kGridSize);
+    };
+
+    size_t found = 0;
+    size_t waypoints = 0;
+    auto   begin = Clock::now();
+    for (int i = 0; i < queries; ++i)
+    {
+        SimVec2 from = grid.getPositionFromGrid(0, nextCell());
+        SimVec2 to   = grid.getPositionFromGrid(kGridSize - 1, nextCell());
+        std::vector<SimVec2> path = PathFinder::getInstance().findPath(grid, context, from, to, false, SimRect(), mode);
+        if (!path.empty())
+            ++found;
+        waypoints += path.size();
+    }
+    double total = elapsedMs(begin);
+
+    std::printf("path      mode=%-10s queries=%-6d found=%-6zu waypoints=%-7zu per-query=%.2fus\n", name, queries,
+                found, waypoints, total * 1000.0 / queries);
+}
+
+/**
+ * @brief 路径平滑（视线检测）：对贯穿地图的逐格锯齿路径反复平滑
+ */
+void benchSmoothing(int iterations)
+{
+    BattleSimulation sim;
+    setupVillage(sim);
+    const SimGrid& grid = sim.getGrid();
+
+    std::vector<SimVec2> rawPath;
+    for (int i = 0; i < kGridSize; ++i)
+        rawPath.push_back(grid.getPositionFromGrid(i, (i / 2) % 2 == 0 ? 1 : 2));
+
+    size_t points = 0;
+    auto   begin  = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+        points += PathFinder::getInstance().smoothPath(grid, rawPath, false, SimRect()).size();
+    double total = elapsedMs(begin);
+
+    std::printf("smooth    raw=%-4zu smoothed=%-4zu per-call=%.2fus\n", rawPath.size(),
+                points / static_cast<size_t>(iterations), total * 1000.0 / iterations);
+}
+} // namespace
+
+/**
+ * 用法：SimBench [工作线程数]
+ */
+int main(int argc, char* argv[])
+{
+    int workers = argc > 1 ? std::atoi(argv[1]) : 3;
+
+    benchPathSearch(PathSearchMode::kAStar, "astar", 20000);
+    benchPathSearch(PathSearchMode::kJumpPoint, "jump-point", 20000);
+    benchSmoothing(20000);
+
+    for (int units : {100, 600, 2000})
+    {
+        benchBattle(units, 0, 0);
+        benchBattle(units, workers, workers);
+    }
+    return 0;
+}
@@ -0,0 +1,330 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     DeterminismTest.cpp
+ * File Function: 战斗模拟确定性测试：同一批战斗录像重复回放，逐段比较状态哈希
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "BattleSimulation.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+/** @brief 每隔多少帧记录一次状态哈希 */
+constexpr unsigned int kHashInterval = 30;
+
+/** @brief 单场战斗的最长帧数（与客户端 3 分钟战斗一致） */
+constexpr unsigned int kMaxFrames = 180 * 60;
+
+/** @brief 网格尺寸与坐标原点（与客户端地图一致） */
+constexpr int   kGridSize   = 44;
+constexpr float kTileSize   = 55.6f;
+constexpr float kStartX     = 1406.0f;
+constexpr float kStartY     = 2107.2f;
+
+/**
+ * @brief 可移植的线性同余随机数（std::uniform_int_distribution 在不同标准库下结果不同）
+ */
+class Lcg
+{
+public:
+    explicit Lcg(uint32_t seed) : _state(seed * 2654435761u + 1) {}
+
+    int next(int bound)
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return static_cast<int>((_state >> 8) % static_cast<uint32_t>(bound));
+    }
+
+private:
+    uint32_t _state;
+};
+
+/**
+ * @struct DeployRecord
+ * @brief 录像中的一次部署（与 ReplayEvent::DEPLOY_UNIT 对应）
+ */
+struct DeployRecord
+{
+    unsigned int frame = 0;
+    UnitType     type  = UnitType::kBarbarian;
+    int          level = 1;
+    int          gridX = 0;
+    int          gridY = 0;
+    int32_t      jitter = 0; ///< 部署点相对格子中心的偏移（定点原始值），模拟触屏坐标
+};
+
+/**
+ * @struct BattleRecording
+ * @brief 一场战斗录像：防守方布局 + 按帧排序的部署事件
+ */
+struct BattleRecording
+{
+    uint32_t                     seed = 0;
+    std::vector<SimBuildingDesc> buildings;
+    std::vector<DeployRecord>    deploys;
+};
+
+void addBuilding(BattleRecording& recording, const SimGrid& grid, std::vector<uint8_t>& occupied,
+                 BuildingType type, int x, int y, int size, int hitpoints, DefenseType defenseType, int level)
+{
+    for (int dy = 0; dy < size; ++dy)
+        for (int dx = 0; dx < size; ++dx)
+            occupied[(y + dy) * kGridSize + x + dx] = 1;
+
+    SimBuildingDesc desc;
+    desc.type         = type;
+    desc.defenseType  = defenseType;
+    desc.footprint    = {x, y, size, size};
+    SimVec2 a         = grid.getPositionFromGrid(x, y);
+    SimVec2 b         = grid.getPositionFromGrid(x + size - 1, y + size - 1);
+    desc.position     = SimVec2((a.x + b.x) / 2, (a.y + b.y) / 2);
+    desc.maxHitpoints = hitpoints;
+    if (type == BuildingType::kDefense)
+    {
+        switch (defenseType)
+        {
+        case DefenseType::kCannon:      desc.stats = DefenseConfig::getCannon(level); break;
+        case DefenseType::kArcherTower: desc.stats = DefenseConfig::getArcherTower(level); break;
+        case DefenseType::kWizardTower: desc.stats = DefenseConfig::getWizardTower(level); break;
+        }
+    }
+    recording.buildings.push_back(desc);
+}
+
+bool isFree(const std::vector<uint8_t>& occupied, int x, int y, int size)
+{
+    for (int dy = -1; dy <= size; ++dy)
+        for (int dx = -1; dx <= size; ++dx)
+            if (occupied[(y + dy) * kGridSize + x + dx])
+                return false;
+    return true;
+}
+
+/**
+ * @brief 由种子生成一场战斗录像
+ *
+ * 布局：中央大本营、随机摆放的资源/兵营/防御建筑和若干段城墙；
+ * 部署：前 15 秒内从地图四边分批投放五种士兵。
+ */
+BattleRecording makeRecording(uint32_t seed)
+{
+    BattleRecording recording;
+    recording.seed = seed;
+    Lcg rng(seed);
+
+    SimGrid grid;
+    grid.init(kGridSize, kGridSize, Fixed::fromFloat(kTileSize), SimVec2::fromFloat(kStartX, kStartY));
+    std::vector<uint8_t> occupied(kGridSize * kGridSize, 0);
+
+    int center = kGridSize / 2 - 2 + rng.next(3) - 1;
+    addBuilding(recording, grid, occupied, BuildingType::kTownHall, center, center, 4, 4000,
+                DefenseType::kCannon, 1);
+
+    int buildingCount = 20 + rng.next(25);
+    for (int attempt = 0; attempt < 400 && buildingCount > 0; ++attempt)
+    {
+        int x = 5 + rng.next(kGridSize - 12);
+        int y = 5 + rng.next(kGridSize - 12);
+        if (!isFree(occupied, x, y, 3))
+            continue;
+
+        int roll = rng.next(10);
+        if (roll < 4)
+            addBuilding(recording, grid, occupied, BuildingType::kDefense, x, y, 3, 800 + rng.next(400),
+                        static_cast<DefenseType>(rng.next(3)), 1 + rng.next(5));
+        else
+            addBuilding(recording, grid, occupied, roll < 7 ? BuildingType::kResource : BuildingType::kArmy, x, y, 3,
+                        600 + rng.next(600), DefenseType::kCannon, 1);
+        --buildingCount;
+    }
+
+    int wallSegments = 4 + rng.next(6);
+    for (int segment = 0; segment < wallSegments; ++segment)
+    {
+        bool horizontal = rng.next(2) == 0;
+        int  fixed      = 3 + rng.next(kGridSize - 6);
+        int  from       = 3 + rng.next(kGridSize / 2);
+        int  length     = 5 + rng.next(kGridSize / 2);
+        for (int i = from; i < from + length && i < kGridSize - 3; ++i)
+        {
+            int x = horizontal ? i : fixed;
+            int y = horizontal ? fixed : i;
+            if (!occupied[y * kGridSize + x])
+                addBuilding(recording, grid, occupied, BuildingType::kWall, x, y, 1, 500, DefenseType::kCannon, 1);
+        }
+    }
+
+    int deployCount = 30 + rng.next(220);
+    unsigned int frame = 0;
+    for (int i = 0; i < deployCount; ++i)
+    {
+        frame += static_cast<unsigned int>(rng.next(8));
+        DeployRecord deploy;
+        deploy.frame = frame;
+        deploy.type  = static_cast<UnitType>(rng.next(5));
+        deploy.level = 1 + rng.next(3);
+        int edge     = rng.next(4);
+        int along    = 1 + rng.next(kGridSize - 2);
+        deploy.gridX  = edge == 0 ? 0 : edge == 1 ? kGridSize - 1 : along;
+        deploy.gridY  = edge == 2 ? 0 : edge == 3 ? kGridSize - 1 : along;
+        deploy.jitter = rng.next(Fixed::kOne) - Fixed::kOne / 2;
+        recording.deploys.push_back(deploy);
+    }
+    return recording;
+}
+
+/**
+ * @struct ReplayOptions
+ * @brief 一次回放的运行方式（都不应改变结果，除了搜索方式）
+ */
+struct ReplayOptions
+{
+    int            pathWorkers   = 0;
+    int            jobWorkers    = 0;
+    PathSearchMode searchMode    = PathSearchMode::kAStar;
+    unsigned int   keyframeFrame = 0; ///< 非 0 时在该帧保存关键帧，换一个新模拟恢复后继续回放
+};
+
+/**
+ * @struct ReplayResult
+ * @brief 回放得到的哈希序列
+ */
+struct ReplayResult
+{
+    std::vector<uint64_t> hashes; ///< 第 i 项为第 i * kHashInterval 帧推进前的状态哈希
+    uint64_t              finalHash = 0;
+    unsigned int          frames    = 0;
+    bool                  keyframeLoaded = true;
+};
+
+void setupSimulation(BattleSimulation& sim, const BattleRecording& recording, const ReplayOptions& options)
+{
+    sim.setPathWorkerCount(options.pathWorkers);
+    sim.setJobWorkerCount(options.jobWorkers);
+    sim.setPathSearchMode(options.searchMode);
+    sim.reset();
+    sim.initGrid(kGridSize, kGridSize, Fixed::fromFloat(kTileSize), SimVec2::fromFloat(kStartX, kStartY));
+    for (const auto& building : recording.buildings)
+        sim.addBuilding(building);
+}
+
+bool isBattleRunning(const BattleSimulation& sim, const BattleRecording& recording, size_t nextDeploy)
+{
+    if (sim.getFrame() >= kMaxFrames || sim.getDestructionPercent() >= 100)
+        return false;
+    return nextDeploy < recording.deploys.size() || sim.countAliveUnits() > 0;
+}
+
+ReplayResult replay(const BattleRecording& recording, const ReplayOptions& options)
+{
+    ReplayResult result;
+    BattleSimulation first;
+    setupSimulation(first, recording, options);
+
+    BattleSimulation  second;
+    BattleSimulation* sim        = &first;
+    size_t            nextDeploy = 0;
+
+    while (isBattleRunning(*sim, recording, nextDeploy))
+    {
+        if (options.keyframeFrame != 0 && sim == &first && sim->getFrame() == options.keyframeFrame)
+        {
+            // 与回放跳转相同：关键帧保存在该帧事件执行之前
+            std::vector<uint8_t> keyframe;
+            first.saveKeyframe(keyframe);
+            setupSimulation(second, recording, options);
+            result.keyframeLoaded = second.loadKeyframe(keyframe);
+            sim                   = &second;
+        }
+
+        if (sim->getFrame() % kHashInterval == 0)
+            result.hashes.push_back(sim->computeStateHash());
+
+        // 与 BattleManager 一致：当前帧的部署在 step() 之前执行
+        while (nextDeploy < recording.deploys.size() && recording.deploys[nextDeploy].frame == sim->getFrame())
+        {
+            const DeployRecord& deploy   = recording.deploys[nextDeploy++];
+            SimVec2             position = sim->getGrid().getPositionFromGrid(deploy.gridX, deploy.gridY);
+            position.x += Fixed::fromRaw(deploy.jitter);
+            sim->spawnUnit(deploy.type, deploy.level, position);
+        }
+        sim->step();
+    }
+
+    result.finalHash = sim->computeStateHash();
+    result.frames    = sim->getFrame();
+    return result;
+}
+
+bool sameResult(const ReplayResult& a, const ReplayResult& b, const char* label, uint32_t seed)
+{
+    if (!b.keyframeLoaded)
+    {
+        std::printf("  seed=%u %s: 关键帧恢复失败\n", seed, label);
+        return false;
+    }
+    size_t count = a.hashes.size() < b.hashes.size() ? a.hashes.size() : b.hashes.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (a.hashes[i] != b.hashes[i])
+        {
+            std::printf("  seed=%u %s: 第 %u 帧开始不一致 %016llx != %016llx\n", seed, label,
+                        static_cast<unsigned int>(i * kHashInterval), static_cast<unsigned long long>(a.hashes[i]),
+                        static_cast<unsigned long long>(b.hashes[i]));
+            return false;
+        }
+    }
+    if (a.hashes.size() != b.hashes.size() || a.frames != b.frames || a.finalHash != b.finalHash)
+    {
+        std::printf("  seed=%u %s: 结束状态不一致 frames %u/%u hash %016llx/%016llx\n", seed, label, a.frames,
+                    b.frames, static_cast<unsigned long long>(a.finalHash),
+                    static_cast<unsigned long long>(b.finalHash));
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    const uint32_t seeds[] = {1, 2, 3, 5, 8, 13, 21, 34};
+    int            failures = 0;
+
+    for (uint32_t seed : seeds)
+    {
+        BattleRecording recording = makeRecording(seed);
+
+        ReplayOptions serial;
+        ReplayResult  reference = replay(recording, serial);
+
+        bool ok = sameResult(reference, replay(recording, serial), "重复回放", seed);
+
+        ReplayOptions threaded;
+        threaded.pathWorkers = 2;
+        threaded.jobWorkers  = 3;
+        ok = sameResult(reference, replay(recording, threaded), "多线程回放", seed) && ok;
+
+        ReplayOptions resumed;
+        resumed.keyframeFrame = (reference.frames / 2) / kHashInterval * kHashInterval + 7;
+        ok = sameResult(reference, replay(recording, resumed), "关键帧恢复", seed) && ok;
+
+        // 跳点搜索与逐格 A* 的结果可以不同，但自身必须可重复
+        ReplayOptions jumpPoint;
+        jumpPoint.searchMode = PathSearchMode::kJumpPoint;
+        ok = sameResult(replay(recording, jumpPoint), replay(recording, jumpPoint), "跳点搜索重复回放", seed) && ok;
+
+        std::printf("seed=%-3u buildings=%-3zu deploys=%-3zu frames=%-5u hash=%016llx %s\n", seed,
+                    recording.buildings.size(), recording.deploys.size(), reference.frames,
+                    static_cast<unsigned long long>(reference.finalHash), ok ? "OK" : "FAILED");
+        if (!ok)
+            ++failures;
+    }
+
+    std::printf("%d/%zu 场录像不一致\n", failures, sizeof(seeds) / sizeof(seeds[0]));
+    return failures == 0 ? 0 : 1;
+}
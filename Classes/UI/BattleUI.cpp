@@ -38,6 +38,7 @@ bool BattleUI::init()
     setupBottomButtons();
     setupTroopButtons();
     setupReadyPhaseUI();
+    setupReplayControls();
 
     return true;
 }
@@ -62,6 +63,11 @@ void BattleUI::setTroopDeselectionCallback(const std::function<void()>& callback
     _onTroopDeselected = callback;
 }
 
+void BattleUI::setReplaySeekCallback(const std::function<void(float)>& callback)
+{
+    _onReplaySeek = callback;
+}
+
 void BattleUI::setupTopBar()
 {
     // 状态标签
@@ -192,6 +198,43 @@ void BattleUI::setupBottomButtons()
     this->addChild(_returnButton, 100);
 }
 
+void BattleUI::setupReplayControls()
+{
+    // 回放跳转按钮放在左下角（回放不显示兵种面板），层级高于结果面板
+    _replayControls = Node::create();
+    _replayControls->setPosition(Vec2(100, 60));
+    _replayControls->setVisible(false);
+    this->addChild(_replayControls, 210);
+
+    auto createSeekButton = [this](const std::string& title, float offsetSeconds, float x) {
+        auto button = Button::create();
+        button->ignoreContentAdaptWithSize(false);
+        button->setContentSize(Size(100, 50));
+        button->setTitleText(title);
+        button->setTitleFontSize(22);
+
+        auto bg = LayerColor::create(Color4B(60, 60, 120, 220), 100, 50);
+        bg->setPosition(Vec2::ZERO);
+        button->addChild(bg, -1);
+
+        if (button->getTitleRenderer())
+        {
+            button->getTitleRenderer()->setPosition(Vec2(50, 25));
+        }
+
+        button->setPosition(Vec2(x, 0));
+        button->addClickEventListener([this, offsetSeconds](Ref*) {
+            AudioManager::GetInstance().PlayEffect(SoundEffectId::kUiButtonClick);
+            if (_onReplaySeek)
+                _onReplaySeek(offsetSeconds);
+        });
+        _replayControls->addChild(button);
+    };
+
+    createSeekButton(StringUtils::format("⏪ %d秒", static_cast<int>(kReplaySeekStep)), -kReplaySeekStep, 0);
+    createSeekButton(StringUtils::format("%d秒 ⏩", static_cast<int>(kReplaySeekStep)), kReplaySeekStep, 120);
+}
+
 Node* BattleUI::createTroopCard(UnitType type, const std::string& iconPath, const std::string& name)
 {
     // 创建卡片容器
@@ -675,6 +718,21 @@ void BattleUI::updateDestruction(int percent)
     }
 }
 
+void BattleUI::updatePoolStats(const std::string& text)
+{
+#if COCOS2D_DEBUG > 0
+    if (!_poolStatsLabel)
+    {
+        _poolStatsLabel = Label::createWithSystemFont("", "Arial", 14);
+        _poolStatsLabel->setAnchorPoint(Vec2(0.0f, 1.0f));
+        _poolStatsLabel->setPosition(Vec2(10, _visibleSize.height - 110));
+        _poolStatsLabel->setTextColor(Color4B(200, 255, 200, 255));
+        this->addChild(_poolStatsLabel, 100);
+    }
+    _poolStatsLabel->setString(text);
+#endif
+}
+
 void BattleUI::updateTroopCounts(int barbarianCount, int archerCount, int giantCount, int goblinCount,
                                  int wallBreakerCount)
 {
@@ -750,6 +808,12 @@ void BattleUI::showReturnButton(bool visible)
         _returnButton->setVisible(visible);
 }
 
+void BattleUI::showReplayControls(bool visible)
+{
+    if (_replayControls)
+        _replayControls->setVisible(visible);
+}
+
 void BattleUI::highlightTroopButton(UnitType type)
 {
     // 更新所有卡片的高亮状态
@@ -985,4 +1049,11 @@ void BattleUI::showResultPanel(int stars, int destructionPercent, int goldLooted
     // 显示返回按钮
     updateStatus("点击返回按钮回到主场景", Color4B::YELLOW);
     showReturnButton(true);
+}
+
+void BattleUI::hideResultPanel()
+{
+    this->removeChildByName("result_panel");
+    showReturnButton(false);
+    showBattleHUD(true);
 }
\ No newline at end of file
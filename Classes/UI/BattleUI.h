@@ -41,6 +41,9 @@ public:
     /** @brief 设置部队取消选择回调 */
     void setTroopDeselectionCallback(const std::function<void()>& callback);
 
+    /** @brief 设置回放跳转回调（参数为相对当前进度的秒数，负数为后退） */
+    void setReplaySeekCallback(const std::function<void(float)>& callback);
+
     /**
      * @brief 更新状态文本
      * @param text 状态文本
@@ -84,6 +87,12 @@ public:
      */
     void updateTroopCounts(int barbarianCount, int archerCount, int giantCount, int goblinCount, int wallBreakerCount);
 
+    /**
+     * @brief 更新对象池统计浮层（仅调试版本显示）
+     * @param text BattleObjectPool::formatStats() 的结果
+     */
+    void updatePoolStats(const std::string& text);
+
     /**
      * @brief 设置回放模式
      * @param isReplay 是否为回放
@@ -111,12 +120,23 @@ public:
     /** @brief 显示/隐藏返回按钮 */
     void showReturnButton(bool visible);
 
+    /**
+     * @brief 显示/隐藏回放跳转按钮（后退/前进 kReplaySeekStep 秒）
+     * @note 仅回放使用；按钮位于结果面板之上，回放结束后仍可后退重新观看
+     */
+    void showReplayControls(bool visible);
+
     /**
      * @brief 显示结果面板
      */
     void showResultPanel(int stars, int destructionPercent, int goldLooted, int elixirLooted, int trophyChange,
                          bool isReplayMode);
 
+    /**
+     * @brief 关闭结果面板，恢复战斗HUD（回放结束后跳转回去继续观看）
+     */
+    void hideResultPanel();
+
     /**
      * @brief 高亮部队按钮
      * @param type 单位类型
@@ -138,11 +158,14 @@ public:
     /** @brief 是否有选中的单位 */
     bool hasSelectedUnit() const { return _hasSelectedUnit; }
 
+    static constexpr float kReplaySeekStep = 10.0f;  ///< 回放跳转按钮每次移动的秒数
+
 private:
     void setupTopBar();        ///< 设置顶部栏
     void setupBottomButtons(); ///< 设置底部按钮
     void setupTroopButtons();  ///< 设置部队按钮
     void setupReadyPhaseUI();  ///< 设置准备阶段UI
+    void setupReplayControls(); ///< 设置回放跳转按钮
 
     cocos2d::Node* createTroopCard(UnitType type, const std::string& iconPath, const std::string& name);
     void updateTroopCardCount(UnitType type, int count);
@@ -160,8 +183,10 @@ private:
     cocos2d::Label* _timerLabel = nullptr;        ///< 计时器标签
     cocos2d::Label* _starsLabel = nullptr;        ///< 星星标签
     cocos2d::Label* _destructionLabel = nullptr;  ///< 摧毁百分比标签
+    cocos2d::Label* _poolStatsLabel = nullptr;    ///< 对象池统计浮层（调试）
     cocos2d::ui::Button* _endBattleButton = nullptr;  ///< 结束战斗按钮
     cocos2d::ui::Button* _returnButton = nullptr;     ///< 返回按钮
+    cocos2d::Node* _replayControls = nullptr;         ///< 回放跳转按钮（后退/前进）
 
     // 准备阶段UI元素
     cocos2d::Node* _readyPhasePanel = nullptr;        ///< 准备阶段面板
@@ -193,6 +218,7 @@ private:
     std::function<void()> _onReturn;              ///< 返回回调
     std::function<void(UnitType)> _onTroopSelected;   ///< 部队选择回调
     std::function<void()> _onTroopDeselected;     ///< 部队取消选择回调
+    std::function<void(float)> _onReplaySeek;     ///< 回放跳转回调
 };
 
 #endif // BATTLE_UI_H_
\ No newline at end of file
@@ -76,10 +76,9 @@ void UnitHealthBarUI::update(float dt)
     // 检查单位是否死亡
     if (_unit->isDead())
     {
-        // 单位死亡，清除引用并移除自己
-        _unit = nullptr;
+        // 单位死亡，隐藏并停止更新（血条是单位的子节点，单位复用时由 reset() 恢复）
+        this->hide();
         this->unscheduleUpdate();
-        this->removeFromParent();
         return;
     }
 
@@ -166,6 +165,16 @@ void UnitHealthBarUI::hide()
     }
 }
 
+void UnitHealthBarUI::reset()
+{
+    this->stopAllActions();
+    _lastHealthValue = -1; // 下一帧强制刷新填充宽度与颜色
+    _hideTimer       = 0.0f;
+    this->show();
+    this->setOpacity(255);
+    this->scheduleUpdate();
+}
+
 bool UnitHealthBarUI::isUnitDead() const
 {
     // 🔴 修复：只检查空指针，不在空指针上调用方法
@@ -20,7 +20,7 @@ class BaseUnit;
  * 功能：
  * - 显示单位的当前生命值和最大生命值
  * - 实时更新血条显示
- * - 血量满时隐藏，为零时单位消失
+ * - 血量满时隐藏，为零时隐藏并停止更新（单位可能被对象池复用）
  * - 支持战斗状态显示
  */
 class UnitHealthBarUI : public cocos2d::Node
@@ -52,6 +52,9 @@ public:
     /** @brief 隐藏血条 */
     void hide();
 
+    /** @brief 单位被对象池复用时调用：重新显示并恢复每帧更新 */
+    void reset();
+
     /**
      * @brief 设置血条是否始终可见
      * @param always 是否始终可见
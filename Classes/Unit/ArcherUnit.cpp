@@ -29,13 +29,15 @@ bool ArcherUnit::init(int level) {
   }
 
   // 设置弓箭手特有属性
-  _moveSpeed = 100.0f;
+  _moveSpeed = UnitConfig::getMoveSpeed(UnitType::kArcher);
   _combatStats = UnitConfig::getArcher(level);
 
+  return true;
+}
+
+void ArcherUnit::onDeploy() {
   // 播放部署音效
   AudioManager::GetInstance().PlayEffect(SoundEffectId::kArcherDeploy);
-
-  return true;
 }
 
 void ArcherUnit::loadAnimations() {
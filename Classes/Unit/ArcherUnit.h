@@ -30,6 +30,9 @@ class ArcherUnit : public BaseUnit {
   /** @brief 获取显示名称 */
   std::string getDisplayName() const override { return "弓箭手"; }
 
+  /** @brief 部署到战场（播放部署音效） */
+  void onDeploy() override;
+
  protected:
   bool init(int level) override;
   void loadAnimations() override;
@@ -29,13 +29,15 @@ bool BarbarianUnit::init(int level) {
   }
 
   // 设置野蛮人特有属性
-  _moveSpeed = 100.0f;
+  _moveSpeed = UnitConfig::getMoveSpeed(UnitType::kBarbarian);
   _combatStats = UnitConfig::getBarbarian(level);
 
+  return true;
+}
+
+void BarbarianUnit::onDeploy() {
   // 播放部署音效
   AudioManager::GetInstance().PlayEffect(SoundEffectId::kBarbarianDeploy);
-
-  return true;
 }
 
 void BarbarianUnit::loadAnimations() {
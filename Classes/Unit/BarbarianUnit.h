@@ -31,6 +31,9 @@ public:
     /** @brief 获取显示名称 */
     std::string getDisplayName() const override { return "野蛮人"; }
 
+    /** @brief 部署到战场（播放部署音效） */
+    void onDeploy() override;
+
 protected:
     virtual bool init(int level) override;
     virtual void loadAnimations() override;
@@ -17,13 +17,8 @@ USING_NS_CC;
 BaseUnit::BaseUnit()
     : _sprite(nullptr)
     , _isMoving(false)
-    , _targetPos(Vec2::ZERO)
-    , _moveVelocity(Vec2::ZERO)
     , _moveSpeed(100.0f)
     , _currentDir(UnitDirection::kRight)
-    , _currentPathIndex(0)
-    , _currentTarget(nullptr)
-    , _attackCooldown(0.0f)  // 将在 init 中根据攻击速度设置
     , _unitLevel(1)
     , _isDead(false)
     , _healthBarUI(nullptr)
@@ -50,106 +45,27 @@ bool BaseUnit::init(int level)
     // 子类在loadAnimations()中创建精灵和加载动画
     loadAnimations();
 
-    // 🔴 修复：初始化攻击冷却，防止新部署的单位立即攻击
-    // 设置为攻击速度的一半，给予单位时间移动到目标
-    _attackCooldown = _combatStats.attackSpeed * 0.5f;
-
     // 初始化血条UI
     initHealthBarUI();
 
     return true;
 }
 
-void BaseUnit::tick(float dt)
-{
-    if (_isDead)
-        return;
-
-    // 更新移动
-    tickMovement(dt);
-
-    // 更新攻击冷却
-    updateAttackCooldown(dt);
-}
+// ==================== 移动表现 ====================
 
-void BaseUnit::tickMovement(float dt)
+void BaseUnit::playMoveAnimation(const cocos2d::Vec2& direction)
 {
     if (_isDead)
         return;
 
-    // 仅更新移动逻辑
-    if (_isMoving)
-    {
-        Vec2  current_pos = this->getPosition();
-        float distance    = current_pos.distance(_targetPos);
-        float step        = _moveSpeed * dt;
-
-        if (step >= distance)
-        {
-            this->setPosition(_targetPos);
-
-            // 检查路径
-            _currentPathIndex++;
-            if (_currentPathIndex < _pathPoints.size())
-            {
-                moveTo(_pathPoints[_currentPathIndex]);
-            }
-            else
-            {
-                stopMoving();
-            }
-        }
-        else
-        {
-            this->setPosition(current_pos + _moveVelocity * dt);
-        }
-    }
-}
-
-// ==================== 移动系统 ====================
-
-void BaseUnit::moveTo(const cocos2d::Vec2& target_pos)
-{
-    if (_isDead)
-        return;
-
-    _targetPos       = target_pos;
-    Vec2 current_pos = this->getPosition();
-    Vec2 diff        = _targetPos - current_pos;
-
-    if (diff.getLength() < 1.0f)
-        return;
-
-    _currentDir = calculateDirection(diff);
+    _currentDir = calculateDirection(direction);
     playAnimation(UnitAction::kRun, _currentDir);
-
-    _moveVelocity = diff.getNormalized() * _moveSpeed;
-    _isMoving     = true;
-}
-
-void BaseUnit::moveToPath(const std::vector<cocos2d::Vec2>& path)
-{
-    if (path.empty() || _isDead)
-        return;
-
-    _pathPoints       = path;
-    _currentPathIndex = 0;
-
-    if (_pathPoints.size() > 0 && this->getPosition().distance(_pathPoints[0]) < 10.0f)
-    {
-        _currentPathIndex = 1;
-    }
-
-    if (_currentPathIndex < _pathPoints.size())
-    {
-        moveTo(_pathPoints[_currentPathIndex]);
-    }
+    _isMoving = true;
 }
 
 void BaseUnit::stopMoving()
 {
     _isMoving = false;
-    _pathPoints.clear();
     playAnimation(UnitAction::kIdle, _currentDir);
 }
 
@@ -173,12 +89,13 @@ void BaseUnit::attack(bool useSecondAttack)
     onAttackAfter();
 }
 
-bool BaseUnit::takeDamage(float damage)
+void BaseUnit::showDamage(int hitpoints)
 {
     if (_isDead)
-        return true;
+        return;
 
-    float actualDamage = _combatStats.takeDamage(damage);
+    float actualDamage            = static_cast<float>(_combatStats.currentHitpoints - hitpoints);
+    _combatStats.currentHitpoints = hitpoints;
 
     CCLOG("%s took %.1f damage, HP: %d/%d", getDisplayName().c_str(), actualDamage, _combatStats.currentHitpoints,
           _combatStats.maxHitpoints);
@@ -200,14 +117,6 @@ bool BaseUnit::takeDamage(float damage)
         restore->setTag(kDamageEffectTag);
         _sprite->runAction(restore);
     }
-
-    if (_combatStats.currentHitpoints <= 0)
-    {
-        die();
-        return true;
-    }
-
-    return false;
 }
 
 void BaseUnit::die()
@@ -236,6 +145,9 @@ void BaseUnit::die()
             // 标记为等待移除状态，通知 BattleManager 可以安全清理
             _pendingRemoval = true;
             this->removeFromParent();
+            // 由对象池创建的单位回到空闲列表（对象池持有引用）
+            if (_recycleCallback)
+                _recycleCallback(this);
             // 释放之前 retain 的引用，BattleManager 清理时会再次 release
             this->release();
         }),
@@ -245,23 +157,29 @@ void BaseUnit::die()
     CCLOG("%s died", getDisplayName().c_str());
 }
 
-bool BaseUnit::isInAttackRange(const cocos2d::Vec2& targetPos) const
+void BaseUnit::resetForReuse()
 {
-    float distance = this->getPosition().distance(targetPos);
-    return distance <= _combatStats.attackRange;
-}
+    this->stopAllActions();
+    this->setVisible(true);
+    this->setOpacity(255);
 
-void BaseUnit::updateAttackCooldown(float dt)
-{
-    if (_attackCooldown > 0.0f)
+    _isDead         = false;
+    _isMoving       = false;
+    _pendingRemoval = false;
+    _currentDir     = UnitDirection::kRight;
+    _combatStats.fullHeal();
+
+    if (_sprite)
     {
-        _attackCooldown -= dt;
+        _sprite->stopAllActions();
+        _sprite->setColor(Color3B::WHITE);
+        _sprite->setOpacity(255);
+        _sprite->setVisible(true);
     }
-}
+    playAnimation(UnitAction::kIdle, _currentDir);
 
-void BaseUnit::resetAttackCooldown()
-{
-    _attackCooldown = _combatStats.attackSpeed;
+    if (_healthBarUI)
+        _healthBarUI->reset();
 }
 
 // ==================== 动画系统 ====================
@@ -13,11 +13,11 @@
 #include "Unit/UnitTypes.h"
 #include "cocos2d.h"
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
 
-class BaseBuilding;
 class UnitHealthBarUI;
 
 // 动作 Tag 常量，用于区分不同类型的动作以便单独停止
@@ -33,32 +33,13 @@ class BaseUnit : public cocos2d::Node {
     virtual ~BaseUnit();
 
     /**
-     * @brief 每帧更新（完整更新，包括移动和攻击冷却）
-     * @param dt 帧时间间隔
-     * @note 当由 BattleManager 统一管理攻击冷却时，应使用 tickMovement
+     * @brief 播放朝指定方向奔跑的动画
+     * @param direction 移动方向向量
+     * @note 战斗中的位置由 BattleSimulation 计算，单位只负责表现
      */
-    virtual void tick(float dt);
+    void playMoveAnimation(const cocos2d::Vec2& direction);
 
-    /**
-     * @brief 每帧移动更新（仅更新移动逻辑，不更新攻击冷却）
-     * @param dt 帧时间间隔
-     * @note 当攻击冷却由外部（如 BattleManager）管理时使用此方法
-     */
-    virtual void tickMovement(float dt);
-
-    /**
-     * @brief 移动到指定位置
-     * @param target_pos 目标位置
-     */
-    void moveTo(const cocos2d::Vec2& target_pos);
-
-    /**
-     * @brief 沿路径移动
-     * @param path 路径点列表
-     */
-    void moveToPath(const std::vector<cocos2d::Vec2>& path);
-
-    /** @brief 停止移动 */
+    /** @brief 停止移动（切换为待机动画） */
     void stopMoving();
 
     /** @brief 获取移动速度 */
@@ -67,9 +48,6 @@ class BaseUnit : public cocos2d::Node {
     /** @brief 是否正在移动 */
     bool isMoving() const { return _isMoving; }
 
-    /** @brief 获取目标位置 */
-    const cocos2d::Vec2& getTargetPosition() const { return _targetPos; }
-
     /**
      * @brief 攻击
      * @param useSecondAttack 是否使用第二攻击
@@ -77,51 +55,38 @@ class BaseUnit : public cocos2d::Node {
     virtual void attack(bool useSecondAttack = false);
 
     /**
-     * @brief 受到伤害
-     * @param damage 伤害值
-     * @return bool 是否死亡
+     * @brief 同步模拟结算后的生命值并播放受击效果
+     * @param hitpoints 当前生命值
+     * @note 死亡由模拟的死亡事件触发 die()，这里不做判断
      */
-    virtual bool takeDamage(float damage);
+    virtual void showDamage(int hitpoints);
 
     /** @brief 死亡 */
     virtual void die();
 
-    /** @brief 是否死亡 */
-    bool isDead() const { return _isDead; }
-
-    /** @brief 是否等待移除（已从父节点移除，等待清理） */
-    bool isPendingRemoval() const { return _pendingRemoval; }
-
-    /** @brief 标记为等待移除状态 */
-    void markPendingRemoval() { _pendingRemoval = true; }
-
-    /** @brief 设置攻击目标 */
-    void setTarget(BaseBuilding* target) { _currentTarget = target; }
-
-    /** @brief 获取攻击目标 */
-    BaseBuilding* getTarget() const { return _currentTarget; }
-
-    /** @brief 清除攻击目标 */
-    void clearTarget() { _currentTarget = nullptr; }
+    /** @brief 部署到战场时调用（子类播放部署音效） */
+    virtual void onDeploy() {}
 
     /**
-     * @brief 检查是否在攻击范围内
-     * @param targetPos 目标位置
-     * @return bool 是否在范围内
+     * @brief 设置回收回调
+     * @param callback 死亡淡出结束、从父节点移除后调用（由 BattleObjectPool 设置，传 nullptr 取消）
      */
-    bool isInAttackRange(const cocos2d::Vec2& targetPos) const;
+    void setRecycleCallback(const std::function<void(BaseUnit*)>& callback) { _recycleCallback = callback; }
 
     /**
-     * @brief 更新攻击冷却
-     * @param dt 帧时间间隔
+     * @brief 恢复到刚创建时的状态，供对象池复用
+     * @note 满血、未死亡、朝右待机、完全不透明，血条重新开始更新
      */
-    void updateAttackCooldown(float dt);
+    void resetForReuse();
+
+    /** @brief 是否死亡 */
+    bool isDead() const { return _isDead; }
 
-    /** @brief 攻击是否就绪 */
-    bool isAttackReady() const { return _attackCooldown <= 0.0f; }
+    /** @brief 是否等待移除（已从父节点移除，等待清理） */
+    bool isPendingRemoval() const { return _pendingRemoval; }
 
-    /** @brief 重置攻击冷却 */
-    void resetAttackCooldown();
+    /** @brief 标记为等待移除状态 */
+    void markPendingRemoval() { _pendingRemoval = true; }
 
     /** @brief 获取单位类型 */
     virtual UnitType getUnitType() const = 0;
@@ -160,8 +125,6 @@ class BaseUnit : public cocos2d::Node {
     void disableBattleMode();
 
     /** @deprecated 使用小写命名的方法 */
-    void     MoveTo(const cocos2d::Vec2& target_pos) { moveTo(target_pos); }
-    void     MoveToPath(const std::vector<cocos2d::Vec2>& path) { moveToPath(path); }
     void     StopMoving() { stopMoving(); }
     void     Attack(bool useSecondAttack = false) { attack(useSecondAttack); }
     void     Die() { die(); }
@@ -226,22 +189,18 @@ class BaseUnit : public cocos2d::Node {
     std::map<std::string, cocos2d::Animation*> _animCache;   ///< 动画缓存
 
     bool _isMoving = false;                    ///< 是否正在移动
-    cocos2d::Vec2 _targetPos;                  ///< 目标位置
-    cocos2d::Vec2 _moveVelocity;               ///< 移动速度向量
     float _moveSpeed = 100.0f;                 ///< 移动速度
     UnitDirection _currentDir = UnitDirection::kRight;  ///< 当前方向
-    std::vector<cocos2d::Vec2> _pathPoints;    ///< 路径点
-    int _currentPathIndex = 0;                 ///< 当前路径索引
 
     CombatStats _combatStats;                  ///< 战斗属性
-    BaseBuilding* _currentTarget = nullptr;    ///< 当前攻击目标
-    float _attackCooldown = 0.0f;              ///< 攻击冷却
     int _unitLevel = 1;                        ///< 单位等级
     bool _isDead = false;                      ///< 是否死亡
     bool _pendingRemoval = false;              ///< 是否等待移除（防止野指针访问）
 
     UnitHealthBarUI* _healthBarUI = nullptr;   ///< 血条UI
     bool _battleModeEnabled = false;           ///< 战斗模式是否启用
+
+    std::function<void(BaseUnit*)> _recycleCallback;  ///< 回收回调（对象池）
 };
 
 #endif  // BASE_UNIT_H_
\ No newline at end of file
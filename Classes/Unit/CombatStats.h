@@ -10,6 +10,8 @@
 #ifndef COMBAT_STATS_H_
 #define COMBAT_STATS_H_
 
+#include "Unit/UnitTypes.h"
+
 /**
  * @struct CombatStats
  * @brief 战斗属性结构体，适用于建筑和单位
@@ -25,6 +27,8 @@ struct CombatStats
 
     int armor = 0;  ///< 护甲（减少伤害）
 
+    float splashRadius = 0.0f;  ///< 溅射半径（像素，0 表示只伤害目标）
+
     /**
      * @enum TargetType
      * @brief 目标类型枚举
@@ -165,6 +169,43 @@ inline CombatStats getWallBreaker(int level)
     stats.preferredTarget  = CombatStats::TargetType::kWalls;
     return stats;
 }
+
+// 按单位类型获取配置
+inline CombatStats getByType(UnitType type, int level)
+{
+    switch (type)
+    {
+    case UnitType::kArcher:
+        return getArcher(level);
+    case UnitType::kGiant:
+        return getGiant(level);
+    case UnitType::kGoblin:
+        return getGoblin(level);
+    case UnitType::kWallBreaker:
+        return getWallBreaker(level);
+    case UnitType::kBarbarian:
+    default:
+        return getBarbarian(level);
+    }
+}
+
+// 移动速度（像素/秒）
+inline float getMoveSpeed(UnitType type)
+{
+    switch (type)
+    {
+    case UnitType::kGiant:
+        return 60.0f;  // 巨人移动慢
+    case UnitType::kGoblin:
+        return 150.0f; // 哥布林移动快
+    case UnitType::kWallBreaker:
+        return 120.0f;
+    case UnitType::kBarbarian:
+    case UnitType::kArcher:
+    default:
+        return 100.0f;
+    }
+}
 } // namespace UnitConfig
 
 /**
@@ -237,6 +278,7 @@ inline CombatStats getWizardTower(int level)
     stats.damage           = 16 + (level - 1) * 4; // 范围伤害
     stats.attackSpeed      = 1.5f;
     stats.attackRange      = 250.0f;
+    stats.splashRadius     = 55.0f; // 约一格
     stats.preferredTarget  = CombatStats::TargetType::kAny;
     return stats;
 }
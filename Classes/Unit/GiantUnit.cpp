@@ -29,13 +29,15 @@ bool GiantUnit::init(int level) {
   }
 
   // 设置巨人特有属性
-  _moveSpeed = 60.0f;  // 巨人移动慢
+  _moveSpeed = UnitConfig::getMoveSpeed(UnitType::kGiant);
   _combatStats = UnitConfig::getGiant(level);
 
+  return true;
+}
+
+void GiantUnit::onDeploy() {
   // 播放部署音效
   AudioManager::GetInstance().PlayEffect(SoundEffectId::kGiantDeploy);
-
-  return true;
 }
 
 void GiantUnit::loadAnimations() {
@@ -29,13 +29,15 @@ bool GoblinUnit::init(int level) {
   }
 
   // 设置哥布林特有属性
-  _moveSpeed = 150.0f;  // 哥布林移动快
+  _moveSpeed = UnitConfig::getMoveSpeed(UnitType::kGoblin);
   _combatStats = UnitConfig::getGoblin(level);
 
+  return true;
+}
+
+void GoblinUnit::onDeploy() {
   // 播放部署音效
   AudioManager::GetInstance().PlayEffect(SoundEffectId::kGoblinDeploy);
-
-  return true;
 }
 
 void GoblinUnit::loadAnimations() {
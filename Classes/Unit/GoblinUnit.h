@@ -30,6 +30,9 @@ class GoblinUnit : public BaseUnit {
   /** @brief 获取显示名称 */
   std::string getDisplayName() const override { return "哥布林"; }
 
+  /** @brief 部署到战场（播放部署音效） */
+  void onDeploy() override;
+
  protected:
   bool init(int level) override;
   void loadAnimations() override;
@@ -9,7 +9,6 @@
 #include "WallBreakerUnit.h"
 
 #include "Audio/AudioManager.h"
-#include "Buildings/BaseBuilding.h"
 #include "Unit/CombatStats.h"
 
 USING_NS_CC;
@@ -30,7 +29,7 @@ bool WallBreakerUnit::init(int level) {
   }
 
   // 设置炸弹人特有属性
-  _moveSpeed = 120.0f;
+  _moveSpeed = UnitConfig::getMoveSpeed(UnitType::kWallBreaker);
   _combatStats = UnitConfig::getWallBreaker(level);
 
   // 注：炸弹人没有专门的部署音效，使用死亡/爆炸音效更有特色
@@ -73,19 +72,7 @@ void WallBreakerUnit::onAttackBefore() {
 }
 
 void WallBreakerUnit::onDeathBefore() {
-  // 炸弹人特殊死亡逻辑：爆炸时对目标造成范围伤害
-  if (_currentTarget && !_currentTarget->isDestroyed()) {
-    // 炸弹人对城墙造成40倍伤害
-    float damage = _combatStats.damage;
-    if (_currentTarget->getBuildingType() == BuildingType::kWall) {
-      damage *= 40.0f;
-      CCLOG("💣 炸弹人对城墙造成 %.0f 点伤害！", damage);
-    } else {
-      // 对非城墙建筑造成普通伤害
-      CCLOG("💣 炸弹人对建筑造成 %.0f 点伤害！", damage);
-    }
-    _currentTarget->takeDamage(static_cast<int>(damage));
-  }
+  // 自爆伤害由 BattleSimulation 结算，这里只负责表现
 
   // 播放爆炸/死亡音效
   AudioManager::GetInstance().PlayEffect(SoundEffectId::kWallBreakerDeath);
@@ -96,10 +83,10 @@ void WallBreakerUnit::onDeathBefore() {
   // 创建爆炸视觉效果
   createExplosionEffect();
 
-  // 延迟后移除自身
-  auto removeAction =
-      Sequence::create(DelayTime::create(0.5f), RemoveSelf::create(), nullptr);
-  this->runAction(removeAction);
+  // 延迟后隐藏自身（不留墓碑），移除与回收仍由 BaseUnit::die() 的淡出序列完成
+  auto hideAction =
+      Sequence::create(DelayTime::create(0.5f), Hide::create(), nullptr);
+  this->runAction(hideAction);
 
   CCLOG("💣 炸弹人爆炸！");
 }
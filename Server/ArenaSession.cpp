@@ -55,8 +55,7 @@ ArenaSession::ArenaSession(PlayerRegistry* registry)
 // PVP 请求处理
 // ============================================================================
 
-void ArenaSession::HandlePvpRequest(SOCKET client_socket,
-                                    const std::string& target_id) {
+void ArenaSession::HandlePvpRequest(SOCKET client_socket, InternedId target_id) {
     // 获取请求者信息
     PlayerContext* requester = player_registry_->GetBySocket(client_socket);
     if (requester == nullptr) {
@@ -66,7 +65,7 @@ void ArenaSession::HandlePvpRequest(SOCKET client_socket,
         return;
     }
 
-    std::string requester_id = requester->playerId;
+    InternedId requester_id = requester->playerId;
 
     // 验证：不能攻击自己
     if (requester_id == target_id) {
@@ -98,7 +97,7 @@ void ArenaSession::HandlePvpRequest(SOCKET client_socket,
 
     // 创建会话（需要加锁）
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         // 验证：请求者不能已在战斗中
         if (sessions_.find(requester_id) != sessions_.end()) {
@@ -137,11 +136,11 @@ void ArenaSession::HandlePvpRequest(SOCKET client_socket,
 
     // 发送响应（在锁外进行网络操作，避免死锁）
     std::string attacker_msg = std::string(kRoleAttack) + kFieldSeparator + 
-                               target_id + kFieldSeparator + target_map_data;
+                               target_id.str() + kFieldSeparator + target_map_data;
     sendPacket(client_socket, PACKET_PVP_START, attacker_msg);
 
     std::string defender_msg = std::string(kRoleDefend) + kFieldSeparator + 
-                               requester_id + kFieldSeparator;
+                               requester_id.str() + kFieldSeparator;
     sendPacket(target_socket, PACKET_PVP_START, defender_msg);
 
     // 广播战斗状态更新
@@ -159,16 +158,16 @@ void ArenaSession::HandlePvpAction(SOCKET client_socket,
         return;
     }
 
-    std::string player_id = player->playerId;
+    InternedId player_id = player->playerId;
     
     // 收集需要通知的目标（在锁内获取信息，锁外发送）
-    std::string defender_id;
+    InternedId defender_id;
     SOCKET defender_socket = INVALID_SOCKET;
-    std::vector<std::pair<std::string, SOCKET>> spectators_to_notify;
+    std::vector<std::pair<InternedId, SOCKET>> spectators_to_notify;
     bool session_found = false;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
         
         auto it = sessions_.find(player_id);
         if (it != sessions_.end() && it->second.isActive) {
@@ -219,24 +218,24 @@ void ArenaSession::HandlePvpAction(SOCKET client_socket,
 // 观战请求处理
 // ============================================================================
 
-void ArenaSession::HandleSpectateRequest(SOCKET client_socket,
-                                         const std::string& target_id) {
+void ArenaSession::HandleSpectateRequest(SOCKET client_socket, InternedId target_id) {
     PlayerContext* requester = player_registry_->GetBySocket(client_socket);
     if (requester == nullptr) {
         sendPacket(client_socket, PACKET_SPECTATE_JOIN, "0|||0|");
         return;
     }
 
-    std::string spectator_id = requester->playerId;
+    InternedId spectator_id = requester->playerId;
     
     // 用于存储观战信息
-    std::string attacker_id, defender_id, map_data;
+    InternedId attacker_id, defender_id;
+    std::string map_data;
     std::vector<std::string> history;
     int64_t elapsed_ms = 0;
     bool found = false;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         for (auto& pair : sessions_) {
             if (!pair.second.isActive) {
@@ -308,16 +307,16 @@ void ArenaSession::HandleSpectateRequest(SOCKET client_socket,
 // 结束会话
 // ============================================================================
 
-void ArenaSession::EndSession(const std::string& attacker_id) {
+void ArenaSession::EndSession(InternedId attacker_id) {
     // 收集需要通知的目标
-    std::string defender_id;
+    InternedId defender_id;
     SOCKET defender_socket = INVALID_SOCKET;
-    std::vector<std::pair<std::string, SOCKET>> spectators_to_notify;
+    std::vector<std::pair<InternedId, SOCKET>> spectators_to_notify;
     bool session_found = false;
     size_t total_action_count = 0;  // 🔧 新增：总操作数量
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
         
         auto it = sessions_.find(attacker_id);
         if (it == sessions_.end()) {
@@ -384,10 +383,10 @@ void ArenaSession::EndSession(const std::string& attacker_id) {
 // 玩家断开连接清理
 // ============================================================================
 
-void ArenaSession::CleanupPlayerSessions(const std::string& player_id) {
+void ArenaSession::CleanupPlayerSessions(InternedId player_id) {
     // 收集需要通知的目标
     struct NotifyTarget {
-        std::string id;
+        InternedId id;
         SOCKET socket;
         size_t action_count;
     };
@@ -396,7 +395,7 @@ void ArenaSession::CleanupPlayerSessions(const std::string& player_id) {
     std::vector<NotifyTarget> spectators_to_notify;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         // 清理玩家作为攻击者的会话
         auto it = sessions_.find(player_id);
@@ -498,7 +497,7 @@ void ArenaSession::CleanupPlayerSessions(const std::string& player_id) {
 // ============================================================================
 
 std::string ArenaSession::GetBattleStatusListJson() {
-    std::lock_guard<std::mutex> lock(session_mutex_);
+    std::lock_guard<StateMutex> lock(session_mutex_);
 
     std::ostringstream oss;
     oss << "{\"statuses\":[";
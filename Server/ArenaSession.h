@@ -9,6 +9,7 @@
 #pragma once
 
 #include "PlayerRegistry.h"
+#include "StateMutex.h"
 #include "WarModels.h"
 
 #include <chrono>
@@ -78,7 +79,7 @@ class ArenaSession {
      *
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
-    void HandlePvpRequest(SOCKET client_socket, const std::string& target_id);
+    void HandlePvpRequest(SOCKET client_socket, InternedId target_id);
 
     /**
      * @brief 处理 PVP 操作（单位部署）。
@@ -114,8 +115,7 @@ class ArenaSession {
      * @note 观战者会收到历史操作记录用于追赶进度。
      * @note 线程安全：此方法内部加锁保护。
      */
-    void HandleSpectateRequest(SOCKET client_socket,
-                               const std::string& target_id);
+    void HandleSpectateRequest(SOCKET client_socket, InternedId target_id);
 
     /**
      * @brief 结束指定攻击者的 PVP 会话。
@@ -129,7 +129,7 @@ class ArenaSession {
      *
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
-    void EndSession(const std::string& attacker_id);
+    void EndSession(InternedId attacker_id);
 
     /**
      * @brief 清理指定玩家相关的所有会话。
@@ -146,7 +146,7 @@ class ArenaSession {
      *
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
-    void CleanupPlayerSessions(const std::string& player_id);
+    void CleanupPlayerSessions(InternedId player_id);
 
     /**
      * @brief 获取所有活跃战斗的 JSON 状态列表。
@@ -178,7 +178,7 @@ class ArenaSession {
     void BroadcastBattleStatusToAll();
 
  private:
-    std::map<std::string, PvpSession> sessions_;  ///< PVP 会话映射（攻击者ID -> 会话）
-    std::mutex session_mutex_;                     ///< 保护 sessions_ 的互斥锁
+    std::map<InternedId, PvpSession> sessions_;   ///< PVP 会话映射（攻击者ID -> 会话）
+    StateMutex session_mutex_;                     ///< 保护 sessions_ 的互斥锁
     PlayerRegistry* player_registry_;              ///< 玩家注册表指针（非拥有）
 };
\ No newline at end of file
@@ -17,29 +17,41 @@
 // 构造函数
 // ============================================================================
 
-ClanHall::ClanHall(PlayerRegistry* registry) 
+ClanHall::ClanHall(PlayerRegistry* registry,
+                   const std::string& data_file_path,
+                   ClanOwnershipFilter owns)
     : player_registry_(registry)
-    , data_file_path_("clan_data.txt")
-    , clan_id_counter_(0) {
-    LoadFromFile();
+    , data_file_path_(data_file_path)
+    , clan_id_counter_(0)
+    , owns_(std::move(owns)) {
+    if (!LoadFromFile(data_file_path_) && owns_) {
+        // 分片首次启动：从单进程模式的共享文件导入归属本分片的部落
+        if (LoadFromFile("clan_data.txt")) {
+            SaveToFile();
+        }
+    }
 }
 
 // ============================================================================
 // 私有辅助方法
 // ============================================================================
 
-std::string ClanHall::GenerateClanId() {
-    return "CLAN_" + std::to_string(++clan_id_counter_);
+InternedId ClanHall::GenerateClanId() {
+    std::string clan_id;
+    do {
+        clan_id = "CLAN_" + std::to_string(++clan_id_counter_);
+    } while (owns_ && !owns_(clan_id));
+    return InternedId::Intern(clan_id);
 }
 
-void ClanHall::LoadFromFile() {
-    std::ifstream file(data_file_path_);
+bool ClanHall::LoadFromFile(const std::string& path) {
+    std::ifstream file(path);
     if (!file.is_open()) {
-        std::cout << "[Clan] 未找到部落数据文件: " << data_file_path_ << "，将创建新文件" << std::endl;
-        return;
+        std::cout << "[Clan] 未找到部落数据文件: " << path << "，将创建新文件" << std::endl;
+        return false;
     }
 
-    std::cout << "[Clan] 正在加载部落数据文件: " << data_file_path_ << std::endl;
+    std::cout << "[Clan] 正在加载部落数据文件: " << path << std::endl;
 
     std::string line;
     // 读取计数器
@@ -66,10 +78,11 @@ void ClanHall::LoadFromFile() {
     // 读取每个部落的数据
     for (int i = 0; i < clan_count; ++i) {
         ClanInfo clan;
-        
-        if (!std::getline(file, clan.clanId)) break;
+        std::string clan_id, leader_id;
+
+        if (!std::getline(file, clan_id)) break;
         if (!std::getline(file, clan.clanName)) break;
-        if (!std::getline(file, clan.leaderId)) break;
+        if (!std::getline(file, leader_id)) break;
         if (!std::getline(file, clan.description)) break;
         
         if (std::getline(file, line)) {
@@ -87,27 +100,39 @@ void ClanHall::LoadFromFile() {
         if (std::getline(file, line)) {
             try { member_count = std::stoi(line); } catch (...) {}
         }
+        std::vector<std::string> member_ids;
         for (int j = 0; j < member_count; ++j) {
             std::string member_id;
             if (std::getline(file, member_id) && !member_id.empty()) {
-                clan.memberIds.push_back(member_id);
+                member_ids.push_back(member_id);
             }
         }
 
-        if (!clan.clanId.empty()) {
-            clans_[clan.clanId] = clan;
-            std::cout << "[Clan] 已加载部落: " << clan.clanName 
-                      << " (ID: " << clan.clanId 
-                      << ", 族长: " << clan.leaderId
-                      << ", 成员: " << clan.memberIds.size() << ")" << std::endl;
-            for (const auto& m : clan.memberIds) {
-                std::cout << "[Clan]   - 成员: " << m << std::endl;
-            }
+        if (clan_id.empty() || (owns_ && !owns_(clan_id))) {
+            continue;  // 无效记录或归属其它分片
+        }
+
+        // 只驻留本分片保留的部落及其成员
+        clan.clanId = InternedId::Intern(clan_id);
+        clan.leaderId = InternedId::Intern(leader_id);
+        clan.memberIds.reserve(member_ids.size());
+        for (const auto& member_id : member_ids) {
+            clan.memberIds.push_back(InternedId::Intern(member_id));
+        }
+
+        clans_[clan.clanId] = clan;
+        std::cout << "[Clan] 已加载部落: " << clan.clanName 
+                  << " (ID: " << clan.clanId 
+                  << ", 族长: " << clan.leaderId
+                  << ", 成员: " << clan.memberIds.size() << ")" << std::endl;
+        for (const auto& m : clan.memberIds) {
+            std::cout << "[Clan]   - 成员: " << m << std::endl;
         }
     }
 
     file.close();
     std::cout << "[Clan] 共加载 " << clans_.size() << " 个部落" << std::endl;
+    return true;
 }
 
 void ClanHall::SaveToFile() {
@@ -146,7 +171,7 @@ void ClanHall::SaveToFile() {
 // 部落创建与管理
 // ============================================================================
 
-bool ClanHall::CreateClan(const std::string& player_id,
+bool ClanHall::CreateClan(InternedId player_id,
                           const std::string& clan_name) {
     // 验证玩家存在性
     PlayerContext* player = player_registry_->GetById(player_id);
@@ -163,9 +188,9 @@ bool ClanHall::CreateClan(const std::string& player_id,
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
-    std::string clan_id = GenerateClanId();
+    InternedId clan_id = GenerateClanId();
 
     // 创建部落记录
     ClanInfo clan;
@@ -190,8 +215,7 @@ bool ClanHall::CreateClan(const std::string& player_id,
     return true;
 }
 
-bool ClanHall::JoinClan(const std::string& player_id,
-                        const std::string& clan_id) {
+bool ClanHall::JoinClan(InternedId player_id, InternedId clan_id) {
     // 验证玩家存在性
     PlayerContext* player = player_registry_->GetById(player_id);
     if (player == nullptr) {
@@ -207,7 +231,7 @@ bool ClanHall::JoinClan(const std::string& player_id,
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     // 验证目标部落存在
     auto it = clans_.find(clan_id);
@@ -245,7 +269,7 @@ bool ClanHall::JoinClan(const std::string& player_id,
     return true;
 }
 
-bool ClanHall::LeaveClan(const std::string& player_id) {
+bool ClanHall::LeaveClan(InternedId player_id) {
     // 验证玩家存在性
     PlayerContext* player = player_registry_->GetById(player_id);
     if (player == nullptr) {
@@ -253,12 +277,12 @@ bool ClanHall::LeaveClan(const std::string& player_id) {
     }
 
     // 验证玩家已加入部落
-    std::string clan_id = player->clanId;
+    InternedId clan_id = player->clanId;
     if (clan_id.empty()) {
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     // 查找部落
     auto it = clans_.find(clan_id);
@@ -271,7 +295,7 @@ bool ClanHall::LeaveClan(const std::string& player_id) {
     members.erase(std::remove(members.begin(), members.end(), player_id),
                   members.end());
     it->second.clanTrophies -= player->trophies;
-    player->clanId = "";
+    player->clanId = InternedId();
 
     // 如果部落为空，删除部落
     if (members.empty()) {
@@ -291,7 +315,7 @@ bool ClanHall::LeaveClan(const std::string& player_id) {
 // ============================================================================
 
 std::string ClanHall::GetClanListJson() {
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     std::ostringstream oss;
     oss << "[";
@@ -316,8 +340,8 @@ std::string ClanHall::GetClanListJson() {
     return oss.str();
 }
 
-std::string ClanHall::GetClanMembersJson(const std::string& clan_id) {
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+std::string ClanHall::GetClanMembersJson(InternedId clan_id) {
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     auto it = clans_.find(clan_id);
     if (it == clans_.end()) {
@@ -338,7 +362,7 @@ std::string ClanHall::GetClanMembersJson(const std::string& clan_id) {
         PlayerContext* player = player_registry_->GetById(member_id);
         bool online = (player != nullptr);
         int trophies = online ? player->trophies : 0;
-        std::string name = online ? player->playerName : member_id;
+        const std::string& name = online ? player->playerName : member_id.str();
 
         oss << "{" << "\"id\":\"" << member_id << "\",\""
             << "name\":\"" << name << "\",\""
@@ -350,9 +374,8 @@ std::string ClanHall::GetClanMembersJson(const std::string& clan_id) {
     return oss.str();
 }
 
-bool ClanHall::IsPlayerInClan(const std::string& player_id,
-                              const std::string& clan_id) {
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+bool ClanHall::IsPlayerInClan(InternedId player_id, InternedId clan_id) {
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     auto it = clans_.find(clan_id);
     if (it == clans_.end()) {
@@ -363,8 +386,8 @@ bool ClanHall::IsPlayerInClan(const std::string& player_id,
     return std::find(members.begin(), members.end(), player_id) != members.end();
 }
 
-std::vector<std::string> ClanHall::GetClanMemberIds(const std::string& clan_id) {
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+std::vector<InternedId> ClanHall::GetClanMemberIds(InternedId clan_id) {
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     auto it = clans_.find(clan_id);
     if (it == clans_.end()) {
@@ -374,7 +397,7 @@ std::vector<std::string> ClanHall::GetClanMemberIds(const std::string& clan_id)
     return it->second.memberIds;  // 返回副本
 }
 
-void ClanHall::EnsurePlayerInClan(const std::string& player_id, const std::string& clan_id) {
+void ClanHall::EnsurePlayerInClan(InternedId player_id, InternedId clan_id) {
     if (player_id.empty() || clan_id.empty()) {
         return;
     }
@@ -386,7 +409,7 @@ void ClanHall::EnsurePlayerInClan(const std::string& player_id, const std::strin
         return;
     }
 
-    std::lock_guard<std::mutex> lock(clan_mutex_);
+    std::lock_guard<StateMutex> lock(clan_mutex_);
 
     std::cout << "[Clan] EnsurePlayerInClan: 玩家=" << player_id 
               << ", 请求部落=" << clan_id 
@@ -411,9 +434,10 @@ void ClanHall::EnsurePlayerInClan(const std::string& player_id, const std::strin
         clans_[clan_id] = clan;
         
         // 更新计数器，确保不会生成重复ID
-        if (clan_id.length() > 5 && clan_id.substr(0, 5) == "CLAN_") {
+        const std::string& clan_name = clan_id.str();
+        if (clan_name.length() > 5 && clan_name.compare(0, 5, "CLAN_") == 0) {
             try {
-                int id_num = std::stoi(clan_id.substr(5));
+                int id_num = std::stoi(clan_name.substr(5));
                 if (id_num >= clan_id_counter_) {
                     clan_id_counter_ = id_num;
                 }
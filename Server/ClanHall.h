@@ -10,12 +10,17 @@
 
 #include "ClanInfo.h"
 #include "PlayerRegistry.h"
+#include "StateMutex.h"
 
+#include <functional>
 #include <map>
 #include <mutex>
 #include <string>
 #include <vector>
 
+/// 部落归属判定：分片模式下只加载、持久化和生成归属本分片的部落ID
+using ClanOwnershipFilter = std::function<bool(const std::string&)>;
+
 /**
  * @class ClanHall
  * @brief 管理部落的创建、加入、离开及信息查询。
@@ -49,8 +54,13 @@ class ClanHall {
      *
      * @param registry 玩家注册表指针，用于获取和更新玩家的部落信息。
      *                 调用者需保证 registry 在 ClanHall 生命周期内有效。
+     * @param data_file_path 部落数据文件路径
+     * @param owns 部落归属判定，为空表示单进程模式（拥有全部部落）。
+     *             分片模式下首次启动时从共享的 clan_data.txt 导入归属本分片的部落。
      */
-    explicit ClanHall(PlayerRegistry* registry);
+    explicit ClanHall(PlayerRegistry* registry,
+                      const std::string& data_file_path = "clan_data.txt",
+                      ClanOwnershipFilter owns = nullptr);
 
     /**
      * @brief 创建新部落。
@@ -68,7 +78,7 @@ class ClanHall {
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    bool CreateClan(const std::string& player_id, const std::string& clan_name);
+    bool CreateClan(InternedId player_id, const std::string& clan_name);
 
     /**
      * @brief 加入指定部落。
@@ -88,7 +98,7 @@ class ClanHall {
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    bool JoinClan(const std::string& player_id, const std::string& clan_id);
+    bool JoinClan(InternedId player_id, InternedId clan_id);
 
     /**
      * @brief 离开当前部落。
@@ -106,7 +116,7 @@ class ClanHall {
      * @note 目前族长离开部落时，部落不会自动转让，可能导致部落无族长。
      * @note 线程安全：此方法内部加锁保护。
      */
-    bool LeaveClan(const std::string& player_id);
+    bool LeaveClan(InternedId player_id);
 
     /**
      * @brief 获取所有部落的 JSON 列表。
@@ -150,7 +160,7 @@ class ClanHall {
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    std::string GetClanMembersJson(const std::string& clan_id);
+    std::string GetClanMembersJson(InternedId clan_id);
 
     /**
      * @brief 检查玩家是否在指定部落中。
@@ -161,8 +171,7 @@ class ClanHall {
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    bool IsPlayerInClan(const std::string& player_id,
-                        const std::string& clan_id);
+    bool IsPlayerInClan(InternedId player_id, InternedId clan_id);
 
     /**
      * @brief 获取部落的所有成员ID列表。
@@ -173,7 +182,7 @@ class ClanHall {
      * @note 返回的是副本，调用者可以安全使用。
      * @note 线程安全：此方法内部加锁保护。
      */
-    std::vector<std::string> GetClanMemberIds(const std::string& clan_id);
+    std::vector<InternedId> GetClanMemberIds(InternedId clan_id);
 
     /**
      * @brief 确保玩家在指定部落中（用于登录时恢复部落归属）。
@@ -186,33 +195,38 @@ class ClanHall {
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    void EnsurePlayerInClan(const std::string& player_id, const std::string& clan_id);
+    void EnsurePlayerInClan(InternedId player_id, InternedId clan_id);
 
  private:
-    std::map<std::string, ClanInfo> clans_;  ///< 部落映射表（部落ID -> 部落信息）
-    std::mutex clan_mutex_;                   ///< 保护 clans_ 的互斥锁
+    std::map<InternedId, ClanInfo> clans_;   ///< 部落映射表（部落ID -> 部落信息，按创建先后排序）
+    StateMutex clan_mutex_;                   ///< 保护 clans_ 的互斥锁
     PlayerRegistry* player_registry_;         ///< 玩家注册表指针（非拥有）
     std::string data_file_path_;              ///< 部落数据文件路径
     int clan_id_counter_;                     ///< 部落ID计数器
+    ClanOwnershipFilter owns_;                ///< 部落归属判定（分片模式）
 
     /**
      * @brief 生成唯一的部落ID。
      *
      * 使用计数器生成格式为 "CLAN_xxx" 的唯一标识符。
+     * 分片模式下跳过不归属本分片的ID，保证各分片生成的ID互不冲突。
      *
-     * @return 新生成的部落ID字符串
+     * @return 新生成（已驻留）的部落ID
      *
      * @note 此方法不是线程安全的，应在持有 clan_mutex_ 时调用。
      */
-    std::string GenerateClanId();
+    InternedId GenerateClanId();
 
     /**
      * @brief 从文件加载部落数据。
      *
      * 在构造时调用，从本地文件恢复所有部落信息。
      * 如果文件不存在或格式错误，则跳过加载。
+     *
+     * @param path 数据文件路径
+     * @return 文件存在并已读取返回 true
      */
-    void LoadFromFile();
+    bool LoadFromFile(const std::string& path);
 
     /**
      * @brief 将部落数据保存到文件。
@@ -8,7 +8,8 @@
  ****************************************************************/
 #pragma once
 
-#include <WinSock2.h>
+#include "IdInterner.h"
+#include "PlatformSocket.h"
 
 #include <chrono>
 #include <string>
@@ -28,9 +29,9 @@ struct PlayerContext {
     SOCKET socket = INVALID_SOCKET;    ///< 玩家的网络套接字句柄
 
     // 玩家身份信息
-    std::string playerId;              ///< 玩家唯一标识符（登录账号）
+    InternedId playerId;               ///< 玩家唯一标识符（登录账号）
     std::string playerName;            ///< 玩家昵称（显示名称）
-    std::string clanId;                ///< 所属部落ID，空字符串表示未加入部落
+    InternedId clanId;                 ///< 所属部落ID，空标识符表示未加入部落
 
     // 游戏数据
     std::string mapData;               ///< 玩家地图数据（JSON格式）
@@ -54,13 +55,13 @@ struct PlayerContext {
  */
 struct ClanInfo {
     // 部落身份信息
-    std::string clanId;                  ///< 部落唯一标识符，格式："CLAN_xxx"
+    InternedId clanId;                   ///< 部落唯一标识符，格式："CLAN_xxx"
     std::string clanName;                ///< 部落名称（显示名称）
-    std::string leaderId;                ///< 族长（创建者）的玩家ID
+    InternedId leaderId;                 ///< 族长（创建者）的玩家ID
     std::string description;             ///< 部落描述文本
 
     // 成员管理
-    std::vector<std::string> memberIds;  ///< 部落成员ID列表
+    std::vector<InternedId> memberIds;   ///< 部落成员ID列表
 
     // 部落属性
     int clanTrophies = 0;                ///< 部落总奖杯数（所有成员奖杯之和）
@@ -80,7 +81,7 @@ struct ClanInfo {
  */
 struct MatchQueueEntry {
     SOCKET socket;                       ///< 玩家套接字，用于发送匹配结果
-    std::string playerId;                ///< 玩家ID
+    InternedId playerId;                 ///< 玩家ID
     int trophies;                        ///< 玩家奖杯数，用于匹配算法
     std::chrono::steady_clock::time_point queueTime;  ///< 入队时间，用于超时处理
 };
\ No newline at end of file
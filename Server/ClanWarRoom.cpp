@@ -28,17 +28,17 @@ ClanWarRoom::ClanWarRoom(PlayerRegistry* registry, ClanHall* hall)
 // 私有辅助方法
 // ============================================================================
 
-std::string ClanWarRoom::GenerateWarId() {
+InternedId ClanWarRoom::GenerateWarId() {
     static int counter = 0;
-    return "WAR_" + std::to_string(++counter);
+    return InternedId::Intern("WAR_" + std::to_string(++counter));
 }
 
 // ============================================================================
 // 匹配队列管理
 // ============================================================================
 
-void ClanWarRoom::AddToQueue(const std::string& clan_id) {
-    std::lock_guard<std::mutex> lock(war_mutex_);
+void ClanWarRoom::AddToQueue(InternedId clan_id) {
+    std::lock_guard<StateMutex> lock(war_mutex_);
 
     // 检查部落是否已在队列中
     if (std::find(war_queue_.begin(), war_queue_.end(), clan_id) !=
@@ -48,7 +48,7 @@ void ClanWarRoom::AddToQueue(const std::string& clan_id) {
 
     // 检查部落是否已在活跃战争中
     {
-        std::lock_guard<std::mutex> session_lock(session_mutex_);
+        std::lock_guard<StateMutex> session_lock(session_mutex_);
         for (const auto& war_pair : active_wars_) {
             if (war_pair.second.clan1Id == clan_id ||
                 war_pair.second.clan2Id == clan_id) {
@@ -72,8 +72,8 @@ void ClanWarRoom::ProcessQueue() {
     }
 
     // 取出队列前两个部落进行匹配
-    std::string clan1_id = war_queue_[0];
-    std::string clan2_id = war_queue_[1];
+    InternedId clan1_id = war_queue_[0];
+    InternedId clan2_id = war_queue_[1];
 
     war_queue_.erase(war_queue_.begin());
     war_queue_.erase(war_queue_.begin());
@@ -85,12 +85,11 @@ void ClanWarRoom::ProcessQueue() {
 // 战争生命周期管理
 // ============================================================================
 
-void ClanWarRoom::StartWar(const std::string& clan1_id,
-                           const std::string& clan2_id) {
-    std::string war_id = GenerateWarId();
+void ClanWarRoom::StartWar(InternedId clan1_id, InternedId clan2_id) {
+    InternedId war_id = GenerateWarId();
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         // 初始化战争会话
         ClanWarSession session;
@@ -143,9 +142,9 @@ void ClanWarRoom::StartWar(const std::string& clan1_id,
     }
 
     // 在锁外发送网络通知，避免死锁
-    std::string msg = war_id + "|" + clan1_id + "|" + clan2_id;
+    std::string msg = war_id.str() + "|" + clan1_id.str() + "|" + clan2_id.str();
 
-    auto notify_members = [&](const std::vector<std::string>& member_ids) {
+    auto notify_members = [&](const std::vector<InternedId>& member_ids) {
         for (const auto& member_id : member_ids) {
             PlayerContext* player = player_registry_->GetById(member_id);
             if (player != nullptr && player->socket != INVALID_SOCKET) {
@@ -158,14 +157,14 @@ void ClanWarRoom::StartWar(const std::string& clan1_id,
     notify_members(clan_hall_->GetClanMemberIds(clan2_id));
 }
 
-void ClanWarRoom::EndWar(const std::string& war_id) {
+void ClanWarRoom::EndWar(InternedId war_id) {
     std::string result_json;
-    std::string clan1_id, clan2_id;
-    std::vector<std::string> all_member_ids;
+    InternedId clan1_id, clan2_id;
+    std::vector<InternedId> all_member_ids;
     std::vector<std::pair<SOCKET, std::string>> packets_to_send;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         auto it = active_wars_.find(war_id);
         if (it == active_wars_.end()) {
@@ -215,13 +214,13 @@ void ClanWarRoom::EndWar(const std::string& war_id) {
         clan2_id = session.clan2Id;
 
         // 确定胜者（星数多者胜，相同则平局）
-        std::string winner_id;
+        InternedId winner_id;
         if (session.clan1TotalStars > session.clan2TotalStars) {
             winner_id = session.clan1Id;
         } else if (session.clan2TotalStars > session.clan1TotalStars) {
             winner_id = session.clan2Id;
         }
-        // 星数相同：winner_id 保持为空表示平局
+        // 星数相同：winner_id 保持为空标识符表示平局
 
         // 构建结果 JSON
         std::ostringstream oss;
@@ -247,7 +246,7 @@ void ClanWarRoom::EndWar(const std::string& war_id) {
         active_wars_.erase(it);
 
         std::cout << "[ClanWar] 战争结束: " << war_id << " (胜者: "
-                  << (winner_id.empty() ? "平局" : winner_id) << ")"
+                  << (winner_id.empty() ? std::string("平局") : winner_id.str()) << ")"
                   << std::endl;
     }
 
@@ -271,8 +270,8 @@ void ClanWarRoom::EndWar(const std::string& war_id) {
 // ============================================================================
 
 void ClanWarRoom::HandleAttackStart(SOCKET client_socket,
-                                    const std::string& war_id,
-                                    const std::string& target_id) {
+                                    InternedId war_id,
+                                    InternedId target_id) {
     // 验证攻击者身份
     PlayerContext* attacker = player_registry_->GetBySocket(client_socket);
     if (attacker == nullptr) {
@@ -281,11 +280,11 @@ void ClanWarRoom::HandleAttackStart(SOCKET client_socket,
         return;
     }
 
-    std::string attacker_id = attacker->playerId;
+    InternedId attacker_id = attacker->playerId;
     std::string target_map_data;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         // 验证战争存在
         auto it = active_wars_.find(war_id);
@@ -353,20 +352,20 @@ void ClanWarRoom::HandleAttackStart(SOCKET client_socket,
               << " (战争: " << war_id << ")" << std::endl;
 
     // 在锁外发送响应
-    std::string response = "ATTACK|" + target_id + "|" + target_map_data;
+    std::string response = "ATTACK|" + target_id.str() + "|" + target_map_data;
     sendPacket(client_socket, PACKET_WAR_ATTACK_START, response);
 }
 
-void ClanWarRoom::HandleAttackEnd(const std::string& war_id,
+void ClanWarRoom::HandleAttackEnd(InternedId war_id,
                                   const AttackRecord& record) {
     bool need_broadcast = false;
-    std::string defender_id;
+    InternedId defender_id;
     SOCKET defender_socket = INVALID_SOCKET;
-    std::vector<std::pair<std::string, SOCKET>> spectators_to_notify;
+    std::vector<std::pair<InternedId, SOCKET>> spectators_to_notify;
     size_t total_action_count = 0;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         // 查找战争会话
         auto it = active_wars_.find(war_id);
@@ -476,8 +475,8 @@ void ClanWarRoom::HandleAttackEnd(const std::string& war_id,
 // ============================================================================
 
 void ClanWarRoom::HandleSpectate(SOCKET client_socket,
-                                 const std::string& war_id,
-                                 const std::string& target_id) {
+                                 InternedId war_id,
+                                 InternedId target_id) {
     // 验证观战者身份
     PlayerContext* spectator = player_registry_->GetBySocket(client_socket);
     if (spectator == nullptr) {
@@ -485,13 +484,14 @@ void ClanWarRoom::HandleSpectate(SOCKET client_socket,
         return;
     }
 
-    std::string spectator_id = spectator->playerId;
-    std::string attacker_id, defender_id, map_data;
+    InternedId spectator_id = spectator->playerId;
+    InternedId attacker_id, defender_id;
+    std::string map_data;
     std::vector<std::string> history;
     bool found = false;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         // 查找战争会话
         auto it = active_wars_.find(war_id);
@@ -557,11 +557,11 @@ void ClanWarRoom::HandleSpectate(SOCKET client_socket,
 // 玩家断开连接清理
 // ============================================================================
 
-void ClanWarRoom::CleanupPlayerSessions(const std::string& player_id) {
+void ClanWarRoom::CleanupPlayerSessions(InternedId player_id) {
     std::vector<std::pair<SOCKET, std::string>> packets_to_send;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         for (auto& war_pair : active_wars_) {
             ClanWarSession& session = war_pair.second;
@@ -607,8 +607,8 @@ void ClanWarRoom::CleanupPlayerSessions(const std::string& player_id) {
 // 查询方法
 // ============================================================================
 
-std::string ClanWarRoom::GetActiveWarIdForPlayer(const std::string& player_id) {
-    std::lock_guard<std::mutex> lock(session_mutex_);
+InternedId ClanWarRoom::GetActiveWarIdForPlayer(InternedId player_id) {
+    std::lock_guard<StateMutex> lock(session_mutex_);
 
     for (const auto& war_pair : active_wars_) {
         const ClanWarSession& session = war_pair.second;
@@ -629,12 +629,11 @@ std::string ClanWarRoom::GetActiveWarIdForPlayer(const std::string& player_id) {
         }
     }
 
-    return "";
+    return InternedId();
 }
 
-std::string ClanWarRoom::GetMemberListJson(const std::string& war_id,
-                                           const std::string& requester_id) {
-    std::lock_guard<std::mutex> lock(session_mutex_);
+std::string ClanWarRoom::GetMemberListJson(InternedId war_id, InternedId requester_id) {
+    std::lock_guard<StateMutex> lock(session_mutex_);
 
     auto it = active_wars_.find(war_id);
     if (it == active_wars_.end()) {
@@ -681,12 +680,12 @@ std::string ClanWarRoom::GetMemberListJson(const std::string& war_id,
 // 状态广播
 // ============================================================================
 
-void ClanWarRoom::BroadcastWarUpdate(const std::string& war_id) {
+void ClanWarRoom::BroadcastWarUpdate(InternedId war_id) {
     std::string state_json;
-    std::string clan1_id, clan2_id;
+    InternedId clan1_id, clan2_id;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         auto it = active_wars_.find(war_id);
         if (it == active_wars_.end()) {
@@ -709,7 +708,7 @@ void ClanWarRoom::BroadcastWarUpdate(const std::string& war_id) {
     }
 
     // 在锁外发送给双方所有成员
-    auto send_to_members = [&](const std::vector<std::string>& member_ids) {
+    auto send_to_members = [&](const std::vector<InternedId>& member_ids) {
         for (const auto& member_id : member_ids) {
             PlayerContext* player = player_registry_->GetById(member_id);
             if (player != nullptr && player->socket != INVALID_SOCKET) {
@@ -723,12 +722,12 @@ void ClanWarRoom::BroadcastWarUpdate(const std::string& war_id) {
     send_to_members(clan_hall_->GetClanMemberIds(clan2_id));
 }
 
-void ClanWarRoom::BroadcastWarEnd(const std::string& war_id,
+void ClanWarRoom::BroadcastWarEnd(InternedId war_id,
                                   const std::string& result_json) {
-    std::string clan1_id, clan2_id;
+    InternedId clan1_id, clan2_id;
 
     {
-        std::lock_guard<std::mutex> lock(session_mutex_);
+        std::lock_guard<StateMutex> lock(session_mutex_);
 
         auto it = active_wars_.find(war_id);
         if (it == active_wars_.end()) {
@@ -740,7 +739,7 @@ void ClanWarRoom::BroadcastWarEnd(const std::string& war_id,
     }
 
     // 在锁外发送给双方所有成员
-    auto send_to_members = [&](const std::vector<std::string>& member_ids) {
+    auto send_to_members = [&](const std::vector<InternedId>& member_ids) {
         for (const auto& member_id : member_ids) {
             PlayerContext* player = player_registry_->GetById(member_id);
             if (player != nullptr && player->socket != INVALID_SOCKET) {
@@ -10,6 +10,7 @@
 
 #include "ClanHall.h"
 #include "PlayerRegistry.h"
+#include "StateMutex.h"
 #include "WarModels.h"
 
 #include <map>
@@ -71,7 +72,7 @@ class ClanWarRoom {
      * @note 目前匹配算法简单地取前两个部落，未考虑实力匹配。
      * @note 线程安全：此方法内部加锁保护。
      */
-    void AddToQueue(const std::string& clan_id);
+    void AddToQueue(InternedId clan_id);
 
     /**
      * @brief 处理部落战攻击开始请求。
@@ -95,8 +96,8 @@ class ClanWarRoom {
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
     void HandleAttackStart(SOCKET client_socket,
-                           const std::string& war_id,
-                           const std::string& target_id);
+                           InternedId war_id,
+                           InternedId target_id);
 
     /**
      * @brief 处理部落战攻击结束。
@@ -109,7 +110,7 @@ class ClanWarRoom {
      *
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
-    void HandleAttackEnd(const std::string& war_id, const AttackRecord& record);
+    void HandleAttackEnd(InternedId war_id, const AttackRecord& record);
 
     /**
      * @brief 处理部落战观战请求。
@@ -130,8 +131,8 @@ class ClanWarRoom {
      * @note 线程安全：此方法内部加锁保护。
      */
     void HandleSpectate(SOCKET client_socket,
-                        const std::string& war_id,
-                        const std::string& target_id);
+                        InternedId war_id,
+                        InternedId target_id);
 
     /**
      * @brief 结束指定的部落战争。
@@ -155,7 +156,7 @@ class ClanWarRoom {
      *
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
-    void EndWar(const std::string& war_id);
+    void EndWar(InternedId war_id);
 
     /**
      * @brief 清理玩家相关的所有战争会话。
@@ -171,7 +172,7 @@ class ClanWarRoom {
      *
      * @note 线程安全：此方法在锁外发送网络包以避免死锁。
      */
-    void CleanupPlayerSessions(const std::string& player_id);
+    void CleanupPlayerSessions(InternedId player_id);
 
     /**
      * @brief 获取战争成员列表的 JSON 表示。
@@ -198,8 +199,7 @@ class ClanWarRoom {
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    std::string GetMemberListJson(const std::string& war_id,
-                                  const std::string& requester_id);
+    std::string GetMemberListJson(InternedId war_id, InternedId requester_id);
 
     /**
      * @brief 获取玩家所在的活跃战争ID。
@@ -207,20 +207,20 @@ class ClanWarRoom {
      * 遍历所有活跃战争，查找包含指定玩家的战争。
      *
      * @param player_id 玩家ID
-     * @return 战争ID，如果玩家不在任何战争中返回空字符串
+     * @return 战争ID，如果玩家不在任何战争中返回空标识符
      *
      * @note 线程安全：此方法内部加锁保护。
      */
-    std::string GetActiveWarIdForPlayer(const std::string& player_id);
+    InternedId GetActiveWarIdForPlayer(InternedId player_id);
 
  private:
     // 战争数据
-    std::map<std::string, ClanWarSession> active_wars_;  ///< 活跃战争（战争ID -> 会话）
-    std::vector<std::string> war_queue_;                 ///< 等待匹配的部落队列
+    std::map<InternedId, ClanWarSession> active_wars_;   ///< 活跃战争（战争ID -> 会话）
+    std::vector<InternedId> war_queue_;                  ///< 等待匹配的部落队列
 
     // 同步原语
-    std::mutex war_mutex_;                               ///< 保护 war_queue_ 的互斥锁
-    std::mutex session_mutex_;                           ///< 保护 active_wars_ 的互斥锁
+    StateMutex war_mutex_;                               ///< 保护 war_queue_ 的互斥锁
+    StateMutex session_mutex_;                           ///< 保护 active_wars_ 的互斥锁
 
     // 依赖组件
     PlayerRegistry* player_registry_;                    ///< 玩家注册表（非拥有）
@@ -231,9 +231,9 @@ class ClanWarRoom {
      *
      * 使用静态计数器生成格式为 "WAR_xxx" 的唯一标识符。
      *
-     * @return 新生成的战争ID字符串
+     * @return 新生成（已驻留）的战争ID
      */
-    std::string GenerateWarId();
+    InternedId GenerateWarId();
 
     /**
      * @brief 处理匹配队列，尝试匹配两个部落。
@@ -252,7 +252,7 @@ class ClanWarRoom {
      * @param clan1_id 第一个部落ID
      * @param clan2_id 第二个部落ID
      */
-    void StartWar(const std::string& clan1_id, const std::string& clan2_id);
+    void StartWar(InternedId clan1_id, InternedId clan2_id);
 
     /**
      * @brief 广播战争状态更新给所有参与者。
@@ -261,7 +261,7 @@ class ClanWarRoom {
      *
      * @param war_id 战争ID
      */
-    void BroadcastWarUpdate(const std::string& war_id);
+    void BroadcastWarUpdate(InternedId war_id);
 
     /**
      * @brief 广播战争结束通知给所有参与者。
@@ -269,5 +269,5 @@ class ClanWarRoom {
      * @param war_id 战争ID
      * @param result_json 战争结果的 JSON 字符串
      */
-    void BroadcastWarEnd(const std::string& war_id, const std::string& result_json);
+    void BroadcastWarEnd(InternedId war_id, const std::string& result_json);
 };
\ No newline at end of file
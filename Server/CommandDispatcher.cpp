@@ -22,4 +22,21 @@ void Router::Route(SOCKET client, uint32_t packet_type,
     } else {
         std::cout << "[Router] 未知的数据包类型: " << packet_type << std::endl;
     }
-}
\ No newline at end of file
+}
+
+RateDecision Router::Admit(ConnectionRateState& state, uint32_t packet_type,
+                           uint32_t length) {
+    return rate_limiter_.Check(state, packet_type, length);
+}
+
+void Router::SetRateLimitConfig(const RateLimitConfig& config) {
+    rate_limiter_.SetConfig(config);
+}
+
+std::string Router::GetRateLimitStats() const {
+    return rate_limiter_.GetStatsDump();
+}
+
+uint64_t Router::GetRejectedPacketCount() const {
+    return rate_limiter_.GetRejectedTotal();
+}
@@ -8,7 +8,9 @@
  ****************************************************************/
 #pragma once
 
-#include <WinSock2.h>
+#include "RateLimiter.h"
+
+#include "PlatformSocket.h"
 
 #include <cstdint>
 #include <functional>
@@ -21,6 +23,9 @@ using PacketHandler = std::function<void(SOCKET, const std::string&)>;
 /**
  * @class Router
  * @brief 管理数据包类型到处理函数的映射和路由分发
+ *
+ * 路由前先通过 Admit 做限流判定（只看包头），被拒绝的包
+ * 不会读取或解析载荷。
  */
 class Router {
  public:
@@ -39,6 +44,34 @@ class Router {
      */
     void Route(SOCKET client, uint32_t packet_type, const std::string& data);
 
+    /**
+     * @brief 根据包头判定是否接受该数据包（在读取载荷之前调用）
+     * @param state 该连接的限流状态（由客户端线程持有）
+     * @param packet_type 数据包类型
+     * @param length 载荷长度
+     * @return 限流判定结果
+     */
+    RateDecision Admit(ConnectionRateState& state, uint32_t packet_type,
+                       uint32_t length);
+
+    /**
+     * @brief 替换限流配置
+     * @param config 新的限流配置
+     */
+    void SetRateLimitConfig(const RateLimitConfig& config);
+
+    /**
+     * @brief 获取被拒数据包的统计信息
+     * @return 统计信息文本
+     */
+    std::string GetRateLimitStats() const;
+
+    /**
+     * @brief 获取累计被拒的数据包数
+     */
+    uint64_t GetRejectedPacketCount() const;
+
  private:
     std::map<uint32_t, PacketHandler> routes_;  // 路由映射表
+    RateLimiter rate_limiter_;                  // 入站限流器
 };
\ No newline at end of file
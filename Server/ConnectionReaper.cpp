@@ -0,0 +1,182 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     ConnectionReaper.cpp
+ * File Function: 心跳检测与空闲连接回收实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "ConnectionReaper.h"
+
+#include <algorithm>
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+ConnectionReaper::ConnectionReaper(const HeartbeatConfig& config)
+    : config_(config),
+      tick_ms_(std::max<int64_t>(1, config.tick.count())) {
+    // 最长的挂起时间为 idleTimeout，时间轮需要覆盖它，因此无需圈数计数
+    size_t slot_count = static_cast<size_t>(config_.idleTimeout.count() / tick_ms_) + 2;
+    slots_.resize(slot_count);
+    current_tick_ = NowMs() / tick_ms_;
+}
+
+ConnectionReaper::~ConnectionReaper() {
+    Stop();
+}
+
+void ConnectionReaper::SetCallbacks(PingCallback on_ping, ReapCallback on_reap) {
+    on_ping_ = std::move(on_ping);
+    on_reap_ = std::move(on_reap);
+}
+
+void ConnectionReaper::SetTickHook(std::function<void()> hook) {
+    on_tick_ = std::move(hook);
+}
+
+int64_t ConnectionReaper::NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// ============================================================================
+// 连接跟踪
+// ============================================================================
+
+std::shared_ptr<ConnectionActivity> ConnectionReaper::Track(SOCKET s) {
+    auto entry = std::make_shared<ConnectionActivity>();
+    entry->socket = s;
+    int64_t now = NowMs();
+    entry->lastActivity.store(now, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(wheel_mutex_);
+    Schedule(entry, now + config_.pingInterval.count());
+    return entry;
+}
+
+void ConnectionReaper::Touch(ConnectionActivity& activity) {
+    activity.lastActivity.store(NowMs(), std::memory_order_relaxed);
+}
+
+void ConnectionReaper::Untrack(ConnectionActivity& activity) {
+    std::lock_guard<std::mutex> lock(activity.mutex);
+    activity.closed.store(true, std::memory_order_relaxed);
+}
+
+void ConnectionReaper::Schedule(const Entry& entry, int64_t deadline_ms) {
+    int64_t tick = (deadline_ms + tick_ms_ - 1) / tick_ms_;
+    tick = std::max(tick, current_tick_);
+    slots_[static_cast<size_t>(tick % static_cast<int64_t>(slots_.size()))].push_back(entry);
+}
+
+// ============================================================================
+// 时间轮推进
+// ============================================================================
+
+void ConnectionReaper::Tick() {
+    const int64_t now = NowMs();
+    const int64_t ping_ms = config_.pingInterval.count();
+    const int64_t timeout_ms = config_.idleTimeout.count();
+
+    std::vector<Entry> to_ping;
+    std::vector<Entry> to_reap;
+
+    {
+        std::lock_guard<std::mutex> lock(wheel_mutex_);
+
+        const int64_t target = now / tick_ms_;
+        const int64_t slot_count = static_cast<int64_t>(slots_.size());
+        // 长时间未推进时，每个槽位最多处理一次
+        current_tick_ = std::max(current_tick_, target - slot_count + 1);
+
+        std::vector<Entry> due;
+        while (current_tick_ <= target) {
+            due.clear();
+            due.swap(slots_[static_cast<size_t>(current_tick_ % slot_count)]);
+            ++current_tick_;
+
+            for (auto& entry : due) {
+                if (entry->closed.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                int64_t last = entry->lastActivity.load(std::memory_order_relaxed);
+                int64_t idle = now - last;
+
+                if (idle >= timeout_ms) {
+                    // 不再挂入时间轮；closed 留给客户端线程在 Untrack 时置位
+                    to_reap.push_back(entry);
+                } else if (idle >= ping_ms) {
+                    if (!entry->pinged) {
+                        entry->pinged = true;
+                        to_ping.push_back(entry);
+                    }
+                    Schedule(entry, last + timeout_ms);
+                } else {
+                    // 期间有过活动：按新的截止时间重新挂入
+                    entry->pinged = false;
+                    Schedule(entry, last + ping_ms);
+                }
+            }
+        }
+    }
+
+    // 在时间轮锁外执行网络操作；持有连接锁并重新确认连接仍然存活，
+    // 防止客户端线程已 Untrack 并关闭套接字（其值可能已分配给新连接）
+    auto invoke = [](const std::vector<Entry>& entries, const std::function<void(SOCKET)>& callback) {
+        if (!callback) {
+            return;
+        }
+        for (const auto& entry : entries) {
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            if (!entry->closed.load(std::memory_order_relaxed)) {
+                callback(entry->socket);
+            }
+        }
+    };
+    invoke(to_ping, on_ping_);
+    invoke(to_reap, on_reap_);
+}
+
+// ============================================================================
+// 时间轮线程
+// ============================================================================
+
+void ConnectionReaper::Start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&ConnectionReaper::Run, this);
+}
+
+void ConnectionReaper::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ConnectionReaper::Run() {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (running_.load(std::memory_order_acquire)) {
+        if (stop_cv_.wait_for(lock, config_.tick,
+                              [this] { return !running_.load(std::memory_order_acquire); })) {
+            break;
+        }
+        lock.unlock();
+        Tick();
+        if (on_tick_) {
+            on_tick_();
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,161 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     ConnectionReaper.h
+ * File Function: 心跳检测与空闲连接回收（时间轮）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include "PlatformSocket.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct HeartbeatConfig
+ * @brief 心跳与空闲回收配置。
+ */
+struct HeartbeatConfig {
+    std::chrono::milliseconds pingInterval{15000};  ///< 静默多久后发送 PING
+    std::chrono::milliseconds idleTimeout{45000};   ///< 静默多久后断开连接
+    std::chrono::milliseconds tick{1000};           ///< 时间轮的刻度
+};
+
+/**
+ * @struct ConnectionActivity
+ * @brief 单个连接的活跃状态。
+ *
+ * 由客户端线程在收到任何数据包时更新 lastActivity（仅一次原子写入，
+ * 不加锁）；时间轮线程读取它来决定发送 PING 或回收连接。
+ *
+ * closed 只在持有 mutex 时置位，时间轮也在持有 mutex 时检查 closed 并操作套接字，
+ * 因此 Untrack 返回后套接字不会再被时间轮触碰，调用方可以安全关闭它（其值随后可能被复用）。
+ */
+struct ConnectionActivity {
+    SOCKET socket = INVALID_SOCKET;           ///< 连接套接字
+    std::atomic<int64_t> lastActivity{0};     ///< 最近一次收到数据的时间（毫秒，steady_clock）
+    std::atomic<bool> closed{false};          ///< 连接已关闭，时间轮遇到时直接丢弃
+    std::mutex mutex;                         ///< 保护 closed 的置位与时间轮对套接字的操作
+    bool pinged = false;                      ///< 本轮静默期内是否已发送 PING（仅时间轮线程访问）
+};
+
+/**
+ * @class ConnectionReaper
+ * @brief 基于时间轮的心跳调度与空闲连接回收器。
+ *
+ * 每个连接在时间轮中只挂一个条目，位置为它下一次需要检查的时刻
+ * （发送 PING 或判定超时）。每个刻度只处理当前槽位中的条目：
+ * - 连接在此期间有过活动：按新的截止时间重新挂入时间轮
+ * - 静默超过 pingInterval：发送 PING，挂到 idleTimeout 截止处
+ * - 静默超过 idleTimeout：调用回收回调断开连接
+ *
+ * 因此每个刻度的开销只与到期条目数成正比，与总连接数无关；
+ * 活跃连接在每个 pingInterval 内最多被重新挂入一次。
+ *
+ * 线程安全：
+ * Track 可在任意线程调用；Touch 为无锁原子操作；
+ * Tick 由单一线程驱动（Start 启动的时间轮线程，Stop 时等待其退出）。
+ */
+class ConnectionReaper {
+ public:
+    using PingCallback = std::function<void(SOCKET)>;
+    using ReapCallback = std::function<void(SOCKET)>;
+
+    explicit ConnectionReaper(const HeartbeatConfig& config = HeartbeatConfig());
+    ~ConnectionReaper();
+
+    /**
+     * @brief 设置发送 PING 与回收连接的回调。
+     *
+     * @note 回调在 Tick 所在线程中、释放时间轮锁之后调用；调用期间持有该连接的
+     *       ConnectionActivity::mutex，并已确认连接未被 Untrack，回调内可以安全使用套接字。
+     */
+    void SetCallbacks(PingCallback on_ping, ReapCallback on_reap);
+
+    /**
+     * @brief 设置每个刻度在 Tick 之后调用一次的附加任务（如定期日志、超时清理）。
+     *
+     * @note 应在 Start 之前设置；任务在时间轮线程中执行，不持有任何时间轮锁。
+     */
+    void SetTickHook(std::function<void()> hook);
+
+    /**
+     * @brief 开始跟踪一个连接。
+     *
+     * @param s 连接套接字
+     * @return 活跃状态句柄，客户端线程通过它调用 Touch / Untrack
+     */
+    std::shared_ptr<ConnectionActivity> Track(SOCKET s);
+
+    /**
+     * @brief 记录一次连接活动（收到任意数据包，包括 PONG）。
+     */
+    static void Touch(ConnectionActivity& activity);
+
+    /**
+     * @brief 停止跟踪连接（关闭套接字之前调用）。
+     *
+     * 若时间轮正在对该连接执行回调，会等待回调结束后返回；返回后不会再有回调触碰该套接字。
+     * 时间轮中的条目会在下次到期时被惰性丢弃。
+     */
+    static void Untrack(ConnectionActivity& activity);
+
+    /**
+     * @brief 推进时间轮到当前时刻，处理所有到期条目。
+     */
+    void Tick();
+
+    /**
+     * @brief 启动时间轮线程，每个刻度调用一次 Tick
+     */
+    void Start();
+
+    /**
+     * @brief 停止时间轮线程并等待其退出
+     */
+    void Stop();
+
+    /**
+     * @brief 获取时间轮刻度
+     */
+    std::chrono::milliseconds GetTickInterval() const { return config_.tick; }
+
+    static int64_t NowMs();
+
+ private:
+    using Entry = std::shared_ptr<ConnectionActivity>;
+
+    /**
+     * @brief 将条目挂到 deadline_ms 所在的槽位。
+     *
+     * @note 调用时应已持有 wheel_mutex_。
+     */
+    void Schedule(const Entry& entry, int64_t deadline_ms);
+
+    void Run();
+
+    HeartbeatConfig config_;
+    int64_t tick_ms_;
+
+    std::vector<std::vector<Entry>> slots_;  ///< 时间轮槽位
+    int64_t current_tick_;                   ///< 下一个待处理的刻度编号
+    std::mutex wheel_mutex_;                 ///< 保护 slots_ 与 current_tick_
+
+    PingCallback on_ping_;
+    ReapCallback on_reap_;
+    std::function<void()> on_tick_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::mutex stop_mutex_;               ///< 配合 stop_cv_ 使 Stop 无需等满一个刻度
+    std::condition_variable stop_cv_;
+};
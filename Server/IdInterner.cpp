@@ -0,0 +1,197 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     IdInterner.cpp
+ * File Function: 标识符驻留表实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "IdInterner.h"
+
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t kInitialSlots = 1024;
+
+}  // namespace
+
+// ============================================================================
+// 构造
+// ============================================================================
+
+IdInterner& IdInterner::Instance() {
+    static IdInterner instance;
+    return instance;
+}
+
+IdInterner::IdInterner() {
+    for (auto& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    for (auto& chunk : ref_chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // 第 0 块包含保留的空标识符
+    owned_chunks_.emplace_back(new std::string[kChunkSize]);
+    chunks_[0].store(owned_chunks_.back().get(), std::memory_order_release);
+    owned_ref_chunks_.emplace_back(new std::atomic<uint32_t>[kChunkSize]());
+    ref_chunks_[0].store(owned_ref_chunks_.back().get(), std::memory_order_release);
+    slots_.assign(kInitialSlots, 0);
+}
+
+uint32_t IdInterner::Hash(const std::string& name) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : name) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+}
+
+// ============================================================================
+// 查找与驻留
+// ============================================================================
+
+size_t IdInterner::Probe(const std::string& name, uint32_t hash, uint32_t* handle) const {
+    const size_t mask = slots_.size() - 1;
+    size_t index = hash & mask;
+    while (true) {
+        const uint64_t slot = slots_[index];
+        if (slot == 0) {
+            *handle = 0;
+            return index;
+        }
+        // 哈希值不同时无需访问字符串，避免一次随机内存访问
+        if (static_cast<uint32_t>(slot >> 32) == hash) {
+            const uint32_t candidate = static_cast<uint32_t>(slot);
+            if (NameOf(candidate) == name) {
+                *handle = candidate;
+                return index;
+            }
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+uint32_t IdInterner::Find(const std::string& name) {
+    if (name.empty()) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t handle;
+    Probe(name, Hash(name), &handle);
+    AddRef(handle);
+    return handle;
+}
+
+uint32_t IdInterner::Intern(const std::string& name) {
+    if (name.empty()) {
+        return 0;
+    }
+
+    const uint32_t hash = Hash(name);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint32_t handle;
+    size_t slot = Probe(name, hash, &handle);
+    if (handle != 0) {
+        AddRef(handle);
+        return handle;
+    }
+
+    // 优先复用已回收的句柄
+    if (!free_handles_.empty()) {
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+    } else {
+        handle = next_handle_;
+        const uint32_t chunk = handle >> kChunkBits;
+        if (chunk >= kMaxChunks) {
+            throw std::length_error("IdInterner: too many identifiers");
+        }
+        if (chunk == owned_chunks_.size()) {
+            owned_chunks_.emplace_back(new std::string[kChunkSize]);
+            chunks_[chunk].store(owned_chunks_.back().get(), std::memory_order_release);
+            owned_ref_chunks_.emplace_back(new std::atomic<uint32_t>[kChunkSize]());
+            ref_chunks_[chunk].store(owned_ref_chunks_.back().get(), std::memory_order_release);
+        }
+        ++next_handle_;
+    }
+
+    // 先写入字符串再发布句柄，其它线程拿到句柄后可无锁读取
+    owned_chunks_[handle >> kChunkBits][handle & (kChunkSize - 1)] = name;
+    RefOf(handle).store(1, std::memory_order_relaxed);
+    slots_[slot] = MakeSlot(hash, handle);
+    const size_t count = count_.load(std::memory_order_relaxed) + 1;
+    count_.store(count, std::memory_order_relaxed);
+
+    // 负载因子保持在 1/2 以下，探测长度短且稳定
+    if (count * 2 > slots_.size()) {
+        Grow();
+    }
+    return handle;
+}
+
+void IdInterner::Reclaim(uint32_t handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string& name = owned_chunks_[handle >> kChunkBits][handle & (kChunkSize - 1)];
+    if (RefOf(handle).load(std::memory_order_acquire) != 0 || name.empty()) {
+        return;
+    }
+
+    uint32_t found;
+    size_t slot = Probe(name, Hash(name), &found);
+    if (found == handle) {
+        EraseSlot(slot);
+    }
+
+    // 不再有人持有该句柄，可以安全地清空字符串并复用
+    std::string().swap(name);
+    free_handles_.push_back(handle);
+    count_.store(count_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+}
+
+void IdInterner::EraseSlot(size_t index) {
+    const size_t mask = slots_.size() - 1;
+    size_t hole = index;
+    size_t next = index;
+    while (true) {
+        next = (next + 1) & mask;
+        const uint64_t slot = slots_[next];
+        if (slot == 0) {
+            break;
+        }
+        // 槽位的理想位置不在 (hole, next] 区间内时，可以前移填补空洞
+        const size_t home = static_cast<uint32_t>(slot >> 32) & mask;
+        const bool between = hole <= next ? (hole < home && home <= next)
+                                          : (hole < home || home <= next);
+        if (!between) {
+            slots_[hole] = slot;
+            hole = next;
+        }
+    }
+    slots_[hole] = 0;
+}
+
+void IdInterner::Grow() {
+    std::vector<uint64_t> slots(slots_.size() * 2, 0);
+    const size_t mask = slots.size() - 1;
+    for (uint64_t slot : slots_) {
+        if (slot == 0) {
+            continue;
+        }
+        size_t index = static_cast<uint32_t>(slot >> 32) & mask;
+        while (slots[index] != 0) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+    slots_.swap(slots);
+}
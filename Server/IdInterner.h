@@ -0,0 +1,228 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     IdInterner.h
+ * File Function: 玩家/部落等标识符的字符串驻留表
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class IdInterner
+ * @brief 全局标识符驻留表：字符串 <-> 稠密的 32 位句柄。
+ *
+ * 玩家ID、部落ID、战争ID 在登录/创建时驻留一次，之后服务器内部
+ * 只传递和比较 32 位句柄，字符串只在协议边界（解析请求、组装响应）
+ * 出现。
+ *
+ * 实现：
+ * - 句柄从 1 开始分配，0 保留为空标识符（对应空字符串）
+ * - 句柄 -> 字符串：分块数组，块一旦分配不再移动，读取无锁
+ * - 字符串 -> 句柄：开放寻址哈希表，槽位存 (哈希值, 句柄) 共 8 字节，
+ *   探测时先比较哈希值，字符串本身不重复存储
+ * - 每个句柄带引用计数，由 InternedId 维护；计数归零时从哈希表删除
+ *   并回收句柄供之后复用，登录时随意提交的 ID 不会让表无限增长
+ *
+ * 线程安全：
+ * Intern / Find 及回收内部加锁；驻留表为进程全局，单线程逻辑模式下也会被
+ * 客户端线程和分片总线线程访问，因此使用真实的 std::mutex 而非 StateMutex。
+ * NameOf 与引用计数增减无锁，可在任意线程对持有的句柄调用。
+ */
+class IdInterner {
+ public:
+    static IdInterner& Instance();
+
+    /**
+     * @brief 驻留字符串，不存在时分配新句柄
+     * @return 已增加一次引用的句柄；空字符串返回 0
+     */
+    uint32_t Intern(const std::string& name);
+
+    /**
+     * @brief 查找已驻留的字符串，不插入
+     * @return 已增加一次引用的句柄；未驻留或为空字符串时返回 0
+     */
+    uint32_t Find(const std::string& name);
+
+    /**
+     * @brief 取句柄对应的字符串（调用方必须持有该句柄的引用）
+     */
+    const std::string& NameOf(uint32_t handle) const {
+        return chunks_[handle >> kChunkBits].load(std::memory_order_acquire)
+            [handle & (kChunkSize - 1)];
+    }
+
+    /**
+     * @brief 增加引用（调用方已持有一个引用）
+     */
+    void AddRef(uint32_t handle) {
+        if (handle != 0) {
+            RefOf(handle).fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 释放引用，最后一个引用释放时回收句柄
+     */
+    void Release(uint32_t handle) {
+        if (handle != 0 && RefOf(handle).fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Reclaim(handle);
+        }
+    }
+
+    /**
+     * @brief 当前驻留（仍被引用）的标识符数量
+     */
+    size_t Size() const { return count_.load(std::memory_order_relaxed); }
+
+ private:
+    static constexpr uint32_t kChunkBits = 16;
+    static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+    static constexpr uint32_t kMaxChunks = 4096;  ///< 最多约 2.7 亿个标识符
+
+    IdInterner();
+
+    static uint32_t Hash(const std::string& name);
+
+    std::atomic<uint32_t>& RefOf(uint32_t handle) const {
+        return ref_chunks_[handle >> kChunkBits].load(std::memory_order_acquire)
+            [handle & (kChunkSize - 1)];
+    }
+
+    /**
+     * @brief 引用计数归零后回收句柄
+     *
+     * 在锁内重新确认计数仍为 0：归零与加锁之间 Find 可能又取走了它，
+     * 也可能已被另一次归零回收（此时名字已清空）。
+     */
+    void Reclaim(uint32_t handle);
+
+    /**
+     * @brief 在哈希表中查找，返回句柄或命中的空槽位下标
+     * @note 调用时应已持有 mutex_。
+     */
+    size_t Probe(const std::string& name, uint32_t hash, uint32_t* handle) const;
+
+    static uint64_t MakeSlot(uint32_t hash, uint32_t handle) {
+        return (static_cast<uint64_t>(hash) << 32) | handle;
+    }
+
+    void Grow();
+
+    /**
+     * @brief 删除哈希表槽位，把后续同一探测链上的槽位前移（无需墓碑）
+     * @note 调用时应已持有 mutex_。
+     */
+    void EraseSlot(size_t index);
+
+    std::array<std::atomic<std::string*>, kMaxChunks> chunks_;  ///< 句柄 -> 字符串
+    std::vector<std::unique_ptr<std::string[]>> owned_chunks_;   ///< 持有分块内存
+    std::array<std::atomic<std::atomic<uint32_t>*>, kMaxChunks> ref_chunks_;  ///< 句柄 -> 引用计数
+    std::vector<std::unique_ptr<std::atomic<uint32_t>[]>> owned_ref_chunks_;  ///< 持有计数分块内存
+    std::vector<uint64_t> slots_;    ///< 开放寻址表：高 32 位哈希值，低 32 位句柄（0 表示空槽）
+    std::vector<uint32_t> free_handles_;  ///< 已回收、可复用的句柄
+    uint32_t next_handle_ = 1;       ///< 从未分配过的下一个句柄
+    std::atomic<size_t> count_{0};   ///< 驻留中的句柄数（不含 0）
+    std::mutex mutex_;               ///< 保护哈希表、分配与回收
+};
+
+/**
+ * @class InternedId
+ * @brief 驻留后的标识符，只有 4 字节，按句柄比较。
+ *
+ * 默认构造为空标识符（等价于空字符串）。从字符串构造必须显式选择
+ * Intern（登录、创建部落等产生新标识符的地方）或 Find（解析客户端
+ * 请求中引用的已有标识符，未知字符串得到空标识符而不会污染驻留表）。
+ *
+ * 每个实例持有句柄的一个引用，最后一个实例销毁时句柄被回收，
+ * 因此玩家下线且不再被部落、地图等状态引用后，其 ID 不再占用驻留表。
+ *
+ * 排序按句柄进行，即大致按驻留的先后（句柄会被复用），而非字典序。
+ */
+class InternedId {
+ public:
+    InternedId() = default;
+
+    InternedId(const InternedId& other) : handle_(other.handle_) {
+        if (handle_ != 0) {
+            IdInterner::Instance().AddRef(handle_);
+        }
+    }
+
+    InternedId(InternedId&& other) noexcept : handle_(other.handle_) {
+        other.handle_ = 0;
+    }
+
+    InternedId& operator=(const InternedId& other) {
+        if (handle_ != other.handle_) {
+            IdInterner::Instance().AddRef(other.handle_);
+            IdInterner::Instance().Release(handle_);
+            handle_ = other.handle_;
+        }
+        return *this;
+    }
+
+    InternedId& operator=(InternedId&& other) noexcept {
+        if (this != &other) {
+            IdInterner::Instance().Release(handle_);
+            handle_ = other.handle_;
+            other.handle_ = 0;
+        }
+        return *this;
+    }
+
+    ~InternedId() {
+        if (handle_ != 0) {
+            IdInterner::Instance().Release(handle_);
+        }
+    }
+
+    static InternedId Intern(const std::string& name) {
+        return InternedId(IdInterner::Instance().Intern(name));
+    }
+
+    static InternedId Find(const std::string& name) {
+        return InternedId(IdInterner::Instance().Find(name));
+    }
+
+    /**
+     * @brief 协议边界使用的字符串形式（引用驻留表，不分配）
+     */
+    const std::string& str() const { return IdInterner::Instance().NameOf(handle_); }
+
+    uint32_t handle() const { return handle_; }
+    bool empty() const { return handle_ == 0; }
+
+    bool operator==(const InternedId& other) const { return handle_ == other.handle_; }
+    bool operator!=(const InternedId& other) const { return handle_ != other.handle_; }
+    bool operator<(const InternedId& other) const { return handle_ < other.handle_; }
+
+ private:
+    /** @brief 接管一个已增加过的引用 */
+    explicit InternedId(uint32_t handle) : handle_(handle) {}
+
+    uint32_t handle_ = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const InternedId& id) {
+    return os << id.str();
+}
+
+namespace std {
+template <>
+struct hash<InternedId> {
+    size_t operator()(const InternedId& id) const noexcept { return id.handle(); }
+};
+}  // namespace std
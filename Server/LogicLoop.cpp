@@ -0,0 +1,114 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     LogicLoop.cpp
+ * File Function: 单线程游戏逻辑循环实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "LogicLoop.h"
+#include "StateMutex.h"
+
+#include <algorithm>
+#include <sstream>
+
+// 默认多线程模式，由 Server 在启动时根据配置切换
+bool StateMutex::single_threaded_ = false;
+
+// ============================================================================
+// 构造与生命周期
+// ============================================================================
+
+LogicLoop::LogicLoop(std::chrono::milliseconds tick, EventHandler handler)
+    : tick_(tick), handler_(std::move(handler)) {}
+
+LogicLoop::~LogicLoop() {
+    Stop();
+}
+
+void LogicLoop::Start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&LogicLoop::Run, this);
+}
+
+void LogicLoop::Stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void LogicLoop::Post(LogicEvent event) {
+    queue_.Push(std::move(event));
+    posted_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// 逻辑线程
+// ============================================================================
+
+void LogicLoop::Run() {
+    using Clock = std::chrono::steady_clock;
+    auto next_tick = Clock::now();
+
+    while (running_.load(std::memory_order_acquire)) {
+        auto begin = Clock::now();
+        size_t batch = Drain();
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                           Clock::now() - begin).count();
+
+        ticks_.fetch_add(1, std::memory_order_relaxed);
+        total_busy_us_.fetch_add(elapsed, std::memory_order_relaxed);
+        if (elapsed > max_tick_us_.load(std::memory_order_relaxed)) {
+            max_tick_us_.store(elapsed, std::memory_order_relaxed);
+        }
+        if (batch > max_batch_.load(std::memory_order_relaxed)) {
+            max_batch_.store(batch, std::memory_order_relaxed);
+        }
+
+        // 固定刻度；处理超时则跳过落后的刻度，不做追赶
+        next_tick += tick_;
+        auto now = Clock::now();
+        if (next_tick < now) {
+            next_tick = now;
+        } else {
+            std::this_thread::sleep_until(next_tick);
+        }
+    }
+
+    Drain();
+}
+
+size_t LogicLoop::Drain() {
+    size_t count = 0;
+    LogicEvent event;
+    while (queue_.TryPop(event)) {
+        handler_(event);
+        ++count;
+    }
+    processed_.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+// ============================================================================
+// 统计信息
+// ============================================================================
+
+std::string LogicLoop::GetStatsDump() const {
+    uint64_t ticks = ticks_.load(std::memory_order_relaxed);
+    int64_t busy = total_busy_us_.load(std::memory_order_relaxed);
+
+    std::ostringstream oss;
+    oss << "[LogicLoop] 刻度: " << tick_.count() << "ms"
+        << ", 已处理刻度: " << ticks
+        << ", 投递事件: " << posted_.load(std::memory_order_relaxed)
+        << ", 已处理事件: " << processed_.load(std::memory_order_relaxed)
+        << ", 单刻度最大事件数: " << max_batch_.load(std::memory_order_relaxed)
+        << ", 单刻度最长耗时: " << max_tick_us_.load(std::memory_order_relaxed) << "us"
+        << ", 平均耗时: " << (ticks > 0 ? busy / static_cast<int64_t>(ticks) : 0) << "us";
+    return oss.str();
+}
@@ -0,0 +1,105 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     LogicLoop.h
+ * File Function: 单线程游戏逻辑循环
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include "MpscQueue.h"
+
+#include "PlatformSocket.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+/**
+ * @struct LogicEvent
+ * @brief 网络线程投递给逻辑线程的事件。
+ */
+struct LogicEvent {
+    enum class Kind {
+        kConnect,     ///< 新连接建立
+        kPacket,      ///< 收到完整数据包
+        kDisconnect,  ///< 连接断开，需要清理会话
+        kShard,       ///< 来自其它分片的消息（type 为 ShardMessageType）
+        kTimer        ///< 定期任务（时间轮线程每个刻度投递一次），在逻辑线程中执行
+    };
+
+    Kind kind = Kind::kPacket;
+    SOCKET socket = INVALID_SOCKET;
+    uint32_t type = 0;
+    std::string data;
+};
+
+/**
+ * @class LogicLoop
+ * @brief 以固定刻度运行的单线程游戏逻辑循环。
+ *
+ * 网络线程只负责收包、限流和解帧，然后把事件投递到无锁 MPSC 队列；
+ * 唯一的逻辑线程在每个刻度取空队列并依次处理。所有游戏状态只由
+ * 逻辑线程访问，因此处理顺序确定，也不需要互斥锁（见 StateMutex）。
+ *
+ * 同一连接的事件严格按接收顺序处理，断开事件总在该连接的
+ * 所有数据包之后处理。
+ *
+ * @note 处理函数中的网络发送仍在逻辑线程中同步执行。
+ */
+class LogicLoop {
+ public:
+    using EventHandler = std::function<void(LogicEvent&)>;
+
+    /**
+     * @brief 构造函数
+     * @param tick 逻辑刻度
+     * @param handler 事件处理函数（在逻辑线程中调用）
+     */
+    LogicLoop(std::chrono::milliseconds tick, EventHandler handler);
+    ~LogicLoop();
+
+    /**
+     * @brief 启动逻辑线程
+     */
+    void Start();
+
+    /**
+     * @brief 停止逻辑线程（处理完已入队的事件后返回）
+     */
+    void Stop();
+
+    /**
+     * @brief 投递事件（任意线程）
+     * @param event 事件
+     */
+    void Post(LogicEvent event);
+
+    /**
+     * @brief 获取逻辑循环的运行统计
+     * @return 统计信息文本
+     */
+    std::string GetStatsDump() const;
+
+ private:
+    void Run();
+    size_t Drain();
+
+    std::chrono::milliseconds tick_;
+    EventHandler handler_;
+    MpscQueue<LogicEvent> queue_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    // ==================== 统计 ====================
+    std::atomic<uint64_t> posted_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> ticks_{0};
+    std::atomic<uint64_t> max_batch_{0};
+    std::atomic<int64_t> max_tick_us_{0};
+    std::atomic<int64_t> total_busy_us_{0};
+};
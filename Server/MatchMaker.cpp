@@ -12,7 +12,7 @@
 #include <cmath>
 
 void Matchmaker::Enqueue(const MatchQueueEntry& entry) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::lock_guard<StateMutex> lock(queue_mutex_);
 
     // 检查是否已在队列中
     for (const auto& e : queue_) {
@@ -25,7 +25,7 @@ void Matchmaker::Enqueue(const MatchQueueEntry& entry) {
 }
 
 void Matchmaker::Remove(SOCKET s) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::lock_guard<StateMutex> lock(queue_mutex_);
 
     auto it = std::find_if(queue_.begin(), queue_.end(),
                            [s](const MatchQueueEntry& e) {
@@ -39,7 +39,7 @@ void Matchmaker::Remove(SOCKET s) {
 
 std::vector<std::pair<MatchQueueEntry, MatchQueueEntry>>
 Matchmaker::ProcessQueue() {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::lock_guard<StateMutex> lock(queue_mutex_);
 
     std::vector<std::pair<MatchQueueEntry, MatchQueueEntry>> matches;
 
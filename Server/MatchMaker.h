@@ -9,6 +9,7 @@
 #pragma once
 
 #include "ClanInfo.h"
+#include "StateMutex.h"
 
 #include <mutex>
 #include <vector>
@@ -39,5 +40,5 @@ class Matchmaker {
 
  private:
     std::vector<MatchQueueEntry> queue_;  // 匹配队列
-    std::mutex queue_mutex_;              // 保护队列的互斥锁
+    StateMutex queue_mutex_;              // 保护队列的互斥锁
 };
\ No newline at end of file
@@ -0,0 +1,183 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     MpscQueue.h
+ * File Function: 无锁多生产者单消费者队列
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief 无锁多生产者单消费者（MPSC）队列（Vyukov 链表算法）。
+ *
+ * 生产者只做一次原子交换即可入队，互不阻塞；消费者出队不需要任何
+ * 原子读-改-写操作。入队顺序即为各生产者 Push 的线性化顺序，
+ * 同一生产者的元素保持先进先出。
+ *
+ * 节点来自队列自带的节点池：出队后的哨兵节点放回空闲栈，入队时优先复用，
+ * 稳定运行时 Push 不再分配堆内存。空闲栈是以（下标, 版本号）打包成 64 位的
+ * Treiber 栈，版本号避免 ABA；节点按块分配且在队列析构前不释放，
+ * 因此并发读取已被他人取走的节点是安全的。池满（kMaxChunks 块）后退化为 new/delete。
+ *
+ * 线程安全：
+ * Push 可在任意线程并发调用；TryPop 只能由单一消费者线程调用。
+ *
+ * @tparam T 元素类型，需要可默认构造和可移动
+ */
+template <typename T>
+class MpscQueue {
+ public:
+    MpscQueue() {
+        Node* sentinel = Acquire();
+        head_.store(sentinel, std::memory_order_relaxed);
+        tail_ = sentinel;
+    }
+
+    ~MpscQueue() {
+        T discard;
+        while (TryPop(discard)) {
+        }
+        if (tail_->slot == 0) {
+            delete tail_;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief 入队（任意线程）
+     * @param value 元素
+     */
+    void Push(T value) {
+        Node* node = Acquire();
+        node->value = std::move(value);
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief 出队（仅消费者线程）
+     * @param out 输出参数，出队的元素
+     * @return 队列非空返回 true
+     *
+     * @note 生产者完成 exchange 但尚未链接 next 的瞬间会返回 false，
+     *       该元素将在下一次调用时可见。
+     */
+    bool TryPop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        out = std::move(next->value);
+        tail_ = next;  // next 成为新的哨兵节点
+        Release(tail);
+        return true;
+    }
+
+ private:
+    static constexpr uint32_t kChunkSize = 1024;  ///< 每块节点数
+    static constexpr uint32_t kMaxChunks = 1024;  ///< 节点池块数上限
+
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<uint32_t> free_next{0};  ///< 空闲栈中下一个节点的 slot（0 表示栈底）
+        uint32_t slot = 0;                   ///< 池内下标 + 1，0 表示不属于节点池
+        T value;
+    };
+
+    /// 空闲栈栈顶：低 32 位为 slot，高 32 位为版本号
+    static uint64_t Pack(uint32_t slot, uint32_t tag) {
+        return (static_cast<uint64_t>(tag) << 32) | slot;
+    }
+
+    Node* NodeAt(uint32_t slot) const {
+        uint32_t index = slot - 1;
+        return &chunks_[index / kChunkSize][index % kChunkSize];
+    }
+
+    Node* Acquire() {
+        uint64_t top = free_top_.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t slot = static_cast<uint32_t>(top);
+            if (slot == 0) {
+                if (Node* node = Grow()) {
+                    return node;
+                }
+                top = free_top_.load(std::memory_order_acquire);
+                continue;
+            }
+            Node* node = NodeAt(slot);
+            uint32_t next = node->free_next.load(std::memory_order_relaxed);
+            if (free_top_.compare_exchange_weak(top, Pack(next, static_cast<uint32_t>(top >> 32) + 1),
+                                                std::memory_order_acquire, std::memory_order_acquire)) {
+                return node;
+            }
+        }
+    }
+
+    void Release(Node* node) {
+        if (node->slot == 0) {
+            delete node;
+            return;
+        }
+        PushFree(node, node);
+    }
+
+    /// 把 first..last 的链（已用 free_next 串好）压入空闲栈
+    void PushFree(Node* first, Node* last) {
+        uint64_t top = free_top_.load(std::memory_order_relaxed);
+        for (;;) {
+            last->free_next.store(static_cast<uint32_t>(top), std::memory_order_relaxed);
+            if (free_top_.compare_exchange_weak(top, Pack(first->slot, static_cast<uint32_t>(top >> 32) + 1),
+                                                std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    /// 空闲栈为空时分配新的一块，返回其中一个节点，其余放入空闲栈；
+    /// 等锁期间其他线程已补充空闲栈时返回 nullptr，由调用方重试
+    Node* Grow() {
+        std::lock_guard<std::mutex> lock(grow_mutex_);
+        if (static_cast<uint32_t>(free_top_.load(std::memory_order_acquire)) != 0) {
+            return nullptr;
+        }
+        if (chunk_count_ == kMaxChunks) {
+            return new Node();
+        }
+        uint32_t base = chunk_count_ * kChunkSize;
+        chunks_[chunk_count_].reset(new Node[kChunkSize]);
+        Node* chunk = chunks_[chunk_count_].get();
+        ++chunk_count_;
+
+        for (uint32_t i = 0; i < kChunkSize; ++i) {
+            chunk[i].slot = base + i + 1;
+            if (i > 1) {
+                chunk[i - 1].free_next.store(chunk[i].slot, std::memory_order_relaxed);
+            }
+        }
+        PushFree(&chunk[1], &chunk[kChunkSize - 1]);
+        return &chunk[0];
+    }
+
+    std::atomic<Node*> head_{nullptr};  ///< 最新入队的节点（生产者端）
+    Node* tail_ = nullptr;              ///< 哨兵节点（消费者端）
+
+    // ==================== 节点池 ====================
+    std::atomic<uint64_t> free_top_{0};                       ///< 空闲栈栈顶
+    std::array<std::unique_ptr<Node[]>, kMaxChunks> chunks_;  ///< 节点块（析构前不释放）
+    uint32_t chunk_count_ = 0;                                ///< 已分配块数（受 grow_mutex_ 保护）
+    std::mutex grow_mutex_;                                   ///< 串行化 Grow
+};
@@ -8,7 +8,10 @@
  ****************************************************************/
 #include "NetworkUtils.h"
 
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <unordered_map>
 
 bool recvFixedAmount(SOCKET socket, char* buffer, int total_bytes) {
     if (buffer == nullptr || total_bytes <= 0) {
@@ -27,11 +30,47 @@ bool recvFixedAmount(SOCKET socket, char* buffer, int total_bytes) {
     return true;
 }
 
+std::mutex& sendLockFor(SOCKET socket) {
+    static std::array<std::mutex, 256> locks;
+    return locks[static_cast<size_t>(socket) % locks.size()];
+}
+
+namespace {
+    std::mutex g_redirect_mutex;
+    std::unordered_map<SOCKET, PacketRedirect> g_redirects;  // 受 g_redirect_mutex 保护
+    std::atomic<size_t> g_redirect_count{0};                 // 没有转发时跳过查表
+
+    PacketRedirect findRedirect(SOCKET socket) {
+        if (g_redirect_count.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(g_redirect_mutex);
+        auto it = g_redirects.find(socket);
+        return it != g_redirects.end() ? it->second : nullptr;
+    }
+}
+
+void setPacketRedirect(SOCKET socket, PacketRedirect redirect) {
+    std::lock_guard<std::mutex> lock(g_redirect_mutex);
+    if (redirect) {
+        g_redirects[socket] = std::move(redirect);
+    } else {
+        g_redirects.erase(socket);
+    }
+    g_redirect_count.store(g_redirects.size(), std::memory_order_release);
+}
+
 bool sendPacket(SOCKET socket, uint32_t type, const std::string& data) {
     if (socket == INVALID_SOCKET) {
         return false;
     }
 
+    if (PacketRedirect redirect = findRedirect(socket)) {
+        return redirect(type, data);
+    }
+
+    std::lock_guard<std::mutex> lock(sendLockFor(socket));
+
     PacketHeader header;
     header.type = type;
     header.length = static_cast<uint32_t>(data.size());
@@ -55,36 +94,102 @@ bool sendPacket(SOCKET socket, uint32_t type, const std::string& data) {
     return true;
 }
 
-bool recvPacket(SOCKET socket, uint32_t& out_type, std::string& out_data) {
+namespace {
+#ifdef MSG_DONTWAIT
+    constexpr int kDontWaitFlag = MSG_DONTWAIT;
+#else
+    constexpr int kDontWaitFlag = 0;
+#endif
+
+    bool sendAll(SOCKET socket, const char* data, int length) {
+        while (length > 0) {
+            int sent = send(socket, data, length, 0);
+            if (sent <= 0) {
+                return false;
+            }
+            data += sent;
+            length -= sent;
+        }
+        return true;
+    }
+}
+
+bool trySendPacket(SOCKET socket, uint32_t type, const std::string& data) {
     if (socket == INVALID_SOCKET) {
         return false;
     }
 
-    // 接收包头
+    if (PacketRedirect redirect = findRedirect(socket)) {
+        return redirect(type, data);
+    }
+
+    std::unique_lock<std::mutex> lock(sendLockFor(socket), std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+
+    std::string frame(sizeof(PacketHeader) + data.size(), '\0');
     PacketHeader header;
-    if (!recvFixedAmount(socket, reinterpret_cast<char*>(&header),
+    header.type = type;
+    header.length = static_cast<uint32_t>(data.size());
+    std::copy(reinterpret_cast<const char*>(&header),
+              reinterpret_cast<const char*>(&header) + sizeof(PacketHeader), frame.begin());
+    std::copy(data.begin(), data.end(), frame.begin() + sizeof(PacketHeader));
+
+    // 只有第一次写入不等待：缓冲区已满则整帧放弃；已写出一部分则必须补完
+    int sent = send(socket, frame.data(), static_cast<int>(frame.size()), kDontWaitFlag);
+    if (sent <= 0) {
+        return false;
+    }
+    return sendAll(socket, frame.data() + sent, static_cast<int>(frame.size()) - sent);
+}
+
+namespace {
+    // 安全检查：防止过大的数据包导致内存问题
+    constexpr uint32_t kMaxPacketSize = 10 * 1024 * 1024;  // 10MB
+}
+
+bool recvPacketHeader(SOCKET socket, PacketHeader& out_header) {
+    if (socket == INVALID_SOCKET) {
+        return false;
+    }
+
+    if (!recvFixedAmount(socket, reinterpret_cast<char*>(&out_header),
                          sizeof(PacketHeader))) {
         return false;
     }
 
-    out_type = header.type;
+    return out_header.length <= kMaxPacketSize;
+}
+
+bool recvPacketBody(SOCKET socket, uint32_t length, std::string& out_data) {
     out_data.clear();
+    if (length == 0) {
+        return true;
+    }
 
-    // 接收包体（如果有数据）
-    if (header.length > 0) {
-        // 安全检查：防止过大的数据包导致内存问题
-        constexpr uint32_t kMaxPacketSize = 10 * 1024 * 1024;  // 10MB
-        if (header.length > kMaxPacketSize) {
-            return false;
-        }
+    out_data.resize(length);
+    return recvFixedAmount(socket, &out_data[0], static_cast<int>(length));
+}
 
-        std::vector<char> buffer(header.length);
-        if (!recvFixedAmount(socket, buffer.data(),
-                             static_cast<int>(header.length))) {
+bool discardPacketBody(SOCKET socket, uint32_t length) {
+    char buffer[4096];
+    while (length > 0) {
+        int chunk = static_cast<int>(std::min<uint32_t>(length, sizeof(buffer)));
+        if (!recvFixedAmount(socket, buffer, chunk)) {
             return false;
         }
-        out_data.assign(buffer.begin(), buffer.end());
+        length -= static_cast<uint32_t>(chunk);
     }
-
     return true;
-}
\ No newline at end of file
+}
+
+bool recvPacket(SOCKET socket, uint32_t& out_type, std::string& out_data) {
+    PacketHeader header;
+    if (!recvPacketHeader(socket, header)) {
+        return false;
+    }
+
+    out_type = header.type;
+    return recvPacketBody(socket, header.length, out_data);
+}
@@ -10,13 +10,42 @@
 
 #include "Protocol.h"
 
-#include <WinSock2.h>
+#include "PlatformSocket.h"
 
 #include <cstdint>
+#include <functional>
+#include <mutex>
 #include <string>
 
 /**
- * @brief 发送数据包到指定套接字
+ * @brief 获取套接字的发送锁
+ *
+ * 同一连接可能被多个线程同时写入（该连接的处理线程、其他玩家触发的广播、心跳线程），
+ * sendPacket 在发送包头和包体期间一直持有该锁，保证帧不会交错。
+ * 锁按套接字值分段，不同连接偶尔共用一把锁只会带来少量竞争。
+ * @param socket 目标套接字
+ * @return 该套接字对应的互斥锁
+ */
+std::mutex& sendLockFor(SOCKET socket);
+
+/**
+ * @brief 数据包转发函数，返回值作为 sendPacket 的结果
+ */
+using PacketRedirect = std::function<bool(uint32_t type, const std::string& data)>;
+
+/**
+ * @brief 为套接字设置发送转发
+ *
+ * 分片模式下访客描述符与归属分片上的原连接是同一条 TCP 连接，sendLockFor 只在进程内有效，
+ * 两个进程各自写入会使帧交错。访客分片为其描述符设置转发后，sendPacket 不再写入该描述符，
+ * 而是交给转发函数经总线送回归属分片，由该连接唯一的写入者发送。
+ * @param socket 目标套接字
+ * @param redirect 转发函数，为空时清除
+ */
+void setPacketRedirect(SOCKET socket, PacketRedirect redirect);
+
+/**
+ * @brief 发送数据包到指定套接字（持有 sendLockFor(socket)，可被多个线程并发调用）
  * @param socket 目标套接字
  * @param type 数据包类型
  * @param data 数据内容
@@ -24,6 +53,18 @@
  */
 bool sendPacket(SOCKET socket, uint32_t type, const std::string& data);
 
+/**
+ * @brief 尝试不阻塞地发送数据包（用于心跳等可丢弃的消息）
+ *
+ * 发送锁被占用或发送缓冲区已满时直接放弃并返回 false，不会因某个连接写满而阻塞调用线程。
+ * 帧一旦开始写入就会写完，避免在流中留下半个包。Windows 下没有 MSG_DONTWAIT，仅依赖 try_lock。
+ * @param socket 目标套接字
+ * @param type 数据包类型
+ * @param data 数据内容
+ * @return 整帧发送成功返回true，跳过或失败返回false
+ */
+bool trySendPacket(SOCKET socket, uint32_t type, const std::string& data);
+
 /**
  * @brief 从套接字接收数据包
  * @param socket 源套接字
@@ -33,6 +74,31 @@ bool sendPacket(SOCKET socket, uint32_t type, const std::string& data);
  */
 bool recvPacket(SOCKET socket, uint32_t& out_type, std::string& out_data);
 
+/**
+ * @brief 只接收数据包头（载荷留在套接字中，供限流判定后再读取或丢弃）
+ * @param socket 源套接字
+ * @param out_header 输出参数，接收到的包头
+ * @return 接收成功且长度合法返回true，失败返回false
+ */
+bool recvPacketHeader(SOCKET socket, PacketHeader& out_header);
+
+/**
+ * @brief 接收指定长度的数据包载荷
+ * @param socket 源套接字
+ * @param length 载荷长度
+ * @param out_data 输出参数，接收到的数据内容
+ * @return 接收成功返回true，失败返回false
+ */
+bool recvPacketBody(SOCKET socket, uint32_t length, std::string& out_data);
+
+/**
+ * @brief 读取并丢弃指定长度的载荷（用于被拒绝的数据包，保持帧同步）
+ * @param socket 源套接字
+ * @param length 需要丢弃的字节数
+ * @return 成功返回true，失败返回false
+ */
+bool discardPacketBody(SOCKET socket, uint32_t length);
+
 /**
  * @brief 从套接字接收固定数量的字节
  * @param socket 源套接字
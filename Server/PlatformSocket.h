@@ -0,0 +1,27 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     PlatformSocket.h
+ * File Function: 服务器端平台相关套接字头文件
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+// ============================================================================
+// 平台相关头文件
+// ============================================================================
+#ifdef _WIN32
+#include <WinSock2.h>
+using socklen_t = int;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define SOCKET int
+#define INVALID_SOCKET -1
+#define SOCKET_ERROR -1
+#define SD_BOTH SHUT_RDWR
+#define closesocket close
+#endif
@@ -13,13 +13,33 @@
 // ============================================================================
 
 void PlayerRegistry::Register(SOCKET s, const PlayerContext& ctx) {
-    std::lock_guard<std::mutex> lock(registry_mutex_);
-    players_[s] = ctx;
+    std::lock_guard<StateMutex> lock(registry_mutex_);
+    PlayerContext& slot = players_[s];
+
+    // 同一套接字重新登录为其它玩家时，移除旧的索引项
+    auto old = by_id_.find(slot.playerId);
+    if (old != by_id_.end() && old->second == &slot) {
+        by_id_.erase(old);
+    }
+
+    slot = ctx;
+    if (!slot.playerId.empty()) {
+        by_id_[slot.playerId] = &slot;  // std::map 节点地址稳定
+    }
 }
 
 void PlayerRegistry::Unregister(SOCKET s) {
-    std::lock_guard<std::mutex> lock(registry_mutex_);
-    players_.erase(s);
+    std::lock_guard<StateMutex> lock(registry_mutex_);
+    auto it = players_.find(s);
+    if (it == players_.end()) {
+        return;
+    }
+
+    auto indexed = by_id_.find(it->second.playerId);
+    if (indexed != by_id_.end() && indexed->second == &it->second) {
+        by_id_.erase(indexed);
+    }
+    players_.erase(it);
 }
 
 // ============================================================================
@@ -27,19 +47,19 @@ void PlayerRegistry::Unregister(SOCKET s) {
 // ============================================================================
 
 PlayerContext* PlayerRegistry::GetBySocket(SOCKET s) {
-    std::lock_guard<std::mutex> lock(registry_mutex_);
+    std::lock_guard<StateMutex> lock(registry_mutex_);
     auto it = players_.find(s);
     return it != players_.end() ? &it->second : nullptr;
 }
 
-PlayerContext* PlayerRegistry::GetById(const std::string& player_id) {
-    std::lock_guard<std::mutex> lock(registry_mutex_);
-    for (auto& pair : players_) {
-        if (pair.second.playerId == player_id) {
-            return &pair.second;
-        }
+PlayerContext* PlayerRegistry::GetById(InternedId player_id) {
+    if (player_id.empty()) {
+        return nullptr;
     }
-    return nullptr;
+
+    std::lock_guard<StateMutex> lock(registry_mutex_);
+    auto it = by_id_.find(player_id);
+    return it != by_id_.end() ? it->second : nullptr;
 }
 
 // ============================================================================
@@ -47,6 +67,6 @@ PlayerContext* PlayerRegistry::GetById(const std::string& player_id) {
 // ============================================================================
 
 std::map<SOCKET, PlayerContext> PlayerRegistry::GetAllSnapshot() {
-    std::lock_guard<std::mutex> lock(registry_mutex_);
+    std::lock_guard<StateMutex> lock(registry_mutex_);
     return players_;  // 返回副本，调用者可安全使用
 }
\ No newline at end of file
@@ -9,12 +9,14 @@
 #pragma once
 
 #include "ClanInfo.h"
+#include "StateMutex.h"
 
-#include <WinSock2.h>
+#include "PlatformSocket.h"
 
 #include <map>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 /**
  * @class PlayerRegistry
@@ -81,8 +83,8 @@ class PlayerRegistry {
     /**
      * @brief 通过玩家ID获取玩家上下文。
      *
-     * 遍历所有注册的玩家，查找匹配指定ID的玩家。
-     * 时间复杂度为 O(n)，其中 n 为在线玩家数量。
+     * 通过句柄索引直接定位，时间复杂度为 O(1)。
+     * 同一玩家ID在多个套接字上注册时，返回最近一次注册的上下文。
      *
      * @param player_id 要查找的玩家ID
      * @return 玩家上下文指针，如果不存在则返回 nullptr
@@ -90,7 +92,7 @@ class PlayerRegistry {
      * @warning 返回的指针在下次 Registry 操作后可能失效。
      * @note 线程安全：此方法内部加锁保护，但返回后锁已释放。
      */
-    PlayerContext* GetById(const std::string& player_id);
+    PlayerContext* GetById(InternedId player_id);
 
     /**
      * @brief 获取所有在线玩家的快照副本。
@@ -107,5 +109,6 @@ class PlayerRegistry {
 
  private:
     std::map<SOCKET, PlayerContext> players_;  ///< 玩家映射表（套接字 -> 上下文）
-    std::mutex registry_mutex_;                ///< 保护 players_ 的互斥锁
+    std::unordered_map<InternedId, PlayerContext*> by_id_;  ///< 玩家ID索引（指向 players_ 中的节点）
+    StateMutex registry_mutex_;                ///< 保护 players_ 与 by_id_ 的互斥锁
 };
\ No newline at end of file
@@ -26,13 +26,15 @@
 
 enum PacketType : uint32_t {
     // ======================== 基础功能 (1-9) ========================
-    // 玩家登录、地图上传/查询、用户列表等基础操作
+    // 玩家登录、地图上传/查询、用户列表、心跳等基础操作
     PACKET_LOGIN = 1,           ///< 登录请求/响应
     PACKET_UPLOAD_MAP = 2,      ///< 上传地图数据（无响应）
     PACKET_QUERY_MAP = 3,       ///< 查询地图数据
     PACKET_ATTACK_DATA = 4,     ///< 攻击数据（已废弃）
     PACKET_USER_LIST_REQ = 5,   ///< 请求在线用户列表
     PACKET_USER_LIST_RESP = 6,  ///< 响应在线用户列表
+    PACKET_HEARTBEAT_PING = 7,  ///< 心跳探测（服务器推送，客户端原样回复 PONG）
+    PACKET_HEARTBEAT_PONG = 8,  ///< 心跳应答
 
     // ======================== 匹配系统 (10-19) ========================
     // 普通匹配战斗相关
@@ -0,0 +1,184 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     RateLimiter.cpp
+ * File Function: 入站数据包限流与防洪泛实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "RateLimiter.h"
+#include "Protocol.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+// ============================================================================
+// 默认配置
+// ============================================================================
+
+RateLimitConfig RateLimitConfig::Defaults() {
+    RateLimitConfig config;
+
+    // 需要构建 JSON 列表的查询：每秒 2 次，突发 5 次
+    config.perType[PACKET_USER_LIST_REQ] = {2.0, 5.0};
+    config.perType[PACKET_CLAN_LIST] = {2.0, 5.0};
+    config.perType[PACKET_CLAN_MEMBERS] = {2.0, 5.0};
+    config.perType[PACKET_BATTLE_STATUS_LIST] = {2.0, 5.0};
+    config.perType[PACKET_WAR_MEMBER_LIST] = {2.0, 5.0};
+
+    // 地图上传/下载：数据量大，限制更严格
+    config.perType[PACKET_UPLOAD_MAP] = {0.2, 3.0};
+    config.perType[PACKET_QUERY_MAP] = {2.0, 5.0};
+    config.perType[PACKET_ATTACK_START] = {1.0, 3.0};
+    config.perType[PACKET_WAR_ATTACK] = {1.0, 3.0};
+
+    // 部落写操作会落盘
+    config.perType[PACKET_CLAN_CREATE] = {0.5, 2.0};
+    config.perType[PACKET_CLAN_JOIN] = {0.5, 3.0};
+    config.perType[PACKET_CLAN_LEAVE] = {0.5, 3.0};
+    config.perType[PACKET_CLAN_CHAT] = {3.0, 10.0};
+
+    // 实时战斗操作需要较高的吞吐
+    config.perType[PACKET_PVP_ACTION] = {30.0, 60.0};
+
+    return config;
+}
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+RateLimiter::RateLimiter(const RateLimitConfig& config) {
+    SetConfig(config);
+}
+
+void RateLimiter::SetConfig(const RateLimitConfig& config) {
+    for (uint32_t i = 0; i < RateLimitConfig::kMaxPacketTypes; ++i) {
+        has_rule_[i] = config.perType[i].rate > 0.0;
+        per_type_[i] = MakeCell(config.perType[i]);
+    }
+    default_cell_ = MakeCell(config.defaultRule);
+    global_bytes_cell_ = MakeCell(config.globalBytes);
+    max_consecutive_rejects_ = config.maxConsecutiveRejects;
+}
+
+RateLimiter::Cell RateLimiter::MakeCell(const RateLimitRule& rule) {
+    Cell cell;
+    if (rule.rate <= 0.0) {
+        return cell;
+    }
+    // 间隔向上取整：截断会让高速率规则（如每秒 32MB 的字节预算，约 29.8ns/字节）明显放宽
+    cell.exact_interval = 1e9 / rule.rate;
+    cell.interval = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(cell.exact_interval)));
+    cell.tolerance = static_cast<int64_t>(cell.exact_interval * std::max(1.0, rule.burst));
+    return cell;
+}
+
+int64_t RateLimiter::NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// ============================================================================
+// 限流判定
+// ============================================================================
+
+RateDecision RateLimiter::Check(ConnectionRateState& state,
+                                uint32_t packet_type, uint32_t length) {
+    const int64_t now = NowNs();
+
+    // 1. 按连接、按包类型的令牌桶（GCRA）
+    const bool tracked = packet_type < RateLimitConfig::kMaxPacketTypes &&
+                         has_rule_[packet_type];
+    const Cell& cell = tracked ? per_type_[packet_type] : default_cell_;
+    int64_t& tat = tracked ? state.tat[packet_type] : state.defaultTat;
+
+    RateDecision decision = RateDecision::kAccept;
+    int64_t new_tat = 0;
+    if (cell.interval > 0) {
+        new_tat = std::max(tat, now) + cell.interval;
+        if (new_tat - now > cell.tolerance) {
+            decision = RateDecision::kRejectPacketRate;
+        }
+    }
+
+    // 2. 全局入站字节预算（所有连接共享）
+    if (decision == RateDecision::kAccept && global_bytes_cell_.interval > 0 &&
+        length > 0) {
+        const int64_t cost = static_cast<int64_t>(std::ceil(global_bytes_cell_.exact_interval * length));
+        int64_t global = global_tat_.load(std::memory_order_relaxed);
+        for (;;) {
+            const int64_t next = std::max(global, now) + cost;
+            if (next - now > global_bytes_cell_.tolerance) {
+                decision = RateDecision::kRejectGlobalBytes;
+                break;
+            }
+            if (global_tat_.compare_exchange_weak(global, next,
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    }
+
+    if (decision == RateDecision::kAccept) {
+        if (cell.interval > 0) {
+            tat = new_tat;
+        }
+        state.consecutiveRejects = 0;
+        return decision;
+    }
+
+    // 被拒绝：记录统计信息
+    if (decision == RateDecision::kRejectGlobalBytes) {
+        rejected_global_bytes_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (packet_type < RateLimitConfig::kMaxPacketTypes) {
+        rejected_by_type_[packet_type].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        rejected_other_type_.fetch_add(1, std::memory_order_relaxed);
+    }
+    rejected_bytes_.fetch_add(length, std::memory_order_relaxed);
+    rejected_total_.fetch_add(1, std::memory_order_relaxed);
+
+    // 全局预算由所有连接共享，耗尽可能是其他连接造成的：只丢弃本包，不计入断开阈值
+    if (decision == RateDecision::kRejectGlobalBytes) {
+        return decision;
+    }
+
+    if (++state.consecutiveRejects > max_consecutive_rejects_) {
+        disconnects_.fetch_add(1, std::memory_order_relaxed);
+        return RateDecision::kDisconnect;
+    }
+    return decision;
+}
+
+// ============================================================================
+// 统计信息
+// ============================================================================
+
+std::string RateLimiter::GetStatsDump() const {
+    std::ostringstream oss;
+    oss << "[RateLimit] 被拒数据包统计:" << std::endl;
+
+    uint64_t total = rejected_other_type_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < RateLimitConfig::kMaxPacketTypes; ++i) {
+        uint64_t count = rejected_by_type_[i].load(std::memory_order_relaxed);
+        if (count > 0) {
+            oss << "  type=" << i << " rejected=" << count << std::endl;
+            total += count;
+        }
+    }
+
+    oss << "  未知类型: " << rejected_other_type_.load(std::memory_order_relaxed) << std::endl
+        << "  全局字节预算拒绝: " << rejected_global_bytes_.load(std::memory_order_relaxed) << std::endl
+        << "  被丢弃字节数: " << rejected_bytes_.load(std::memory_order_relaxed) << std::endl
+        << "  洪泛断开连接数: " << disconnects_.load(std::memory_order_relaxed) << std::endl
+        << "  总计: " << total;
+    return oss.str();
+}
+
+uint64_t RateLimiter::GetRejectedTotal() const {
+    return rejected_total_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,145 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     RateLimiter.h
+ * File Function: 入站数据包限流与防洪泛
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct RateLimitRule
+ * @brief 单个令牌桶的速率配置。
+ *
+ * rate 为每秒补充的令牌数，burst 为桶容量（允许的突发量）。
+ * rate <= 0 表示不限流。
+ */
+struct RateLimitRule {
+    double rate = 0.0;   ///< 每秒令牌数
+    double burst = 0.0;  ///< 桶容量
+};
+
+/**
+ * @struct RateLimitConfig
+ * @brief 限流配置：按包类型的令牌桶 + 全局入站字节预算。
+ */
+struct RateLimitConfig {
+    static constexpr uint32_t kMaxPacketTypes = 64;  ///< 可单独配置的包类型上限
+
+    std::array<RateLimitRule, kMaxPacketTypes> perType;  ///< 各包类型的规则（按连接）
+    RateLimitRule defaultRule{20.0, 40.0};               ///< 未单独配置的包类型使用此规则
+    RateLimitRule globalBytes{32.0 * 1024 * 1024, 24.0 * 1024 * 1024};  ///< 全局入站字节预算
+    int maxConsecutiveRejects = 64;  ///< 按包类型连续被拒次数超过此值则断开连接（全局预算拒绝不计入）
+
+    /**
+     * @brief 返回服务器默认配置。
+     *
+     * 对构建 JSON 或复制地图等开销较大的请求设置更严格的限制。
+     */
+    static RateLimitConfig Defaults();
+};
+
+/**
+ * @enum RateDecision
+ * @brief 限流判定结果。
+ */
+enum class RateDecision {
+    kAccept,            ///< 放行
+    kRejectPacketRate,  ///< 超出该包类型的速率
+    kRejectGlobalBytes, ///< 超出全局字节预算
+    kDisconnect         ///< 持续洪泛，应断开连接
+};
+
+/**
+ * @struct ConnectionRateState
+ * @brief 单个连接的限流状态。
+ *
+ * 由连接所属的客户端线程独占持有，因此无需加锁。
+ * 每个包类型只保存一个理论到达时间（GCRA 算法），判定为 O(1)。
+ */
+struct ConnectionRateState {
+    std::array<int64_t, RateLimitConfig::kMaxPacketTypes> tat{};  ///< 各包类型的理论到达时间（纳秒）
+    int64_t defaultTat = 0;        ///< 未单独配置类型共享的理论到达时间
+    int consecutiveRejects = 0;    ///< 按包类型连续被拒次数（全局字节预算拒绝不计入）
+};
+
+/**
+ * @class RateLimiter
+ * @brief 基于 GCRA（等价于令牌桶）的入站数据包限流器。
+ *
+ * 在读取载荷之前根据包头（类型 + 长度）做出判定，被拒绝的包
+ * 只需丢弃载荷，不会进入 JSON 构建或地图复制等处理逻辑。
+ *
+ * 快速路径只包含一次时钟读取、一次数组访问和一次全局原子 CAS，
+ * 不分配内存也不加锁。
+ *
+ * 线程安全：
+ * Check 可在任意客户端线程并发调用（各自传入自己的 ConnectionRateState）；
+ * 全局字节预算通过原子变量维护。
+ */
+class RateLimiter {
+ public:
+    explicit RateLimiter(const RateLimitConfig& config = RateLimitConfig::Defaults());
+
+    /**
+     * @brief 替换限流配置。
+     *
+     * @note 应在服务器开始接受连接前调用。
+     */
+    void SetConfig(const RateLimitConfig& config);
+
+    /**
+     * @brief 判定一个数据包是否放行。
+     *
+     * @param state 该连接的限流状态
+     * @param packet_type 数据包类型
+     * @param length 载荷长度（字节）
+     * @return 判定结果
+     */
+    RateDecision Check(ConnectionRateState& state, uint32_t packet_type,
+                       uint32_t length);
+
+    /**
+     * @brief 生成被拒数据包的统计信息文本。
+     */
+    std::string GetStatsDump() const;
+
+    /**
+     * @brief 返回累计被拒的数据包数（用于判断统计是否有新变化）。
+     */
+    uint64_t GetRejectedTotal() const;
+
+ private:
+    /// 预计算的 GCRA 参数：每个令牌的发放间隔与允许的突发容差
+    struct Cell {
+        int64_t interval = 0;        ///< 每个令牌的间隔（纳秒，向上取整），0 表示不限流
+        int64_t tolerance = 0;       ///< 突发容差（纳秒）
+        double exact_interval = 0.0; ///< 未取整的间隔，按字节计费时先乘长度再取整
+    };
+
+    static Cell MakeCell(const RateLimitRule& rule);
+    static int64_t NowNs();
+
+    std::array<Cell, RateLimitConfig::kMaxPacketTypes> per_type_;
+    std::array<bool, RateLimitConfig::kMaxPacketTypes> has_rule_{};
+    Cell default_cell_;
+    Cell global_bytes_cell_;
+    int max_consecutive_rejects_ = 64;
+
+    std::atomic<int64_t> global_tat_{0};  ///< 全局字节预算的理论到达时间
+
+    // ==================== 统计 ====================
+    std::array<std::atomic<uint64_t>, RateLimitConfig::kMaxPacketTypes> rejected_by_type_{};
+    std::atomic<uint64_t> rejected_other_type_{0};
+    std::atomic<uint64_t> rejected_global_bytes_{0};
+    std::atomic<uint64_t> rejected_bytes_{0};
+    std::atomic<uint64_t> rejected_total_{0};
+    std::atomic<uint64_t> disconnects_{0};
+};
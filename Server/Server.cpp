@@ -8,7 +8,9 @@
  ****************************************************************/
 #define _CRT_SECURE_NO_WARNINGS
 #define _WINSOCK_DEPRECATED_NO_WARNINGS
+#ifdef _WIN32
 #pragma comment(lib, "Ws2_32.lib")
+#endif
 
 #include "Server.h"
 #include "NetworkUtils.h"
@@ -17,38 +19,104 @@
 #include <iostream>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 // ============================================================================
 // 协议格式常量
 // ============================================================================
 namespace {
     constexpr char kFieldSeparator = '|';
+
+    // 跨分片列表（部落、在线用户）的最长等待时间，超时后以已收到的部分应答
+    constexpr std::chrono::milliseconds kShardListTimeout{2000};
+
+    /**
+     * @brief 把 JSON 数组的元素追加到 items（均不含方括号）
+     */
+    void appendJsonArrayItems(std::string& items, const std::string& array) {
+        if (array.size() <= 2 || array.front() != '[' || array.back() != ']') {
+            return;
+        }
+        if (!items.empty()) {
+            items += ',';
+        }
+        items.append(array, 1, array.size() - 2);
+    }
+
+    /**
+     * @brief 合并一个分片的列表：部落列表为 JSON 数组，在线用户列表以分隔符连接
+     */
+    void appendListItems(uint32_t packetType, std::string& items, const std::string& part) {
+        if (packetType == PACKET_CLAN_LIST) {
+            appendJsonArrayItems(items, part);
+            return;
+        }
+        if (part.empty()) {
+            return;
+        }
+        if (!items.empty()) {
+            items += kFieldSeparator;
+        }
+        items += part;
+    }
 }
 
 // ============================================================================
 // 构造与析构
 // ============================================================================
 
-Server::Server() : port(8888) {
+Server::Server(const ServerOptions& serverOptions)
+    : port(8888), options(serverOptions) {
+#ifdef _WIN32
     if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
         std::cerr << "[Server] WSAStartup 失败" << std::endl;
         exit(EXIT_FAILURE);
     }
+#endif
+
+    if (options.shardCount > 1) {
+        shardRing = std::make_unique<ShardRing>(options.shardCount);
+        shardBus = std::make_unique<ShardBus>(options.shardIndex, options.shardCount,
+                                              options.shardSocketDir);
+    }
 
     // 初始化各模块
     playerRegistry = std::make_unique<PlayerRegistry>();
-    clanHall = std::make_unique<ClanHall>(playerRegistry.get());
+    if (shardRing) {
+        // 每个分片只持久化归属自己的部落
+        clanHall = std::make_unique<ClanHall>(
+            playerRegistry.get(),
+            "clan_data_shard" + std::to_string(options.shardIndex) + ".txt",
+            [this](const std::string& clanId) { return isLocalId(clanId); });
+    } else {
+        clanHall = std::make_unique<ClanHall>(playerRegistry.get());
+    }
     clanWarRoom = std::make_unique<ClanWarRoom>(playerRegistry.get(), clanHall.get());
     matchmaker = std::make_unique<Matchmaker>();
     arenaSession = std::make_unique<ArenaSession>(playerRegistry.get());
     router = std::make_unique<Router>();
+    connectionReaper = std::make_unique<ConnectionReaper>();
+
+    if (options.singleThreadLogic) {
+        // 所有游戏状态只由逻辑线程访问，状态锁可以省略
+        StateMutex::SetSingleThreaded(true);
+        logicLoop = std::make_unique<LogicLoop>(
+            options.logicTick,
+            [this](LogicEvent& event) { dispatchLogicEvent(event); });
+    }
 
     registerRoutes();
 }
 
 Server::~Server() {
+    connectionReaper->Stop();
+    if (logicLoop) {
+        logicLoop->Stop();
+    }
     closesocket(serverSocket);
+#ifdef _WIN32
     WSACleanup();
+#endif
 }
 
 // ============================================================================
@@ -73,9 +141,9 @@ void Server::registerRoutes() {
 
             PlayerContext ctx;
             ctx.socket = client;
-            ctx.playerId = playerId;
+            ctx.playerId = InternedId::Intern(playerId);
             ctx.playerName = playerName.empty() ? playerId : playerName;
-            ctx.clanId = clanId;  // 恢复部落归属
+            ctx.clanId = InternedId::Intern(clanId);  // 恢复部落归属
             if (!trophiesStr.empty()) {
                 try {
                     ctx.trophies = std::stoi(trophiesStr);
@@ -86,15 +154,15 @@ void Server::registerRoutes() {
 
             playerRegistry->Register(client, ctx);
 
-            // 如果玩家有部落ID，确保部落记录中包含该玩家
-            if (!clanId.empty()) {
+            // 如果玩家有部落ID，确保部落记录中包含该玩家（部落归属其它分片时由其维护）
+            if (!clanId.empty() && isLocalId(clanId)) {
                 std::cout << "[Login] 调用 EnsurePlayerInClan: " << playerId << " -> " << clanId << std::endl;
-                clanHall->EnsurePlayerInClan(playerId, clanId);
+                clanHall->EnsurePlayerInClan(ctx.playerId, ctx.clanId);
                 
                 // 再次获取玩家信息确认 clanId 是否设置成功
-                PlayerContext* player = playerRegistry->GetById(playerId);
+                PlayerContext* player = playerRegistry->GetById(ctx.playerId);
                 if (player) {
-                    std::cout << "[Login] 登录后玩家clanId=" << (player->clanId.empty() ? "(空)" : player->clanId) << std::endl;
+                    std::cout << "[Login] 登录后玩家clanId=" << (player->clanId.empty() ? std::string("(空)") : player->clanId.str()) << std::endl;
                 }
             }
 
@@ -104,12 +172,17 @@ void Server::registerRoutes() {
             sendPacket(client, PACKET_LOGIN, "Login Success");
         });
 
+    // ======================== 心跳 ========================
+    // 活跃时间在收到包头时已刷新，PONG 无需额外处理
+    router->Register(PACKET_HEARTBEAT_PONG,
+        [](SOCKET, const std::string&) {});
+
     // ======================== 地图操作 ========================
     router->Register(PACKET_UPLOAD_MAP,
         [this](SOCKET client, const std::string& data) {
             PlayerContext* player = playerRegistry->GetBySocket(client);
             if (player != nullptr && !player->playerId.empty()) {
-                std::lock_guard<std::mutex> lock(dataMutex);
+                std::lock_guard<StateMutex> lock(dataMutex);
                 savedMaps[player->playerId] = data;
                 player->mapData = data;
                 std::cout << "[Map] 已保存玩家 " << player->playerId
@@ -119,8 +192,12 @@ void Server::registerRoutes() {
 
     router->Register(PACKET_QUERY_MAP,
         [this](SOCKET client, const std::string& data) {
-            std::lock_guard<std::mutex> lock(dataMutex);
-            auto it = savedMaps.find(data);
+            // 地图保存在目标玩家的归属分片上
+            if (forwardAsGuest(client, PACKET_QUERY_MAP, data, data, false)) {
+                return;
+            }
+            std::lock_guard<StateMutex> lock(dataMutex);
+            auto it = savedMaps.find(InternedId::Find(data));
             if (it != savedMaps.end()) {
                 sendPacket(client, PACKET_QUERY_MAP, it->second);
                 std::cout << "[Query] 已发送玩家 " << data << " 的地图" << std::endl;
@@ -137,6 +214,9 @@ void Server::registerRoutes() {
                 sendPacket(client, PACKET_USER_LIST_RESP, "");
                 return;
             }
+            if (requestShardLists(client, PACKET_USER_LIST_RESP)) {
+                return;
+            }
             std::string userList = getUserListJson(player->playerId);
             sendPacket(client, PACKET_USER_LIST_RESP, userList);
             std::cout << "[UserList] 已发送给: " << player->playerId << std::endl;
@@ -162,9 +242,9 @@ void Server::registerRoutes() {
             // 处理匹配
             auto matches = matchmaker->ProcessQueue();
             for (auto& match : matches) {
-                std::string msg1 = match.second.playerId + kFieldSeparator +
+                std::string msg1 = match.second.playerId.str() + kFieldSeparator +
                                    std::to_string(match.second.trophies);
-                std::string msg2 = match.first.playerId + kFieldSeparator +
+                std::string msg2 = match.first.playerId.str() + kFieldSeparator +
                                    std::to_string(match.first.trophies);
                 sendPacket(match.first.socket, PACKET_MATCH_FOUND, msg1);
                 sendPacket(match.second.socket, PACKET_MATCH_FOUND, msg2);
@@ -182,8 +262,11 @@ void Server::registerRoutes() {
     // ======================== 攻击处理 ========================
     router->Register(PACKET_ATTACK_START,
         [this](SOCKET client, const std::string& data) {
-            std::lock_guard<std::mutex> lock(dataMutex);
-            auto it = savedMaps.find(data);
+            if (forwardAsGuest(client, PACKET_ATTACK_START, data, data, false)) {
+                return;
+            }
+            std::lock_guard<StateMutex> lock(dataMutex);
+            auto it = savedMaps.find(InternedId::Find(data));
             if (it != savedMaps.end()) {
                 sendPacket(client, PACKET_ATTACK_START, it->second);
                 PlayerContext* player = playerRegistry->GetBySocket(client);
@@ -206,12 +289,18 @@ void Server::registerRoutes() {
                     attacker->trophies += result.trophyChange;
                 }
 
-                PlayerContext* defender = playerRegistry->GetById(result.defenderId);
-                if (defender != nullptr) {
-                    defender->gold -= result.goldLooted;
-                    defender->elixir -= result.elixirLooted;
-                    defender->trophies -= result.trophyChange;
-                    sendPacket(defender->socket, PACKET_ATTACK_RESULT, data);
+                // 防守方归属其它分片时由该分片结算；远端ID在本进程可能从未驻留，按原始字符串判断归属
+                std::istringstream iss(data);
+                std::string attackerId, defenderId;
+                std::getline(iss, attackerId, kFieldSeparator);
+                std::getline(iss, defenderId, kFieldSeparator);
+                if (shardBus && !defenderId.empty() && !isLocalId(defenderId)) {
+                    ShardMessage message;
+                    message.type = SHARD_ATTACK_RESULT;
+                    message.payload = data;
+                    shardBus->Send(shardRing->OwnerOf(defenderId), message);
+                } else {
+                    applyDefenderResult(result, data);
                 }
 
                 std::cout << "[Battle] 结果 - 星数: " << result.starsEarned
@@ -238,7 +327,7 @@ void Server::registerRoutes() {
 
             if (clanHall->CreateClan(player->playerId, data)) {
                 sendPacket(client, PACKET_CLAN_CREATE, 
-                           "OK" + std::string(1, kFieldSeparator) + player->clanId);
+                           "OK" + std::string(1, kFieldSeparator) + player->clanId.str());
             } else {
                 sendPacket(client, PACKET_CLAN_CREATE, "FAIL");
             }
@@ -251,7 +340,11 @@ void Server::registerRoutes() {
                 return;
             }
 
-            if (clanHall->JoinClan(player->playerId, data)) {
+            if (forwardAsGuest(client, PACKET_CLAN_JOIN, data, data, false)) {
+                return;
+            }
+
+            if (clanHall->JoinClan(player->playerId, InternedId::Find(data))) {
                 sendPacket(client, PACKET_CLAN_JOIN, "OK");
             } else {
                 sendPacket(client, PACKET_CLAN_JOIN, "FAIL");
@@ -265,6 +358,11 @@ void Server::registerRoutes() {
                 return;
             }
 
+            if (!player->clanId.empty() &&
+                forwardAsGuest(client, PACKET_CLAN_LEAVE, "", player->clanId.str(), false)) {
+                return;
+            }
+
             if (clanHall->LeaveClan(player->playerId)) {
                 sendPacket(client, PACKET_CLAN_LEAVE, "OK");
             } else {
@@ -274,13 +372,20 @@ void Server::registerRoutes() {
 
     router->Register(PACKET_CLAN_LIST,
         [this](SOCKET client, const std::string&) {
+            // 分片模式下每个分片只持有自己的部落，向其它分片查询后合并应答
+            if (requestShardLists(client, PACKET_CLAN_LIST)) {
+                return;
+            }
             std::string clanList = clanHall->GetClanListJson();
             sendPacket(client, PACKET_CLAN_LIST, clanList);
         });
 
     router->Register(PACKET_CLAN_MEMBERS,
         [this](SOCKET client, const std::string& data) {
-            std::string members = clanHall->GetClanMembersJson(data);
+            if (forwardAsGuest(client, PACKET_CLAN_MEMBERS, data, data, false)) {
+                return;
+            }
+            std::string members = clanHall->GetClanMembersJson(InternedId::Find(data));
             sendPacket(client, PACKET_CLAN_MEMBERS, members);
         });
 
@@ -302,8 +407,13 @@ void Server::registerRoutes() {
                 return;
             }
 
+            // 部落归属其它分片时，由部落所在分片取成员列表并分发
+            if (forwardAsGuest(client, PACKET_CLAN_CHAT, data, player->clanId.str(), false)) {
+                return;
+            }
+
             // 获取部落所有成员
-            std::vector<std::string> memberIds = clanHall->GetClanMemberIds(player->clanId);
+            std::vector<InternedId> memberIds = clanHall->GetClanMemberIds(player->clanId);
             
             // 构建聊天消息: sender|message
             std::string chatMessage = player->playerName + kFieldSeparator + data;
@@ -313,22 +423,46 @@ void Server::registerRoutes() {
                       << " (成员数: " << memberIds.size() << ")" << std::endl;
 
             // 广播给部落所有在线成员（包括发送者自己，以便确认消息已发送）
-            for (const auto& memberId : memberIds) {
+            // 分片模式下，归属其它分片的成员按分片分组后经总线转发
+            std::map<int, std::vector<InternedId>> remoteMembers;
+            for (InternedId memberId : memberIds) {
+                if (!isLocalId(memberId.str())) {
+                    remoteMembers[shardRing->OwnerOf(memberId.str())].push_back(memberId);
+                    continue;
+                }
                 PlayerContext* member = playerRegistry->GetById(memberId);
                 if (member != nullptr && member->socket != INVALID_SOCKET) {
                     sendPacket(member->socket, PACKET_CHAT_MESSAGE, chatMessage);
                 }
             }
+
+            for (const auto& pair : remoteMembers) {
+                std::ostringstream oss;
+                oss << pair.second.size();
+                for (const auto& memberId : pair.second) {
+                    oss << kFieldSeparator << memberId;
+                }
+                oss << kFieldSeparator << chatMessage;
+
+                ShardMessage relay;
+                relay.type = SHARD_CHAT_RELAY;
+                relay.payload = oss.str();
+                shardBus->Send(pair.first, relay);
+            }
         });
 
     // ======================== 部落战争 ========================
+    // 分片模式下部落战争由部落所在分片创建和保存，玩家的战争请求以访客身份转发过去
     router->Register(PACKET_WAR_SEARCH,
-        [this](SOCKET client, const std::string&) {
+        [this](SOCKET client, const std::string& data) {
             PlayerContext* player = playerRegistry->GetBySocket(client);
             if (player == nullptr || player->clanId.empty()) {
                 sendPacket(client, PACKET_WAR_SEARCH, "NO_CLAN");
                 return;
             }
+            if (forwardToClanShard(client, PACKET_WAR_SEARCH, data)) {
+                return;
+            }
             clanWarRoom->AddToQueue(player->clanId);
             sendPacket(client, PACKET_WAR_SEARCH, "SEARCHING");
         });
@@ -339,9 +473,12 @@ void Server::registerRoutes() {
             std::string warId, targetId;
             std::getline(iss, warId, kFieldSeparator);
             std::getline(iss, targetId, kFieldSeparator);
+            if (forwardAsGuest(client, PACKET_WAR_ATTACK, data, targetId, false)) {
+                return;
+            }
 
-            std::lock_guard<std::mutex> lock(dataMutex);
-            auto it = savedMaps.find(targetId);
+            std::lock_guard<StateMutex> lock(dataMutex);
+            auto it = savedMaps.find(InternedId::Find(targetId));
             if (it != savedMaps.end()) {
                 sendPacket(client, PACKET_WAR_ATTACK, 
                            warId + kFieldSeparator + it->second);
@@ -362,18 +499,31 @@ void Server::registerRoutes() {
         });
 
     // ======================== PVP 系统 ========================
+    // 目标玩家归属其它分片时，请求者以访客身份转发到目标分片处理，
+    // 后续的操作和结束包也随之转发
     router->Register(PACKET_PVP_REQUEST,
         [this](SOCKET client, const std::string& data) {
-            arenaSession->HandlePvpRequest(client, data);
+            if (forwardAsGuest(client, PACKET_PVP_REQUEST, data, data, true)) {
+                return;
+            }
+            arenaSession->HandlePvpRequest(client, InternedId::Find(data));
         });
 
     router->Register(PACKET_PVP_ACTION,
         [this](SOCKET client, const std::string& data) {
+            if (forwardPvpPacket(client, PACKET_PVP_ACTION, data)) {
+                return;
+            }
             arenaSession->HandlePvpAction(client, data);
         });
 
     router->Register(PACKET_PVP_END,
-        [this](SOCKET client, const std::string&) {
+        [this](SOCKET client, const std::string& data) {
+            if (forwardPvpPacket(client, PACKET_PVP_END, data)) {
+                std::lock_guard<StateMutex> lock(shardMutex);
+                pvpRemoteShard.erase(client);
+                return;
+            }
             PlayerContext* player = playerRegistry->GetBySocket(client);
             if (player != nullptr && !player->playerId.empty()) {
                 arenaSession->EndSession(player->playerId);
@@ -382,7 +532,10 @@ void Server::registerRoutes() {
 
     router->Register(PACKET_SPECTATE_REQUEST,
         [this](SOCKET client, const std::string& data) {
-            arenaSession->HandleSpectateRequest(client, data);
+            if (forwardAsGuest(client, PACKET_SPECTATE_REQUEST, data, data, true)) {
+                return;
+            }
+            arenaSession->HandleSpectateRequest(client, InternedId::Find(data));
         });
 
     // ======================== 部落战争增强 ========================
@@ -392,28 +545,39 @@ void Server::registerRoutes() {
             if (player == nullptr) {
                 return;
             }
-            std::string json = clanWarRoom->GetMemberListJson(data, player->playerId);
+            if (forwardToClanShard(client, PACKET_WAR_MEMBER_LIST, data)) {
+                return;
+            }
+            std::string json = clanWarRoom->GetMemberListJson(InternedId::Find(data),
+                                                              player->playerId);
             sendPacket(client, PACKET_WAR_MEMBER_LIST, json);
         });
 
     router->Register(PACKET_WAR_ATTACK_START,
         [this](SOCKET client, const std::string& data) {
+            if (forwardToClanShard(client, PACKET_WAR_ATTACK_START, data)) {
+                return;
+            }
             size_t pos = data.find(kFieldSeparator);
             if (pos != std::string::npos) {
-                std::string warId = data.substr(0, pos);
-                std::string targetId = data.substr(pos + 1);
+                InternedId warId = InternedId::Find(data.substr(0, pos));
+                InternedId targetId = InternedId::Find(data.substr(pos + 1));
                 clanWarRoom->HandleAttackStart(client, warId, targetId);
             }
         });
 
     router->Register(PACKET_WAR_ATTACK_END,
-        [this](SOCKET, const std::string& data) {
+        [this](SOCKET client, const std::string& data) {
+            if (forwardToClanShard(client, PACKET_WAR_ATTACK_END, data)) {
+                return;
+            }
             try {
                 AttackRecord record;
                 std::istringstream iss(data);
-                std::string warId, starsStr, destructionStr;
+                std::string warId, attackerId, starsStr, destructionStr;
                 std::getline(iss, warId, kFieldSeparator);
-                std::getline(iss, record.attackerId, kFieldSeparator);
+                std::getline(iss, attackerId, kFieldSeparator);
+                record.attackerId = InternedId::Find(attackerId);
                 std::getline(iss, record.attackerName, kFieldSeparator);
                 std::getline(iss, starsStr, kFieldSeparator);
                 std::getline(iss, destructionStr, kFieldSeparator);
@@ -426,7 +590,7 @@ void Server::registerRoutes() {
                 }
                 record.attackTime = std::chrono::steady_clock::now();
 
-                clanWarRoom->HandleAttackEnd(warId, record);
+                clanWarRoom->HandleAttackEnd(InternedId::Find(warId), record);
             } catch (const std::exception& e) {
                 std::cout << "[ClanWar] 解析攻击结束数据错误: " << e.what() << std::endl;
             }
@@ -434,10 +598,13 @@ void Server::registerRoutes() {
 
     router->Register(PACKET_WAR_SPECTATE,
         [this](SOCKET client, const std::string& data) {
+            if (forwardToClanShard(client, PACKET_WAR_SPECTATE, data)) {
+                return;
+            }
             size_t pos = data.find(kFieldSeparator);
             if (pos != std::string::npos) {
-                std::string warId = data.substr(0, pos);
-                std::string targetId = data.substr(pos + 1);
+                InternedId warId = InternedId::Find(data.substr(0, pos));
+                InternedId targetId = InternedId::Find(data.substr(pos + 1));
                 clanWarRoom->HandleSpectate(client, warId, targetId);
             }
         });
@@ -448,11 +615,14 @@ void Server::registerRoutes() {
             if (player == nullptr) {
                 return;
             }
+            if (forwardToClanShard(client, PACKET_WAR_END, data)) {
+                return;
+            }
 
             if (!data.empty()) {
-                clanWarRoom->EndWar(data);
+                clanWarRoom->EndWar(InternedId::Find(data));
             } else {
-                std::string warId = clanWarRoom->GetActiveWarIdForPlayer(player->playerId);
+                InternedId warId = clanWarRoom->GetActiveWarIdForPlayer(player->playerId);
                 if (!warId.empty()) {
                     clanWarRoom->EndWar(warId);
                 }
@@ -465,30 +635,116 @@ void Server::registerRoutes() {
 // ============================================================================
 
 void clientHandler(SOCKET clientSocket, Server& server) {
-    uint32_t msgType;
+    PacketHeader header;
     std::string msgData;
+    ConnectionRateState rateState;
+    auto activity = server.connectionReaper->Track(clientSocket);
+
+    while (recvPacketHeader(clientSocket, header)) {
+        ConnectionReaper::Touch(*activity);
+
+        // 仅凭包头做限流判定，被拒绝的包直接丢弃载荷，不进入业务处理
+        RateDecision decision = server.router->Admit(rateState, header.type, header.length);
+        if (decision == RateDecision::kDisconnect) {
+            std::cout << "[RateLimit] 客户端持续洪泛，断开连接: " << clientSocket << std::endl;
+            std::cout << server.router->GetRateLimitStats() << std::endl;
+            break;
+        }
+        if (decision != RateDecision::kAccept) {
+            if (!discardPacketBody(clientSocket, header.length)) {
+                break;
+            }
+            continue;
+        }
+
+        if (!recvPacketBody(clientSocket, header.length, msgData)) {
+            break;
+        }
+
+        // 分片模式：玩家归属其它分片时，把连接连同登录包移交过去，本线程退出
+        if (header.type == PACKET_LOGIN && server.handOffIfRemote(clientSocket, msgData)) {
+            break;
+        }
 
-    while (recvPacket(clientSocket, msgType, msgData)) {
-        server.router->Route(clientSocket, msgType, msgData);
+        if (server.logicLoop) {
+            LogicEvent event;
+            event.kind = LogicEvent::Kind::kPacket;
+            event.socket = clientSocket;
+            event.type = header.type;
+            event.data = std::move(msgData);
+            server.logicLoop->Post(std::move(event));
+        } else {
+            server.router->Route(clientSocket, header.type, msgData);
+        }
     }
 
+    ConnectionReaper::Untrack(*activity);
+
+    if (server.logicLoop) {
+        // 断开事件排在该连接所有数据包之后，由逻辑线程完成清理和关闭
+        LogicEvent event;
+        event.kind = LogicEvent::Kind::kDisconnect;
+        event.socket = clientSocket;
+        server.logicLoop->Post(std::move(event));
+    } else {
+        server.onClientDisconnected(clientSocket);
+    }
+}
+
+// ============================================================================
+// 连接事件
+// ============================================================================
+
+void Server::onClientConnected(SOCKET clientSocket) {
+    PlayerContext ctx;
+    ctx.socket = clientSocket;
+    playerRegistry->Register(clientSocket, ctx);
+}
+
+void Server::onClientDisconnected(SOCKET clientSocket) {
     // 玩家断开连接时的清理工作
-    PlayerContext* player = server.playerRegistry->GetBySocket(clientSocket);
-    std::string playerId;
+    PlayerContext* player = playerRegistry->GetBySocket(clientSocket);
+    InternedId playerId;
     if (player != nullptr) {
         playerId = player->playerId;
     }
 
-    server.matchmaker->Remove(clientSocket);
+    leaveRemoteShards(clientSocket);
+    matchmaker->Remove(clientSocket);
 
     if (!playerId.empty()) {
         // 清理 PVP 相关会话
-        server.arenaSession->CleanupPlayerSessions(playerId);
+        arenaSession->CleanupPlayerSessions(playerId);
         // 清理部落战争相关会话
-        server.clanWarRoom->CleanupPlayerSessions(playerId);
+        clanWarRoom->CleanupPlayerSessions(playerId);
     }
 
-    server.closeClientSocket(clientSocket);
+    closeClientSocket(clientSocket);
+}
+
+void Server::dispatchLogicEvent(LogicEvent& event) {
+    switch (event.kind) {
+        case LogicEvent::Kind::kConnect:
+            onClientConnected(event.socket);
+            break;
+        case LogicEvent::Kind::kPacket:
+            router->Route(event.socket, event.type, event.data);
+            break;
+        case LogicEvent::Kind::kDisconnect:
+            onClientDisconnected(event.socket);
+            break;
+        case LogicEvent::Kind::kShard: {
+            ShardMessage message;
+            message.type = event.type;
+            message.payload = std::move(event.data);
+            message.fd = event.socket;
+            handleShardMessage(message);
+            break;
+        }
+        case LogicEvent::Kind::kTimer:
+            flushExpiredShardLists();
+            break;
+    }
 }
 
 // ============================================================================
@@ -497,9 +753,62 @@ void clientHandler(SOCKET clientSocket, Server& server) {
 
 void Server::run() {
     createAndBindSocket();
+    startShardBus();
+    startHeartbeat();
+    if (logicLoop) {
+        logicLoop->Start();
+        std::cout << "[Server] 单线程逻辑模式，刻度: "
+                  << options.logicTick.count() << "ms" << std::endl;
+    }
     handleConnections();
 }
 
+void Server::startHeartbeat() {
+    connectionReaper->SetCallbacks(
+        [](SOCKET s) {
+            // 心跳线程为所有连接服务，不能被某个写满的连接阻塞；发不出去按漏发处理，超时后照常回收
+            trySendPacket(s, PACKET_HEARTBEAT_PING, "");
+        },
+        [](SOCKET s) {
+            // 关闭读写使阻塞中的 recv 返回，由 clientHandler 统一完成清理
+            std::cout << "[Heartbeat] 连接超时，断开: " << s << std::endl;
+            shutdown(s, SD_BOTH);
+        });
+    nextRateStatsLog = std::chrono::steady_clock::now() + options.rateStatsInterval;
+    connectionReaper->SetTickHook([this]() {
+        logRateLimitStats();
+        if (!shardBus) {
+            return;
+        }
+        // 超时的跨分片列表按已收到的部分应答；逻辑模式下分片状态只能由逻辑线程访问
+        if (logicLoop) {
+            LogicEvent event;
+            event.kind = LogicEvent::Kind::kTimer;
+            logicLoop->Post(std::move(event));
+        } else {
+            flushExpiredShardLists();
+        }
+    });
+    connectionReaper->Start();
+}
+
+void Server::logRateLimitStats() {
+    if (options.rateStatsInterval.count() <= 0) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextRateStatsLog) {
+        return;
+    }
+    nextRateStatsLog = now + options.rateStatsInterval;
+
+    uint64_t rejected = router->GetRejectedPacketCount();
+    if (rejected != loggedRateRejects) {
+        loggedRateRejects = rejected;
+        std::cout << router->GetRateLimitStats() << std::endl;
+    }
+}
+
 void Server::createAndBindSocket() {
     serverSocket = socket(AF_INET, SOCK_STREAM, 0);
     if (serverSocket == INVALID_SOCKET) {
@@ -507,6 +816,15 @@ void Server::createAndBindSocket() {
         exit(EXIT_FAILURE);
     }
 
+#ifdef SO_REUSEPORT
+    if (options.shardCount > 1) {
+        // 多个分片进程共享同一端口，由内核按连接哈希分配
+        int enable = 1;
+        setsockopt(serverSocket, SOL_SOCKET, SO_REUSEPORT,
+                   reinterpret_cast<const char*>(&enable), sizeof(enable));
+    }
+#endif
+
     serverAddr.sin_family = AF_INET;
     serverAddr.sin_addr.s_addr = INADDR_ANY;
     serverAddr.sin_port = htons(port);
@@ -529,7 +847,7 @@ void Server::handleConnections() {
 
     while (true) {
         sockaddr_in clientAddr;
-        int clientAddrLen = sizeof(clientAddr);
+        socklen_t clientAddrLen = sizeof(clientAddr);
         SOCKET clientSocket = accept(
             serverSocket, 
             reinterpret_cast<struct sockaddr*>(&clientAddr),
@@ -538,9 +856,14 @@ void Server::handleConnections() {
         if (clientSocket != INVALID_SOCKET) {
             std::cout << "[Connect] 新客户端: " << clientSocket << std::endl;
 
-            PlayerContext ctx;
-            ctx.socket = clientSocket;
-            playerRegistry->Register(clientSocket, ctx);
+            if (logicLoop) {
+                LogicEvent event;
+                event.kind = LogicEvent::Kind::kConnect;
+                event.socket = clientSocket;
+                logicLoop->Post(std::move(event));
+            } else {
+                onClientConnected(clientSocket);
+            }
 
             std::thread clientThread(clientHandler, clientSocket, std::ref(*this));
             clientThread.detach();
@@ -550,12 +873,14 @@ void Server::handleConnections() {
 
 void Server::closeClientSocket(SOCKET clientSocket) {
     PlayerContext* player = playerRegistry->GetBySocket(clientSocket);
-    std::string playerId;
+    InternedId playerId;
     if (player != nullptr) {
         playerId = player->playerId;
     }
 
     playerRegistry->Unregister(clientSocket);
+    // 描述符关闭后其值可能被新连接复用，访客转发必须先清除
+    setPacketRedirect(clientSocket, nullptr);
     closesocket(clientSocket);
 
     std::cout << "[Disconnect] 客户端: " << clientSocket;
@@ -565,6 +890,513 @@ void Server::closeClientSocket(SOCKET clientSocket) {
     std::cout << std::endl;
 }
 
+// ============================================================================
+// 分片
+// ============================================================================
+
+void Server::startShardBus() {
+    if (!shardBus) {
+        return;
+    }
+
+    bool started = shardBus->Start([this](ShardMessage& message) {
+        if (logicLoop) {
+            LogicEvent event;
+            event.kind = LogicEvent::Kind::kShard;
+            event.socket = message.fd;
+            event.type = message.type;
+            event.data = std::move(message.payload);
+            logicLoop->Post(std::move(event));
+        } else {
+            handleShardMessage(message);
+        }
+    });
+    if (!started) {
+        std::cerr << "[Shard] 总线启动失败" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+bool Server::isLocalId(const std::string& id) const {
+    return !shardRing || shardRing->OwnerOf(id) == options.shardIndex;
+}
+
+bool Server::handOffIfRemote(SOCKET clientSocket, const std::string& loginData) {
+    if (!shardBus) {
+        return false;
+    }
+
+    std::string playerId = loginData.substr(0, loginData.find(kFieldSeparator));
+    if (playerId.empty() || isLocalId(playerId)) {
+        return false;
+    }
+
+    ShardMessage message;
+    message.type = SHARD_HANDOFF;
+    message.payload = loginData;
+    message.fd = clientSocket;
+
+    int owner = shardRing->OwnerOf(playerId);
+    if (!shardBus->Send(owner, message)) {
+        // 目标分片不可用时退化为本地处理
+        std::cerr << "[Shard] 移交失败，本地处理玩家 " << playerId << std::endl;
+        return false;
+    }
+
+    std::cout << "[Shard] 玩家 " << playerId << " 移交到分片 " << owner << std::endl;
+    return true;
+}
+
+bool Server::forwardAsGuest(SOCKET client, uint32_t type, const std::string& data,
+                            const std::string& ownerId, bool pvpSession) {
+    if (!shardBus || ownerId.empty() || isLocalId(ownerId)) {
+        return false;
+    }
+
+    PlayerContext* player = playerRegistry->GetBySocket(client);
+    if (player == nullptr || player->playerId.empty()) {
+        return false;
+    }
+
+    // 载荷："playerId|playerName|trophies|clanId|packetType|data"
+    std::ostringstream oss;
+    oss << player->playerId << kFieldSeparator
+        << player->playerName << kFieldSeparator
+        << player->trophies << kFieldSeparator
+        << player->clanId << kFieldSeparator
+        << type << kFieldSeparator << data;
+
+    ShardMessage message;
+    message.type = SHARD_GUEST_FORWARD;
+    message.payload = oss.str();
+    message.fd = client;
+
+    int owner = shardRing->OwnerOf(ownerId);
+    if (!shardBus->Send(owner, message)) {
+        return false;
+    }
+
+    std::lock_guard<StateMutex> lock(shardMutex);
+    guestShards[client].insert(owner);
+    if (pvpSession) {
+        pvpRemoteShard[client] = owner;
+    }
+    return true;
+}
+
+bool Server::forwardPvpPacket(SOCKET client, uint32_t type, const std::string& data) {
+    if (!shardBus) {
+        return false;
+    }
+
+    int owner;
+    {
+        std::lock_guard<StateMutex> lock(shardMutex);
+        auto it = pvpRemoteShard.find(client);
+        if (it == pvpRemoteShard.end()) {
+            return false;
+        }
+        owner = it->second;
+    }
+
+    PlayerContext* player = playerRegistry->GetBySocket(client);
+    if (player == nullptr) {
+        return false;
+    }
+
+    ShardMessage message;
+    message.type = SHARD_GUEST_PACKET;
+    message.payload = player->playerId.str() + kFieldSeparator + std::to_string(type) +
+                      kFieldSeparator + data;
+    shardBus->Send(owner, message);
+    return true;
+}
+
+bool Server::forwardToClanShard(SOCKET client, uint32_t type, const std::string& data) {
+    PlayerContext* player = playerRegistry->GetBySocket(client);
+    if (player == nullptr || player->clanId.empty()) {
+        return false;
+    }
+    return forwardAsGuest(client, type, data, player->clanId.str(), false);
+}
+
+bool Server::requestShardLists(SOCKET client, uint32_t packetType) {
+    if (!shardBus) {
+        return false;
+    }
+
+    PlayerContext* player = playerRegistry->GetBySocket(client);
+    if (player == nullptr || player->playerId.empty()) {
+        return false;
+    }
+
+    PendingShardList pending;
+    pending.packetType = packetType;
+    pending.socket = client;
+    pending.playerId = player->playerId;
+    pending.remaining = shardRing->GetShardCount() - 1;
+    pending.deadline = std::chrono::steady_clock::now() + kShardListTimeout;
+    appendListItems(packetType, pending.items, getLocalList(packetType, player->playerId));
+
+    uint64_t requestId;
+    {
+        std::lock_guard<StateMutex> lock(shardMutex);
+        requestId = ++nextShardListRequest;
+        pendingShardLists[requestId] = std::move(pending);
+    }
+
+    ShardMessage query;
+    query.type = packetType == PACKET_CLAN_LIST ? SHARD_CLAN_LIST_QUERY : SHARD_USER_LIST_QUERY;
+    query.payload = std::to_string(options.shardIndex) + kFieldSeparator + std::to_string(requestId);
+    for (int shard = 0; shard < shardRing->GetShardCount(); ++shard) {
+        if (shard != options.shardIndex && !shardBus->Send(shard, query)) {
+            // 不可用的分片视为列表为空，不必等到超时
+            mergeShardList(requestId, "");
+        }
+    }
+    return true;
+}
+
+std::string Server::getLocalList(uint32_t packetType, InternedId requesterId) {
+    if (packetType == PACKET_CLAN_LIST) {
+        return clanHall->GetClanListJson();
+    }
+    return getUserListJson(requesterId);
+}
+
+void Server::mergeShardList(uint64_t requestId, const std::string& part) {
+    PendingShardList done;
+    {
+        std::lock_guard<StateMutex> lock(shardMutex);
+        auto it = pendingShardLists.find(requestId);
+        if (it == pendingShardLists.end()) {
+            return;  // 已超时应答
+        }
+        appendListItems(it->second.packetType, it->second.items, part);
+        if (--it->second.remaining > 0) {
+            return;
+        }
+        done = std::move(it->second);
+        pendingShardLists.erase(it);
+    }
+    deliverShardList(done);
+}
+
+void Server::flushExpiredShardLists() {
+    std::vector<PendingShardList> expired;
+    {
+        std::lock_guard<StateMutex> lock(shardMutex);
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = pendingShardLists.begin(); it != pendingShardLists.end();) {
+            if (it->second.deadline <= now) {
+                expired.push_back(std::move(it->second));
+                it = pendingShardLists.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (const auto& pending : expired) {
+        deliverShardList(pending);
+    }
+}
+
+void Server::deliverShardList(const PendingShardList& pending) {
+    // 请求者可能已断开，其套接字值也可能已分配给新连接
+    PlayerContext* player = playerRegistry->GetById(pending.playerId);
+    if (player == nullptr || player->socket != pending.socket) {
+        return;
+    }
+    if (pending.packetType == PACKET_CLAN_LIST) {
+        sendPacket(pending.socket, PACKET_CLAN_LIST, "[" + pending.items + "]");
+    } else {
+        sendPacket(pending.socket, pending.packetType, pending.items);
+    }
+}
+
+void Server::leaveRemoteShards(SOCKET client) {
+    if (!shardBus) {
+        return;
+    }
+
+    std::set<int> shards;
+    {
+        std::lock_guard<StateMutex> lock(shardMutex);
+        auto it = guestShards.find(client);
+        if (it == guestShards.end()) {
+            return;
+        }
+        shards.swap(it->second);
+        guestShards.erase(it);
+        pvpRemoteShard.erase(client);
+    }
+
+    PlayerContext* player = playerRegistry->GetBySocket(client);
+    if (player == nullptr) {
+        return;
+    }
+
+    ShardMessage message;
+    message.type = SHARD_GUEST_LEAVE;
+    message.payload = player->playerId.str();
+    for (int shard : shards) {
+        shardBus->Send(shard, message);
+    }
+}
+
+void Server::handleGuestForward(ShardMessage& message) {
+    // "playerId|playerName|trophies|clanId|packetType|data"
+    std::istringstream iss(message.payload);
+    std::string playerId, playerName, trophiesStr, clanId, typeStr, data;
+    std::getline(iss, playerId, kFieldSeparator);
+    std::getline(iss, playerName, kFieldSeparator);
+    std::getline(iss, trophiesStr, kFieldSeparator);
+    std::getline(iss, clanId, kFieldSeparator);
+    std::getline(iss, typeStr, kFieldSeparator);
+    std::getline(iss, data, '\0');
+
+    uint32_t type = 0;
+    int trophies = 0;
+    try {
+        type = static_cast<uint32_t>(std::stoul(typeStr));
+        trophies = std::stoi(trophiesStr);
+    } catch (...) {
+        if (message.fd != INVALID_SOCKET) {
+            closesocket(message.fd);
+        }
+        return;
+    }
+
+    // 访客在本分片上同样以句柄标识
+    InternedId guestId = InternedId::Intern(playerId);
+    SOCKET guestSocket = message.fd;
+    {
+        std::lock_guard<StateMutex> lock(shardMutex);
+        auto it = guestSockets.find(guestId);
+        if (it != guestSockets.end()) {
+            // 已是本分片访客，复用之前的描述符
+            if (guestSocket != INVALID_SOCKET) {
+                closesocket(guestSocket);
+            }
+            guestSocket = it->second;
+        } else if (guestSocket != INVALID_SOCKET) {
+            // 本进程发给访客的数据包经总线交给归属分片写入，避免两个进程同时写同一连接
+            int home = shardRing->OwnerOf(playerId);
+            setPacketRedirect(guestSocket,
+                [this, home, playerId](uint32_t replyType, const std::string& replyData) {
+                    ShardMessage reply;
+                    reply.type = SHARD_GUEST_REPLY;
+                    reply.payload = playerId + kFieldSeparator + std::to_string(replyType) +
+                                    kFieldSeparator + replyData;
+                    return shardBus->Send(home, reply);
+                });
+            guestSockets[guestId] = guestSocket;
+        }
+    }
+    if (guestSocket == INVALID_SOCKET) {
+        return;
+    }
+
+    PlayerContext* guest = playerRegistry->GetBySocket(guestSocket);
+    if (guest == nullptr) {
+        PlayerContext ctx;
+        ctx.socket = guestSocket;
+        ctx.playerId = guestId;
+        ctx.playerName = playerName;
+        ctx.trophies = trophies;
+        ctx.clanId = InternedId::Intern(clanId);
+        playerRegistry->Register(guestSocket, ctx);
+        guest = playerRegistry->GetBySocket(guestSocket);
+    }
+    InternedId clanBefore = guest != nullptr ? guest->clanId : InternedId::Find(clanId);
+
+    router->Route(guestSocket, type, data);
+
+    // 部落归属变化（加入/离开）需要同步回玩家所在分片
+    guest = playerRegistry->GetBySocket(guestSocket);
+    if (guest != nullptr && guest->clanId != clanBefore) {
+        ShardMessage update;
+        update.type = SHARD_PLAYER_CLAN;
+        update.payload = playerId + kFieldSeparator + guest->clanId.str();
+        shardBus->Send(shardRing->OwnerOf(playerId), update);
+    }
+}
+
+void Server::handleShardMessage(ShardMessage& message) {
+    switch (message.type) {
+        case SHARD_HANDOFF: {
+            // 接管连接：重放登录包，然后为其启动接收线程
+            SOCKET clientSocket = message.fd;
+            if (clientSocket == INVALID_SOCKET) {
+                return;
+            }
+            onClientConnected(clientSocket);
+            router->Route(clientSocket, PACKET_LOGIN, message.payload);
+            std::thread clientThread(clientHandler, clientSocket, std::ref(*this));
+            clientThread.detach();
+            break;
+        }
+
+        case SHARD_CHAT_RELAY: {
+            // "count|id1|...|idN|message"
+            std::istringstream iss(message.payload);
+            std::string token;
+            std::getline(iss, token, kFieldSeparator);
+            int count = 0;
+            try {
+                count = std::stoi(token);
+            } catch (...) {
+                return;
+            }
+
+            std::vector<InternedId> memberIds;
+            for (int i = 0; i < count && std::getline(iss, token, kFieldSeparator); ++i) {
+                memberIds.push_back(InternedId::Find(token));  // 不在本分片登录过的成员无需驻留
+            }
+            std::string chatMessage;
+            std::getline(iss, chatMessage, '\0');
+
+            for (InternedId memberId : memberIds) {
+                PlayerContext* member = playerRegistry->GetById(memberId);
+                if (member != nullptr && member->socket != INVALID_SOCKET) {
+                    sendPacket(member->socket, PACKET_CHAT_MESSAGE, chatMessage);
+                }
+            }
+            break;
+        }
+
+        case SHARD_GUEST_FORWARD:
+            handleGuestForward(message);
+            break;
+
+        case SHARD_GUEST_PACKET: {
+            // "playerId|type|data"
+            std::istringstream iss(message.payload);
+            std::string playerId, typeStr, data;
+            std::getline(iss, playerId, kFieldSeparator);
+            std::getline(iss, typeStr, kFieldSeparator);
+            std::getline(iss, data, '\0');
+
+            SOCKET guestSocket = INVALID_SOCKET;
+            {
+                std::lock_guard<StateMutex> lock(shardMutex);
+                auto it = guestSockets.find(InternedId::Find(playerId));
+                if (it != guestSockets.end()) {
+                    guestSocket = it->second;
+                }
+            }
+            if (guestSocket == INVALID_SOCKET) {
+                return;
+            }
+            try {
+                router->Route(guestSocket, static_cast<uint32_t>(std::stoul(typeStr)), data);
+            } catch (...) {}
+            break;
+        }
+
+        case SHARD_GUEST_REPLY: {
+            // "playerId|type|data"：访客分片的回包，由本分片作为连接的唯一写入者发送
+            std::istringstream iss(message.payload);
+            std::string playerId, typeStr, data;
+            std::getline(iss, playerId, kFieldSeparator);
+            std::getline(iss, typeStr, kFieldSeparator);
+            std::getline(iss, data, '\0');
+
+            PlayerContext* player = playerRegistry->GetById(InternedId::Find(playerId));
+            if (player == nullptr || player->socket == INVALID_SOCKET) {
+                return;
+            }
+            try {
+                sendPacket(player->socket, static_cast<uint32_t>(std::stoul(typeStr)), data);
+            } catch (...) {}
+            break;
+        }
+
+        case SHARD_CLAN_LIST_QUERY:
+        case SHARD_USER_LIST_QUERY: {
+            // "originShard|requestId"
+            size_t pos = message.payload.find(kFieldSeparator);
+            if (pos == std::string::npos) {
+                return;
+            }
+            int origin = 0;
+            try {
+                origin = std::stoi(message.payload.substr(0, pos));
+            } catch (...) {
+                return;
+            }
+
+            bool clanList = message.type == SHARD_CLAN_LIST_QUERY;
+            ShardMessage reply;
+            reply.type = clanList ? SHARD_CLAN_LIST_REPLY : SHARD_USER_LIST_REPLY;
+            reply.payload = message.payload.substr(pos + 1) + kFieldSeparator +
+                            getLocalList(clanList ? PACKET_CLAN_LIST : PACKET_USER_LIST_RESP, InternedId());
+            shardBus->Send(origin, reply);
+            break;
+        }
+
+        case SHARD_CLAN_LIST_REPLY:
+        case SHARD_USER_LIST_REPLY: {
+            // "requestId|list"
+            size_t pos = message.payload.find(kFieldSeparator);
+            if (pos == std::string::npos) {
+                return;
+            }
+            uint64_t requestId = 0;
+            try {
+                requestId = std::stoull(message.payload.substr(0, pos));
+            } catch (...) {
+                return;
+            }
+            mergeShardList(requestId, message.payload.substr(pos + 1));
+            break;
+        }
+
+        case SHARD_ATTACK_RESULT: {
+            // 本分片是防守方的归属分片：结算防守方并通知其客户端
+            try {
+                applyDefenderResult(deserializeAttackResult(message.payload), message.payload);
+            } catch (...) {}
+            break;
+        }
+
+        case SHARD_GUEST_LEAVE: {
+            SOCKET guestSocket = INVALID_SOCKET;
+            {
+                std::lock_guard<StateMutex> lock(shardMutex);
+                auto it = guestSockets.find(InternedId::Find(message.payload));
+                if (it != guestSockets.end()) {
+                    guestSocket = it->second;
+                    guestSockets.erase(it);
+                }
+            }
+            if (guestSocket != INVALID_SOCKET) {
+                // 清理会话并关闭本进程持有的副本，不影响归属分片上的原连接
+                onClientDisconnected(guestSocket);
+            }
+            break;
+        }
+
+        case SHARD_PLAYER_CLAN: {
+            // "playerId|clanId"
+            size_t pos = message.payload.find(kFieldSeparator);
+            if (pos == std::string::npos) {
+                return;
+            }
+            PlayerContext* player =
+                playerRegistry->GetById(InternedId::Find(message.payload.substr(0, pos)));
+            if (player != nullptr) {
+                player->clanId = InternedId::Intern(message.payload.substr(pos + 1));
+            }
+            break;
+        }
+
+        default:
+            std::cout << "[Shard] 未知的分片消息类型: " << message.type << std::endl;
+            break;
+    }
+}
+
 // ============================================================================
 // 辅助函数
 // ============================================================================
@@ -586,8 +1418,10 @@ AttackResult Server::deserializeAttackResult(const std::string& data) {
     std::istringstream iss(data);
     std::string token;
 
-    std::getline(iss, result.attackerId, kFieldSeparator);
-    std::getline(iss, result.defenderId, kFieldSeparator);
+    std::getline(iss, token, kFieldSeparator);
+    result.attackerId = InternedId::Find(token);
+    std::getline(iss, token, kFieldSeparator);
+    result.defenderId = InternedId::Find(token);
 
     std::getline(iss, token, kFieldSeparator);
     if (!token.empty()) {
@@ -614,15 +1448,27 @@ AttackResult Server::deserializeAttackResult(const std::string& data) {
     return result;
 }
 
-std::string Server::getUserListJson(const std::string& requesterId) {
+void Server::applyDefenderResult(const AttackResult& result, const std::string& data) {
+    PlayerContext* defender = playerRegistry->GetById(result.defenderId);
+    if (defender != nullptr) {
+        defender->gold -= result.goldLooted;
+        defender->elixir -= result.elixirLooted;
+        defender->trophies -= result.trophyChange;
+        sendPacket(defender->socket, PACKET_ATTACK_RESULT, data);
+    }
+}
+
+std::string Server::getUserListJson(InternedId requesterId) {
     auto allPlayers = playerRegistry->GetAllSnapshot();
 
     std::ostringstream oss;
     bool first = true;
 
+    // 分片模式下访客只是远端玩家的副本，由其归属分片列出
+    std::lock_guard<StateMutex> lock(shardMutex);
     for (const auto& pair : allPlayers) {
         const auto& player = pair.second;
-        if (player.playerId.empty() || player.playerId == requesterId) {
+        if (player.playerId.empty() || player.playerId == requesterId || guestSockets.count(player.playerId) > 0) {
             continue;
         }
 
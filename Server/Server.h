@@ -16,17 +16,45 @@
 #include "ClanInfo.h"
 #include "ClanWarRoom.h"
 #include "CommandDispatcher.h"
+#include "ConnectionReaper.h"
+#include "LogicLoop.h"
 #include "MatchMaker.h"
 #include "PlayerRegistry.h"
 #include "Protocol.h"
+#include "ShardBus.h"
+#include "ShardRing.h"
+#include "StateMutex.h"
 #include "WarModels.h"
 
-#include <WinSock2.h>
+#include "PlatformSocket.h"
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+
+/**
+ * @struct ServerOptions
+ * @brief 服务器启动选项
+ */
+struct ServerOptions {
+    /// 单线程逻辑模式：网络线程只收包，游戏逻辑全部在一个固定刻度的
+    /// 逻辑线程中执行，状态锁被省略（见 LogicLoop / StateMutex）
+    bool singleThreadLogic = false;
+    std::chrono::milliseconds logicTick{5};  ///< 逻辑线程刻度
+
+    /// 分片模式：shardCount 个进程通过 SO_REUSEPORT 共享同一端口，
+    /// 玩家按ID一致性哈希归属到分片，跨分片操作经 Unix 域套接字转发
+    int shardCount = 1;
+    int shardIndex = 0;                      ///< 本进程的分片编号
+    std::string shardSocketDir = "/tmp";     ///< 分片总线套接字目录
+
+    /// 限流统计的输出周期（有新的被拒数据包时才输出），0 表示只在洪泛断开时输出
+    std::chrono::seconds rateStatsInterval{60};
+};
 
 /**
  * @class Server
@@ -34,7 +62,7 @@
  */
 class Server {
  public:
-    Server();
+    explicit Server(const ServerOptions& options = ServerOptions());
     ~Server();
 
     /**
@@ -47,10 +75,13 @@ class Server {
 
  private:
     // ==================== 网络基础 ====================
+#ifdef _WIN32
     WSADATA wsaData;
+#endif
     SOCKET serverSocket;
     struct sockaddr_in serverAddr;
     int port;
+    ServerOptions options;
 
     // ==================== 模块化组件 ====================
     std::unique_ptr<PlayerRegistry> playerRegistry;  // 玩家注册管理
@@ -59,16 +90,66 @@ class Server {
     std::unique_ptr<Matchmaker> matchmaker;          // 匹配系统
     std::unique_ptr<ArenaSession> arenaSession;      // PVP竞技场
     std::unique_ptr<Router> router;                  // 命令路由器
+    std::unique_ptr<ConnectionReaper> connectionReaper;  // 心跳与空闲连接回收
+    std::unique_ptr<LogicLoop> logicLoop;            // 单线程逻辑循环（仅单线程逻辑模式）
+    std::unique_ptr<ShardRing> shardRing;            // 分片一致性哈希环（仅分片模式）
+    std::unique_ptr<ShardBus> shardBus;              // 分片消息总线（仅分片模式）
 
     // ==================== 共享数据 ====================
-    std::map<std::string, std::string> savedMaps;  // 玩家ID -> 地图数据
+    std::unordered_map<InternedId, std::string> savedMaps;  // 玩家ID -> 地图数据
     std::map<std::string, PlayerContext> playerDatabase;  // 玩家持久化数据
-    std::mutex dataMutex;  // 保护共享数据的互斥锁
+    StateMutex dataMutex;  // 保护共享数据的互斥锁
+
+    // ==================== 定期任务（仅时间轮线程访问） ====================
+    std::chrono::steady_clock::time_point nextRateStatsLog;  // 下次检查限流统计的时刻
+    uint64_t loggedRateRejects = 0;                          // 上次输出时的累计被拒数
+
+    // ==================== 分片状态 ====================
+    std::map<SOCKET, int> pvpRemoteShard;          // 本地玩家 -> 进行中的 PVP/观战所在分片
+    std::map<SOCKET, std::set<int>> guestShards;   // 本地玩家 -> 以访客身份访问过的分片
+    std::unordered_map<InternedId, SOCKET> guestSockets;  // 远端玩家ID -> 复制到本进程的套接字
+
+    /**
+     * @brief 等待其它分片应答的列表请求（部落列表、在线用户列表）
+     */
+    struct PendingShardList {
+        uint32_t packetType = 0;         // 应答包类型：PACKET_CLAN_LIST 或 PACKET_USER_LIST_RESP
+        SOCKET socket = INVALID_SOCKET;  // 请求者连接
+        InternedId playerId;             // 请求者ID（发送前确认连接未被复用）
+        int remaining = 0;               // 尚未应答的分片数
+        std::string items;               // 已合并的列表元素（部落列表为不含方括号的 JSON 数组元素）
+        std::chrono::steady_clock::time_point deadline;  // 超时后以已收到的部分应答
+    };
+    std::map<uint64_t, PendingShardList> pendingShardLists;  // 请求编号 -> 待合并的列表
+    uint64_t nextShardListRequest = 0;
+    StateMutex shardMutex;                         // 保护上述分片映射
 
     // ==================== 网络函数 ====================
     void createAndBindSocket();
     void handleConnections();
     void closeClientSocket(SOCKET clientSocket);
+    void startHeartbeat();
+    void logRateLimitStats();
+    void onClientConnected(SOCKET clientSocket);
+    void onClientDisconnected(SOCKET clientSocket);
+    void dispatchLogicEvent(LogicEvent& event);
+
+    // ==================== 分片 ====================
+    void startShardBus();
+    bool isLocalId(const std::string& id) const;
+    bool handOffIfRemote(SOCKET clientSocket, const std::string& loginData);
+    bool forwardAsGuest(SOCKET client, uint32_t type, const std::string& data,
+                        const std::string& ownerId, bool pvpSession);
+    bool forwardPvpPacket(SOCKET client, uint32_t type, const std::string& data);
+    bool forwardToClanShard(SOCKET client, uint32_t type, const std::string& data);
+    bool requestShardLists(SOCKET client, uint32_t packetType);
+    std::string getLocalList(uint32_t packetType, InternedId requesterId);
+    void mergeShardList(uint64_t requestId, const std::string& part);
+    void flushExpiredShardLists();
+    void deliverShardList(const PendingShardList& pending);
+    void leaveRemoteShards(SOCKET client);
+    void handleGuestForward(ShardMessage& message);
+    void handleShardMessage(ShardMessage& message);
 
     // ==================== 路由注册 ====================
     void registerRoutes();
@@ -76,7 +157,8 @@ class Server {
     // ==================== 辅助函数 ====================
     std::string serializeAttackResult(const AttackResult& result);
     AttackResult deserializeAttackResult(const std::string& data);
-    std::string getUserListJson(const std::string& requesterId);
+    void applyDefenderResult(const AttackResult& result, const std::string& data);
+    std::string getUserListJson(InternedId requesterId);
 };
 
 #endif  // SERVER_H_
\ No newline at end of file
@@ -8,11 +8,43 @@
  ****************************************************************/
 #include "Server.h"
 
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char* argv[]) {
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--logic-loop") == 0) {
+            options.singleThreadLogic = true;
+        } else if (std::strcmp(argv[i], "--logic-tick") == 0 && i + 1 < argc) {
+            options.logicTick = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            options.shardCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--shard-index") == 0 && i + 1 < argc) {
+            options.shardIndex = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--shard-dir") == 0 && i + 1 < argc) {
+            options.shardSocketDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--rate-stats-interval") == 0 && i + 1 < argc) {
+            options.rateStatsInterval = std::chrono::seconds(std::atoi(argv[++i]));
+        }
+    }
+
+    if (options.shardCount < 1 || options.shardIndex < 0 ||
+        options.shardIndex >= options.shardCount) {
+        std::cerr << "无效的分片参数: --shards " << options.shardCount
+                  << " --shard-index " << options.shardIndex << std::endl;
+        return -1;
+    }
+
+#ifndef _WIN32
+    // 对端已关闭时 send 返回错误即可，不要让 SIGPIPE 终止进程
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
     try {
-        Server server;
+        Server server(options);
         server.run();
     } catch (const std::exception& e) {
         std::cerr << "服务器错误: " << e.what() << std::endl;
@@ -0,0 +1,333 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     ShardBus.cpp
+ * File Function: 分片进程间的本地消息总线实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "ShardBus.h"
+#include "NetworkUtils.h"
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/un.h>
+#endif
+
+// ============================================================================
+// 构造与析构
+// ============================================================================
+
+ShardBus::ShardBus(int shard_index, int shard_count, const std::string& socket_dir)
+    : shard_index_(shard_index), shard_count_(shard_count), socket_dir_(socket_dir) {
+    // 出站连接表在构造时建好，之后只读，Send 无需全局锁
+    for (int shard = 0; shard < shard_count_; ++shard) {
+        if (shard != shard_index_) {
+            peers_[shard] = std::make_unique<Peer>();
+        }
+    }
+}
+
+ShardBus::~ShardBus() {
+    running_ = false;
+    if (listen_socket_ != INVALID_SOCKET) {
+        closesocket(listen_socket_);
+    }
+    for (auto& pair : peers_) {
+        Peer& peer = *pair.second;
+        {
+            // 唤醒发送线程；对方不读时发送线程可能阻塞在写操作上，先关闭连接的写方向
+            std::lock_guard<std::mutex> lock(peer.mutex);
+            if (peer.socket != INVALID_SOCKET) {
+                shutdown(peer.socket, SD_BOTH);
+            }
+            peer.ready.notify_all();
+        }
+        if (peer.writer.joinable()) {
+            peer.writer.join();
+        }
+        if (peer.socket != INVALID_SOCKET) {
+            closesocket(peer.socket);
+        }
+        for (auto& message : peer.queue) {
+            if (message.fd != INVALID_SOCKET) {
+                closesocket(message.fd);
+            }
+        }
+    }
+}
+
+std::string ShardBus::PathOf(int shard) const {
+    return socket_dir_ + "/coc_shard_" + std::to_string(shard) + ".sock";
+}
+
+#ifdef _WIN32
+
+// ============================================================================
+// Windows：不支持分片模式
+// ============================================================================
+
+bool ShardBus::Start(MessageHandler) {
+    std::cerr << "[ShardBus] 分片模式仅支持 POSIX 平台" << std::endl;
+    return false;
+}
+
+bool ShardBus::Send(int, const ShardMessage&) { return false; }
+SOCKET ShardBus::ConnectTo(int) { return INVALID_SOCKET; }
+void ShardBus::AcceptLoop() {}
+void ShardBus::ReadLoop(SOCKET) {}
+void ShardBus::WriteLoop(int, Peer&) {}
+bool ShardBus::SendMessage(SOCKET, const ShardMessage&) { return false; }
+bool ShardBus::RecvMessage(SOCKET, ShardMessage&) { return false; }
+
+#else
+
+// ============================================================================
+// 监听与接收
+// ============================================================================
+
+bool ShardBus::Start(MessageHandler handler) {
+    handler_ = std::move(handler);
+
+    listen_socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_socket_ == INVALID_SOCKET) {
+        std::cerr << "[ShardBus] 创建 Unix 域套接字失败" << std::endl;
+        return false;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::string path = PathOf(shard_index_);
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "[ShardBus] 套接字路径过长: " << path << std::endl;
+        return false;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());  // 清理上次运行残留的套接字文件
+
+    if (bind(listen_socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR ||
+        listen(listen_socket_, SOMAXCONN) == SOCKET_ERROR) {
+        std::cerr << "[ShardBus] 绑定失败: " << path << std::endl;
+        closesocket(listen_socket_);
+        listen_socket_ = INVALID_SOCKET;
+        return false;
+    }
+
+    running_ = true;
+    for (auto& pair : peers_) {
+        pair.second->writer = std::thread(&ShardBus::WriteLoop, this, pair.first, std::ref(*pair.second));
+    }
+    std::thread(&ShardBus::AcceptLoop, this).detach();
+    std::cout << "[ShardBus] 分片 " << shard_index_ << "/" << shard_count_
+              << " 总线已启动: " << path << std::endl;
+    return true;
+}
+
+void ShardBus::AcceptLoop() {
+    while (running_) {
+        SOCKET peer = accept(listen_socket_, nullptr, nullptr);
+        if (peer == INVALID_SOCKET) {
+            continue;
+        }
+        std::thread(&ShardBus::ReadLoop, this, peer).detach();
+    }
+}
+
+void ShardBus::ReadLoop(SOCKET peer) {
+    ShardMessage message;
+    while (RecvMessage(peer, message)) {
+        handler_(message);
+        message = ShardMessage();
+    }
+    closesocket(peer);
+}
+
+// ============================================================================
+// 发送
+// ============================================================================
+
+SOCKET ShardBus::ConnectTo(int shard) {
+    SOCKET s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET) {
+        return INVALID_SOCKET;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, PathOf(shard).c_str(), sizeof(addr.sun_path) - 1);
+
+    if (connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+        closesocket(s);
+        return INVALID_SOCKET;
+    }
+    return s;
+}
+
+bool ShardBus::Send(int shard, const ShardMessage& message) {
+    auto it = peers_.find(shard);
+    if (it == peers_.end() || !running_) {
+        return false;
+    }
+
+    Peer& peer = *it->second;
+    std::lock_guard<std::mutex> lock(peer.mutex);
+
+    // 连接在入队时建立，目标分片不可达时调用方仍能同步得知（如移交失败退化为本地处理）
+    if (peer.socket == INVALID_SOCKET) {
+        peer.socket = ConnectTo(shard);
+        if (peer.socket == INVALID_SOCKET) {
+            std::cerr << "[ShardBus] 无法连接分片 " << shard << std::endl;
+            return false;
+        }
+    }
+    if (peer.queue.size() >= kMaxQueuedMessages) {
+        std::cerr << "[ShardBus] 分片 " << shard << " 发送队列已满" << std::endl;
+        return false;
+    }
+
+    ShardMessage queued;
+    queued.type = message.type;
+    queued.payload = message.payload;
+    if (message.fd != INVALID_SOCKET) {
+        // 调用方返回后可能立即关闭原描述符（如移交后退出的接收线程），入队的是副本
+        queued.fd = fcntl(message.fd, F_DUPFD_CLOEXEC, 0);
+        if (queued.fd == INVALID_SOCKET) {
+            return false;
+        }
+    }
+    peer.queue.push_back(std::move(queued));
+    peer.ready.notify_one();
+    return true;
+}
+
+void ShardBus::WriteLoop(int shard, Peer& peer) {
+    std::unique_lock<std::mutex> lock(peer.mutex);
+    for (;;) {
+        peer.ready.wait(lock, [&]() { return !peer.queue.empty() || !running_; });
+        if (!running_) {
+            return;
+        }
+        ShardMessage message = std::move(peer.queue.front());
+        peer.queue.pop_front();
+
+        // 写操作不持锁，期间 Send 仍可入队；连接断开（对方重启）时重连一次
+        bool sent = false;
+        for (int attempt = 0; attempt < 2 && !sent; ++attempt) {
+            if (peer.socket == INVALID_SOCKET) {
+                peer.socket = ConnectTo(shard);
+                if (peer.socket == INVALID_SOCKET) {
+                    break;
+                }
+            }
+            SOCKET s = peer.socket;
+            lock.unlock();
+            sent = SendMessage(s, message);
+            lock.lock();
+            if (!sent) {
+                closesocket(s);
+                peer.socket = INVALID_SOCKET;
+            }
+        }
+        if (!sent) {
+            std::cerr << "[ShardBus] 丢弃发往分片 " << shard << " 的消息，类型 " << message.type << std::endl;
+        }
+        if (message.fd != INVALID_SOCKET) {
+            closesocket(message.fd);
+        }
+    }
+}
+
+// ============================================================================
+// 帧编解码（包头携带 SCM_RIGHTS 附属数据）
+// ============================================================================
+
+bool ShardBus::SendMessage(SOCKET s, const ShardMessage& message) {
+    PacketHeader header;
+    header.type = message.type;
+    header.length = static_cast<uint32_t>(message.payload.size());
+
+    iovec iov;
+    iov.iov_base = &header;
+    iov.iov_len = sizeof(header);
+
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    if (message.fd != INVALID_SOCKET) {
+        std::memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        int fd = message.fd;
+        std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    if (sendmsg(s, &msg, MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(header))) {
+        return false;
+    }
+
+    size_t sent = 0;
+    while (sent < message.payload.size()) {
+        ssize_t ret = send(s, message.payload.data() + sent,
+                           message.payload.size() - sent, MSG_NOSIGNAL);
+        if (ret <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+bool ShardBus::RecvMessage(SOCKET s, ShardMessage& out) {
+    PacketHeader header;
+    iovec iov;
+    iov.iov_base = &header;
+    iov.iov_len = sizeof(header);
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t ret = recvmsg(s, &msg, 0);
+    if (ret <= 0) {
+        return false;
+    }
+
+    out.fd = INVALID_SOCKET;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            int fd;
+            std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+            out.fd = fd;
+        }
+    }
+
+    // 包头可能被拆开，补齐剩余字节
+    if (ret < static_cast<ssize_t>(sizeof(header)) &&
+        !recvFixedAmount(s, reinterpret_cast<char*>(&header) + ret,
+                         static_cast<int>(sizeof(header) - ret))) {
+        return false;
+    }
+
+    out.type = header.type;
+    return recvPacketBody(s, header.length, out.payload);
+}
+
+#endif
@@ -0,0 +1,132 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     ShardBus.h
+ * File Function: 分片进程间的本地消息总线（Unix 域套接字）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include "PlatformSocket.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @enum ShardMessageType
+ * @brief 分片间消息类型。
+ */
+enum ShardMessageType : uint32_t {
+    SHARD_HANDOFF = 1,        ///< 连接移交：附带客户端套接字，载荷为登录数据
+    SHARD_CHAT_RELAY = 2,     ///< 部落聊天转发："count|id1|...|idN|message"
+    SHARD_GUEST_FORWARD = 3,  ///< 以访客身份转发请求：附带客户端套接字
+    SHARD_GUEST_PACKET = 4,   ///< 访客后续数据包："playerId|type|data"
+    SHARD_GUEST_LEAVE = 5,    ///< 访客离开："playerId"
+    SHARD_PLAYER_CLAN = 6,    ///< 玩家部落归属变化："playerId|clanId"
+    SHARD_GUEST_REPLY = 7,    ///< 访客分片发给玩家的数据包，由归属分片写入连接："playerId|type|data"
+    SHARD_CLAN_LIST_QUERY = 8,  ///< 查询对方分片的部落列表："originShard|requestId"
+    SHARD_CLAN_LIST_REPLY = 9,  ///< 部落列表应答："requestId|json"
+    SHARD_USER_LIST_QUERY = 10, ///< 查询对方分片的在线用户列表："originShard|requestId"
+    SHARD_USER_LIST_REPLY = 11, ///< 在线用户列表应答："requestId|list"
+    SHARD_ATTACK_RESULT = 12    ///< 攻击结果，由防守方归属分片结算并通知防守方：PACKET_ATTACK_RESULT 的载荷
+};
+
+/**
+ * @struct ShardMessage
+ * @brief 分片间传递的一条消息。
+ *
+ * fd 不为 INVALID_SOCKET 时，通过 SCM_RIGHTS 把该套接字复制给接收方进程，
+ * 接收方得到的是指向同一 TCP 连接的新描述符。
+ */
+struct ShardMessage {
+    uint32_t type = 0;
+    std::string payload;
+    SOCKET fd = INVALID_SOCKET;
+};
+
+/**
+ * @class ShardBus
+ * @brief 同一主机上多个分片进程之间的消息总线。
+ *
+ * 每个分片在 socket_dir 下监听一个 Unix 域流套接字
+ * （coc_shard_<index>.sock）。发送方按需连接目标分片并复用连接，
+ * 消息使用与客户端协议相同的 [类型][长度][载荷] 帧格式。
+ *
+ * 线程安全：
+ * Send 可在任意线程调用，只把消息放入目标分片的发送队列，由该分片专属的
+ * 发送线程写出。消息处理回调在总线的接收线程中调用，回调里再 Send 也不会
+ * 阻塞接收线程——否则两个分片同时互发大消息时，双方的接收线程都卡在写操作上，
+ * 谁也不再读取，形成死锁。
+ *
+ * @note 仅支持 POSIX 平台；Windows 上 Start 返回 false。
+ */
+class ShardBus {
+ public:
+    using MessageHandler = std::function<void(ShardMessage&)>;
+
+    /**
+     * @brief 构造函数
+     * @param shard_index 本进程的分片编号
+     * @param shard_count 分片总数
+     * @param socket_dir Unix 域套接字所在目录
+     */
+    ShardBus(int shard_index, int shard_count, const std::string& socket_dir);
+    ~ShardBus();
+
+    /**
+     * @brief 开始监听并接收其它分片的消息
+     * @param handler 消息处理回调
+     * @return 成功返回 true
+     */
+    bool Start(MessageHandler handler);
+
+    /**
+     * @brief 向目标分片发送消息（异步，同一目标分片的消息保持发送顺序）
+     * @param shard 目标分片编号
+     * @param message 消息（fd 字段会被复制给对方，本进程仍持有原描述符，返回后即可关闭）
+     * @return 已连上目标分片并入队返回 true；分片不可达或发送队列已满返回 false
+     */
+    bool Send(int shard, const ShardMessage& message);
+
+    int GetShardIndex() const { return shard_index_; }
+
+ private:
+    std::string PathOf(int shard) const;
+    SOCKET ConnectTo(int shard);
+    void AcceptLoop();
+    void ReadLoop(SOCKET peer);
+
+    struct Peer;
+    void WriteLoop(int shard, Peer& peer);
+
+    static bool SendMessage(SOCKET s, const ShardMessage& message);
+    static bool RecvMessage(SOCKET s, ShardMessage& out);
+
+    /// 单个目标分片的发送队列上限，对方长时间不读时拒绝继续入队
+    static constexpr size_t kMaxQueuedMessages = 65536;
+
+    struct Peer {
+        std::mutex mutex;                  ///< 保护以下字段
+        std::condition_variable ready;     ///< 队列非空或总线停止
+        std::deque<ShardMessage> queue;    ///< 待发送消息（fd 为入队时复制的描述符）
+        SOCKET socket = INVALID_SOCKET;    ///< 出站连接：Send 负责建立，只有发送线程在上面写数据
+        std::thread writer;                ///< 发送线程
+    };
+
+    int shard_index_;
+    int shard_count_;
+    std::string socket_dir_;
+    SOCKET listen_socket_ = INVALID_SOCKET;
+    MessageHandler handler_;
+    std::map<int, std::unique_ptr<Peer>> peers_;  ///< 目标分片 -> 出站连接
+    std::atomic<bool> running_{false};
+};
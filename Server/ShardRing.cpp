@@ -0,0 +1,50 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     ShardRing.cpp
+ * File Function: 多进程分片的一致性哈希环实现
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "ShardRing.h"
+
+#include <algorithm>
+
+ShardRing::ShardRing(int shard_count, int virtual_nodes)
+    : shard_count_(std::max(1, shard_count)) {
+    ring_.reserve(static_cast<size_t>(shard_count_) * virtual_nodes);
+    for (int shard = 0; shard < shard_count_; ++shard) {
+        for (int v = 0; v < virtual_nodes; ++v) {
+            std::string key = "shard-" + std::to_string(shard) + "#" + std::to_string(v);
+            ring_.emplace_back(Hash(key), shard);
+        }
+    }
+    std::sort(ring_.begin(), ring_.end());
+}
+
+int ShardRing::OwnerOf(const std::string& id) const {
+    if (shard_count_ == 1 || ring_.empty()) {
+        return 0;
+    }
+
+    uint64_t h = Hash(id);
+    auto it = std::lower_bound(ring_.begin(), ring_.end(),
+                               std::make_pair(h, 0));
+    if (it == ring_.end()) {
+        it = ring_.begin();  // 环绕
+    }
+    return it->second;
+}
+
+uint64_t ShardRing::Hash(const std::string& key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    // 末尾混合，改善短键和相近键的分布
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
@@ -0,0 +1,52 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     ShardRing.h
+ * File Function: 多进程分片的一致性哈希环
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ShardRing
+ * @brief 一致性哈希环，把玩家/部落/战争ID映射到所属分片。
+ *
+ * 每个分片在环上放置若干虚拟节点，ID 归属于顺时针方向的第一个节点。
+ * 增减分片时只有相邻区间的 ID 会迁移。
+ *
+ * 所有进程使用相同的分片数和虚拟节点数构造，因此对同一 ID 的
+ * 归属判定在各进程间一致，无需通信。
+ */
+class ShardRing {
+ public:
+    /**
+     * @brief 构造函数
+     * @param shard_count 分片数量（>= 1）
+     * @param virtual_nodes 每个分片的虚拟节点数
+     */
+    explicit ShardRing(int shard_count, int virtual_nodes = 128);
+
+    /**
+     * @brief 获取 ID 所属的分片
+     * @param id 玩家、部落或战争ID
+     * @return 分片编号 [0, shard_count)
+     */
+    int OwnerOf(const std::string& id) const;
+
+    int GetShardCount() const { return shard_count_; }
+
+    /**
+     * @brief 64 位 FNV-1a 哈希（与平台和编译器无关）
+     */
+    static uint64_t Hash(const std::string& key);
+
+ private:
+    int shard_count_;
+    std::vector<std::pair<uint64_t, int>> ring_;  ///< 按哈希值排序的虚拟节点
+};
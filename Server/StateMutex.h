@@ -0,0 +1,52 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     StateMutex.h
+ * File Function: 可在单线程逻辑模式下省略的状态锁
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <mutex>
+
+/**
+ * @class StateMutex
+ * @brief 保护服务器游戏状态的互斥锁。
+ *
+ * 默认（多线程模式）下等同于 std::mutex。当服务器以单线程逻辑循环
+ * 模式运行时，所有游戏状态只由逻辑线程访问，lock/unlock 直接返回，
+ * 不产生任何原子操作。
+ *
+ * @note 模式必须在任何线程访问游戏状态之前设置，运行期间不可切换。
+ * @see LogicLoop
+ */
+class StateMutex {
+ public:
+    void lock() {
+        if (!single_threaded_) {
+            mutex_.lock();
+        }
+    }
+
+    void unlock() {
+        if (!single_threaded_) {
+            mutex_.unlock();
+        }
+    }
+
+    bool try_lock() {
+        return single_threaded_ || mutex_.try_lock();
+    }
+
+    /**
+     * @brief 设置是否为单线程逻辑模式（启动时调用一次）
+     */
+    static void SetSingleThreaded(bool enabled) { single_threaded_ = enabled; }
+
+    static bool IsSingleThreaded() { return single_threaded_; }
+
+ private:
+    std::mutex mutex_;
+    static bool single_threaded_;
+};
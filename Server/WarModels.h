@@ -27,8 +27,8 @@
  */
 struct AttackResult {
     // 参与者信息
-    std::string attackerId;    ///< 攻击者玩家ID
-    std::string defenderId;    ///< 防守者玩家ID
+    InternedId attackerId;     ///< 攻击者玩家ID
+    InternedId defenderId;     ///< 防守者玩家ID
 
     // 战斗结果
     int starsEarned = 0;       ///< 获得的星数（0-3）
@@ -53,7 +53,7 @@ struct AttackResult {
  */
 struct AttackRecord {
     // 攻击者信息
-    std::string attackerId;      ///< 攻击者玩家ID
+    InternedId attackerId;       ///< 攻击者玩家ID
     std::string attackerName;    ///< 攻击者名称（用于显示）
 
     // 战斗结果
@@ -79,11 +79,11 @@ struct AttackRecord {
  */
 struct PvpSession {
     // 参与者信息
-    std::string attackerId;      ///< 攻击者玩家ID（会话的键）
-    std::string defenderId;      ///< 防守者玩家ID
+    InternedId attackerId;       ///< 攻击者玩家ID（会话的键）
+    InternedId defenderId;       ///< 防守者玩家ID
 
     // 观战者管理
-    std::vector<std::string> spectatorIds;  ///< 观战者玩家ID列表
+    std::vector<InternedId> spectatorIds;   ///< 观战者玩家ID列表
 
     // 战斗数据
     std::string mapData;         ///< 防守方地图数据（战斗开始时快照）
@@ -106,7 +106,7 @@ struct PvpSession {
  */
 struct ClanWarMember {
     // 成员身份
-    std::string memberId;        ///< 成员玩家ID
+    InternedId memberId;         ///< 成员玩家ID
     std::string memberName;      ///< 成员名称（用于显示）
 
     // 战斗数据
@@ -138,16 +138,16 @@ struct ClanWarMember {
  */
 struct ClanWarSession {
     // 战争标识
-    std::string warId;           ///< 战争唯一标识符，格式："WAR_xxx"
+    InternedId warId;            ///< 战争唯一标识符，格式："WAR_xxx"
 
     // 参战部落信息
-    std::string clan1Id;         ///< 第一个部落的ID
-    std::string clan2Id;         ///< 第二个部落的ID
+    InternedId clan1Id;          ///< 第一个部落的ID
+    InternedId clan2Id;          ///< 第二个部落的ID
     std::vector<ClanWarMember> clan1Members;  ///< 第一个部落的成员列表
     std::vector<ClanWarMember> clan2Members;  ///< 第二个部落的成员列表
 
     // 活跃战斗（以攻击者ID为键）
-    std::map<std::string, PvpSession> activeBattles;  ///< 当前进行中的战斗
+    std::map<InternedId, PvpSession> activeBattles;   ///< 当前进行中的战斗
 
     // 战争统计
     int clan1TotalStars = 0;     ///< 第一个部落获得的总星数
@@ -0,0 +1,235 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     LogicLoopBench.cpp
+ * File Function: 单线程逻辑循环与按处理函数加锁模型的对比基准
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "LogicLoop.h"
+#include "MpscQueue.h"
+#include "StateMutex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 模拟的共享游戏状态：按连接查找玩家、修改字段并构造一段应答文本，
+ *        与 Server 中大多数处理函数的访问模式相当。
+ */
+struct FakeState {
+    struct Player {
+        int gold = 0;
+        int trophies = 0;
+        std::string name;
+    };
+
+    std::unordered_map<SOCKET, Player> players;
+    size_t replyBytes = 0;
+
+    explicit FakeState(int connections) {
+        for (int i = 0; i < connections; ++i) {
+            players[i].name = "player_" + std::to_string(i);
+        }
+    }
+
+    void Handle(SOCKET socket, uint32_t type) {
+        Player& player = players[socket];
+        player.gold += static_cast<int>(type);
+        player.trophies ^= static_cast<int>(type);
+        std::string reply = "{\"name\":\"" + player.name + "\",\"gold\":" + std::to_string(player.gold) +
+                            ",\"trophies\":" + std::to_string(player.trophies) + "}";
+        replyBytes += reply.size();
+    }
+};
+
+int64_t ElapsedNs(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count();
+}
+
+int64_t Percentile(std::vector<int64_t>& samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void Report(const char* name, int threads, int events, int64_t total_ns, std::vector<int64_t>& latency) {
+    double seconds = total_ns / 1e9;
+    std::printf("%-14s threads=%-3d events=%-9d total=%8.1fms  throughput=%6.2fM/s  "
+                "latency p50=%7.1fus p99=%8.1fus\n",
+                name, threads, events, total_ns / 1e6, events / seconds / 1e6,
+                Percentile(latency, 0.50) / 1e3, Percentile(latency, 0.99) / 1e3);
+}
+
+/// 原有模型：每个客户端线程在自己的线程中持锁执行处理函数；gap 为每个客户端两次收包的间隔（0 表示满速）
+void RunMutexModel(int threads, int per_thread, std::chrono::microseconds gap) {
+    FakeState state(threads);
+    StateMutex mutex;
+    std::vector<std::vector<int64_t>> latency(threads);
+
+    auto begin = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            latency[t].reserve(per_thread);
+            for (int i = 0; i < per_thread; ++i) {
+                auto received = Clock::now();
+                {
+                    std::lock_guard<StateMutex> lock(mutex);
+                    state.Handle(t, static_cast<uint32_t>(i & 63));
+                }
+                latency[t].push_back(ElapsedNs(received));
+                if (gap.count() > 0) {
+                    std::this_thread::sleep_for(gap);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    int64_t total = ElapsedNs(begin);
+
+    std::vector<int64_t> all;
+    for (auto& samples : latency) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    Report("mutex-handler", threads, threads * per_thread, total, all);
+}
+
+/// 单线程逻辑循环：客户端线程只投递事件，处理函数在逻辑线程中无锁执行
+void RunLogicLoop(int threads, int per_thread, std::chrono::microseconds gap, std::chrono::milliseconds tick) {
+    FakeState state(threads);
+    std::vector<int64_t> latency;
+    latency.reserve(static_cast<size_t>(threads) * per_thread);
+    std::atomic<int> processed{0};
+    const int64_t epoch = Clock::now().time_since_epoch().count();
+
+    LogicLoop loop(tick, [&](LogicEvent& event) {
+        state.Handle(event.socket, event.type);
+        int64_t posted = 0;
+        std::memcpy(&posted, event.data.data(), sizeof(posted));
+        latency.push_back(Clock::now().time_since_epoch().count() - epoch - posted);
+        processed.fetch_add(1, std::memory_order_release);
+    });
+    loop.Start();
+
+    const int expected = threads * per_thread;
+    auto begin = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                LogicEvent event;
+                event.socket = t;
+                event.type = static_cast<uint32_t>(i & 63);
+                int64_t posted = Clock::now().time_since_epoch().count() - epoch;
+                event.data.assign(reinterpret_cast<const char*>(&posted), sizeof(posted));
+                loop.Post(std::move(event));
+                if (gap.count() > 0) {
+                    std::this_thread::sleep_for(gap);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    while (processed.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+    int64_t total = ElapsedNs(begin);
+    loop.Stop();
+
+    // steady_clock 的计数单位不一定是纳秒
+    for (auto& sample : latency) {
+        sample = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::duration(sample)).count();
+    }
+    Report("logic-loop", threads, expected, total, latency);
+}
+
+/// MpscQueue 单独的入队/出队开销
+void RunQueue(int threads, int per_thread) {
+    MpscQueue<LogicEvent> queue;
+    std::atomic<bool> done{false};
+    int64_t popped = 0;
+
+    std::thread consumer([&]() {
+        LogicEvent event;
+        for (;;) {
+            if (queue.TryPop(event)) {
+                ++popped;
+            } else if (done.load(std::memory_order_acquire)) {
+                while (queue.TryPop(event)) {
+                    ++popped;
+                }
+                return;
+            }
+        }
+    });
+
+    auto begin = Clock::now();
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                LogicEvent event;
+                event.socket = t;
+                queue.Push(std::move(event));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    int64_t total = ElapsedNs(begin);
+
+    std::printf("%-14s threads=%-3d events=%-9lld total=%8.1fms  %.1fns/event\n", "mpsc-queue", threads,
+                static_cast<long long>(popped), total / 1e6, static_cast<double>(total) / popped);
+}
+
+}  // namespace
+
+/**
+ * 用法：LogicLoopBench [每线程事件数] [逻辑刻度毫秒]
+ *
+ * 满速测试衡量吞吐（逻辑循环的延迟此时只反映积压）；
+ * 限速测试模拟 256 个客户端每 2ms 发一个包，衡量正常负载下的处理延迟。
+ */
+int main(int argc, char* argv[]) {
+    int per_thread = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::chrono::milliseconds tick(argc > 2 ? std::atoi(argv[2]) : 5);
+    const std::chrono::microseconds flat_out(0);
+    const std::chrono::microseconds paced(2000);
+
+    std::printf("== MpscQueue ==\n");
+    for (int threads : {1, 4, 16, 64}) {
+        RunQueue(threads, per_thread);
+    }
+    std::printf("== 满速 ==\n");
+    for (int threads : {1, 4, 16, 64}) {
+        RunMutexModel(threads, per_thread, flat_out);
+        RunLogicLoop(threads, per_thread, flat_out, tick);
+    }
+    std::printf("== 限速（每客户端 2ms 一个包）==\n");
+    RunMutexModel(256, 500, paced);
+    RunLogicLoop(256, 500, paced, tick);
+    return 0;
+}
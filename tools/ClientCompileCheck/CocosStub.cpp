@@ -0,0 +1,86 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     CocosStub.cpp
+ * File Function: 接口桩中非内联符号的空实现与链接检查入口
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#include "cocos2d.h"
+#include "audio/include/AudioEngine.h"
+#include "base/base64.h"
+
+namespace cocos2d {
+
+void log(const char* format, ...) {}
+
+namespace StringUtils {
+std::string format(const char* format, ...) { return std::string(); }
+}  // namespace StringUtils
+
+namespace utils {
+double gettime() { return 0.0; }
+long long getTimeInMilliseconds() { return 0; }
+}  // namespace utils
+
+int base64Decode(const unsigned char* in, unsigned int inLength, unsigned char** out) { return 0; }
+int base64Encode(const unsigned char* in, unsigned int inLength, char** out) { return 0; }
+
+const Vec2 Vec2::ZERO(0, 0);
+const Vec2 Vec2::ONE(1, 1);
+const Vec2 Vec2::UNIT_X(1, 0);
+const Vec2 Vec2::UNIT_Y(0, 1);
+const Vec2 Vec2::ANCHOR_MIDDLE(0.5f, 0.5f);
+const Vec2 Vec2::ANCHOR_BOTTOM_LEFT(0, 0);
+const Vec2 Vec2::ANCHOR_TOP_LEFT(0, 1);
+const Vec2 Vec2::ANCHOR_BOTTOM_RIGHT(1, 0);
+const Vec2 Vec2::ANCHOR_TOP_RIGHT(1, 1);
+const Vec2 Vec2::ANCHOR_MIDDLE_RIGHT(1, 0.5f);
+const Vec2 Vec2::ANCHOR_MIDDLE_LEFT(0, 0.5f);
+const Vec2 Vec2::ANCHOR_MIDDLE_TOP(0.5f, 1);
+const Vec2 Vec2::ANCHOR_MIDDLE_BOTTOM(0.5f, 0);
+const Size Size::ZERO(0, 0);
+const Rect Rect::ZERO(0, 0, 0, 0);
+
+const Color3B Color3B::WHITE(255, 255, 255);
+const Color3B Color3B::YELLOW(255, 255, 0);
+const Color3B Color3B::BLUE(0, 0, 255);
+const Color3B Color3B::GREEN(0, 255, 0);
+const Color3B Color3B::RED(255, 0, 0);
+const Color3B Color3B::MAGENTA(255, 0, 255);
+const Color3B Color3B::BLACK(0, 0, 0);
+const Color3B Color3B::ORANGE(255, 127, 0);
+const Color3B Color3B::GRAY(166, 166, 166);
+const Color4B Color4B::WHITE(255, 255, 255, 255);
+const Color4B Color4B::YELLOW(255, 255, 0, 255);
+const Color4B Color4B::BLUE(0, 0, 255, 255);
+const Color4B Color4B::GREEN(0, 255, 0, 255);
+const Color4B Color4B::RED(255, 0, 0, 255);
+const Color4B Color4B::MAGENTA(255, 0, 255, 255);
+const Color4B Color4B::BLACK(0, 0, 0, 255);
+const Color4B Color4B::ORANGE(255, 127, 0, 255);
+const Color4B Color4B::GRAY(166, 166, 166, 255);
+const Color4F Color4F::WHITE(1, 1, 1, 1);
+const Color4F Color4F::YELLOW(1, 1, 0, 1);
+const Color4F Color4F::BLUE(0, 0, 1, 1);
+const Color4F Color4F::GREEN(0, 1, 0, 1);
+const Color4F Color4F::RED(1, 0, 0, 1);
+const Color4F Color4F::MAGENTA(1, 0, 1, 1);
+const Color4F Color4F::BLACK(0, 0, 0, 1);
+const Color4F Color4F::ORANGE(1, 0.5f, 0, 1);
+const Color4F Color4F::GRAY(0.65f, 0.65f, 0.65f, 1);
+
+const BlendFunc BlendFunc::DISABLE = {};
+const BlendFunc BlendFunc::ALPHA_PREMULTIPLIED = {};
+const BlendFunc BlendFunc::ALPHA_NON_PREMULTIPLIED = {};
+const BlendFunc BlendFunc::ADDITIVE = {};
+
+const float AudioEngine::TIME_UNKNOWN = -1.0f;
+
+}  // namespace cocos2d
+
+// 链接检查只需要可执行文件能链接成功，不会被运行
+int main()
+{
+    return 0;
+}
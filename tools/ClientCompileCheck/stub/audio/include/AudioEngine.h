@@ -0,0 +1,50 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     AudioEngine.h
+ * File Function: cocos2d-x 4.0 AudioEngine 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace cocos2d {
+namespace experimental {}
+class AudioProfile {};
+class AudioEngine {
+public:
+    enum class AudioState { ERROR = -1, INITIALIZING, PLAYING, PAUSED };
+    static const int INVALID_AUDIO_ID = -1;
+    static const float TIME_UNKNOWN;
+    static bool lazyInit() { return true; }
+    static void end() {}
+    static int play2d(const std::string& filePath, bool loop = false, float volume = 1.0f,
+                      const AudioProfile* profile = nullptr)
+    {
+        return 0;
+    }
+    static void setLoop(int audioID, bool loop) {}
+    static bool isLoop(int audioID) { return false; }
+    static void setVolume(int audioID, float volume) {}
+    static float getVolume(int audioID) { return 1.0f; }
+    static void pause(int audioID) {}
+    static void pauseAll() {}
+    static void resume(int audioID) {}
+    static void resumeAll() {}
+    static void stop(int audioID) {}
+    static void stopAll() {}
+    static bool setCurrentTime(int audioID, float sec) { return true; }
+    static float getCurrentTime(int audioID) { return 0; }
+    static float getDuration(int audioID) { return 0; }
+    static AudioState getState(int audioID) { return AudioState::PLAYING; }
+    static void setFinishCallback(int audioID, const std::function<void(int, const std::string&)>& callback) {}
+    static int getMaxAudioInstance() { return 32; }
+    static bool setMaxAudioInstance(int maxInstances) { return true; }
+    static void uncache(const std::string& filePath) {}
+    static void uncacheAll() {}
+    static void preload(const std::string& filePath, std::function<void(bool isSuccess)> callback = nullptr) {}
+};
+}  // namespace cocos2d
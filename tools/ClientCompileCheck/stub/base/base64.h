@@ -0,0 +1,14 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     base64.h
+ * File Function: cocos2d-x 4.0 base64 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+namespace cocos2d {
+int base64Decode(const unsigned char* in, unsigned int inLength, unsigned char** out);
+int base64Encode(const unsigned char* in, unsigned int inLength, char** out);
+}  // namespace cocos2d
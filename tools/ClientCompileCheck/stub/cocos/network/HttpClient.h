@@ -0,0 +1,47 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     HttpClient.h
+ * File Function: cocos2d-x 4.0 HttpClient 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include "cocos2d.h"
+
+namespace cocos2d {
+namespace network {
+class HttpResponse;
+class HttpClient;
+class HttpRequest : public Ref {
+public:
+    enum class Type { GET, POST, PUT, DELETE, UNKNOWN };
+    void setRequestType(Type type) {}
+    void setUrl(const std::string& url) {}
+    void setRequestData(const char* buffer, size_t len) {}
+    void setHeaders(const std::vector<std::string>& headers) {}
+    void setTag(const std::string& tag) {}
+    void setResponseCallback(const std::function<void(HttpClient*, HttpResponse*)>& callback) {}
+};
+class HttpResponse : public Ref {
+public:
+    bool isSucceed() const { return false; }
+    long getResponseCode() const { return 0; }
+    std::vector<char>* getResponseData() { return &_data; }
+    const char* getErrorBuffer() const { return ""; }
+    HttpRequest* getHttpRequest() const { return nullptr; }
+
+private:
+    std::vector<char> _data;
+};
+class HttpClient {
+public:
+    static HttpClient* getInstance() { static HttpClient client; return &client; }
+    void send(HttpRequest* request) {}
+    void sendImmediate(HttpRequest* request) {}
+    void setTimeoutForConnect(int value) {}
+    void setTimeoutForRead(int value) {}
+};
+}  // namespace network
+}  // namespace cocos2d
@@ -0,0 +1,1463 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     cocos2d.h
+ * File Function: cocos2d-x 4.0 核心接口桩（节点、动作、事件、单例等）
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+// 只声明 Classes/ 实际用到的引擎接口，函数体为空；签名与 cocos2d-x 4.0 保持一致，
+// 用于在没有引擎源码的环境中发现客户端代码的编译与链接错误，不能运行。
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <cstdio>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <cstring>
+#include <sstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define USING_NS_CC using namespace cocos2d
+#define NS_CC_BEGIN namespace cocos2d {
+#define NS_CC_END }
+
+#define CCLOG(...) ((void)0)
+#define CCLOGERROR(...) ((void)0)
+#define CCLOGWARN(...) ((void)0)
+#define CCLOGINFO(...) ((void)0)
+#define CCASSERT(cond, msg) ((void)(cond))
+#define CC_ASSERT(cond) ((void)(cond))
+#define CC_UNUSED_PARAM(p) (void)(p)
+#ifndef MIN
+#define MIN(x, y) (((x) > (y)) ? (y) : (x))
+#endif
+#ifndef MAX
+#define MAX(x, y) (((x) < (y)) ? (y) : (x))
+#endif
+
+#define CC_SAFE_DELETE(p) do { delete (p); (p) = nullptr; } while (0)
+#define CC_SAFE_DELETE_ARRAY(p) do { delete[] (p); (p) = nullptr; } while (0)
+#define CC_SAFE_RELEASE(p) do { if (p) { (p)->release(); } } while (0)
+#define CC_SAFE_RELEASE_NULL(p) do { if (p) { (p)->release(); (p) = nullptr; } } while (0)
+#define CC_SAFE_RETAIN(p) do { if (p) { (p)->retain(); } } while (0)
+#define CC_BREAK_IF(cond) if (cond) break
+
+#define CC_CALLBACK_0(selector, target, ...) std::bind(&selector, target, ##__VA_ARGS__)
+#define CC_CALLBACK_1(selector, target, ...) std::bind(&selector, target, std::placeholders::_1, ##__VA_ARGS__)
+#define CC_CALLBACK_2(selector, target, ...) \
+    std::bind(&selector, target, std::placeholders::_1, std::placeholders::_2, ##__VA_ARGS__)
+#define CC_CALLBACK_3(selector, target, ...) \
+    std::bind(&selector, target, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, ##__VA_ARGS__)
+
+#define CC_DEGREES_TO_RADIANS(a) ((a) * 0.01745329252f)
+#define CC_RADIANS_TO_DEGREES(a) ((a) * 57.29577951f)
+#define MATH_DEG_TO_RAD(x) ((x) * 0.0174532925f)
+#define MATH_RAD_TO_DEG(x) ((x) * 57.29577951f)
+#define CCRANDOM_0_1() (static_cast<float>(std::rand()) / RAND_MAX)
+#define CCRANDOM_MINUS1_1() (CCRANDOM_0_1() * 2.0f - 1.0f)
+#define FLT_EPSILON_CC 1.192092896e-07F
+
+#define CC_PLATFORM_WIN32 3
+#define CC_PLATFORM_LINUX 5
+#define CC_PLATFORM_ANDROID 2
+#define CC_PLATFORM_MAC 8
+#define CC_PLATFORM_IOS 1
+#define CC_TARGET_PLATFORM CC_PLATFORM_LINUX
+
+#define CREATE_FUNC(__TYPE__)                      \
+    static __TYPE__* create()                      \
+    {                                              \
+        __TYPE__* pRet = new (std::nothrow) __TYPE__(); \
+        if (pRet && pRet->init())                  \
+        {                                          \
+            pRet->autorelease();                   \
+            return pRet;                           \
+        }                                          \
+        delete pRet;                               \
+        return nullptr;                            \
+    }
+
+#include <cstdlib>
+#include <new>
+
+namespace cocos2d {
+
+void log(const char* format, ...);
+
+namespace StringUtils {
+template <typename T>
+std::string toString(T arg) { return std::to_string(arg); }
+std::string format(const char* format, ...);
+}  // namespace StringUtils
+
+namespace utils {
+double gettime();
+long long getTimeInMilliseconds();
+}  // namespace utils
+
+class Ref;
+class Node;
+typedef void (Ref::*SEL_SCHEDULE)(float);
+typedef void (Ref::*SEL_CallFunc)();
+typedef void (Ref::*SEL_MenuHandler)(Ref*);
+#define CC_SCHEDULE_SELECTOR(_SELECTOR) static_cast<cocos2d::SEL_SCHEDULE>(&_SELECTOR)
+#define CC_CALLFUNC_SELECTOR(_SELECTOR) static_cast<cocos2d::SEL_CallFunc>(&_SELECTOR)
+#define CC_MENU_SELECTOR(_SELECTOR) static_cast<cocos2d::SEL_MenuHandler>(&_SELECTOR)
+
+class Ref {
+public:
+    virtual ~Ref() {}
+    void retain() {}
+    void release() {}
+    Ref* autorelease() { return this; }
+    unsigned int getReferenceCount() const { return 1; }
+};
+
+class Vec2 {
+public:
+    float x = 0.0f;
+    float y = 0.0f;
+    Vec2() {}
+    Vec2(float xx, float yy) : x(xx), y(yy) {}
+    static const Vec2 ZERO;
+    static const Vec2 ONE;
+    static const Vec2 UNIT_X;
+    static const Vec2 UNIT_Y;
+    static const Vec2 ANCHOR_MIDDLE;
+    static const Vec2 ANCHOR_BOTTOM_LEFT;
+    static const Vec2 ANCHOR_TOP_LEFT;
+    static const Vec2 ANCHOR_BOTTOM_RIGHT;
+    static const Vec2 ANCHOR_TOP_RIGHT;
+    static const Vec2 ANCHOR_MIDDLE_RIGHT;
+    static const Vec2 ANCHOR_MIDDLE_LEFT;
+    static const Vec2 ANCHOR_MIDDLE_TOP;
+    static const Vec2 ANCHOR_MIDDLE_BOTTOM;
+    void set(float xx, float yy) { x = xx; y = yy; }
+    bool isZero() const { return x == 0.0f && y == 0.0f; }
+    float length() const { return std::sqrt(x * x + y * y); }
+    float lengthSquared() const { return x * x + y * y; }
+    float distance(const Vec2& v) const { return (*this - v).length(); }
+    float distanceSquared(const Vec2& v) const { return (*this - v).lengthSquared(); }
+    float dot(const Vec2& v) const { return x * v.x + y * v.y; }
+    float cross(const Vec2& v) const { return x * v.y - y * v.x; }
+    float getAngle() const { return std::atan2(y, x); }
+    float getAngle(const Vec2& other) const { return std::atan2(cross(other), dot(other)); }
+    float getLength() const { return length(); }
+    float getDistance(const Vec2& v) const { return distance(v); }
+    void normalize() { float l = length(); if (l > 0) { x /= l; y /= l; } }
+    Vec2 getNormalized() const { Vec2 v(*this); v.normalize(); return v; }
+    Vec2 getMidpoint(const Vec2& v) const { return Vec2((x + v.x) / 2, (y + v.y) / 2); }
+    Vec2 lerp(const Vec2& to, float alpha) const { return *this * (1.f - alpha) + to * alpha; }
+    Vec2 rotateByAngle(const Vec2& pivot, float angle) const { return pivot + (*this - pivot); }
+    Vec2 getPerp() const { return Vec2(-y, x); }
+    bool equals(const Vec2& v) const { return x == v.x && y == v.y; }
+    bool fuzzyEquals(const Vec2& v, float var) const { return std::fabs(x - v.x) < var && std::fabs(y - v.y) < var; }
+    Vec2 operator+(const Vec2& v) const { return Vec2(x + v.x, y + v.y); }
+    Vec2 operator-(const Vec2& v) const { return Vec2(x - v.x, y - v.y); }
+    Vec2 operator-() const { return Vec2(-x, -y); }
+    Vec2 operator*(float s) const { return Vec2(x * s, y * s); }
+    Vec2 operator/(float s) const { return Vec2(x / s, y / s); }
+    Vec2& operator+=(const Vec2& v) { x += v.x; y += v.y; return *this; }
+    Vec2& operator-=(const Vec2& v) { x -= v.x; y -= v.y; return *this; }
+    Vec2& operator*=(float s) { x *= s; y *= s; return *this; }
+    Vec2& operator/=(float s) { x /= s; y /= s; return *this; }
+    bool operator==(const Vec2& v) const { return x == v.x && y == v.y; }
+    bool operator!=(const Vec2& v) const { return !(*this == v); }
+    bool operator<(const Vec2& v) const { return x < v.x || (x == v.x && y < v.y); }
+};
+inline Vec2 operator*(float s, const Vec2& v) { return v * s; }
+typedef Vec2 Point;
+
+class Vec3 {
+public:
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    Vec3() {}
+    Vec3(float xx, float yy, float zz) : x(xx), y(yy), z(zz) {}
+};
+
+class Size {
+public:
+    float width = 0.0f;
+    float height = 0.0f;
+    Size() {}
+    Size(float w, float h) : width(w), height(h) {}
+    explicit Size(const Vec2& v) : width(v.x), height(v.y) {}
+    operator Vec2() const { return Vec2(width, height); }
+    static const Size ZERO;
+    void setSize(float w, float h) { width = w; height = h; }
+    bool equals(const Size& s) const { return width == s.width && height == s.height; }
+    Size operator*(float a) const { return Size(width * a, height * a); }
+    Size operator/(float a) const { return Size(width / a, height / a); }
+    Size operator+(const Size& s) const { return Size(width + s.width, height + s.height); }
+    Size operator-(const Size& s) const { return Size(width - s.width, height - s.height); }
+    bool operator==(const Size& s) const { return equals(s); }
+    bool operator!=(const Size& s) const { return !equals(s); }
+};
+
+class Rect {
+public:
+    Vec2 origin;
+    Size size;
+    Rect() {}
+    Rect(float x, float y, float w, float h) : origin(x, y), size(w, h) {}
+    Rect(const Vec2& pos, const Size& dimension) : origin(pos), size(dimension) {}
+    static const Rect ZERO;
+    float getMinX() const { return origin.x; }
+    float getMidX() const { return origin.x + size.width / 2; }
+    float getMaxX() const { return origin.x + size.width; }
+    float getMinY() const { return origin.y; }
+    float getMidY() const { return origin.y + size.height / 2; }
+    float getMaxY() const { return origin.y + size.height; }
+    bool containsPoint(const Vec2& p) const
+    {
+        return p.x >= getMinX() && p.x <= getMaxX() && p.y >= getMinY() && p.y <= getMaxY();
+    }
+    bool intersectsRect(const Rect& r) const
+    {
+        return !(getMaxX() < r.getMinX() || r.getMaxX() < getMinX() || getMaxY() < r.getMinY() ||
+                 r.getMaxY() < getMinY());
+    }
+    bool equals(const Rect& r) const { return origin == r.origin && size == r.size; }
+    Rect unionWithRect(const Rect& r) const { return r; }
+    void merge(const Rect& r) {}
+};
+
+struct Color4B;
+struct Color4F;
+struct Color3B {
+    uint8_t r = 0, g = 0, b = 0;
+    Color3B() {}
+    Color3B(uint8_t rr, uint8_t gg, uint8_t bb) : r(rr), g(gg), b(bb) {}
+    explicit Color3B(const Color4B& color);
+    bool operator==(const Color3B& c) const { return r == c.r && g == c.g && b == c.b; }
+    bool operator!=(const Color3B& c) const { return !(*this == c); }
+    static const Color3B WHITE, YELLOW, BLUE, GREEN, RED, MAGENTA, BLACK, ORANGE, GRAY;
+};
+struct Color4B {
+    uint8_t r = 0, g = 0, b = 0, a = 0;
+    Color4B() {}
+    Color4B(uint8_t rr, uint8_t gg, uint8_t bb, uint8_t aa) : r(rr), g(gg), b(bb), a(aa) {}
+    explicit Color4B(const Color3B& c, uint8_t aa = 255) : r(c.r), g(c.g), b(c.b), a(aa) {}
+    explicit Color4B(const Color4F& color);
+    bool operator==(const Color4B& c) const { return r == c.r && g == c.g && b == c.b && a == c.a; }
+    bool operator!=(const Color4B& c) const { return !(*this == c); }
+    static const Color4B WHITE, YELLOW, BLUE, GREEN, RED, MAGENTA, BLACK, ORANGE, GRAY;
+};
+struct Color4F {
+    float r = 0, g = 0, b = 0, a = 0;
+    Color4F() {}
+    Color4F(float rr, float gg, float bb, float aa) : r(rr), g(gg), b(bb), a(aa) {}
+    explicit Color4F(const Color3B& c, float aa = 1.0f) : r(c.r / 255.f), g(c.g / 255.f), b(c.b / 255.f), a(aa) {}
+    explicit Color4F(const Color4B& c) : r(c.r / 255.f), g(c.g / 255.f), b(c.b / 255.f), a(c.a / 255.f) {}
+    bool operator==(const Color4F& c) const { return r == c.r && g == c.g && b == c.b && a == c.a; }
+    bool operator!=(const Color4F& c) const { return !(*this == c); }
+    static const Color4F WHITE, YELLOW, BLUE, GREEN, RED, MAGENTA, BLACK, ORANGE, GRAY;
+};
+inline Color3B::Color3B(const Color4B& c) : r(c.r), g(c.g), b(c.b) {}
+inline Color4B::Color4B(const Color4F& c) : r(c.r * 255), g(c.g * 255), b(c.b * 255), a(c.a * 255) {}
+
+struct BlendFunc {
+    static const BlendFunc DISABLE, ALPHA_PREMULTIPLIED, ALPHA_NON_PREMULTIPLIED, ADDITIVE;
+};
+
+inline float clampf(float value, float min_inclusive, float max_inclusive)
+{
+    return value < min_inclusive ? min_inclusive : (value > max_inclusive ? max_inclusive : value);
+}
+inline float rand_0_1() { return CCRANDOM_0_1(); }
+inline float rand_minus1_1() { return CCRANDOM_MINUS1_1(); }
+template <typename T>
+inline T random(T min, T max) { return min; }
+inline int random() { return 0; }
+
+// ============================================================================
+// 容器
+// ============================================================================
+
+template <class T>
+class Vector {
+public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+    Vector() {}
+    explicit Vector(ssize_t capacity) { _data.reserve(capacity); }
+    Vector(std::initializer_list<T> list) : _data(list) {}
+    iterator begin() { return _data.begin(); }
+    iterator end() { return _data.end(); }
+    const_iterator begin() const { return _data.begin(); }
+    const_iterator end() const { return _data.end(); }
+    typename std::vector<T>::reverse_iterator rbegin() { return _data.rbegin(); }
+    typename std::vector<T>::reverse_iterator rend() { return _data.rend(); }
+    void reserve(ssize_t n) { _data.reserve(n); }
+    ssize_t size() const { return static_cast<ssize_t>(_data.size()); }
+    ssize_t capacity() const { return static_cast<ssize_t>(_data.capacity()); }
+    bool empty() const { return _data.empty(); }
+    T at(ssize_t index) const { return _data[index]; }
+    T front() const { return _data.front(); }
+    T back() const { return _data.back(); }
+    bool contains(T object) const { return false; }
+    ssize_t getIndex(T object) const { return -1; }
+    void pushBack(T object) { _data.push_back(object); }
+    void pushBack(const Vector<T>& other) { _data.insert(_data.end(), other._data.begin(), other._data.end()); }
+    void insert(ssize_t index, T object) { _data.insert(_data.begin() + index, object); }
+    void popBack() { _data.pop_back(); }
+    void eraseObject(T object, bool removeAll = false) {}
+    iterator erase(iterator position) { return _data.erase(position); }
+    iterator erase(ssize_t index) { return _data.erase(_data.begin() + index); }
+    void clear() { _data.clear(); }
+    const std::vector<T>& getNativeVector() const { return _data; }
+
+private:
+    std::vector<T> _data;
+};
+
+template <class K, class V>
+class Map {
+public:
+    using iterator = typename std::unordered_map<K, V>::iterator;
+    using const_iterator = typename std::unordered_map<K, V>::const_iterator;
+    iterator begin() { return _data.begin(); }
+    iterator end() { return _data.end(); }
+    const_iterator begin() const { return _data.begin(); }
+    const_iterator end() const { return _data.end(); }
+    ssize_t size() const { return static_cast<ssize_t>(_data.size()); }
+    bool empty() const { return _data.empty(); }
+    V at(const K& key) const { auto it = _data.find(key); return it == _data.end() ? nullptr : it->second; }
+    iterator find(const K& key) { return _data.find(key); }
+    void insert(const K& key, V object) { _data[key] = object; }
+    ssize_t erase(const K& key) { return static_cast<ssize_t>(_data.erase(key)); }
+    void clear() { _data.clear(); }
+
+private:
+    std::unordered_map<K, V> _data;
+};
+
+class Value;
+typedef std::vector<Value> ValueVector;
+typedef std::unordered_map<std::string, Value> ValueMap;
+class Value {
+public:
+    Value() {}
+    explicit Value(int v) {}
+    explicit Value(float v) {}
+    explicit Value(double v) {}
+    explicit Value(bool v) {}
+    explicit Value(const char* v) {}
+    explicit Value(const std::string& v) {}
+    int asInt() const { return 0; }
+    float asFloat() const { return 0; }
+    double asDouble() const { return 0; }
+    bool asBool() const { return false; }
+    std::string asString() const { return std::string(); }
+    bool isNull() const { return true; }
+};
+
+// ============================================================================
+// 纹理与精灵帧
+// ============================================================================
+
+class Texture2D : public Ref {
+public:
+    const Size& getContentSize() const { return _size; }
+    Size getContentSizeInPixels() { return _size; }
+    int getPixelsWide() const { return 0; }
+    int getPixelsHigh() const { return 0; }
+    void setAliasTexParameters() {}
+    void setAntiAliasTexParameters() {}
+
+private:
+    Size _size;
+};
+
+class TextureCache : public Ref {
+public:
+    Texture2D* addImage(const std::string& path) { return nullptr; }
+    Texture2D* getTextureForKey(const std::string& key) const { return nullptr; }
+    void removeTextureForKey(const std::string& key) {}
+    void removeUnusedTextures() {}
+};
+
+class SpriteFrame : public Ref {
+public:
+    static SpriteFrame* create(const std::string& filename, const Rect& rect) { return nullptr; }
+    static SpriteFrame* createWithTexture(Texture2D* texture, const Rect& rect) { return nullptr; }
+    static SpriteFrame* createWithTexture(Texture2D* texture, const Rect& rect, bool rotated, const Vec2& offset,
+                                          const Size& originalSize) { return nullptr; }
+    const Rect& getRect() const { return _rect; }
+    const Size& getOriginalSize() const { return _rect.size; }
+    Texture2D* getTexture() { return nullptr; }
+
+private:
+    Rect _rect;
+};
+
+class SpriteFrameCache {
+public:
+    static SpriteFrameCache* getInstance() { static SpriteFrameCache cache; return &cache; }
+    void addSpriteFramesWithFile(const std::string& plist) {}
+    void addSpriteFramesWithFile(const std::string& plist, const std::string& textureFileName) {}
+    bool isSpriteFramesWithFileLoaded(const std::string& plist) const { return false; }
+    SpriteFrame* getSpriteFrameByName(const std::string& name) { return nullptr; }
+    void addSpriteFrame(SpriteFrame* frame, const std::string& frameName) {}
+    void removeSpriteFramesFromFile(const std::string& plist) {}
+    void removeUnusedSpriteFrames() {}
+};
+
+class Animation : public Ref {
+public:
+    static Animation* create() { return nullptr; }
+    static Animation* createWithSpriteFrames(const Vector<SpriteFrame*>& arrayOfSpriteFrameNames, float delay = 0.0f,
+                                             unsigned int loops = 1) { return nullptr; }
+    void addSpriteFrame(SpriteFrame* frame) {}
+    void addSpriteFrameWithFile(const std::string& filename) {}
+    void setDelayPerUnit(float delayPerUnit) {}
+    float getDelayPerUnit() const { return 0; }
+    float getDuration() const { return 0; }
+    void setRestoreOriginalFrame(bool restoreOriginalFrame) {}
+    void setLoops(unsigned int loops) {}
+    unsigned int getLoops() const { return 1; }
+    Animation* clone() const { return nullptr; }
+};
+
+class AnimationCache {
+public:
+    static AnimationCache* getInstance() { static AnimationCache cache; return &cache; }
+    void addAnimation(Animation* animation, const std::string& name) {}
+    void removeAnimation(const std::string& name) {}
+    Animation* getAnimation(const std::string& name) { return nullptr; }
+};
+
+// ============================================================================
+// 事件
+// ============================================================================
+
+class Node;
+
+class Event : public Ref {
+public:
+    enum class Type { TOUCH, KEYBOARD, ACCELERATION, MOUSE, FOCUS, GAME_CONTROLLER, CUSTOM };
+    void stopPropagation() {}
+    bool isStopped() const { return false; }
+    Node* getCurrentTarget() { return nullptr; }
+    Type getType() const { return Type::CUSTOM; }
+};
+
+class Touch : public Ref {
+public:
+    Vec2 getLocation() const { return Vec2(); }
+    Vec2 getPreviousLocation() const { return Vec2(); }
+    Vec2 getStartLocation() const { return Vec2(); }
+    Vec2 getDelta() const { return Vec2(); }
+    Vec2 getLocationInView() const { return Vec2(); }
+    Vec2 getPreviousLocationInView() const { return Vec2(); }
+    Vec2 getStartLocationInView() const { return Vec2(); }
+    int getID() const { return 0; }
+};
+
+class EventTouch : public Event {
+public:
+    enum class EventCode { BEGAN, MOVED, ENDED, CANCELLED };
+    const std::vector<Touch*>& getTouches() const { return _touches; }
+
+private:
+    std::vector<Touch*> _touches;
+};
+
+class EventMouse : public Event {
+public:
+    enum class MouseEventType { MOUSE_NONE, MOUSE_DOWN, MOUSE_UP, MOUSE_MOVE, MOUSE_SCROLL };
+    enum class MouseButton { BUTTON_UNSET = -1, BUTTON_LEFT = 0, BUTTON_RIGHT = 1, BUTTON_MIDDLE = 2 };
+    float getScrollX() const { return 0; }
+    float getScrollY() const { return 0; }
+    float getCursorX() const { return 0; }
+    float getCursorY() const { return 0; }
+    Vec2 getLocation() const { return Vec2(); }
+    Vec2 getLocationInView() const { return Vec2(); }
+    Vec2 getPreviousLocation() const { return Vec2(); }
+    Vec2 getDelta() const { return Vec2(); }
+    MouseButton getMouseButton() const { return MouseButton::BUTTON_UNSET; }
+};
+
+class EventKeyboard : public Event {
+public:
+    enum class KeyCode {
+        KEY_NONE, KEY_ESCAPE, KEY_BACKSPACE, KEY_TAB, KEY_ENTER, KEY_KP_ENTER, KEY_SPACE, KEY_SHIFT,
+        KEY_LEFT_SHIFT, KEY_RIGHT_SHIFT, KEY_CTRL, KEY_LEFT_CTRL, KEY_RIGHT_CTRL, KEY_ALT,
+        KEY_LEFT_ARROW, KEY_RIGHT_ARROW, KEY_UP_ARROW, KEY_DOWN_ARROW, KEY_PLUS, KEY_MINUS, KEY_EQUAL,
+        KEY_0, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9,
+        KEY_A, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I, KEY_J, KEY_K, KEY_L, KEY_M,
+        KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R, KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z,
+        KEY_CAPITAL_A, KEY_F1, KEY_F2, KEY_F3, KEY_F4, KEY_F5, KEY_F12, KEY_DELETE
+    };
+};
+
+class EventCustom : public Event {
+public:
+    explicit EventCustom(const std::string& eventName) {}
+    void setUserData(void* data) {}
+    void* getUserData() const { return nullptr; }
+    const std::string& getEventName() const { return _name; }
+
+private:
+    std::string _name;
+};
+
+class EventListener : public Ref {
+public:
+    void setEnabled(bool enabled) {}
+    bool isEnabled() const { return true; }
+    EventListener* clone() { return this; }
+};
+
+class EventListenerTouchOneByOne : public EventListener {
+public:
+    static EventListenerTouchOneByOne* create() { return new EventListenerTouchOneByOne(); }
+    void setSwallowTouches(bool needSwallow) {}
+    bool isSwallowTouches() { return false; }
+    std::function<bool(Touch*, Event*)> onTouchBegan;
+    std::function<void(Touch*, Event*)> onTouchMoved;
+    std::function<void(Touch*, Event*)> onTouchEnded;
+    std::function<void(Touch*, Event*)> onTouchCancelled;
+};
+
+class EventListenerTouchAllAtOnce : public EventListener {
+public:
+    static EventListenerTouchAllAtOnce* create() { return new EventListenerTouchAllAtOnce(); }
+    std::function<void(const std::vector<Touch*>&, Event*)> onTouchesBegan;
+    std::function<void(const std::vector<Touch*>&, Event*)> onTouchesMoved;
+    std::function<void(const std::vector<Touch*>&, Event*)> onTouchesEnded;
+    std::function<void(const std::vector<Touch*>&, Event*)> onTouchesCancelled;
+};
+
+class EventListenerMouse : public EventListener {
+public:
+    static EventListenerMouse* create() { return new EventListenerMouse(); }
+    std::function<void(EventMouse*)> onMouseDown;
+    std::function<void(EventMouse*)> onMouseUp;
+    std::function<void(EventMouse*)> onMouseMove;
+    std::function<void(EventMouse*)> onMouseScroll;
+};
+
+class EventListenerKeyboard : public EventListener {
+public:
+    static EventListenerKeyboard* create() { return new EventListenerKeyboard(); }
+    std::function<void(EventKeyboard::KeyCode, Event*)> onKeyPressed;
+    std::function<void(EventKeyboard::KeyCode, Event*)> onKeyReleased;
+};
+
+class EventListenerCustom : public EventListener {
+public:
+    static EventListenerCustom* create(const std::string& eventName, const std::function<void(EventCustom*)>& callback)
+    {
+        return new EventListenerCustom();
+    }
+};
+
+class EventDispatcher : public Ref {
+public:
+    void addEventListenerWithSceneGraphPriority(EventListener* listener, Node* node) {}
+    void addEventListenerWithFixedPriority(EventListener* listener, int fixedPriority) {}
+    EventListenerCustom* addCustomEventListener(const std::string& eventName,
+                                                const std::function<void(EventCustom*)>& callback)
+    {
+        return nullptr;
+    }
+    void removeEventListener(EventListener* listener) {}
+    void removeEventListenersForTarget(Node* target, bool recursive = false) {}
+    void removeCustomEventListeners(const std::string& customEventName) {}
+    void removeAllEventListeners() {}
+    void pauseEventListenersForTarget(Node* target, bool recursive = false) {}
+    void resumeEventListenersForTarget(Node* target, bool recursive = false) {}
+    void dispatchEvent(Event* event) {}
+    void dispatchCustomEvent(const std::string& eventName, void* optionalUserData = nullptr) {}
+    void setEnabled(bool isEnabled) {}
+};
+
+// ============================================================================
+// 调度器与动作
+// ============================================================================
+
+class Scheduler : public Ref {
+public:
+    typedef std::function<void(float)> ccSchedulerFunc;
+    void schedule(const ccSchedulerFunc& callback, void* target, float interval, bool paused, const std::string& key)
+    {
+    }
+    void schedule(const ccSchedulerFunc& callback, void* target, float interval, unsigned int repeat, float delay,
+                  bool paused, const std::string& key)
+    {
+    }
+    void unschedule(const std::string& key, void* target) {}
+    void unscheduleAllForTarget(void* target) {}
+    bool isScheduled(const std::string& key, const void* target) const { return false; }
+    void performFunctionInCocosThread(std::function<void()> function) {}
+    void setTimeScale(float timeScale) {}
+    float getTimeScale() { return 1.0f; }
+    void pauseTarget(void* target) {}
+    void resumeTarget(void* target) {}
+};
+
+class Action : public Ref {
+public:
+    static const int INVALID_TAG = -1;
+    virtual Action* clone() const { return nullptr; }
+    virtual Action* reverse() const { return nullptr; }
+    virtual bool isDone() const { return false; }
+    Node* getTarget() const { return nullptr; }
+    int getTag() const { return 0; }
+    void setTag(int tag) {}
+    unsigned int getFlags() const { return 0; }
+    void setFlags(unsigned int flags) {}
+};
+
+class FiniteTimeAction : public Action {
+public:
+    float getDuration() const { return 0; }
+    void setDuration(float duration) {}
+    FiniteTimeAction* clone() const override { return nullptr; }
+    FiniteTimeAction* reverse() const override { return nullptr; }
+};
+
+class ActionInterval : public FiniteTimeAction {
+public:
+    float getElapsed() { return 0; }
+    ActionInterval* clone() const override { return nullptr; }
+    ActionInterval* reverse() const override { return nullptr; }
+};
+
+class ActionInstant : public FiniteTimeAction {
+public:
+    ActionInstant* clone() const override { return nullptr; }
+    ActionInstant* reverse() const override { return nullptr; }
+};
+
+class Sequence : public ActionInterval {
+public:
+    static Sequence* create(FiniteTimeAction* action1, ...) { return nullptr; }
+    static Sequence* create(const Vector<FiniteTimeAction*>& arrayOfActions) { return nullptr; }
+    static Sequence* createWithTwoActions(FiniteTimeAction* actionOne, FiniteTimeAction* actionTwo) { return nullptr; }
+};
+
+class Spawn : public ActionInterval {
+public:
+    static Spawn* create(FiniteTimeAction* action1, ...) { return nullptr; }
+    static Spawn* create(const Vector<FiniteTimeAction*>& arrayOfActions) { return nullptr; }
+    static Spawn* createWithTwoActions(FiniteTimeAction* action1, FiniteTimeAction* action2) { return nullptr; }
+};
+
+class Repeat : public ActionInterval {
+public:
+    static Repeat* create(FiniteTimeAction* action, unsigned int times) { return nullptr; }
+};
+
+class RepeatForever : public ActionInterval {
+public:
+    static RepeatForever* create(ActionInterval* action) { return nullptr; }
+};
+
+class Speed : public Action {
+public:
+    static Speed* create(ActionInterval* action, float speed) { return nullptr; }
+    void setSpeed(float speed) {}
+    float getSpeed() const { return 1.0f; }
+};
+
+class DelayTime : public ActionInterval {
+public:
+    static DelayTime* create(float d) { return nullptr; }
+};
+
+class MoveTo : public ActionInterval {
+public:
+    static MoveTo* create(float duration, const Vec2& position) { return nullptr; }
+};
+class MoveBy : public ActionInterval {
+public:
+    static MoveBy* create(float duration, const Vec2& deltaPosition) { return nullptr; }
+};
+class JumpTo : public ActionInterval {
+public:
+    static JumpTo* create(float duration, const Vec2& position, float height, int jumps) { return nullptr; }
+};
+class JumpBy : public ActionInterval {
+public:
+    static JumpBy* create(float duration, const Vec2& position, float height, int jumps) { return nullptr; }
+};
+struct ccBezierConfig {
+    Vec2 endPosition;
+    Vec2 controlPoint_1;
+    Vec2 controlPoint_2;
+};
+class BezierTo : public ActionInterval {
+public:
+    static BezierTo* create(float t, const ccBezierConfig& c) { return nullptr; }
+};
+class BezierBy : public ActionInterval {
+public:
+    static BezierBy* create(float t, const ccBezierConfig& c) { return nullptr; }
+};
+class ScaleTo : public ActionInterval {
+public:
+    static ScaleTo* create(float duration, float s) { return nullptr; }
+    static ScaleTo* create(float duration, float sx, float sy) { return nullptr; }
+};
+class ScaleBy : public ActionInterval {
+public:
+    static ScaleBy* create(float duration, float s) { return nullptr; }
+    static ScaleBy* create(float duration, float sx, float sy) { return nullptr; }
+};
+class RotateTo : public ActionInterval {
+public:
+    static RotateTo* create(float duration, float dstAngle) { return nullptr; }
+};
+class RotateBy : public ActionInterval {
+public:
+    static RotateBy* create(float duration, float deltaAngle) { return nullptr; }
+};
+class FadeIn : public ActionInterval {
+public:
+    static FadeIn* create(float d) { return nullptr; }
+};
+class FadeOut : public ActionInterval {
+public:
+    static FadeOut* create(float d) { return nullptr; }
+};
+class FadeTo : public ActionInterval {
+public:
+    static FadeTo* create(float duration, uint8_t opacity) { return nullptr; }
+};
+class TintTo : public ActionInterval {
+public:
+    static TintTo* create(float duration, uint8_t red, uint8_t green, uint8_t blue) { return nullptr; }
+    static TintTo* create(float duration, const Color3B& color) { return nullptr; }
+};
+class TintBy : public ActionInterval {
+public:
+    static TintBy* create(float duration, int16_t deltaRed, int16_t deltaGreen, int16_t deltaBlue) { return nullptr; }
+};
+class Blink : public ActionInterval {
+public:
+    static Blink* create(float duration, int blinks) { return nullptr; }
+};
+class Animate : public ActionInterval {
+public:
+    static Animate* create(Animation* animation) { return nullptr; }
+    Animation* getAnimation() { return nullptr; }
+};
+class ProgressTo : public ActionInterval {
+public:
+    static ProgressTo* create(float duration, float percent) { return nullptr; }
+};
+class ProgressFromTo : public ActionInterval {
+public:
+    static ProgressFromTo* create(float duration, float fromPercentage, float toPercentage) { return nullptr; }
+};
+
+class ActionEase : public ActionInterval {
+};
+#define CC_STUB_EASE(name)                                                    \
+    class name : public ActionEase {                                          \
+    public:                                                                   \
+        static name* create(ActionInterval* action) { return nullptr; }       \
+    };
+#define CC_STUB_EASE_RATE(name)                                               \
+    class name : public ActionEase {                                          \
+    public:                                                                   \
+        static name* create(ActionInterval* action, float rate) { return nullptr; } \
+    };
+CC_STUB_EASE_RATE(EaseIn)
+CC_STUB_EASE_RATE(EaseOut)
+CC_STUB_EASE_RATE(EaseInOut)
+CC_STUB_EASE(EaseSineIn)
+CC_STUB_EASE(EaseSineOut)
+CC_STUB_EASE(EaseSineInOut)
+CC_STUB_EASE(EaseBackIn)
+CC_STUB_EASE(EaseBackOut)
+CC_STUB_EASE(EaseBackInOut)
+CC_STUB_EASE(EaseBounceIn)
+CC_STUB_EASE(EaseBounceOut)
+CC_STUB_EASE(EaseExponentialIn)
+CC_STUB_EASE(EaseExponentialOut)
+CC_STUB_EASE(EaseQuadraticActionOut)
+CC_STUB_EASE(EaseCubicActionOut)
+class EaseElasticOut : public ActionEase {
+public:
+    static EaseElasticOut* create(ActionInterval* action) { return nullptr; }
+    static EaseElasticOut* create(ActionInterval* action, float period) { return nullptr; }
+};
+class EaseElasticIn : public ActionEase {
+public:
+    static EaseElasticIn* create(ActionInterval* action) { return nullptr; }
+    static EaseElasticIn* create(ActionInterval* action, float period) { return nullptr; }
+};
+
+class CallFunc : public ActionInstant {
+public:
+    static CallFunc* create(const std::function<void()>& func) { return nullptr; }
+};
+class CallFuncN : public ActionInstant {
+public:
+    static CallFuncN* create(const std::function<void(Node*)>& func) { return nullptr; }
+};
+class RemoveSelf : public ActionInstant {
+public:
+    static RemoveSelf* create(bool isNeedCleanUp = true) { return nullptr; }
+};
+class Show : public ActionInstant {
+public:
+    static Show* create() { return nullptr; }
+};
+class Hide : public ActionInstant {
+public:
+    static Hide* create() { return nullptr; }
+};
+class ToggleVisibility : public ActionInstant {
+public:
+    static ToggleVisibility* create() { return nullptr; }
+};
+class Place : public ActionInstant {
+public:
+    static Place* create(const Vec2& pos) { return nullptr; }
+};
+class FlipX : public ActionInstant {
+public:
+    static FlipX* create(bool x) { return nullptr; }
+};
+
+class ActionManager : public Ref {
+public:
+    void removeAllActions() {}
+    void removeAllActionsFromTarget(Node* target) {}
+    void pauseTarget(Node* target) {}
+    void resumeTarget(Node* target) {}
+    ssize_t getNumberOfRunningActionsInTarget(const Node* target) const { return 0; }
+};
+
+// ============================================================================
+// 节点
+// ============================================================================
+
+class Scene;
+class Camera;
+class Component;
+
+class Node : public Ref {
+public:
+    static const int INVALID_TAG = -1;
+    static Node* create() { return new Node(); }
+    virtual bool init() { return true; }
+    virtual void onEnter() {}
+    virtual void onExit() {}
+    virtual void onEnterTransitionDidFinish() {}
+    virtual void onExitTransitionDidStart() {}
+    virtual void cleanup() {}
+    virtual void update(float delta) {}
+
+    virtual void addChild(Node* child) {}
+    virtual void addChild(Node* child, int localZOrder) {}
+    virtual void addChild(Node* child, int localZOrder, int tag) {}
+    virtual void addChild(Node* child, int localZOrder, const std::string& name) {}
+    virtual void removeChild(Node* child, bool cleanup = true) {}
+    virtual void removeChildByTag(int tag, bool cleanup = true) {}
+    virtual void removeChildByName(const std::string& name, bool cleanup = true) {}
+    virtual void removeAllChildren() {}
+    virtual void removeAllChildrenWithCleanup(bool cleanup) {}
+    virtual void removeFromParent() {}
+    virtual void removeFromParentAndCleanup(bool cleanup) {}
+    virtual void reorderChild(Node* child, int localZOrder) {}
+    virtual void sortAllChildren() {}
+    Node* getChildByTag(int tag) const { return nullptr; }
+    Node* getChildByName(const std::string& name) const { return nullptr; }
+    template <typename T>
+    T getChildByName(const std::string& name) const { return nullptr; }
+    template <typename T>
+    T getChildByTag(int tag) const { return nullptr; }
+    Vector<Node*>& getChildren() { return _children; }
+    const Vector<Node*>& getChildren() const { return _children; }
+    ssize_t getChildrenCount() const { return _children.size(); }
+    Node* getParent() { return nullptr; }
+    const Node* getParent() const { return nullptr; }
+    virtual void setParent(Node* parent) {}
+    Scene* getScene() const { return nullptr; }
+
+    virtual void setPosition(const Vec2& position) {}
+    virtual void setPosition(float x, float y) {}
+    virtual const Vec2& getPosition() const { return _position; }
+    virtual void getPosition(float* x, float* y) const {}
+    virtual void setPositionX(float x) {}
+    virtual float getPositionX() const { return 0; }
+    virtual void setPositionY(float y) {}
+    virtual float getPositionY() const { return 0; }
+    virtual void setPositionNormalized(const Vec2& position) {}
+    virtual void setNormalizedPosition(const Vec2& position) {}
+    virtual void setScale(float scale) {}
+    virtual void setScale(float scaleX, float scaleY) {}
+    virtual float getScale() const { return 1; }
+    virtual void setScaleX(float scaleX) {}
+    virtual float getScaleX() const { return 1; }
+    virtual void setScaleY(float scaleY) {}
+    virtual float getScaleY() const { return 1; }
+    virtual void setRotation(float rotation) {}
+    virtual float getRotation() const { return 0; }
+    virtual void setSkewX(float skewX) {}
+    virtual void setSkewY(float skewY) {}
+    virtual void setAnchorPoint(const Vec2& anchorPoint) {}
+    virtual const Vec2& getAnchorPoint() const { return _position; }
+    virtual const Vec2& getAnchorPointInPoints() const { return _position; }
+    virtual void setContentSize(const Size& contentSize) {}
+    virtual const Size& getContentSize() const { return _size; }
+    virtual Rect getBoundingBox() const { return Rect(); }
+    virtual void setVisible(bool visible) {}
+    virtual bool isVisible() const { return true; }
+    virtual void setLocalZOrder(int localZOrder) {}
+    virtual int getLocalZOrder() const { return 0; }
+    virtual void setGlobalZOrder(float globalZOrder) {}
+    virtual float getGlobalZOrder() const { return 0; }
+    virtual void setIgnoreAnchorPointForPosition(bool ignore) {}
+    virtual void setTag(int tag) {}
+    virtual int getTag() const { return 0; }
+    virtual void setName(const std::string& name) {}
+    virtual const std::string& getName() const { return _name; }
+    virtual void setUserData(void* userData) {}
+    virtual void* getUserData() { return nullptr; }
+    virtual void setUserObject(Ref* userObject) {}
+    virtual Ref* getUserObject() { return nullptr; }
+    virtual void setCameraMask(unsigned short mask, bool applyChildren = true) {}
+    virtual bool isRunning() const { return true; }
+
+    virtual void setOpacity(uint8_t opacity) {}
+    virtual uint8_t getOpacity() const { return 255; }
+    virtual uint8_t getDisplayedOpacity() const { return 255; }
+    virtual void setColor(const Color3B& color) {}
+    virtual const Color3B& getColor() const { return _color; }
+    virtual const Color3B& getDisplayedColor() const { return _color; }
+    virtual void setCascadeOpacityEnabled(bool cascadeOpacityEnabled) {}
+    virtual void setCascadeColorEnabled(bool cascadeColorEnabled) {}
+    virtual bool isCascadeOpacityEnabled() const { return false; }
+
+    virtual Action* runAction(Action* action) { return action; }
+    void stopAllActions() {}
+    void stopAction(Action* action) {}
+    void stopActionByTag(int tag) {}
+    void stopAllActionsByTag(int tag) {}
+    Action* getActionByTag(int tag) { return nullptr; }
+    ssize_t getNumberOfRunningActions() const { return 0; }
+    ssize_t getNumberOfRunningActionsByTag(int tag) const { return 0; }
+    ActionManager* getActionManager() { return nullptr; }
+
+    Scheduler* getScheduler() { return nullptr; }
+    void scheduleUpdate() {}
+    void scheduleUpdateWithPriority(int priority) {}
+    void unscheduleUpdate() {}
+    void schedule(const std::function<void(float)>& callback, const std::string& key) {}
+    void schedule(const std::function<void(float)>& callback, float interval, const std::string& key) {}
+    void schedule(const std::function<void(float)>& callback, float interval, unsigned int repeat, float delay,
+                  const std::string& key)
+    {
+    }
+    void scheduleOnce(const std::function<void(float)>& callback, float delay, const std::string& key) {}
+    void schedule(SEL_SCHEDULE selector) {}
+    void schedule(SEL_SCHEDULE selector, float interval) {}
+    void schedule(SEL_SCHEDULE selector, float interval, unsigned int repeat, float delay) {}
+    void scheduleOnce(SEL_SCHEDULE selector, float delay) {}
+    void unschedule(SEL_SCHEDULE selector) {}
+    bool isScheduled(SEL_SCHEDULE selector) const { return false; }
+    void unschedule(const std::string& key) {}
+    void unscheduleAllCallbacks() {}
+    bool isScheduled(const std::string& key) const { return false; }
+    virtual void pause() {}
+    virtual void resume() {}
+
+    EventDispatcher* getEventDispatcher() const { return _eventDispatcher; }
+
+    Vec2 convertToNodeSpace(const Vec2& worldPoint) const { return worldPoint; }
+    Vec2 convertToWorldSpace(const Vec2& nodePoint) const { return nodePoint; }
+    Vec2 convertToNodeSpaceAR(const Vec2& worldPoint) const { return worldPoint; }
+    Vec2 convertToWorldSpaceAR(const Vec2& nodePoint) const { return nodePoint; }
+    Vec2 convertTouchToNodeSpace(Touch* touch) const { return Vec2(); }
+    Vec2 convertTouchToNodeSpaceAR(Touch* touch) const { return Vec2(); }
+
+protected:
+    EventDispatcher* _eventDispatcher = nullptr;
+    Vector<Node*> _children;
+    Vec2 _position;
+    Size _size;
+    Color3B _color;
+    std::string _name;
+};
+
+class Sprite : public Node {
+public:
+    static Sprite* create() { return new Sprite(); }
+    static Sprite* create(const std::string& filename) { return nullptr; }
+    static Sprite* create(const std::string& filename, const Rect& rect) { return nullptr; }
+    static Sprite* createWithTexture(Texture2D* texture) { return nullptr; }
+    static Sprite* createWithTexture(Texture2D* texture, const Rect& rect, bool rotated = false) { return nullptr; }
+    static Sprite* createWithSpriteFrame(SpriteFrame* spriteFrame) { return nullptr; }
+    static Sprite* createWithSpriteFrameName(const std::string& spriteFrameName) { return nullptr; }
+    bool init() override { return true; }
+    virtual bool initWithFile(const std::string& filename) { return true; }
+    virtual bool initWithSpriteFrame(SpriteFrame* spriteFrame) { return true; }
+    virtual bool initWithSpriteFrameName(const std::string& spriteFrameName) { return true; }
+    virtual bool initWithTexture(Texture2D* texture) { return true; }
+    virtual void setTexture(const std::string& filename) {}
+    virtual void setTexture(Texture2D* texture) {}
+    virtual Texture2D* getTexture() const { return nullptr; }
+    virtual void setTextureRect(const Rect& rect) {}
+    virtual void setSpriteFrame(const std::string& spriteFrameName) {}
+    virtual void setSpriteFrame(SpriteFrame* newFrame) {}
+    virtual SpriteFrame* getSpriteFrame() const { return nullptr; }
+    virtual void setDisplayFrame(SpriteFrame* newFrame) {}
+    const Rect& getTextureRect() const { return _rect; }
+    void setFlippedX(bool flippedX) {}
+    void setFlippedY(bool flippedY) {}
+    bool isFlippedX() const { return false; }
+    bool isFlippedY() const { return false; }
+    void setBlendFunc(const BlendFunc& blendFunc) {}
+    void setStretchEnabled(bool enabled) {}
+
+private:
+    Rect _rect;
+};
+
+enum class TextHAlignment { LEFT, CENTER, RIGHT };
+enum class TextVAlignment { TOP, CENTER, BOTTOM };
+
+struct TTFConfig {
+    std::string fontFilePath;
+    float fontSize = 12;
+    TTFConfig(const std::string& filePath = "", float size = 12) : fontFilePath(filePath), fontSize(size) {}
+};
+
+class Label : public Node {
+public:
+    static Label* create() { return new Label(); }
+    static Label* createWithSystemFont(const std::string& text, const std::string& font, float fontSize,
+                                       const Size& dimensions = Size::ZERO,
+                                       TextHAlignment hAlignment = TextHAlignment::LEFT,
+                                       TextVAlignment vAlignment = TextVAlignment::TOP)
+    {
+        return nullptr;
+    }
+    static Label* createWithTTF(const std::string& text, const std::string& fontFilePath, float fontSize,
+                                const Size& dimensions = Size::ZERO, TextHAlignment hAlignment = TextHAlignment::LEFT,
+                                TextVAlignment vAlignment = TextVAlignment::TOP)
+    {
+        return nullptr;
+    }
+    static Label* createWithTTF(const TTFConfig& ttfConfig, const std::string& text,
+                                TextHAlignment hAlignment = TextHAlignment::LEFT, int maxLineWidth = 0)
+    {
+        return nullptr;
+    }
+    static Label* createWithBMFont(const std::string& bmfontPath, const std::string& text,
+                                   const TextHAlignment& hAlignment = TextHAlignment::LEFT, int maxLineWidth = 0)
+    {
+        return nullptr;
+    }
+    virtual void setString(const std::string& text) {}
+    virtual const std::string& getString() const { return _text; }
+    virtual void setTextColor(const Color4B& color) {}
+    virtual const Color4B& getTextColor() const { return _textColor; }
+    virtual void enableShadow(const Color4B& shadowColor = Color4B::BLACK, const Size& offset = Size(2, -2),
+                              int blurRadius = 0)
+    {
+    }
+    virtual void enableOutline(const Color4B& outlineColor, int outlineSize = -1) {}
+    virtual void enableGlow(const Color4B& glowColor) {}
+    virtual void enableBold() {}
+    virtual void enableItalics() {}
+    virtual void enableUnderline() {}
+    virtual void disableEffect() {}
+    void setAlignment(TextHAlignment hAlignment) {}
+    void setAlignment(TextHAlignment hAlignment, TextVAlignment vAlignment) {}
+    void setHorizontalAlignment(TextHAlignment hAlignment) {}
+    void setVerticalAlignment(TextVAlignment vAlignment) {}
+    void setDimensions(float width, float height) {}
+    void setWidth(float width) {}
+    void setMaxLineWidth(float maxLineWidth) {}
+    void setLineBreakWithoutSpace(bool breakWithoutSpace) {}
+    void setSystemFontSize(float fontSize) {}
+    float getSystemFontSize() const { return 0; }
+    void setSystemFontName(const std::string& font) {}
+    void setOverflow(int overflow) {}
+    void setLineSpacing(float height) {}
+    void setTTFConfig(const TTFConfig& ttfConfig) {}
+    const TTFConfig& getTTFConfig() const { return _ttf; }
+    float getRenderingFontSize() const { return 0; }
+
+private:
+    std::string _text;
+    Color4B _textColor;
+    TTFConfig _ttf;
+};
+
+class Layer : public Node {
+public:
+    static Layer* create() { return new Layer(); }
+    bool init() override { return true; }
+};
+
+class LayerColor : public Layer {
+public:
+    static LayerColor* create() { return new LayerColor(); }
+    static LayerColor* create(const Color4B& color) { return nullptr; }
+    static LayerColor* create(const Color4B& color, float width, float height) { return nullptr; }
+    virtual bool initWithColor(const Color4B& color) { return true; }
+    virtual bool initWithColor(const Color4B& color, float width, float height) { return true; }
+    void changeWidth(float w) {}
+    void changeHeight(float h) {}
+    void changeWidthAndHeight(float w, float h) {}
+};
+
+class LayerGradient : public LayerColor {
+public:
+    static LayerGradient* create(const Color4B& start, const Color4B& end) { return nullptr; }
+};
+
+class Scene : public Node {
+public:
+    static Scene* create() { return new Scene(); }
+    bool init() override { return true; }
+};
+
+class TransitionScene : public Scene {
+};
+class TransitionFade : public TransitionScene {
+public:
+    static TransitionFade* create(float duration, Scene* scene) { return nullptr; }
+    static TransitionFade* create(float duration, Scene* scene, const Color3B& color) { return nullptr; }
+};
+class TransitionCrossFade : public TransitionScene {
+public:
+    static TransitionCrossFade* create(float t, Scene* scene) { return nullptr; }
+};
+
+class DrawNode : public Node {
+public:
+    static DrawNode* create(float defaultLineWidth = 2) { return new DrawNode(); }
+    void drawDot(const Vec2& pos, float radius, const Color4F& color) {}
+    void drawPoint(const Vec2& point, const float pointSize, const Color4F& color) {}
+    void drawLine(const Vec2& origin, const Vec2& destination, const Color4F& color) {}
+    void drawRect(const Vec2& origin, const Vec2& destination, const Color4F& color) {}
+    void drawRect(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Vec2& p4, const Color4F& color) {}
+    void drawSolidRect(const Vec2& origin, const Vec2& destination, const Color4F& color) {}
+    void drawCircle(const Vec2& center, float radius, float angle, unsigned int segments, bool drawLineToCenter,
+                    float scaleX, float scaleY, const Color4F& color)
+    {
+    }
+    void drawCircle(const Vec2& center, float radius, float angle, unsigned int segments, bool drawLineToCenter,
+                    const Color4F& color)
+    {
+    }
+    void drawSolidCircle(const Vec2& center, float radius, float angle, unsigned int segments, float scaleX,
+                         float scaleY, const Color4F& color)
+    {
+    }
+    void drawSolidCircle(const Vec2& center, float radius, float angle, unsigned int segments, const Color4F& color)
+    {
+    }
+    void drawSegment(const Vec2& from, const Vec2& to, float radius, const Color4F& color) {}
+    void drawPolygon(const Vec2* verts, int count, const Color4F& fillColor, float borderWidth,
+                     const Color4F& borderColor)
+    {
+    }
+    void drawSolidPoly(const Vec2* poli, unsigned int numberOfPoints, const Color4F& color) {}
+    void drawPoly(const Vec2* poli, unsigned int numberOfPoints, bool closePolygon, const Color4F& color) {}
+    void drawTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color4F& color) {}
+    void drawQuadBezier(const Vec2& origin, const Vec2& control, const Vec2& destination, unsigned int segments,
+                        const Color4F& color)
+    {
+    }
+    void clear() {}
+    void setLineWidth(float lineWidth) {}
+};
+
+class ClippingNode : public Node {
+public:
+    static ClippingNode* create() { return new ClippingNode(); }
+    static ClippingNode* create(Node* stencil) { return nullptr; }
+    void setStencil(Node* stencil) {}
+    void setInverted(bool inverted) {}
+    void setAlphaThreshold(float alphaThreshold) {}
+};
+
+class ProgressTimer : public Node {
+public:
+    enum class Type { RADIAL, BAR };
+    static ProgressTimer* create(Sprite* sp) { return nullptr; }
+    void setType(Type type) {}
+    void setPercentage(float percentage) {}
+    float getPercentage() const { return 0; }
+    void setMidpoint(const Vec2& point) {}
+    void setBarChangeRate(const Vec2& barChangeRate) {}
+    void setReverseDirection(bool value) {}
+    void setSprite(Sprite* sprite) {}
+};
+
+class ParticleSystem : public Node {
+public:
+    enum class PositionType { FREE, RELATIVE, GROUPED };
+    static const int DURATION_INFINITY = -1;
+    void setDuration(float duration) {}
+    void setAutoRemoveOnFinish(bool var) {}
+    void setLife(float life) {}
+    void setLifeVar(float lifeVar) {}
+    void setStartSize(float startSize) {}
+    void setStartSizeVar(float sizeVar) {}
+    void setEndSize(float endSize) {}
+    void setEndSizeVar(float sizeVar) {}
+    void setStartColor(const Color4F& color) {}
+    void setStartColorVar(const Color4F& color) {}
+    void setEndColor(const Color4F& color) {}
+    void setEndColorVar(const Color4F& color) {}
+    void setSpeed(float speed) {}
+    void setSpeedVar(float speed) {}
+    void setAngle(float angle) {}
+    void setAngleVar(float angle) {}
+    void setGravity(const Vec2& g) {}
+    void setEmissionRate(float rate) {}
+    void setTotalParticles(int totalParticles) {}
+    void setPosVar(const Vec2& pos) {}
+    void setTexture(Texture2D* texture) {}
+    void setPositionType(PositionType type) {}
+    void setBlendAdditive(bool value) {}
+    void stopSystem() {}
+    void resetSystem() {}
+};
+class ParticleSystemQuad : public ParticleSystem {
+public:
+    static ParticleSystemQuad* create() { return nullptr; }
+    static ParticleSystemQuad* create(const std::string& filename) { return nullptr; }
+    static ParticleSystemQuad* createWithTotalParticles(int numberOfParticles) { return nullptr; }
+};
+#define CC_STUB_PARTICLE(name)                                                    \
+    class name : public ParticleSystemQuad {                                      \
+    public:                                                                       \
+        static name* create() { return nullptr; }                                 \
+        static name* createWithTotalParticles(int numberOfParticles) { return nullptr; } \
+    };
+CC_STUB_PARTICLE(ParticleExplosion)
+CC_STUB_PARTICLE(ParticleFire)
+CC_STUB_PARTICLE(ParticleSmoke)
+CC_STUB_PARTICLE(ParticleSun)
+CC_STUB_PARTICLE(ParticleMeteor)
+CC_STUB_PARTICLE(ParticleGalaxy)
+CC_STUB_PARTICLE(ParticleFlower)
+CC_STUB_PARTICLE(ParticleSpiral)
+CC_STUB_PARTICLE(ParticleFireworks)
+CC_STUB_PARTICLE(ParticleSnow)
+CC_STUB_PARTICLE(ParticleRain)
+
+class MenuItem : public Node {
+public:
+    void setEnabled(bool value) {}
+    bool isEnabled() const { return true; }
+    void setCallback(const std::function<void(Ref*)>& callback) {}
+};
+class MenuItemLabel : public MenuItem {
+public:
+    static MenuItemLabel* create(Node* label, const std::function<void(Ref*)>& callback) { return nullptr; }
+    static MenuItemLabel* create(Node* label) { return nullptr; }
+    void setString(const std::string& label) {}
+    Node* getLabel() const { return nullptr; }
+};
+class MenuItemSprite : public MenuItem {
+public:
+    static MenuItemSprite* create(Node* normalSprite, Node* selectedSprite,
+                                  const std::function<void(Ref*)>& callback) { return nullptr; }
+};
+class MenuItemImage : public MenuItemSprite {
+public:
+    static MenuItemImage* create(const std::string& normalImage, const std::string& selectedImage,
+                                 const std::function<void(Ref*)>& callback) { return nullptr; }
+    static MenuItemImage* create(const std::string& normalImage, const std::string& selectedImage,
+                                 const std::string& disabledImage,
+                                 const std::function<void(Ref*)>& callback) { return nullptr; }
+};
+class MenuItemFont : public MenuItemLabel {
+public:
+    static MenuItemFont* create(const std::string& value, const std::function<void(Ref*)>& callback)
+    {
+        return nullptr;
+    }
+};
+class Menu : public Layer {
+public:
+    static Menu* create() { return new Menu(); }
+    static Menu* create(MenuItem* item, ...) { return nullptr; }
+    static Menu* createWithArray(const Vector<MenuItem*>& arrayOfItems) { return nullptr; }
+    void alignItemsVertically() {}
+    void alignItemsVerticallyWithPadding(float padding) {}
+    void alignItemsHorizontally() {}
+    void alignItemsHorizontallyWithPadding(float padding) {}
+    void setEnabled(bool value) {}
+};
+
+class Camera : public Node {
+public:
+    static Camera* getDefaultCamera() { return nullptr; }
+};
+
+class RenderTexture : public Node {
+public:
+    static RenderTexture* create(int w, int h) { return nullptr; }
+    void begin() {}
+    void end() {}
+    Sprite* getSprite() const { return nullptr; }
+};
+
+// ============================================================================
+// 全局单例
+// ============================================================================
+
+struct GLContextAttrs {
+    int redBits, greenBits, blueBits, alphaBits, depthBits, stencilBits, multisamplingCount;
+};
+
+enum class ResolutionPolicy { EXACT_FIT, NO_BORDER, SHOW_ALL, FIXED_HEIGHT, FIXED_WIDTH, UNKNOWN };
+
+class GLView : public Ref {
+public:
+    static void setGLContextAttrs(GLContextAttrs& glContextAttrs) {}
+    void setDesignResolutionSize(float width, float height, ResolutionPolicy resolutionPolicy) {}
+    void setFrameZoomFactor(float zoomFactor) {}
+    void setViewName(const std::string& viewname) {}
+    Size getFrameSize() const { return Size(); }
+    Size getDesignResolutionSize() const { return Size(); }
+    Size getVisibleSize() const { return Size(); }
+    Vec2 getVisibleOrigin() const { return Vec2(); }
+    void setDesignResolutionSize(float width, float height, int resolutionPolicy) {}
+    void setCursorVisible(bool isVisible) {}
+};
+
+class GLViewImpl : public GLView {
+public:
+    static GLViewImpl* create(const std::string& viewName) { return nullptr; }
+    static GLViewImpl* create(const std::string& viewName, bool resizable) { return nullptr; }
+    static GLViewImpl* createWithRect(const std::string& viewName, Rect size, float frameZoomFactor = 1.0f,
+                                      bool resizable = false)
+    {
+        return nullptr;
+    }
+    static GLViewImpl* createWithFullScreen(const std::string& viewName) { return nullptr; }
+};
+
+class Director : public Ref {
+public:
+    enum class Projection { _2D, _3D, CUSTOM, DEFAULT = _3D };
+    static Director* getInstance() { static Director director; return &director; }
+    Scene* getRunningScene() { return nullptr; }
+    void runWithScene(Scene* scene) {}
+    void replaceScene(Scene* scene) {}
+    void pushScene(Scene* scene) {}
+    void popScene() {}
+    void popToRootScene() {}
+    void end() {}
+    void pause() {}
+    void resume() {}
+    bool isPaused() { return false; }
+    Size getWinSize() const { return Size(); }
+    Size getWinSizeInPixels() const { return Size(); }
+    Size getVisibleSize() const { return Size(); }
+    Vec2 getVisibleOrigin() const { return Vec2(); }
+    Rect getSafeAreaRect() const { return Rect(); }
+    Vec2 convertToGL(const Vec2& point) { return point; }
+    Vec2 convertToUI(const Vec2& point) { return point; }
+    GLView* getOpenGLView() { return nullptr; }
+    void setOpenGLView(GLView* openGLView) {}
+    void startAnimation() {}
+    void stopAnimation() {}
+    Scheduler* getScheduler() const { return nullptr; }
+    ActionManager* getActionManager() const { return nullptr; }
+    EventDispatcher* getEventDispatcher() const { return nullptr; }
+    TextureCache* getTextureCache() const { return nullptr; }
+    float getAnimationInterval() { return 1.0f / 60; }
+    void setAnimationInterval(float interval) {}
+    float getDeltaTime() const { return 1.0f / 60; }
+    unsigned int getTotalFrames() const { return 0; }
+    float getContentScaleFactor() const { return 1; }
+    void setDisplayStats(bool displayStats) {}
+    void setProjection(Projection projection) {}
+};
+
+class UserDefault {
+public:
+    static UserDefault* getInstance() { static UserDefault instance; return &instance; }
+    bool getBoolForKey(const char* key, bool defaultValue = false) { return defaultValue; }
+    int getIntegerForKey(const char* key, int defaultValue = 0) { return defaultValue; }
+    int64_t getLargeIntForKey(const char* key, int64_t defaultValue = 0) { return defaultValue; }
+    float getFloatForKey(const char* key, float defaultValue = 0) { return defaultValue; }
+    double getDoubleForKey(const char* key, double defaultValue = 0) { return defaultValue; }
+    std::string getStringForKey(const char* key, const std::string& defaultValue = "") { return defaultValue; }
+    void setBoolForKey(const char* key, bool value) {}
+    void setIntegerForKey(const char* key, int value) {}
+    void setLargeIntForKey(const char* key, int64_t value) {}
+    void setFloatForKey(const char* key, float value) {}
+    void setDoubleForKey(const char* key, double value) {}
+    void setStringForKey(const char* key, const std::string& value) {}
+    void deleteValueForKey(const char* key) {}
+    void flush() {}
+};
+
+class Data {
+public:
+    unsigned char* getBytes() const { return nullptr; }
+    ssize_t getSize() const { return 0; }
+    bool isNull() const { return true; }
+};
+
+class FileUtils {
+public:
+    static FileUtils* getInstance() { static FileUtils instance; return &instance; }
+    std::string getStringFromFile(const std::string& filename) const { return std::string(); }
+    Data getDataFromFile(const std::string& filename) const { return Data(); }
+    bool writeStringToFile(const std::string& dataStr, const std::string& fullPath) const { return true; }
+    bool writeDataToFile(const Data& data, const std::string& fullPath) const { return true; }
+    bool isFileExist(const std::string& filename) const { return false; }
+    bool isDirectoryExist(const std::string& dirPath) const { return false; }
+    bool createDirectory(const std::string& dirPath) const { return true; }
+    bool removeFile(const std::string& filepath) const { return true; }
+    bool removeDirectory(const std::string& dirPath) const { return true; }
+    bool renameFile(const std::string& oldfullpath, const std::string& newfullpath) const { return true; }
+    std::string getWritablePath() const { return std::string(); }
+    std::string fullPathForFilename(const std::string& filename) const { return filename; }
+    void addSearchPath(const std::string& path, const bool front = false) {}
+    const std::vector<std::string> getSearchPaths() const { return std::vector<std::string>(); }
+    ValueMap getValueMapFromFile(const std::string& filename) const { return ValueMap(); }
+    ValueVector getValueVectorFromFile(const std::string& filename) const { return ValueVector(); }
+    bool writeValueMapToFile(const ValueMap& dict, const std::string& fullPath) const { return true; }
+    bool writeValueVectorToFile(const ValueVector& vecData, const std::string& fullPath) const { return true; }
+    std::vector<std::string> listFiles(const std::string& dirPath) const { return std::vector<std::string>(); }
+    long getFileSize(const std::string& filepath) const { return 0; }
+};
+
+class Device {
+public:
+    static void setKeepScreenOn(bool keepScreenOn) {}
+    static int getDPI() { return 160; }
+};
+
+class Application {
+public:
+    virtual ~Application() {}
+    static Application* getInstance() { return nullptr; }
+    virtual void initGLContextAttrs() {}
+    virtual bool applicationDidFinishLaunching() = 0;
+    virtual void applicationDidEnterBackground() = 0;
+    virtual void applicationWillEnterForeground() = 0;
+    int run() { return 0; }
+};
+
+}  // namespace cocos2d
+
+#include "ui/CocosGUI.h"
@@ -0,0 +1,231 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     document.h
+ * File Function: rapidjson Document/Value 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rapidjson {
+
+typedef unsigned SizeType;
+enum Type { kNullType, kFalseType, kTrueType, kObjectType, kArrayType, kStringType, kNumberType };
+enum ParseErrorCode { kParseErrorNone = 0 };
+
+class MemoryPoolAllocator {};
+
+template <typename CharType>
+struct GenericStringRef {
+    const CharType* s;
+    SizeType length;
+    template <SizeType N>
+    GenericStringRef(const CharType (&str)[N]) : s(str), length(N - 1) {}
+    explicit GenericStringRef(const CharType* str) : s(str), length(0) {}
+    GenericStringRef(const CharType* str, SizeType len) : s(str), length(len) {}
+};
+inline GenericStringRef<char> StringRef(const char* str) { return GenericStringRef<char>(str); }
+inline GenericStringRef<char> StringRef(const char* str, size_t length)
+{
+    return GenericStringRef<char>(str, static_cast<SizeType>(length));
+}
+inline GenericStringRef<char> StringRef(const std::string& str)
+{
+    return GenericStringRef<char>(str.data(), static_cast<SizeType>(str.size()));
+}
+
+class GenericValue;
+
+template <bool Const>
+class GenericArray {
+public:
+    typedef GenericValue* iterator;
+    iterator begin() const { return nullptr; }
+    iterator end() const { return nullptr; }
+    SizeType Size() const { return 0; }
+    bool Empty() const { return true; }
+    GenericValue& operator[](SizeType index) const;
+};
+
+template <typename V>
+struct GenericMember {
+    V name;
+    V value;
+};
+
+class GenericValue {
+public:
+    typedef MemoryPoolAllocator AllocatorType;
+    typedef GenericMember<GenericValue>* MemberIterator;
+    typedef const GenericMember<GenericValue>* ConstMemberIterator;
+    typedef GenericValue* ValueIterator;
+    typedef const GenericValue* ConstValueIterator;
+    typedef GenericArray<false> Array;
+    typedef GenericArray<true> ConstArray;
+    typedef GenericArray<false> Object;
+
+    GenericValue() {}
+    explicit GenericValue(Type type) {}
+    explicit GenericValue(bool b) {}
+    explicit GenericValue(int i) {}
+    explicit GenericValue(unsigned u) {}
+    explicit GenericValue(int64_t i64) {}
+    explicit GenericValue(uint64_t u64) {}
+    explicit GenericValue(double d) {}
+    explicit GenericValue(float f) {}
+    GenericValue(const char* s, SizeType length) {}
+    GenericValue(GenericStringRef<char> s) {}
+    GenericValue(const char* s, SizeType length, AllocatorType& allocator) {}
+    GenericValue(const char* s, AllocatorType& allocator) {}
+    GenericValue(const std::string& s, AllocatorType& allocator) {}
+    GenericValue(const GenericValue& rhs, AllocatorType& allocator) {}
+    GenericValue(GenericValue&& rhs) {}
+    GenericValue& operator=(GenericValue& rhs) { return *this; }
+    GenericValue& operator=(GenericValue&& rhs) { return *this; }
+    GenericValue& operator=(GenericStringRef<char> str) { return *this; }
+    template <typename T>
+    GenericValue& operator=(T value) { return *this; }
+
+    Type GetType() const { return kNullType; }
+    bool IsNull() const { return true; }
+    bool IsFalse() const { return false; }
+    bool IsTrue() const { return false; }
+    bool IsBool() const { return false; }
+    bool IsObject() const { return false; }
+    bool IsArray() const { return false; }
+    bool IsNumber() const { return false; }
+    bool IsInt() const { return false; }
+    bool IsUint() const { return false; }
+    bool IsInt64() const { return false; }
+    bool IsUint64() const { return false; }
+    bool IsDouble() const { return false; }
+    bool IsFloat() const { return false; }
+    bool IsString() const { return false; }
+
+    GenericValue& SetNull() { return *this; }
+    GenericValue& SetObject() { return *this; }
+    GenericValue& SetArray() { return *this; }
+    GenericValue& SetBool(bool b) { return *this; }
+    GenericValue& SetInt(int i) { return *this; }
+    GenericValue& SetDouble(double d) { return *this; }
+    GenericValue& SetString(const char* s, SizeType length) { return *this; }
+    GenericValue& SetString(GenericStringRef<char> s) { return *this; }
+    GenericValue& SetString(const char* s, SizeType length, AllocatorType& allocator) { return *this; }
+    GenericValue& SetString(const char* s, AllocatorType& allocator) { return *this; }
+    GenericValue& SetString(const std::string& s, AllocatorType& allocator) { return *this; }
+
+    bool GetBool() const { return false; }
+    int GetInt() const { return 0; }
+    unsigned GetUint() const { return 0; }
+    int64_t GetInt64() const { return 0; }
+    uint64_t GetUint64() const { return 0; }
+    double GetDouble() const { return 0; }
+    float GetFloat() const { return 0; }
+    const char* GetString() const { return ""; }
+    SizeType GetStringLength() const { return 0; }
+
+    bool HasMember(const char* name) const { return false; }
+    bool HasMember(const std::string& name) const { return false; }
+    GenericValue& operator[](const char* name) { return *this; }
+    const GenericValue& operator[](const char* name) const { return *this; }
+    GenericValue& operator[](const std::string& name) { return *this; }
+    const GenericValue& operator[](const std::string& name) const { return *this; }
+    GenericValue& operator[](SizeType index) { return *this; }
+    const GenericValue& operator[](SizeType index) const { return *this; }
+    GenericValue& operator[](int index) { return *this; }
+    const GenericValue& operator[](int index) const { return *this; }
+    MemberIterator FindMember(const char* name) { return nullptr; }
+    ConstMemberIterator FindMember(const char* name) const { return nullptr; }
+    MemberIterator MemberBegin() { return nullptr; }
+    MemberIterator MemberEnd() { return nullptr; }
+    ConstMemberIterator MemberBegin() const { return nullptr; }
+    ConstMemberIterator MemberEnd() const { return nullptr; }
+    SizeType MemberCount() const { return 0; }
+    bool RemoveMember(const char* name) { return false; }
+
+    GenericValue& AddMember(GenericValue& name, GenericValue& value, AllocatorType& allocator) { return *this; }
+    GenericValue& AddMember(GenericValue& name, GenericValue&& value, AllocatorType& allocator) { return *this; }
+    GenericValue& AddMember(GenericValue&& name, GenericValue&& value, AllocatorType& allocator) { return *this; }
+    GenericValue& AddMember(GenericValue&& name, GenericValue& value, AllocatorType& allocator) { return *this; }
+    GenericValue& AddMember(GenericStringRef<char> name, GenericValue& value, AllocatorType& allocator)
+    {
+        return *this;
+    }
+    GenericValue& AddMember(GenericStringRef<char> name, GenericValue&& value, AllocatorType& allocator)
+    {
+        return *this;
+    }
+    GenericValue& AddMember(GenericStringRef<char> name, GenericStringRef<char> value, AllocatorType& allocator)
+    {
+        return *this;
+    }
+    template <typename T>
+    GenericValue& AddMember(GenericStringRef<char> name, T value, AllocatorType& allocator) { return *this; }
+    template <typename T>
+    GenericValue& AddMember(GenericValue& name, T value, AllocatorType& allocator) { return *this; }
+
+    SizeType Size() const { return 0; }
+    SizeType Capacity() const { return 0; }
+    bool Empty() const { return true; }
+    void Clear() {}
+    GenericValue& Reserve(SizeType newCapacity, AllocatorType& allocator) { return *this; }
+    GenericValue& PushBack(GenericValue& value, AllocatorType& allocator) { return *this; }
+    GenericValue& PushBack(GenericValue&& value, AllocatorType& allocator) { return *this; }
+    GenericValue& PushBack(GenericStringRef<char> value, AllocatorType& allocator) { return *this; }
+    template <typename T>
+    GenericValue& PushBack(T value, AllocatorType& allocator) { return *this; }
+    ValueIterator Begin() { return nullptr; }
+    ValueIterator End() { return nullptr; }
+    ConstValueIterator Begin() const { return nullptr; }
+    ConstValueIterator End() const { return nullptr; }
+    Array GetArray() { return Array(); }
+    ConstArray GetArray() const { return ConstArray(); }
+    Object GetObject() { return Object(); }
+
+    GenericValue& CopyFrom(const GenericValue& rhs, AllocatorType& allocator) { return *this; }
+    GenericValue& Swap(GenericValue& other) { return *this; }
+    GenericValue& Move() { return *this; }
+
+    template <typename Handler>
+    bool Accept(Handler& handler) const { return true; }
+
+    bool operator==(const GenericValue& rhs) const { return true; }
+    bool operator!=(const GenericValue& rhs) const { return false; }
+};
+
+template <bool Const>
+GenericValue& GenericArray<Const>::operator[](SizeType index) const
+{
+    static GenericValue value;
+    return value;
+}
+
+typedef GenericValue Value;
+
+class GenericDocument : public GenericValue {
+public:
+    typedef MemoryPoolAllocator AllocatorType;
+    GenericDocument() {}
+    explicit GenericDocument(Type type) {}
+    GenericDocument& Parse(const char* str) { return *this; }
+    GenericDocument& Parse(const char* str, size_t length) { return *this; }
+    GenericDocument& Parse(const std::string& str) { return *this; }
+    template <unsigned ParseFlags>
+    GenericDocument& Parse(const char* str) { return *this; }
+    bool HasParseError() const { return false; }
+    ParseErrorCode GetParseError() const { return kParseErrorNone; }
+    size_t GetErrorOffset() const { return 0; }
+    AllocatorType& GetAllocator() { return allocator_; }
+
+private:
+    AllocatorType allocator_;
+};
+
+typedef GenericDocument Document;
+
+}  // namespace rapidjson
@@ -0,0 +1,10 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     prettywriter.h
+ * File Function: rapidjson PrettyWriter 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+#include "json/writer.h"
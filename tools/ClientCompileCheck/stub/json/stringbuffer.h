@@ -0,0 +1,22 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     stringbuffer.h
+ * File Function: rapidjson StringBuffer 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include <cstddef>
+
+namespace rapidjson {
+class GenericStringBuffer {
+public:
+    const char* GetString() const { return ""; }
+    size_t GetSize() const { return 0; }
+    size_t GetLength() const { return 0; }
+    void Clear() {}
+};
+typedef GenericStringBuffer StringBuffer;
+}  // namespace rapidjson
@@ -0,0 +1,33 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     writer.h
+ * File Function: rapidjson Writer 接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include "json/stringbuffer.h"
+
+namespace rapidjson {
+template <typename OutputStream>
+class Writer {
+public:
+    explicit Writer(OutputStream& os) {}
+    bool StartObject() { return true; }
+    bool EndObject() { return true; }
+    bool StartArray() { return true; }
+    bool EndArray() { return true; }
+    bool Key(const char* str) { return true; }
+    bool String(const char* str) { return true; }
+    bool Int(int i) { return true; }
+    bool Bool(bool b) { return true; }
+    bool Double(double d) { return true; }
+};
+template <typename OutputStream>
+class PrettyWriter : public Writer<OutputStream> {
+public:
+    explicit PrettyWriter(OutputStream& os) : Writer<OutputStream>(os) {}
+};
+}  // namespace rapidjson
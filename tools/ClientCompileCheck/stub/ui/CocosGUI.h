@@ -0,0 +1,267 @@
+﻿/****************************************************************
+ * Project Name:  Clash_of_Clans
+ * File Name:     CocosGUI.h
+ * File Function: cocos2d-x 4.0 UI 控件接口桩
+ * Author:        赵崇治
+ * Update Date:   2026/10/19
+ * License:       MIT License
+ ****************************************************************/
+#pragma once
+
+#include "cocos2d.h"
+
+namespace cocos2d {
+namespace ui {
+
+class Widget : public Node {
+public:
+    enum class TouchEventType { BEGAN, MOVED, ENDED, CANCELED };
+    enum class TextureResType { LOCAL = 0, PLIST = 1 };
+    enum class SizeType { ABSOLUTE, PERCENT };
+    typedef std::function<void(Ref*, TouchEventType)> ccWidgetTouchCallback;
+    typedef std::function<void(Ref*)> ccWidgetClickCallback;
+    static Widget* create() { return new Widget(); }
+    virtual void setEnabled(bool enabled) {}
+    bool isEnabled() const { return true; }
+    void setBright(bool bright) {}
+    bool isBright() const { return true; }
+    void setTouchEnabled(bool enabled) {}
+    bool isTouchEnabled() const { return true; }
+    void setSwallowTouches(bool swallow) {}
+    void setHighlighted(bool highlight) {}
+    void addTouchEventListener(const ccWidgetTouchCallback& callback) {}
+    void addClickEventListener(const ccWidgetClickCallback& callback) {}
+    void setPropagateTouchEvents(bool isPropagate) {}
+    void setSizeType(SizeType type) {}
+    void setSizePercent(const Vec2& percent) {}
+    void ignoreContentAdaptWithSize(bool ignore) {}
+    Vec2 getTouchBeganPosition() const { return Vec2(); }
+    Vec2 getTouchEndPosition() const { return Vec2(); }
+    Vec2 getWorldPosition() const { return Vec2(); }
+    bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const { return false; }
+};
+
+class Button : public Widget {
+public:
+    static Button* create() { return new Button(); }
+    static Button* create(const std::string& normalImage, const std::string& selectedImage = "",
+                          const std::string& disableImage = "", TextureResType texType = TextureResType::LOCAL)
+    {
+        return nullptr;
+    }
+    void loadTextures(const std::string& normal, const std::string& selected, const std::string& disabled = "",
+                      TextureResType texType = TextureResType::LOCAL)
+    {
+    }
+    void loadTextureNormal(const std::string& normal, TextureResType texType = TextureResType::LOCAL) {}
+    void loadTexturePressed(const std::string& selected, TextureResType texType = TextureResType::LOCAL) {}
+    void loadTextureDisabled(const std::string& disabled, TextureResType texType = TextureResType::LOCAL) {}
+    void setTitleText(const std::string& text) {}
+    std::string getTitleText() const { return std::string(); }
+    void setTitleColor(const Color3B& color) {}
+    Color3B getTitleColor() const { return Color3B(); }
+    void setTitleFontSize(float size) {}
+    float getTitleFontSize() const { return 0; }
+    void setTitleFontName(const std::string& fontName) {}
+    void setTitleAlignment(TextHAlignment hAlignment) {}
+    Label* getTitleLabel() const { return nullptr; }
+    Label* getTitleRenderer() const { return nullptr; }
+    void setTitleLabel(Label* label) {}
+    void setScale9Enabled(bool enable) {}
+    void setCapInsets(const Rect& capInsets) {}
+    void setPressedActionEnabled(bool enabled) {}
+    void setZoomScale(float scale) {}
+    Node* getRendererNormal() const { return nullptr; }
+};
+
+class Text : public Widget {
+public:
+    static Text* create() { return new Text(); }
+    static Text* create(const std::string& textContent, const std::string& fontName, float fontSize)
+    {
+        return nullptr;
+    }
+    void setString(const std::string& text) {}
+    const std::string& getString() const { return _text; }
+    void setFontSize(float size) {}
+    void setFontName(const std::string& name) {}
+    void setTextColor(const Color4B color) {}
+    void setTextHorizontalAlignment(TextHAlignment alignment) {}
+    void setTextVerticalAlignment(TextVAlignment alignment) {}
+    void setTextAreaSize(const Size& size) {}
+    void enableOutline(const Color4B& outlineColor, int outlineSize = 1) {}
+    void enableShadow(const Color4B& shadowColor = Color4B::BLACK, const Size& offset = Size(2, -2),
+                      int blurRadius = 0)
+    {
+    }
+
+private:
+    std::string _text;
+};
+
+class ImageView : public Widget {
+public:
+    static ImageView* create() { return new ImageView(); }
+    static ImageView* create(const std::string& imageFileName, TextureResType texType = TextureResType::LOCAL)
+    {
+        return nullptr;
+    }
+    void loadTexture(const std::string& fileName, TextureResType texType = TextureResType::LOCAL) {}
+    void setScale9Enabled(bool enabled) {}
+    void setCapInsets(const Rect& capInsets) {}
+};
+
+class TextField : public Widget {
+public:
+    enum class EventType { ATTACH_WITH_IME, DETACH_WITH_IME, INSERT_TEXT, DELETE_BACKWARD };
+    typedef std::function<void(Ref*, EventType)> ccTextFieldCallback;
+    static TextField* create() { return new TextField(); }
+    static TextField* create(const std::string& placeholder, const std::string& fontName, int fontSize)
+    {
+        return nullptr;
+    }
+    void setString(const std::string& text) {}
+    const std::string& getString() const { return _text; }
+    void setPlaceHolder(const std::string& value) {}
+    void setPlaceHolderColor(const Color3B& color) {}
+    void setPlaceHolderColor(const Color4B& color) {}
+    void setTextColor(const Color4B& textColor) {}
+    void setFontSize(int size) {}
+    void setFontName(const std::string& name) {}
+    void setMaxLengthEnabled(bool enable) {}
+    void setMaxLength(int length) {}
+    void setPasswordEnabled(bool enable) {}
+    void setPasswordStyleText(const char* styleText) {}
+    void setTextHorizontalAlignment(TextHAlignment alignment) {}
+    void setTextVerticalAlignment(TextVAlignment alignment) {}
+    void setCursorEnabled(bool enabled) {}
+    void attachWithIME() {}
+    void didNotSelectSelf() {}
+    void addEventListener(const ccTextFieldCallback& callback) {}
+
+private:
+    std::string _text;
+};
+
+class Slider : public Widget {
+public:
+    enum class EventType { ON_PERCENTAGE_CHANGED, ON_SLIDEBALL_DOWN, ON_SLIDEBALL_UP, ON_SLIDEBALL_CANCEL };
+    typedef std::function<void(Ref*, EventType)> ccSliderCallback;
+    static Slider* create() { return new Slider(); }
+    static Slider* create(const std::string& barTextureName, const std::string& normalBallTextureName,
+                          TextureResType resType = TextureResType::LOCAL)
+    {
+        return nullptr;
+    }
+    void loadBarTexture(const std::string& fileName, TextureResType resType = TextureResType::LOCAL) {}
+    void loadProgressBarTexture(const std::string& fileName, TextureResType resType = TextureResType::LOCAL) {}
+    void loadSlidBallTextures(const std::string& normal, const std::string& pressed = "",
+                              const std::string& disabled = "", TextureResType texType = TextureResType::LOCAL)
+    {
+    }
+    void setScale9Enabled(bool able) {}
+    void setPercent(int percent) {}
+    int getPercent() const { return 0; }
+    void setMaxPercent(int percent) {}
+    int getMaxPercent() const { return 100; }
+    void addEventListener(const ccSliderCallback& callback) {}
+};
+
+class LoadingBar : public Widget {
+public:
+    enum class Direction { LEFT, RIGHT };
+    static LoadingBar* create() { return new LoadingBar(); }
+    static LoadingBar* create(const std::string& textureName, float percentage = 0) { return nullptr; }
+    void setDirection(Direction direction) {}
+    void setPercent(float percent) {}
+    float getPercent() const { return 0; }
+    void loadTexture(const std::string& texture, TextureResType texType = TextureResType::LOCAL) {}
+    void setScale9Enabled(bool enabled) {}
+};
+
+class CheckBox : public Widget {
+public:
+    enum class EventType { SELECTED, UNSELECTED };
+    static CheckBox* create() { return new CheckBox(); }
+    void setSelected(bool selected) {}
+    bool isSelected() const { return false; }
+    void addEventListener(const std::function<void(Ref*, EventType)>& callback) {}
+};
+
+class Layout : public Widget {
+public:
+    enum class Type { ABSOLUTE, VERTICAL, HORIZONTAL, RELATIVE };
+    enum class BackGroundColorType { NONE, SOLID, GRADIENT };
+    static Layout* create() { return new Layout(); }
+    void setLayoutType(Type type) {}
+    void setBackGroundColorType(BackGroundColorType type) {}
+    void setBackGroundColor(const Color3B& color) {}
+    void setBackGroundColor(const Color3B& startColor, const Color3B& endColor) {}
+    void setBackGroundColorOpacity(uint8_t opacity) {}
+    void setBackGroundImage(const std::string& fileName, TextureResType texType = TextureResType::LOCAL) {}
+    void setClippingEnabled(bool enabled) {}
+    void requestDoLayout() {}
+};
+
+class ScrollView : public Layout {
+public:
+    enum class Direction { NONE, VERTICAL, HORIZONTAL, BOTH };
+    enum class EventType { SCROLL_TO_TOP, SCROLL_TO_BOTTOM, SCROLLING, CONTAINER_MOVED };
+    static ScrollView* create() { return new ScrollView(); }
+    void setDirection(Direction dir) {}
+    void setInnerContainerSize(const Size& size) {}
+    const Size& getInnerContainerSize() const { return _size; }
+    Layout* getInnerContainer() const { return nullptr; }
+    const Vec2 getInnerContainerPosition() const { return Vec2(); }
+    void setInnerContainerPosition(const Vec2& pos) {}
+    void setBounceEnabled(bool enabled) {}
+    void setScrollBarEnabled(bool enabled) {}
+    void setScrollBarOpacity(uint8_t opacity) {}
+    void setScrollBarWidth(float width) {}
+    void setScrollBarPositionFromCorner(const Vec2& positionFromCorner) {}
+    void setInertiaScrollEnabled(bool enabled) {}
+    void jumpToTop() {}
+    void jumpToBottom() {}
+    void scrollToTop(float timeInSec, bool attenuated) {}
+    void scrollToBottom(float timeInSec, bool attenuated) {}
+    void addEventListener(const std::function<void(Ref*, EventType)>& callback) {}
+};
+
+class ListView : public ScrollView {
+public:
+    enum class Gravity { LEFT, RIGHT, CENTER_HORIZONTAL, TOP, BOTTOM, CENTER_VERTICAL };
+    enum class EventType { ON_SELECTED_ITEM_START, ON_SELECTED_ITEM_END };
+    using ScrollView::addEventListener;
+    void addEventListener(const std::function<void(Ref*, EventType)>& callback) {}
+    ssize_t getCurSelectedIndex() const { return -1; }
+    ssize_t getIndex(Widget* item) const { return -1; }
+    static ListView* create() { return new ListView(); }
+    void pushBackCustomItem(Widget* item) {}
+    void insertCustomItem(Widget* item, ssize_t index) {}
+    void removeItem(ssize_t index) {}
+    void removeLastItem() {}
+    void removeAllItems() {}
+    Widget* getItem(ssize_t index) const { return nullptr; }
+    Vector<Widget*>& getItems() { return _items; }
+    void setItemsMargin(float margin) {}
+    void setGravity(Gravity gravity) {}
+    void forceDoLayout() {}
+    void doLayout() {}
+    void jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint) {}
+
+private:
+    Vector<Widget*> _items;
+};
+
+class PageView : public ListView {
+public:
+    static PageView* create() { return new PageView(); }
+};
+
+class RichText : public Widget {
+public:
+    static RichText* create() { return new RichText(); }
+};
+
+}  // namespace ui
+}  // namespace cocos2d